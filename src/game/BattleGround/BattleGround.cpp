@@ -56,6 +56,7 @@
 #include "GridNotifiersImpl.h"
 #include "Chat.h"
 #include "PlayerRegistry.h"
+#include "SharedPacket.h"
 #ifdef ENABLE_ELUNA
 #include "LuaEngine.h"
 #include <cstdarg>
@@ -560,6 +561,8 @@ void BattleGround::SetTeamStartLoc(Team team, float X, float Y, float Z, float O
  */
 void BattleGround::SendPacketToAll(WorldPacket* packet)
 {
+    proto::SharedPacketScope shared(*packet);
+
     for (BattleGroundPlayerMap::const_iterator itr = m_Players.begin(); itr != m_Players.end(); ++itr)
     {
         if (itr->second.OfflineRemoveTime)
@@ -588,6 +591,8 @@ void BattleGround::SendPacketToAll(WorldPacket* packet)
  */
 void BattleGround::SendPacketToTeam(Team teamId, WorldPacket* packet, Player* sender, bool self)
 {
+    proto::SharedPacketScope shared(*packet);
+
     for (BattleGroundPlayerMap::const_iterator itr = m_Players.begin(); itr != m_Players.end(); ++itr)
     {
         if (itr->second.OfflineRemoveTime)
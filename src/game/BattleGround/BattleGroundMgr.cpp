@@ -91,6 +91,11 @@ BattleGroundQueue::BattleGroundQueue()
             }
         }
     }
+
+    for (uint8 i = 0; i < MAX_BATTLEGROUND_BRACKETS; ++i)
+    {
+        m_Matchers[i].Attach(m_QueuedGroups[i]);
+    }
 }
 
 /**
@@ -180,6 +185,7 @@ BattleGroundMgr::BattleGroundMgr()
  */
 BattleGroundMgr::~BattleGroundMgr()
 {
+    m_QueueMatchPool.Deactivate();
     DeleteAllBattleGrounds();
 }
 
@@ -223,16 +229,63 @@ void BattleGroundMgr::Update(uint32 /*diff*/)
             m_QueueUpdateScheduler.clear();
         }
 
-        for (uint8 i = 0; i < scheduled.size(); ++i)
+        // The scheduler holds each (queue, bracket) pair at most once, and a bracket's
+        // match search touches nothing but that bracket. Only the search runs on the
+        // pool: filling running battlegrounds and inviting reach into players and
+        // battlegrounds, so both stay here on the world thread.
+        std::vector<PendingQueueMatch> pending;
+        pending.reserve(scheduled.size());
+        for (uint32 i = 0; i < scheduled.size(); ++i)
+        {
+            PendingQueueMatch match;
+            match.QueueTypeId = BattleGroundQueueTypeId(scheduled[i] >> 16 & 255);
+            match.TypeId = BattleGroundTypeId((scheduled[i] >> 8) & 255);
+            match.BracketId = BattleGroundBracketId(scheduled[i] & 255);
+            match.Result = BG_MATCH_NONE;
+            if (m_BattleGroundQueues[match.QueueTypeId].PrepareMatch(match.TypeId, match.BracketId, match.Rules))
+            {
+                pending.push_back(match);
+            }
+        }
+
+        for (size_t i = 0; i < pending.size(); ++i)
+        {
+            PendingQueueMatch* match = &pending[i];
+            BattleGroundQueue* queue = &m_BattleGroundQueues[match->QueueTypeId];
+            m_QueueMatchPool.Schedule([match, queue]()
+            {
+                match->Result = queue->FindMatch(match->BracketId, match->Rules);
+            });
+        }
+        m_QueueMatchPool.Wait();
+
+        for (size_t i = 0; i < pending.size(); ++i)
         {
-            BattleGroundQueueTypeId bgQueueTypeId = BattleGroundQueueTypeId(scheduled[i] >> 16 & 255);
-            BattleGroundTypeId bgTypeId = BattleGroundTypeId((scheduled[i] >> 8) & 255);
-            BattleGroundBracketId bracket_id = BattleGroundBracketId(scheduled[i] & 255);
-            m_BattleGroundQueues[bgQueueTypeId].Update(bgTypeId, bracket_id);
+            PendingQueueMatch const& match = pending[i];
+            m_BattleGroundQueues[match.QueueTypeId].ApplyMatch(match.TypeId, match.BracketId, match.Rules, match.Result);
         }
     }
 }
 
+/**
+ * @brief Starts the worker threads that search battleground queues for matches.
+ *
+ * With Battleground.QueueMatchThreads set to 0 the search runs on the world thread.
+ */
+void BattleGroundMgr::InitQueueMatchThreads()
+{
+    uint32 threads = sWorld.getConfig(CONFIG_UINT32_BATTLEGROUND_QUEUE_MATCH_THREADS);
+    if (threads && !m_QueueMatchPool.Activate(threads))
+    {
+        sLog.outError("BattleGroundMgr: could not start %u queue match threads, matching on the world thread", threads);
+        return;
+    }
+    if (threads)
+    {
+        sLog.outString(">> Battleground queues matched by %u threads", threads);
+    }
+}
+
 /**
  * @brief Builds a battlefield status packet for sending to the player.
  *
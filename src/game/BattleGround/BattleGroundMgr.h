@@ -64,6 +64,8 @@
 #include "Policies/Singleton.h"
 #include "BattleGround.h"
 #include "Utilities/EventProcessor.h"
+#include "Threading/TaskPool.h"
+#include "BattleGroundQueueMatch.h"
 
 /**
  * @brief Container for storing battleground instances.
@@ -93,47 +95,6 @@ typedef std::unordered_map<uint32, BattleGroundEventIdx> GameObjectBattleEventIn
 
 #define COUNT_OF_PLAYERS_TO_AVERAGE_WAIT_TIME 10
 
-struct GroupQueueInfo; // type predefinition
-
-/**
- * @brief Stores information for players in queue.
- */
-struct PlayerQueueInfo
-{
-    uint32  LastOnlineTime; /**< For tracking and removing offline players from queue after 5 minutes */
-    GroupQueueInfo* GroupInfo; /**< Pointer to the associated groupqueueinfo */
-};
-
-/**
- * @brief Container for storing player queue info in a group.
- */
-typedef std::map<ObjectGuid, PlayerQueueInfo*> GroupQueueInfoPlayers;
-
-/**
- * @brief Stores information about the group in queue (also used when joined as solo!).
- */
-struct GroupQueueInfo
-{
-    GroupQueueInfoPlayers Players; /**< Player queue info map */
-    Team GroupTeam; /**< Player team (ALLIANCE/HORDE) */
-    BattleGroundTypeId BgTypeId; /**< Battleground type id */
-    uint32 JoinTime; /**< Time when group was added */
-    uint32 RemoveInviteTime; /**< Time when we will remove invite for players in group */
-    uint32 IsInvitedToBGInstanceGUID; /**< Was invited to certain BG */
-};
-
-/**
- * @brief Enum for battleground queue group types.
- */
-enum BattleGroundQueueGroupTypes
-{
-    BG_QUEUE_PREMADE_ALLIANCE   = 0,
-    BG_QUEUE_PREMADE_HORDE      = 1,
-    BG_QUEUE_NORMAL_ALLIANCE    = 2,
-    BG_QUEUE_NORMAL_HORDE       = 3
-};
-#define BG_QUEUE_GROUP_TYPES_COUNT 4
-
 /**
  * @brief Enum for battleground group join status.
  */
@@ -170,29 +131,40 @@ class BattleGroundQueue
         void Update(BattleGroundTypeId bgTypeId, BattleGroundBracketId bracket_id);
 
         /**
-         * @brief Fills players to the battleground.
-         * @param bg The battleground.
+         * @brief First step of Update: fills running battlegrounds and captures the match rules.
+         * Must run on the world thread.
+         * @param bgTypeId The battleground type id.
          * @param bracket_id The bracket id.
+         * @param rules Receives the rules for FindMatch and ApplyMatch.
+         * @return bool True if the bracket still has groups that could start a new battleground.
          */
-        void FillPlayersToBG(BattleGround* bg, BattleGroundBracketId bracket_id);
+        bool PrepareMatch(BattleGroundTypeId bgTypeId, BattleGroundBracketId bracket_id, BattleGroundMatchRules& rules);
 
         /**
-         * @brief Checks for premade match.
+         * @brief Second step of Update: searches the bracket for a new battleground.
+         * Touches nothing outside the bracket, so different brackets may be searched concurrently.
          * @param bracket_id The bracket id.
-         * @param MinPlayersPerTeam Minimum players per team.
-         * @param MaxPlayersPerTeam Maximum players per team.
-         * @return bool True if premade match is found, false otherwise.
+         * @param rules The rules captured by PrepareMatch.
+         * @return BattleGroundMatchResult What was found.
+         */
+        BattleGroundMatchResult FindMatch(BattleGroundBracketId bracket_id, BattleGroundMatchRules const& rules);
+
+        /**
+         * @brief Last step of Update: creates the battleground and invites the selected groups.
+         * Must run on the world thread.
+         * @param bgTypeId The battleground type id.
+         * @param bracket_id The bracket id.
+         * @param rules The rules captured by PrepareMatch.
+         * @param result The result of FindMatch.
          */
-        bool CheckPremadeMatch(BattleGroundBracketId bracket_id, uint32 MinPlayersPerTeam, uint32 MaxPlayersPerTeam);
+        void ApplyMatch(BattleGroundTypeId bgTypeId, BattleGroundBracketId bracket_id, BattleGroundMatchRules const& rules, BattleGroundMatchResult result);
 
         /**
-         * @brief Checks for normal match.
+         * @brief Fills players to the battleground.
+         * @param bg The battleground.
          * @param bracket_id The bracket id.
-         * @param minPlayers Minimum players.
-         * @param maxPlayers Maximum players.
-         * @return bool True if normal match is found, false otherwise.
          */
-        bool CheckNormalMatch(BattleGroundBracketId bracket_id, uint32 minPlayers, uint32 maxPlayers);
+        void FillPlayersToBG(BattleGround* bg, BattleGroundBracketId bracket_id);
 
         /**
          * @brief Adds a group to the battleground queue.
@@ -253,9 +225,8 @@ class BattleGroundQueue
 
         /**
          * @brief List for storing queued groups.
-         * We need constant add to begin and constant remove / add from the end, therefore deque suits our problem well.
          */
-        typedef std::list<GroupQueueInfo*> GroupsQueueType;
+        typedef BattleGroundGroupList GroupsQueueType;
 
         /**
          * @brief Two dimensional array for storing all queued groups.
@@ -269,50 +240,17 @@ class BattleGroundQueue
         GroupsQueueType m_QueuedGroups[MAX_BATTLEGROUND_BRACKETS][BG_QUEUE_GROUP_TYPES_COUNT]; /**< Two dimensional array for storing all queued groups. */
 
         /**
-         * @brief Class to select and invite groups to battleground.
+         * @brief Match search and selection pools of each bracket.
+         * Kept per bracket, not per queue, so that brackets can be searched concurrently.
          */
-        class SelectionPool
-        {
-            public:
-                /**
-                 * @brief Constructor for SelectionPool.
-                 */
-                SelectionPool() : PlayerCount(0) {}
-
-                /**
-                 * @brief Initializes the selection pool.
-                 */
-                void Init();
-
-                /**
-                 * @brief Adds a group to the selection pool.
-                 * @param ginfo Pointer to the group queue info.
-                 * @param desiredCount The desired count.
-                 * @return bool True if the group is added, false otherwise.
-                 */
-                bool AddGroup(GroupQueueInfo* ginfo, uint32 desiredCount);
-
-                /**
-                 * @brief Kicks a group from the selection pool.
-                 * @param size The size of the group.
-                 * @return bool True if the group is kicked, false otherwise.
-                 */
-                bool KickGroup(uint32 size);
-
-                /**
-                 * @brief Gets the player count in the selection pool.
-                 * @return uint32 The player count.
-                 */
-                uint32 GetPlayerCount() const {return PlayerCount;}
-
-            public:
-                GroupsQueueType SelectedGroups; /**< List of selected groups. */
-
-            private:
-                uint32 PlayerCount; /**< Player count in the selection pool. */
-        };
+        BattleGroundBracketMatcher m_Matchers[MAX_BATTLEGROUND_BRACKETS];
 
-        SelectionPool m_SelectionPools[PVP_TEAM_COUNT]; /**< One selection pool for horde, other one for alliance. */
+        /**
+         * @brief Invites the groups a matcher selected to the battleground.
+         * @param matcher The matcher holding the selection.
+         * @param bg Pointer to the battleground.
+         */
+        void InviteSelectedGroups(BattleGroundBracketMatcher const& matcher, BattleGround* bg);
 
         /**
          * @brief Invites a group to the battleground.
@@ -440,6 +378,11 @@ class BattleGroundMgr
          */
         void Update(uint32 diff);
 
+        /**
+         * @brief Starts the threads that search queue brackets for matches.
+         */
+        void InitQueueMatchThreads();
+
         /* Packet Building */
 
         /**
@@ -759,6 +702,19 @@ class BattleGroundMgr
         BattleGroundSet m_BattleGrounds[MAX_BATTLEGROUND_TYPE_ID]; /**< Array of maps storing battleground instances by type ID. */
         std::vector<uint32> m_QueueUpdateScheduler; /**< Vector for scheduling queue updates. */
 
+        /**
+         * @brief A scheduled queue bracket between the prepare and apply steps of Update.
+         */
+        struct PendingQueueMatch
+        {
+            BattleGroundQueueTypeId QueueTypeId; /**< Queue the bracket belongs to. */
+            BattleGroundTypeId TypeId; /**< Battleground type to start. */
+            BattleGroundBracketId BracketId; /**< Bracket to search. */
+            BattleGroundMatchRules Rules; /**< Rules captured on the world thread. */
+            BattleGroundMatchResult Result; /**< Written by the match search. */
+        };
+        MaNGOS::TaskPool m_QueueMatchPool; /**< Threads searching scheduled brackets for matches. */
+
         /**
          * @brief Set of client-visible battleground instance IDs.
          * The first dimension specifies the battleground type ID.
@@ -64,89 +64,6 @@
 #include "LuaEngine.h"
 #endif /* ENABLE_ELUNA */
 
-/**
- * @brief Initializes the selection pool for team balancing.
- *
- * Clears the list of selected groups and resets the player count to prepare
- * for a new team building cycle.
- */
-void BattleGroundQueue::SelectionPool::Init()
-{
-    SelectedGroups.clear();
-    PlayerCount = 0;
-}
-
-/**
- * @brief Removes a group from the selection pool.
- *
- * Attempts to remove a group of approximately the specified size from the selection pool
- * to balance team composition. Prefers to remove larger groups or groups of similar size
- * to the target size.
- *
- * @param size The target group size to remove.
- * @return true if more groups should be added to maintain balance, false otherwise.
- */
-bool BattleGroundQueue::SelectionPool::KickGroup(uint32 size)
-{
-    // find maxgroup or LAST group with size == size and kick it
-    bool found = false;
-    GroupsQueueType::iterator groupToKick = SelectedGroups.begin();
-    for (GroupsQueueType::iterator itr = groupToKick; itr != SelectedGroups.end(); ++itr)
-    {
-        if (abs((int32)((*itr)->Players.size() - size)) <= 1)
-        {
-            groupToKick = itr;
-            found = true;
-        }
-        else if (!found && (*itr)->Players.size() >= (*groupToKick)->Players.size())
-        {
-            groupToKick = itr;
-        }
-    }
-    // if pool is empty, do nothing
-    if (GetPlayerCount())
-    {
-        // update player count
-        GroupQueueInfo* ginfo = (*groupToKick);
-        SelectedGroups.erase(groupToKick);
-        PlayerCount -= ginfo->Players.size();
-        // return false if we kicked smaller group or there are enough players in selection pool
-        if (ginfo->Players.size() <= size + 1)
-        {
-            return false;
-        }
-    }
-    return true;
-}
-
-/**
- * @brief Adds a group to the selection pool if space is available.
- *
- * Attempts to add a group to the selection pool for battleground invitation.
- * Only adds the group if doing so won't exceed the desired player count, or
- * if the pool still needs more players to reach the desired count.
- *
- * @param ginfo Pointer to the group queue info to add.
- * @param desiredCount The target number of players for this team.
- * @return true if the group was added or if more players are still needed, false if pool is full.
- */
-bool BattleGroundQueue::SelectionPool::AddGroup(GroupQueueInfo* ginfo, uint32 desiredCount)
-{
-    // if group is larger than desired count - don't allow to add it to pool
-    if (!ginfo->IsInvitedToBGInstanceGUID && desiredCount >= PlayerCount + ginfo->Players.size())
-    {
-        SelectedGroups.push_back(ginfo);
-        // increase selected players count
-        PlayerCount += ginfo->Players.size();
-        return true;
-    }
-    if (PlayerCount < desiredCount)
-    {
-        return true;
-    }
-    return false;
-}
-
 /**
  * @brief Adds a group or solo player to the battleground queue.
  *
@@ -538,264 +455,78 @@ bool BattleGroundQueue::InviteGroupToBG(GroupQueueInfo* ginfo, BattleGround* bg,
  * @brief Fills a battleground with players from the queue.
  *
  * Attempts to populate an in-progress battleground with additional players from the queue.
- * Selects groups based on available slots for each team, attempting to balance team composition
- * using the selection pool system. Large groups may be broken apart to maintain balance
- * based on configuration settings.
+ * The bracket's matcher selects the groups, balancing the teams when
+ * Battleground.InvitationType asks for it; the selection is invited right away.
  *
  * @param bg Pointer to the battleground to fill with players.
  * @param bracket_id The bracket to select players from.
  */
 void BattleGroundQueue::FillPlayersToBG(BattleGround* bg, BattleGroundBracketId bracket_id)
 {
-    int32 hordeFree = bg->GetFreeSlotsForTeam(HORDE);
-    int32 aliFree   = bg->GetFreeSlotsForTeam(ALLIANCE);
-
-    // iterator for iterating through bg queue
-    GroupsQueueType::const_iterator Ali_itr = m_QueuedGroups[bracket_id][BG_QUEUE_NORMAL_ALLIANCE].begin();
-    // count of groups in queue - used to stop cycles
-    uint32 aliCount = m_QueuedGroups[bracket_id][BG_QUEUE_NORMAL_ALLIANCE].size();
-    // index to queue which group is current
-    uint32 aliIndex = 0;
-    for (; aliIndex < aliCount && m_SelectionPools[TEAM_INDEX_ALLIANCE].AddGroup((*Ali_itr), aliFree); ++aliIndex)
-    {
-        ++Ali_itr;
-    }
-    // the same thing for horde
-    GroupsQueueType::const_iterator Horde_itr = m_QueuedGroups[bracket_id][BG_QUEUE_NORMAL_HORDE].begin();
-    uint32 hordeCount = m_QueuedGroups[bracket_id][BG_QUEUE_NORMAL_HORDE].size();
-    uint32 hordeIndex = 0;
-    for (; hordeIndex < hordeCount && m_SelectionPools[TEAM_INDEX_HORDE].AddGroup((*Horde_itr), hordeFree); ++hordeIndex)
-    {
-        ++Horde_itr;
-    }
+    BattleGroundBracketMatcher& matcher = m_Matchers[bracket_id];
 
-    // if ofc like BG queue invitation is set in config, then we are happy
-    if (sWorld.getConfig(CONFIG_UINT32_BATTLEGROUND_INVITATION_TYPE) == 0)
-    {
-        return;
-    }
+    // clear selection pools
+    matcher.Reset();
 
-    /**
-     * If we reached this code, then we have to solve NP - complete problem called Subset sum problem
-     * So one solution is to check all possible invitation subgroups, or we can use these conditions:
-     * 1. Last time when BattleGroundQueue::Update was executed we invited all possible players - so there is only small possibility
-     * that we will invite now whole queue, because only 1 change has been made to queues from the last BattleGroundQueue::Update call
-     * 2. Other thing we should consider is group order in queue
-     */
-
-    // At first we need to compare free space in bg and our selection pool
-    int32 diffAli   = aliFree   - int32(m_SelectionPools[TEAM_INDEX_ALLIANCE].GetPlayerCount());
-    int32 diffHorde = hordeFree - int32(m_SelectionPools[TEAM_INDEX_HORDE].GetPlayerCount());
-    while (abs(diffAli - diffHorde) > 1 && (m_SelectionPools[TEAM_INDEX_HORDE].GetPlayerCount() > 0 || m_SelectionPools[TEAM_INDEX_ALLIANCE].GetPlayerCount() > 0))
-    {
-        // each cycle execution we need to kick at least 1 group
-        if (diffAli < diffHorde)
-        {
-            // kick alliance group, add to pool new group if needed
-            if (m_SelectionPools[TEAM_INDEX_ALLIANCE].KickGroup(diffHorde - diffAli))
-            {
-                for (; aliIndex < aliCount && m_SelectionPools[TEAM_INDEX_ALLIANCE].AddGroup((*Ali_itr), (aliFree >= diffHorde) ? aliFree - diffHorde : 0); ++aliIndex)
-                {
-                    ++Ali_itr;
-                }
-            }
-            // if ali selection is already empty, then kick horde group, but if there are less horde than ali in bg - break;
-            if (!m_SelectionPools[TEAM_INDEX_ALLIANCE].GetPlayerCount())
-            {
-                if (aliFree <= diffHorde + 1)
-                {
-                    break;
-                }
-                m_SelectionPools[TEAM_INDEX_HORDE].KickGroup(diffHorde - diffAli);
-            }
-        }
-        else
-        {
-            // kick horde group, add to pool new group if needed
-            if (m_SelectionPools[TEAM_INDEX_HORDE].KickGroup(diffAli - diffHorde))
-            {
-                for (; hordeIndex < hordeCount && m_SelectionPools[TEAM_INDEX_HORDE].AddGroup((*Horde_itr), (hordeFree >= diffAli) ? hordeFree - diffAli : 0); ++hordeIndex)
-                {
-                    ++Horde_itr;
-                }
-            }
-            if (!m_SelectionPools[TEAM_INDEX_HORDE].GetPlayerCount())
-            {
-                if (hordeFree <= diffAli + 1)
-                {
-                    break;
-                }
-                m_SelectionPools[TEAM_INDEX_ALLIANCE].KickGroup(diffAli - diffHorde);
-            }
-        }
-        // count diffs after small update
-        diffAli   = aliFree   - int32(m_SelectionPools[TEAM_INDEX_ALLIANCE].GetPlayerCount());
-        diffHorde = hordeFree - int32(m_SelectionPools[TEAM_INDEX_HORDE].GetPlayerCount());
-    }
+    // call a function that does the job for us
+    matcher.FillFreeSlots(bg->GetFreeSlotsForTeam(ALLIANCE), bg->GetFreeSlotsForTeam(HORDE),
+                          sWorld.getConfig(CONFIG_UINT32_BATTLEGROUND_INVITATION_TYPE) != 0);
+
+    // now everything is set, invite players
+    InviteSelectedGroups(matcher, bg);
 }
 
 /**
- * @brief Checks if a premade versus premade battleground match can be made.
- *
- * Attempts to create a premade versus premade battleground match between groups that have
- * been waiting. After 30 minutes (default), premade groups are moved to the normal queue
- * if a premade match cannot be created. Groups are invited to a new battleground instance
- * up to the maximum players per team.
+ * @brief Invites every group a matcher selected to a battleground.
  *
- * @param bracket_id The bracket to check for premade matches.
- * @param MinPlayersPerTeam The minimum players required per team.
- * @param MaxPlayersPerTeam The maximum players allowed per team.
- * @return true if a match was successfully created or handled, false otherwise.
+ * @param matcher The matcher whose selection pools are invited.
+ * @param bg Pointer to the battleground the groups are invited to.
  */
-bool BattleGroundQueue::CheckPremadeMatch(BattleGroundBracketId bracket_id, uint32 MinPlayersPerTeam, uint32 MaxPlayersPerTeam)
+void BattleGroundQueue::InviteSelectedGroups(BattleGroundBracketMatcher const& matcher, BattleGround* bg)
 {
-    // check match
-    if (!m_QueuedGroups[bracket_id][BG_QUEUE_PREMADE_ALLIANCE].empty() && !m_QueuedGroups[bracket_id][BG_QUEUE_PREMADE_HORDE].empty())
-    {
-        // start premade match
-        // if groups aren't invited
-        GroupsQueueType::const_iterator ali_group, horde_group;
-        for (ali_group = m_QueuedGroups[bracket_id][BG_QUEUE_PREMADE_ALLIANCE].begin(); ali_group != m_QueuedGroups[bracket_id][BG_QUEUE_PREMADE_ALLIANCE].end(); ++ali_group)
-        {
-            if (!(*ali_group)->IsInvitedToBGInstanceGUID)
-            {
-                break;
-            }
-        }
-
-        for (horde_group = m_QueuedGroups[bracket_id][BG_QUEUE_PREMADE_HORDE].begin(); horde_group != m_QueuedGroups[bracket_id][BG_QUEUE_PREMADE_HORDE].end(); ++horde_group)
-        {
-            if (!(*horde_group)->IsInvitedToBGInstanceGUID)
-            {
-                break;
-            }
-        }
-
-        if (ali_group != m_QueuedGroups[bracket_id][BG_QUEUE_PREMADE_ALLIANCE].end() && horde_group != m_QueuedGroups[bracket_id][BG_QUEUE_PREMADE_HORDE].end())
-        {
-            m_SelectionPools[TEAM_INDEX_ALLIANCE].AddGroup((*ali_group), MaxPlayersPerTeam);
-            m_SelectionPools[TEAM_INDEX_HORDE].AddGroup((*horde_group), MaxPlayersPerTeam);
-            // add groups/players from normal queue to size of bigger group
-            uint32 maxPlayers = std::max(m_SelectionPools[TEAM_INDEX_ALLIANCE].GetPlayerCount(), m_SelectionPools[TEAM_INDEX_HORDE].GetPlayerCount());
-            GroupsQueueType::const_iterator itr;
-            for (uint8 i = 0; i < PVP_TEAM_COUNT; ++i)
-            {
-                for (itr = m_QueuedGroups[bracket_id][BG_QUEUE_NORMAL_ALLIANCE + i].begin(); itr != m_QueuedGroups[bracket_id][BG_QUEUE_NORMAL_ALLIANCE + i].end(); ++itr)
-                {
-                    // if itr can join BG and player count is less that maxPlayers, then add group to selectionpool
-                    if (!(*itr)->IsInvitedToBGInstanceGUID && !m_SelectionPools[i].AddGroup((*itr), maxPlayers))
-                    {
-                        break;
-                    }
-                }
-            }
-            // premade selection pools are set
-            return true;
-        }
-    }
-    // now check if we can move group from Premade queue to normal queue (timer has expired) or group size lowered!!
-    // this could be 2 cycles but i'm checking only first team in queue - it can cause problem -
-    // if first is invited to BG and seconds timer expired, but we can ignore it, because players have only 80 seconds to click to enter bg
-    // and when they click or after 80 seconds the queue info is removed from queue
-    uint32 time_before = GameTime::GetGameTimeMS() - sWorld.getConfig(CONFIG_UINT32_BATTLEGROUND_PREMADE_GROUP_WAIT_FOR_MATCH);
     for (uint8 i = 0; i < PVP_TEAM_COUNT; ++i)
     {
-        if (!m_QueuedGroups[bracket_id][BG_QUEUE_PREMADE_ALLIANCE + i].empty())
+        BattleGroundSelectionPool const& pool = matcher.GetPool(TEAM_INDEX_ALLIANCE + i);
+        for (GroupsQueueType::const_iterator citr = pool.SelectedGroups.begin(); citr != pool.SelectedGroups.end(); ++citr)
         {
-            GroupsQueueType::iterator itr = m_QueuedGroups[bracket_id][BG_QUEUE_PREMADE_ALLIANCE + i].begin();
-            if (!(*itr)->IsInvitedToBGInstanceGUID && ((*itr)->JoinTime < time_before || (*itr)->Players.size() < MinPlayersPerTeam))
-            {
-                // we must insert group to normal queue and erase pointer from premade queue
-                m_QueuedGroups[bracket_id][BG_QUEUE_NORMAL_ALLIANCE + i].push_front((*itr));
-                m_QueuedGroups[bracket_id][BG_QUEUE_PREMADE_ALLIANCE + i].erase(itr);
-            }
+            InviteGroupToBG((*citr), bg, (*citr)->GroupTeam);
         }
     }
-    // selection pools are not set
-    return false;
 }
 
 /**
- * @brief Checks if a normal (non-premade) match can be created.
- *
- * Attempts to build balanced teams from the normal queue with at least minPlayers on each side.
- * Uses selection pools to collect groups and balance team sizes. If configured to allow
- * invitation type balancing, may invite additional groups to the team with fewer players.
- *
- * @param bracket_id The bracket to check for normal matches.
- * @param minPlayers The minimum players required per team.
- * @param maxPlayers The maximum players allowed per team.
- * @return true if a match was successfully created, false otherwise.
+ * This method is called when group is inserted, or player / group is removed from BG Queue - there is only one player's status changed, so we don't use while (true) cycles to invite whole queue
+ * it must be called after fully adding the members of a group to ensure group joining
+ * should be called from BattleGround::RemovePlayer function in some cases
  */
-bool BattleGroundQueue::CheckNormalMatch(BattleGroundBracketId bracket_id, uint32 minPlayers, uint32 maxPlayers)
+void BattleGroundQueue::Update(BattleGroundTypeId bgTypeId, BattleGroundBracketId bracket_id)
 {
-    GroupsQueueType::const_iterator itr_team[PVP_TEAM_COUNT];
-    for (uint8 i = 0; i < PVP_TEAM_COUNT; ++i)
-    {
-        itr_team[i] = m_QueuedGroups[bracket_id][BG_QUEUE_NORMAL_ALLIANCE + i].begin();
-        for (; itr_team[i] != m_QueuedGroups[bracket_id][BG_QUEUE_NORMAL_ALLIANCE + i].end(); ++(itr_team[i]))
-        {
-            if (!(*(itr_team[i]))->IsInvitedToBGInstanceGUID)
-            {
-                m_SelectionPools[i].AddGroup(*(itr_team[i]), maxPlayers);
-                if (m_SelectionPools[i].GetPlayerCount() >= minPlayers)
-                {
-                    break;
-                }
-            }
-        }
-    }
-    // try to invite same number of players - this cycle may cause longer wait time even if there are enough players in queue, but we want ballanced bg
-    uint32 j = TEAM_INDEX_ALLIANCE;
-    if (m_SelectionPools[TEAM_INDEX_HORDE].GetPlayerCount() < m_SelectionPools[TEAM_INDEX_ALLIANCE].GetPlayerCount())
+    BattleGroundMatchRules rules;
+    if (!PrepareMatch(bgTypeId, bracket_id, rules))
     {
-        j = TEAM_INDEX_HORDE;
+        return;
     }
 
-    if (sWorld.getConfig(CONFIG_UINT32_BATTLEGROUND_INVITATION_TYPE) != 0 &&
-        m_SelectionPools[TEAM_INDEX_HORDE].GetPlayerCount() >= minPlayers && m_SelectionPools[TEAM_INDEX_ALLIANCE].GetPlayerCount() >= minPlayers)
-    {
-        // we will try to invite more groups to team with less players indexed by j
-        ++(itr_team[j]);                                    // this will not cause a crash, because for cycle above reached break;
-        for (; itr_team[j] != m_QueuedGroups[bracket_id][BG_QUEUE_NORMAL_ALLIANCE + j].end(); ++(itr_team[j]))
-        {
-            if (!(*(itr_team[j]))->IsInvitedToBGInstanceGUID)
-            {
-                if (!m_SelectionPools[j].AddGroup(*(itr_team[j]), m_SelectionPools[(j + 1) % PVP_TEAM_COUNT].GetPlayerCount()))
-                {
-                    break;
-                }
-            }
-        }
-        // do not allow to start bg with more than 2 players more on 1 faction
-        if (abs((int32)(m_SelectionPools[TEAM_INDEX_HORDE].GetPlayerCount() - m_SelectionPools[TEAM_INDEX_ALLIANCE].GetPlayerCount())) > 2)
-        {
-            return false;
-        }
-    }
-    // allow 1v0 if debug bg
-    if (sBattleGroundMgr.isTesting() && (m_SelectionPools[TEAM_INDEX_ALLIANCE].GetPlayerCount() || m_SelectionPools[TEAM_INDEX_HORDE].GetPlayerCount()))
-    {
-        return true;
-    }
-    // return true if there are enough players in selection pools - enable to work .debug bg command correctly
-    return m_SelectionPools[TEAM_INDEX_ALLIANCE].GetPlayerCount() >= minPlayers && m_SelectionPools[TEAM_INDEX_HORDE].GetPlayerCount() >= minPlayers;
+    ApplyMatch(bgTypeId, bracket_id, rules, FindMatch(bracket_id, rules));
 }
 
 /**
- * This method is called when group is inserted, or player / group is removed from BG Queue - there is only one player's status changed, so we don't use while (true) cycles to invite whole queue
- * it must be called after fully adding the members of a group to ensure group joining
- * should be called from BattleGround::RemovePlayer function in some cases
+ * @brief Fills running battlegrounds of the bracket and captures the match rules.
+ *
+ * Everything the match search needs from the world - configuration, game time, the
+ * battleground template - is read here, so that FindMatch can run off the world thread.
+ *
+ * @param bgTypeId The battleground type the queue is updated for.
+ * @param bracket_id The bracket being updated.
+ * @param rules Receives the rules for the match search.
+ * @return true if a new battleground may have to be started, false if there is nothing to do.
  */
-void BattleGroundQueue::Update(BattleGroundTypeId bgTypeId, BattleGroundBracketId bracket_id)
+bool BattleGroundQueue::PrepareMatch(BattleGroundTypeId bgTypeId, BattleGroundBracketId bracket_id, BattleGroundMatchRules& rules)
 {
     // if no players in queue - do nothing
-    if (m_QueuedGroups[bracket_id][BG_QUEUE_PREMADE_ALLIANCE].empty() &&
-        m_QueuedGroups[bracket_id][BG_QUEUE_PREMADE_HORDE].empty() &&
-        m_QueuedGroups[bracket_id][BG_QUEUE_NORMAL_ALLIANCE].empty() &&
-        m_QueuedGroups[bracket_id][BG_QUEUE_NORMAL_HORDE].empty())
+    if (m_Matchers[bracket_id].IsEmpty())
     {
-        return;
+        return false;
     }
 
     // battleground with free slot for player should be always in the beggining of the queue
@@ -812,23 +543,8 @@ void BattleGroundQueue::Update(BattleGroundTypeId bgTypeId, BattleGroundBracketI
             BattleGround* bg = *itr; // we have to store battleground pointer here, because when battleground is full, it is removed from free queue (not yet implemented!!)
             // and iterator is invalid
 
-            // clear selection pools
-            m_SelectionPools[TEAM_INDEX_ALLIANCE].Init();
-            m_SelectionPools[TEAM_INDEX_HORDE].Init();
-
-            // call a function that does the job for us
             FillPlayersToBG(bg, bracket_id);
 
-            // now everything is set, invite players
-            for (GroupsQueueType::const_iterator citr = m_SelectionPools[TEAM_INDEX_ALLIANCE].SelectedGroups.begin(); citr != m_SelectionPools[TEAM_INDEX_ALLIANCE].SelectedGroups.end(); ++citr)
-            {
-                InviteGroupToBG((*citr), bg, (*citr)->GroupTeam);
-            }
-            for (GroupsQueueType::const_iterator citr = m_SelectionPools[TEAM_INDEX_HORDE].SelectedGroups.begin(); citr != m_SelectionPools[TEAM_INDEX_HORDE].SelectedGroups.end(); ++citr)
-            {
-                InviteGroupToBG((*citr), bg, (*citr)->GroupTeam);
-            }
-
             if (!bg->HasFreeSlots())
             {
                 // remove BG from BGFreeSlotQueue
@@ -843,22 +559,53 @@ void BattleGroundQueue::Update(BattleGroundTypeId bgTypeId, BattleGroundBracketI
     if (!bg_template)
     {
         sLog.outError("Battleground: Update: bg template not found for %u", bgTypeId);
-        return;
+        return false;
     }
 
     // get the min. players per team, properly for larger arenas as well. (must have full teams for arena matches!)
-    uint32 MinPlayersPerTeam = bg_template->GetMinPlayersPerTeam();
-    uint32 MaxPlayersPerTeam = bg_template->GetMaxPlayersPerTeam();
-    if (sBattleGroundMgr.isTesting())
+    rules.MinPlayersPerTeam = bg_template->GetMinPlayersPerTeam();
+    rules.MaxPlayersPerTeam = bg_template->GetMaxPlayersPerTeam();
+    rules.Testing = sBattleGroundMgr.isTesting();
+    if (rules.Testing)
     {
-        MinPlayersPerTeam = 1;
+        rules.MinPlayersPerTeam = 1;
     }
+    rules.BalancedInvites = sWorld.getConfig(CONFIG_UINT32_BATTLEGROUND_INVITATION_TYPE) != 0;
+    rules.PremadeJoinedBefore = GameTime::GetGameTimeMS() - sWorld.getConfig(CONFIG_UINT32_BATTLEGROUND_PREMADE_GROUP_WAIT_FOR_MATCH);
+    return true;
+}
 
-    m_SelectionPools[TEAM_INDEX_ALLIANCE].Init();
-    m_SelectionPools[TEAM_INDEX_HORDE].Init();
+/**
+ * @brief Searches the bracket for groups that can start a new battleground.
+ *
+ * Reads and reorders only this bracket's group lists and writes only its selection pools;
+ * BattleGroundMgr::Update calls it for several brackets at once.
+ *
+ * @param bracket_id The bracket to search.
+ * @param rules The rules captured by PrepareMatch.
+ * @return BattleGroundMatchResult What the bracket's selection pools hold.
+ */
+BattleGroundMatchResult BattleGroundQueue::FindMatch(BattleGroundBracketId bracket_id, BattleGroundMatchRules const& rules)
+{
+    return m_Matchers[bracket_id].Match(rules);
+}
+
+/**
+ * @brief Starts the battleground a match search found.
+ *
+ * A premade match is started first; the normal queue is then searched again, because
+ * only now are the premade groups marked as invited.
+ *
+ * @param bgTypeId The battleground type to create.
+ * @param bracket_id The bracket that was searched.
+ * @param rules The rules captured by PrepareMatch.
+ * @param result The result of FindMatch for this bracket.
+ */
+void BattleGroundQueue::ApplyMatch(BattleGroundTypeId bgTypeId, BattleGroundBracketId bracket_id, BattleGroundMatchRules const& rules, BattleGroundMatchResult result)
+{
+    BattleGroundBracketMatcher& matcher = m_Matchers[bracket_id];
 
-    // check if there is premade against premade match
-    if (CheckPremadeMatch(bracket_id, MinPlayersPerTeam, MaxPlayersPerTeam))
+    if (result == BG_MATCH_PREMADE)
     {
         // create new battleground
         BattleGround* bg2 = sBattleGroundMgr.CreateNewBattleGround(bgTypeId, bracket_id);
@@ -868,46 +615,33 @@ void BattleGroundQueue::Update(BattleGroundTypeId bgTypeId, BattleGroundBracketI
             return;
         }
         // invite those selection pools
-        for (uint8 i = 0; i < PVP_TEAM_COUNT; ++i)
-        {
-            for (GroupsQueueType::const_iterator citr = m_SelectionPools[TEAM_INDEX_ALLIANCE + i].SelectedGroups.begin(); citr != m_SelectionPools[TEAM_INDEX_ALLIANCE + i].SelectedGroups.end(); ++citr)
-            {
-                InviteGroupToBG((*citr), bg2, (*citr)->GroupTeam);
-            }
-        }
+        InviteSelectedGroups(matcher, bg2);
 
         // start bg
         bg2->StartBattleGround();
         // clear structures
-        m_SelectionPools[TEAM_INDEX_ALLIANCE].Init();
-        m_SelectionPools[TEAM_INDEX_HORDE].Init();
+        matcher.Reset();
+
+        // now check if there are in queues enough players to start new game of (normal battleground, or non-rated arena)
+        result = matcher.CheckNormalMatch(rules) ? BG_MATCH_NORMAL : BG_MATCH_NONE;
     }
 
-    // now check if there are in queues enough players to start new game of (normal battleground, or non-rated arena)
+    // if there are enough players in pools, start new battleground or non rated arena
+    if (result == BG_MATCH_NORMAL)
     {
-        // if there are enough players in pools, start new battleground or non rated arena
-        if (CheckNormalMatch(bracket_id, MinPlayersPerTeam, MaxPlayersPerTeam))
+        // we successfully created a pool
+        BattleGround* bg2 = sBattleGroundMgr.CreateNewBattleGround(bgTypeId, bracket_id);
+        if (!bg2)
         {
-            // we successfully created a pool
-            BattleGround* bg2 = sBattleGroundMgr.CreateNewBattleGround(bgTypeId, bracket_id);
-            if (!bg2)
-            {
-                sLog.outError("BattleGroundQueue::Update - Can not create battleground: %u", bgTypeId);
-                return;
-            }
+            sLog.outError("BattleGroundQueue::Update - Can not create battleground: %u", bgTypeId);
+            return;
+        }
 
-            // invite those selection pools
-            for (uint8 i = 0; i < PVP_TEAM_COUNT; ++i)
-            {
-                for (GroupsQueueType::const_iterator citr = m_SelectionPools[TEAM_INDEX_ALLIANCE + i].SelectedGroups.begin(); citr != m_SelectionPools[TEAM_INDEX_ALLIANCE + i].SelectedGroups.end(); ++citr)
-                {
-                    InviteGroupToBG((*citr), bg2, (*citr)->GroupTeam);
-                }
-            }
+        // invite those selection pools
+        InviteSelectedGroups(matcher, bg2);
 
-            // start bg
-            bg2->StartBattleGround();
-        }
+        // start bg
+        bg2->StartBattleGround();
     }
 }
 
@@ -0,0 +1,416 @@
+/**
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2026 MaNGOS <https://www.getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+/**
+ * @file BattleGroundQueueMatch.cpp
+ * @brief Selection pools and the per-bracket match search of the battleground queue.
+ *
+ * Nothing in this file may reach a player, a battleground or a world singleton:
+ * BattleGroundMgr runs the matchers of different brackets at the same time.
+ */
+
+#include "BattleGroundQueueMatch.h"
+#include <algorithm>
+#include <cstdlib>
+
+/*********************************************************/
+/***      BATTLEGROUND QUEUE SELECTION POOLS           ***/
+/*********************************************************/
+
+/**
+ * @brief Initializes the selection pool for team balancing.
+ *
+ * Clears the list of selected groups and resets the player count to prepare
+ * for a new team building cycle.
+ */
+void BattleGroundSelectionPool::Init()
+{
+    SelectedGroups.clear();
+    PlayerCount = 0;
+}
+
+/**
+ * @brief Removes a group from the selection pool.
+ *
+ * Attempts to remove a group of approximately the specified size from the selection pool
+ * to balance team composition. Prefers to remove larger groups or groups of similar size
+ * to the target size.
+ *
+ * @param size The target group size to remove.
+ * @return true if more groups should be added to maintain balance, false otherwise.
+ */
+bool BattleGroundSelectionPool::KickGroup(uint32 size)
+{
+    // find maxgroup or LAST group with size == size and kick it
+    bool found = false;
+    BattleGroundGroupList::iterator groupToKick = SelectedGroups.begin();
+    for (BattleGroundGroupList::iterator itr = groupToKick; itr != SelectedGroups.end(); ++itr)
+    {
+        if (abs((int32)((*itr)->Players.size() - size)) <= 1)
+        {
+            groupToKick = itr;
+            found = true;
+        }
+        else if (!found && (*itr)->Players.size() >= (*groupToKick)->Players.size())
+        {
+            groupToKick = itr;
+        }
+    }
+    // if pool is empty, do nothing
+    if (GetPlayerCount())
+    {
+        // update player count
+        GroupQueueInfo* ginfo = (*groupToKick);
+        SelectedGroups.erase(groupToKick);
+        PlayerCount -= ginfo->Players.size();
+        // return false if we kicked smaller group or there are enough players in selection pool
+        if (ginfo->Players.size() <= size + 1)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Adds a group to the selection pool if space is available.
+ *
+ * Attempts to add a group to the selection pool for battleground invitation.
+ * Only adds the group if doing so won't exceed the desired player count, or
+ * if the pool still needs more players to reach the desired count.
+ *
+ * @param ginfo Pointer to the group queue info to add.
+ * @param desiredCount The target number of players for this team.
+ * @return true if the group was added or if more players are still needed, false if pool is full.
+ */
+bool BattleGroundSelectionPool::AddGroup(GroupQueueInfo* ginfo, uint32 desiredCount)
+{
+    // if group is larger than desired count - don't allow to add it to pool
+    if (!ginfo->IsInvitedToBGInstanceGUID && desiredCount >= PlayerCount + ginfo->Players.size())
+    {
+        SelectedGroups.push_back(ginfo);
+        // increase selected players count
+        PlayerCount += ginfo->Players.size();
+        return true;
+    }
+    if (PlayerCount < desiredCount)
+    {
+        return true;
+    }
+    return false;
+}
+
+/*********************************************************/
+/***          BATTLEGROUND BRACKET MATCHING            ***/
+/*********************************************************/
+
+/**
+ * @brief Empties both selection pools.
+ */
+void BattleGroundBracketMatcher::Reset()
+{
+    m_SelectionPools[TEAM_INDEX_ALLIANCE].Init();
+    m_SelectionPools[TEAM_INDEX_HORDE].Init();
+}
+
+/**
+ * @brief Checks if there are no groups queued in the bracket.
+ *
+ * @return true if all premade and normal lists are empty.
+ */
+bool BattleGroundBracketMatcher::IsEmpty() const
+{
+    return m_Groups[BG_QUEUE_PREMADE_ALLIANCE].empty() &&
+           m_Groups[BG_QUEUE_PREMADE_HORDE].empty() &&
+           m_Groups[BG_QUEUE_NORMAL_ALLIANCE].empty() &&
+           m_Groups[BG_QUEUE_NORMAL_HORDE].empty();
+}
+
+/**
+ * @brief Selects groups for the free slots of a running battleground.
+ *
+ * Selects groups based on available slots for each team, attempting to balance team composition
+ * using the selection pool system. Large groups may be broken apart to maintain balance
+ * based on configuration settings.
+ *
+ * @param aliFree Free alliance slots of the battleground.
+ * @param hordeFree Free horde slots of the battleground.
+ * @param balanced True when Battleground.InvitationType asks for balanced invites.
+ */
+void BattleGroundBracketMatcher::FillFreeSlots(int32 aliFree, int32 hordeFree, bool balanced)
+{
+    // iterator for iterating through bg queue
+    BattleGroundGroupList::const_iterator Ali_itr = m_Groups[BG_QUEUE_NORMAL_ALLIANCE].begin();
+    // count of groups in queue - used to stop cycles
+    uint32 aliCount = m_Groups[BG_QUEUE_NORMAL_ALLIANCE].size();
+    // index to queue which group is current
+    uint32 aliIndex = 0;
+    for (; aliIndex < aliCount && m_SelectionPools[TEAM_INDEX_ALLIANCE].AddGroup((*Ali_itr), aliFree); ++aliIndex)
+    {
+        ++Ali_itr;
+    }
+    // the same thing for horde
+    BattleGroundGroupList::const_iterator Horde_itr = m_Groups[BG_QUEUE_NORMAL_HORDE].begin();
+    uint32 hordeCount = m_Groups[BG_QUEUE_NORMAL_HORDE].size();
+    uint32 hordeIndex = 0;
+    for (; hordeIndex < hordeCount && m_SelectionPools[TEAM_INDEX_HORDE].AddGroup((*Horde_itr), hordeFree); ++hordeIndex)
+    {
+        ++Horde_itr;
+    }
+
+    // if ofc like BG queue invitation is set in config, then we are happy
+    if (!balanced)
+    {
+        return;
+    }
+
+    /**
+     * If we reached this code, then we have to solve NP - complete problem called Subset sum problem
+     * So one solution is to check all possible invitation subgroups, or we can use these conditions:
+     * 1. Last time when BattleGroundQueue::Update was executed we invited all possible players - so there is only small possibility
+     * that we will invite now whole queue, because only 1 change has been made to queues from the last BattleGroundQueue::Update call
+     * 2. Other thing we should consider is group order in queue
+     */
+
+    // At first we need to compare free space in bg and our selection pool
+    int32 diffAli   = aliFree   - int32(m_SelectionPools[TEAM_INDEX_ALLIANCE].GetPlayerCount());
+    int32 diffHorde = hordeFree - int32(m_SelectionPools[TEAM_INDEX_HORDE].GetPlayerCount());
+    while (abs(diffAli - diffHorde) > 1 && (m_SelectionPools[TEAM_INDEX_HORDE].GetPlayerCount() > 0 || m_SelectionPools[TEAM_INDEX_ALLIANCE].GetPlayerCount() > 0))
+    {
+        // each cycle execution we need to kick at least 1 group
+        if (diffAli < diffHorde)
+        {
+            // kick alliance group, add to pool new group if needed
+            if (m_SelectionPools[TEAM_INDEX_ALLIANCE].KickGroup(diffHorde - diffAli))
+            {
+                for (; aliIndex < aliCount && m_SelectionPools[TEAM_INDEX_ALLIANCE].AddGroup((*Ali_itr), (aliFree >= diffHorde) ? aliFree - diffHorde : 0); ++aliIndex)
+                {
+                    ++Ali_itr;
+                }
+            }
+            // if ali selection is already empty, then kick horde group, but if there are less horde than ali in bg - break;
+            if (!m_SelectionPools[TEAM_INDEX_ALLIANCE].GetPlayerCount())
+            {
+                if (aliFree <= diffHorde + 1)
+                {
+                    break;
+                }
+                m_SelectionPools[TEAM_INDEX_HORDE].KickGroup(diffHorde - diffAli);
+            }
+        }
+        else
+        {
+            // kick horde group, add to pool new group if needed
+            if (m_SelectionPools[TEAM_INDEX_HORDE].KickGroup(diffAli - diffHorde))
+            {
+                for (; hordeIndex < hordeCount && m_SelectionPools[TEAM_INDEX_HORDE].AddGroup((*Horde_itr), (hordeFree >= diffAli) ? hordeFree - diffAli : 0); ++hordeIndex)
+                {
+                    ++Horde_itr;
+                }
+            }
+            if (!m_SelectionPools[TEAM_INDEX_HORDE].GetPlayerCount())
+            {
+                if (hordeFree <= diffAli + 1)
+                {
+                    break;
+                }
+                m_SelectionPools[TEAM_INDEX_ALLIANCE].KickGroup(diffAli - diffHorde);
+            }
+        }
+        // count diffs after small update
+        diffAli   = aliFree   - int32(m_SelectionPools[TEAM_INDEX_ALLIANCE].GetPlayerCount());
+        diffHorde = hordeFree - int32(m_SelectionPools[TEAM_INDEX_HORDE].GetPlayerCount());
+    }
+}
+
+/**
+ * @brief Checks if a premade versus premade battleground match can be made.
+ *
+ * Attempts to create a premade versus premade battleground match between groups that have
+ * been waiting. After 30 minutes (default), premade groups are moved to the normal queue
+ * if a premade match cannot be created. Groups are selected up to the maximum players per team.
+ *
+ * @param rules The match rules of the bracket.
+ * @return true if the selection pools hold a premade match, false otherwise.
+ */
+bool BattleGroundBracketMatcher::CheckPremadeMatch(BattleGroundMatchRules const& rules)
+{
+    // check match
+    if (!m_Groups[BG_QUEUE_PREMADE_ALLIANCE].empty() && !m_Groups[BG_QUEUE_PREMADE_HORDE].empty())
+    {
+        // start premade match
+        // if groups aren't invited
+        BattleGroundGroupList::const_iterator ali_group, horde_group;
+        for (ali_group = m_Groups[BG_QUEUE_PREMADE_ALLIANCE].begin(); ali_group != m_Groups[BG_QUEUE_PREMADE_ALLIANCE].end(); ++ali_group)
+        {
+            if (!(*ali_group)->IsInvitedToBGInstanceGUID)
+            {
+                break;
+            }
+        }
+
+        for (horde_group = m_Groups[BG_QUEUE_PREMADE_HORDE].begin(); horde_group != m_Groups[BG_QUEUE_PREMADE_HORDE].end(); ++horde_group)
+        {
+            if (!(*horde_group)->IsInvitedToBGInstanceGUID)
+            {
+                break;
+            }
+        }
+
+        if (ali_group != m_Groups[BG_QUEUE_PREMADE_ALLIANCE].end() && horde_group != m_Groups[BG_QUEUE_PREMADE_HORDE].end())
+        {
+            m_SelectionPools[TEAM_INDEX_ALLIANCE].AddGroup((*ali_group), rules.MaxPlayersPerTeam);
+            m_SelectionPools[TEAM_INDEX_HORDE].AddGroup((*horde_group), rules.MaxPlayersPerTeam);
+            // add groups/players from normal queue to size of bigger group
+            uint32 maxPlayers = std::max(m_SelectionPools[TEAM_INDEX_ALLIANCE].GetPlayerCount(), m_SelectionPools[TEAM_INDEX_HORDE].GetPlayerCount());
+            BattleGroundGroupList::const_iterator itr;
+            for (uint8 i = 0; i < PVP_TEAM_COUNT; ++i)
+            {
+                for (itr = m_Groups[BG_QUEUE_NORMAL_ALLIANCE + i].begin(); itr != m_Groups[BG_QUEUE_NORMAL_ALLIANCE + i].end(); ++itr)
+                {
+                    // if itr can join BG and player count is less that maxPlayers, then add group to selectionpool
+                    if (!(*itr)->IsInvitedToBGInstanceGUID && !m_SelectionPools[i].AddGroup((*itr), maxPlayers))
+                    {
+                        break;
+                    }
+                }
+            }
+            // premade selection pools are set
+            return true;
+        }
+    }
+    // now check if we can move group from Premade queue to normal queue (timer has expired) or group size lowered!!
+    // this could be 2 cycles but i'm checking only first team in queue - it can cause problem -
+    // if first is invited to BG and seconds timer expired, but we can ignore it, because players have only 80 seconds to click to enter bg
+    // and when they click or after 80 seconds the queue info is removed from queue
+    for (uint8 i = 0; i < PVP_TEAM_COUNT; ++i)
+    {
+        if (!m_Groups[BG_QUEUE_PREMADE_ALLIANCE + i].empty())
+        {
+            BattleGroundGroupList::iterator itr = m_Groups[BG_QUEUE_PREMADE_ALLIANCE + i].begin();
+            if (!(*itr)->IsInvitedToBGInstanceGUID && ((*itr)->JoinTime < rules.PremadeJoinedBefore || (*itr)->Players.size() < rules.MinPlayersPerTeam))
+            {
+                // we must insert group to normal queue and erase pointer from premade queue
+                m_Groups[BG_QUEUE_NORMAL_ALLIANCE + i].push_front((*itr));
+                m_Groups[BG_QUEUE_PREMADE_ALLIANCE + i].erase(itr);
+            }
+        }
+    }
+    // selection pools are not set
+    return false;
+}
+
+/**
+ * @brief Checks if a normal (non-premade) match can be created.
+ *
+ * Attempts to build balanced teams from the normal queue with at least MinPlayersPerTeam on each side.
+ * Uses selection pools to collect groups and balance team sizes. If configured to allow
+ * invitation type balancing, may select additional groups for the team with fewer players.
+ *
+ * @param rules The match rules of the bracket.
+ * @return true if the selection pools hold a normal match, false otherwise.
+ */
+bool BattleGroundBracketMatcher::CheckNormalMatch(BattleGroundMatchRules const& rules)
+{
+    BattleGroundGroupList::const_iterator itr_team[PVP_TEAM_COUNT];
+    for (uint8 i = 0; i < PVP_TEAM_COUNT; ++i)
+    {
+        itr_team[i] = m_Groups[BG_QUEUE_NORMAL_ALLIANCE + i].begin();
+        for (; itr_team[i] != m_Groups[BG_QUEUE_NORMAL_ALLIANCE + i].end(); ++(itr_team[i]))
+        {
+            if (!(*(itr_team[i]))->IsInvitedToBGInstanceGUID)
+            {
+                m_SelectionPools[i].AddGroup(*(itr_team[i]), rules.MaxPlayersPerTeam);
+                if (m_SelectionPools[i].GetPlayerCount() >= rules.MinPlayersPerTeam)
+                {
+                    break;
+                }
+            }
+        }
+    }
+    // try to invite same number of players - this cycle may cause longer wait time even if there are enough players in queue, but we want ballanced bg
+    uint32 j = TEAM_INDEX_ALLIANCE;
+    if (m_SelectionPools[TEAM_INDEX_HORDE].GetPlayerCount() < m_SelectionPools[TEAM_INDEX_ALLIANCE].GetPlayerCount())
+    {
+        j = TEAM_INDEX_HORDE;
+    }
+
+    if (rules.BalancedInvites &&
+        m_SelectionPools[TEAM_INDEX_HORDE].GetPlayerCount() >= rules.MinPlayersPerTeam && m_SelectionPools[TEAM_INDEX_ALLIANCE].GetPlayerCount() >= rules.MinPlayersPerTeam)
+    {
+        // we will try to invite more groups to team with less players indexed by j
+        ++(itr_team[j]);                                    // this will not cause a crash, because for cycle above reached break;
+        for (; itr_team[j] != m_Groups[BG_QUEUE_NORMAL_ALLIANCE + j].end(); ++(itr_team[j]))
+        {
+            if (!(*(itr_team[j]))->IsInvitedToBGInstanceGUID)
+            {
+                if (!m_SelectionPools[j].AddGroup(*(itr_team[j]), m_SelectionPools[(j + 1) % PVP_TEAM_COUNT].GetPlayerCount()))
+                {
+                    break;
+                }
+            }
+        }
+        // do not allow to start bg with more than 2 players more on 1 faction
+        if (abs((int32)(m_SelectionPools[TEAM_INDEX_HORDE].GetPlayerCount() - m_SelectionPools[TEAM_INDEX_ALLIANCE].GetPlayerCount())) > 2)
+        {
+            return false;
+        }
+    }
+    // allow 1v0 if debug bg
+    if (rules.Testing && (m_SelectionPools[TEAM_INDEX_ALLIANCE].GetPlayerCount() || m_SelectionPools[TEAM_INDEX_HORDE].GetPlayerCount()))
+    {
+        return true;
+    }
+    // return true if there are enough players in selection pools - enable to work .debug bg command correctly
+    return m_SelectionPools[TEAM_INDEX_ALLIANCE].GetPlayerCount() >= rules.MinPlayersPerTeam && m_SelectionPools[TEAM_INDEX_HORDE].GetPlayerCount() >= rules.MinPlayersPerTeam;
+}
+
+/**
+ * @brief Searches the bracket for a battleground that can start.
+ *
+ * A premade match wins over a normal one. Its groups are not invited yet, so the normal
+ * queue cannot be searched until they are; the caller does that after the invites.
+ *
+ * @param rules The match rules of the bracket.
+ * @return BG_MATCH_PREMADE or BG_MATCH_NORMAL with the pools set, BG_MATCH_NONE otherwise.
+ */
+BattleGroundMatchResult BattleGroundBracketMatcher::Match(BattleGroundMatchRules const& rules)
+{
+    Reset();
+
+    // check if there is premade against premade match
+    if (CheckPremadeMatch(rules))
+    {
+        return BG_MATCH_PREMADE;
+    }
+
+    // now check if there are in queues enough players to start new game of (normal battleground, or non-rated arena)
+    if (CheckNormalMatch(rules))
+    {
+        return BG_MATCH_NORMAL;
+    }
+
+    return BG_MATCH_NONE;
+}
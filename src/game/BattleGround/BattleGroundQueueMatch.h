@@ -0,0 +1,238 @@
+/**
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2026 MaNGOS <https://www.getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+/**
+ * @file BattleGroundQueueMatch.h
+ * @brief Queue records and the per-bracket match search of the battleground queue
+ *
+ * Everything a bracket needs to decide whether a new battleground can start lives
+ * here, apart from the players and battlegrounds it will eventually touch:
+ *
+ * - GroupQueueInfo, the record of a queued group or solo player
+ * - BattleGroundSelectionPool, one team's side of a prospective match
+ * - BattleGroundBracketMatcher, the premade and normal match search of a bracket
+ *
+ * A matcher reads and reorders only the four group lists of its own bracket and
+ * writes only its own two pools. BattleGroundMgr relies on that to search several
+ * brackets at once; inviting the selected groups stays on the world thread.
+ *
+ * @see BattleGroundQueue for the queue that owns the group lists
+ */
+
+#ifndef MANGOS_H_BATTLEGROUNDQUEUEMATCH
+#define MANGOS_H_BATTLEGROUNDQUEUEMATCH
+
+#include "Platform/Define.h"
+#include "SharedDefines.h"
+#include "ObjectGuid.h"
+#include <list>
+#include <map>
+
+struct GroupQueueInfo; // type predefinition
+
+/**
+ * @brief Stores information for players in queue.
+ */
+struct PlayerQueueInfo
+{
+    uint32  LastOnlineTime; /**< For tracking and removing offline players from queue after 5 minutes */
+    GroupQueueInfo* GroupInfo; /**< Pointer to the associated groupqueueinfo */
+};
+
+/**
+ * @brief Container for storing player queue info in a group.
+ */
+typedef std::map<ObjectGuid, PlayerQueueInfo*> GroupQueueInfoPlayers;
+
+/**
+ * @brief Stores information about the group in queue (also used when joined as solo!).
+ */
+struct GroupQueueInfo
+{
+    GroupQueueInfoPlayers Players; /**< Player queue info map */
+    Team GroupTeam; /**< Player team (ALLIANCE/HORDE) */
+    BattleGroundTypeId BgTypeId; /**< Battleground type id */
+    uint32 JoinTime; /**< Time when group was added */
+    uint32 RemoveInviteTime; /**< Time when we will remove invite for players in group */
+    uint32 IsInvitedToBGInstanceGUID; /**< Was invited to certain BG */
+};
+
+/**
+ * @brief Enum for battleground queue group types.
+ */
+enum BattleGroundQueueGroupTypes
+{
+    BG_QUEUE_PREMADE_ALLIANCE   = 0,
+    BG_QUEUE_PREMADE_HORDE      = 1,
+    BG_QUEUE_NORMAL_ALLIANCE    = 2,
+    BG_QUEUE_NORMAL_HORDE       = 3
+};
+#define BG_QUEUE_GROUP_TYPES_COUNT 4
+
+/**
+ * @brief List of queued groups.
+ * We need constant add to begin and constant remove / add from the end, therefore deque suits our problem well.
+ */
+typedef std::list<GroupQueueInfo*> BattleGroundGroupList;
+
+/**
+ * @brief Class to select and invite groups to battleground.
+ */
+class BattleGroundSelectionPool
+{
+    public:
+        /**
+         * @brief Constructor for BattleGroundSelectionPool.
+         */
+        BattleGroundSelectionPool() : PlayerCount(0) {}
+
+        /**
+         * @brief Initializes the selection pool.
+         */
+        void Init();
+
+        /**
+         * @brief Adds a group to the selection pool.
+         * @param ginfo Pointer to the group queue info.
+         * @param desiredCount The desired count.
+         * @return bool True if the group is added, false otherwise.
+         */
+        bool AddGroup(GroupQueueInfo* ginfo, uint32 desiredCount);
+
+        /**
+         * @brief Kicks a group from the selection pool.
+         * @param size The size of the group.
+         * @return bool True if the group is kicked, false otherwise.
+         */
+        bool KickGroup(uint32 size);
+
+        /**
+         * @brief Gets the player count in the selection pool.
+         * @return uint32 The player count.
+         */
+        uint32 GetPlayerCount() const {return PlayerCount;}
+
+    public:
+        BattleGroundGroupList SelectedGroups; /**< List of selected groups. */
+
+    private:
+        uint32 PlayerCount; /**< Player count in the selection pool. */
+};
+
+/**
+ * @brief World state a bracket's match search depends on.
+ *
+ * Captured on the world thread before the search, so the search itself never
+ * reads configuration, the clock or the battleground templates.
+ */
+struct BattleGroundMatchRules
+{
+    uint32 MinPlayersPerTeam;   /**< Smallest team a new battleground may start with */
+    uint32 MaxPlayersPerTeam;   /**< Largest team a new battleground may take */
+    uint32 PremadeJoinedBefore; /**< Premade groups that joined earlier give up waiting for a premade match */
+    bool   BalancedInvites;     /**< Battleground.InvitationType is not 0 */
+    bool   Testing;             /**< .debug bg is on: a single player may start a battleground */
+};
+
+/**
+ * @brief Outcome of a bracket's match search.
+ */
+enum BattleGroundMatchResult
+{
+    BG_MATCH_NONE               = 0,    // nothing can start yet
+    BG_MATCH_PREMADE            = 1,    // premade against premade, normal queue still to be checked after the invites
+    BG_MATCH_NORMAL             = 2     // the pools hold a normal match
+};
+
+/**
+ * @brief The match search of one queue bracket.
+ *
+ * Works on the bracket's four group lists owned by BattleGroundQueue and leaves its
+ * choice in the two selection pools, indexed by TEAM_INDEX_ALLIANCE / TEAM_INDEX_HORDE.
+ */
+class BattleGroundBracketMatcher
+{
+    public:
+        BattleGroundBracketMatcher() : m_Groups(NULL) {}
+
+        /**
+         * @brief Binds the matcher to the group lists of its bracket.
+         * @param groups BG_QUEUE_GROUP_TYPES_COUNT lists, indexed by BattleGroundQueueGroupTypes.
+         */
+        void Attach(BattleGroundGroupList* groups) { m_Groups = groups; }
+
+        /**
+         * @brief Empties both selection pools.
+         */
+        void Reset();
+
+        /**
+         * @brief Checks if there are no groups queued in the bracket.
+         * @return bool True if all four group lists are empty.
+         */
+        bool IsEmpty() const;
+
+        /**
+         * @brief Selects normal queue groups for the free slots of a running battleground.
+         * @param aliFree Free alliance slots.
+         * @param hordeFree Free horde slots.
+         * @param balanced True to trade groups until both sides end up about equally full.
+         */
+        void FillFreeSlots(int32 aliFree, int32 hordeFree, bool balanced);
+
+        /**
+         * @brief Checks for premade match, moving expired premades to the normal queue.
+         * @param rules The match rules.
+         * @return bool True if the pools hold a premade match.
+         */
+        bool CheckPremadeMatch(BattleGroundMatchRules const& rules);
+
+        /**
+         * @brief Checks for normal match.
+         * @param rules The match rules.
+         * @return bool True if the pools hold a normal match.
+         */
+        bool CheckNormalMatch(BattleGroundMatchRules const& rules);
+
+        /**
+         * @brief Runs the premade check, then the normal check, on freshly reset pools.
+         * @param rules The match rules.
+         * @return BattleGroundMatchResult What the pools hold afterwards.
+         */
+        BattleGroundMatchResult Match(BattleGroundMatchRules const& rules);
+
+        /**
+         * @brief Gets a team's selection pool.
+         * @param teamIndex TEAM_INDEX_ALLIANCE or TEAM_INDEX_HORDE.
+         * @return BattleGroundSelectionPool const& The pool.
+         */
+        BattleGroundSelectionPool const& GetPool(uint32 teamIndex) const { return m_SelectionPools[teamIndex]; }
+
+    private:
+        BattleGroundGroupList* m_Groups; /**< The bracket's group lists, owned by the queue. */
+        BattleGroundSelectionPool m_SelectionPools[PVP_TEAM_COUNT]; /**< One selection pool for horde, other one for alliance. */
+};
+
+#endif
@@ -44,6 +44,7 @@
 #include "WorldPacket.h"
 #include "Player.h"
 #include "OpcodeTable.h"
+#include "OpcodeProfiler.h"
 #include "Chat.h"
 #include "Log.h"
 #include "Unit.h"
@@ -59,6 +60,8 @@
 #include "MapManager.h"
 #include "TransportMap.h"
 #include "Transports.h"
+#include "Utilities/SlabPool.h"
+#include "Utilities/PacketBufferPool.h"
 
 /**
  * @brief Handler for HandleDebugSendSpellFailCommand command.
@@ -1020,6 +1023,239 @@ bool ChatHandler::HandleDebugSpellCheckCommand(char* /*args*/)
     return true;
 }
 
+/**
+ * @brief Handler for HandleDebugObjectPoolsCommand command.
+ *
+ * Lists the slab pools of the world objects: live objects, pooled blocks,
+ * how many allocations reused a released block and how much of the pooled
+ * memory is idle.
+ *
+ * @param args Command arguments.
+ * @returns True if the command executed successfully, false otherwise.
+ */
+bool ChatHandler::HandleDebugObjectPoolsCommand(char* /*args*/)
+{
+    std::vector<MaNGOS::SlabPoolStats> pools = MaNGOS::SlabPool::GetAllStats();
+    if (pools.empty())
+    {
+        SendSysMessage("No object pool in use yet.");
+        return true;
+    }
+
+    for (std::vector<MaNGOS::SlabPoolStats>::const_iterator itr = pools.begin(); itr != pools.end(); ++itr)
+    {
+        PSendSysMessage("%s (%zu bytes): %zu live of %zu pooled in %zu slabs, %zu allocations, %.1f%% reused, %.1f%% idle, %zu to heap",
+            itr->Name.c_str(), itr->BlockSize, itr->InUse, itr->Capacity, itr->Slabs, itr->Allocations,
+            itr->HitRate() * 100.0f, itr->Fragmentation() * 100.0f, itr->Oversized);
+    }
+    return true;
+}
+
+/**
+ * @brief Handler for HandleDebugPacketPoolsCommand command.
+ *
+ * Lists the packet buffer size classes with their allocations and the share
+ * served from a thread free list, then the allocations too big for any class.
+ *
+ * @param args Command arguments.
+ * @returns True if the command executed successfully, false otherwise.
+ */
+bool ChatHandler::HandleDebugPacketPoolsCommand(char* /*args*/)
+{
+    MaNGOS::PacketBufferPoolStats stats = MaNGOS::PacketBufferPool::GetStats();
+    for (size_t i = 0; i < MaNGOS::PacketBufferPoolStats::ClassCount; ++i)
+    {
+        PSendSysMessage("%6zu bytes: %zu allocations, %.1f%% from free lists", stats.ClassSize[i], stats.Allocations[i],
+            stats.Allocations[i] ? float(stats.Hits[i]) * 100.0f / float(stats.Allocations[i]) : 0.0f);
+    }
+    PSendSysMessage("oversized: %zu allocations", stats.Oversized);
+    return true;
+}
+
+/**
+ * @brief Handler for HandleDebugMapTickCommand command.
+ *
+ * Without arguments shows where the updates of the current map spent their
+ * time over the last minute or two, phase by phase, and its last slow tick.
+ * "slow #ms" sets the tick length from which maps log their breakdown, 0 off;
+ * "log" writes the statistics of every loaded map to the map tick log.
+ *
+ * @param args Command arguments.
+ * @returns True if the command executed successfully, false otherwise.
+ */
+bool ChatHandler::HandleDebugMapTickCommand(char* args)
+{
+    if (ExtractLiteralArg(&args, "slow"))
+    {
+        uint32 thresholdMs;
+        if (!ExtractUInt32(&args, thresholdMs))
+        {
+            PSendSysMessage("Slow map tick threshold: %u ms (0 is off).", MapTickProfile::GetSlowTickThreshold());
+            return true;
+        }
+
+        MapTickProfile::SetSlowTickThreshold(thresholdMs);
+        PSendSysMessage("Maps now log updates from %u ms (0 is off).", thresholdMs);
+        return true;
+    }
+
+    if (ExtractLiteralArg(&args, "log"))
+    {
+        uint32 count = 0;
+        sMapMgr.DoForAllMaps([&count](Map* map)
+        {
+            MapTickProfile const& profile = map->GetTickProfile();
+            sLog.outMapTick("Map %u instance %u, last tick " UI64FMTD " us: %s", map->GetId(), map->GetInstanceId(),
+                profile.GetLastTickTotal(), profile.FormatStats().c_str());
+            ++count;
+        });
+        PSendSysMessage("Wrote the update statistics of %u maps to the map tick log.", count);
+        return true;
+    }
+
+    if (*args || !m_session)
+    {
+        return false;
+    }
+
+    Map* map = m_session->GetPlayer()->GetMap();
+    MapTickProfile const& profile = map->GetTickProfile();
+    PSendSysMessage("Map %u instance %u, %u ticks, last " UI64FMTD " us", map->GetId(), map->GetInstanceId(),
+        profile.GetPhaseStats(MAP_TICK_SESSIONS).ticks, profile.GetLastTickTotal());
+    for (uint32 phase = 0; phase < MAP_TICK_PHASE_COUNT; ++phase)
+    {
+        MapTickProfile::PhaseStats stats = profile.GetPhaseStats(MapTickPhase(phase));
+        if (stats.maxMicros)
+        {
+            PSendSysMessage("  %s: avg " UI64FMTD " us, p50 " UI64FMTD " us, p99 " UI64FMTD " us, max " UI64FMTD " us",
+                GetMapTickPhaseName(MapTickPhase(phase)), stats.avgMicros, stats.p50Micros, stats.p99Micros, stats.maxMicros);
+        }
+    }
+    if (profile.GetSlowTickTotal())
+    {
+        PSendSysMessage("Last slow tick " UI64FMTD " us: %s", profile.GetSlowTickTotal(), profile.FormatSlowTick().c_str());
+    }
+    return true;
+}
+
+/**
+ * @brief Handler for HandleDebugOpcodesCommand command.
+ *
+ * Lists the client opcode handlers that took the most time since start, with
+ * their calls, 99th percentile and worst call, and the bytes they read and sent.
+ *
+ * @param args Command arguments: optional number of opcodes to list (default 10).
+ * @returns True if the command executed successfully, false otherwise.
+ */
+bool ChatHandler::HandleDebugOpcodesCommand(char* args)
+{
+    uint32 count = 10;
+    if (*args && !ExtractUInt32(&args, count))
+    {
+        return false;
+    }
+
+    std::vector<OpcodeProfile> profiles = sOpcodeProfiler.GetTotals();
+    if (profiles.empty())
+    {
+        SendSysMessage("No client opcode handled yet.");
+        return true;
+    }
+
+    for (size_t i = 0; i < profiles.size() && i < count; ++i)
+    {
+        OpcodeProfile const& p = profiles[i];
+        PSendSysMessage("%s: " UI64FMTD " calls, " UI64FMTD " us total, " UI64FMTD " us avg, p99 " UI64FMTD " us, max " UI64FMTD " us, " UI64FMTD " bytes in, " UI64FMTD " out",
+            LookupOpcodeName(p.opcode), p.calls, p.totalMicros, p.totalMicros / p.calls, p.p99Micros, p.maxMicros, p.bytesIn, p.bytesOut);
+    }
+    return true;
+}
+
+/**
+ * @brief Handler for HandleDebugScriptsCommand command.
+ *
+ * Shows the DB script steps pending on the current map, those run in its last
+ * tick and in total, and those dropped because their script ended early.
+ *
+ * @param args Command arguments.
+ * @returns True if the command executed successfully, false otherwise.
+ */
+bool ChatHandler::HandleDebugScriptsCommand(char* /*args*/)
+{
+    Map* map = m_session->GetPlayer()->GetMap();
+    ScriptSchedule<ScriptAction> const& schedule = map->GetScriptSchedule();
+
+    PSendSysMessage("Map %u instance %u: %zu script steps pending, %u run last tick, " UI64FMTD " run, " UI64FMTD " terminated",
+        map->GetId(), map->GetInstanceId(), schedule.size(), schedule.GetStepsLastTick(),
+        schedule.GetStepsTotal(), schedule.GetRemovedByTermination());
+    return true;
+}
+
+/**
+ * @brief Handler for HandleDebugVisibilityCommand command.
+ *
+ * Shows the visibility pass of the current map: its interval, the units
+ * waiting for it, and how many relocations the passes so far absorbed.
+ *
+ * @param args Command arguments.
+ * @returns True if the command executed successfully, false otherwise.
+ */
+bool ChatHandler::HandleDebugVisibilityCommand(char* /*args*/)
+{
+    Map* map = m_session->GetPlayer()->GetMap();
+    VisibilityScheduler const& scheduler = map->GetVisibilityScheduler();
+
+    if (!scheduler.GetInterval())
+    {
+        PSendSysMessage("Map %u instance %u: visibility is updated at every relocation, %zu units pending",
+            map->GetId(), map->GetInstanceId(), scheduler.GetPendingCount());
+        return true;
+    }
+
+    PSendSysMessage("Map %u instance %u: visibility pass every %u ms (batch limit %u), %zu units pending, last pass %u units",
+        map->GetId(), map->GetInstanceId(), scheduler.GetInterval(), scheduler.GetBatchLimit(),
+        scheduler.GetPendingCount(), scheduler.GetLastPassSize());
+    PSendSysMessage(UI64FMTD " relocations queued, " UI64FMTD " coalesced, " UI64FMTD " passes updated " UI64FMTD " units",
+        scheduler.GetScheduledTotal(), scheduler.GetCoalescedTotal(), scheduler.GetPassesTotal(), scheduler.GetUpdatedTotal());
+    return true;
+}
+
+/**
+ * @brief Handler for HandleDebugObserversCommand command.
+ *
+ * Checks the observer list of the selected unit (or of yourself) against the grid
+ * visit that broadcasts used to make, and names every player found on one side only.
+ *
+ * @param args Command arguments.
+ * @returns True if the command executed successfully, false otherwise.
+ */
+bool ChatHandler::HandleDebugObserversCommand(char* /*args*/)
+{
+    Unit* target = getSelectedUnit();
+    if (!target)
+    {
+        target = m_session->GetPlayer();
+    }
+
+    std::vector<Player*> missing;
+    std::vector<Player*> extra;
+    uint32 const broken = target->GetMap()->CheckObservers(target, missing, extra);
+
+    PSendSysMessage("%s: %zu observers, %zu missing, %zu not found by the grid, %u not holding it at client",
+        target->GetGuidStr().c_str(), target->GetObservers().size(), missing.size(), extra.size(), broken);
+
+    for (std::vector<Player*>::const_iterator itr = missing.begin(); itr != missing.end(); ++itr)
+    {
+        PSendSysMessage("  missing: %s", (*itr)->GetName());
+    }
+    for (std::vector<Player*>::const_iterator itr = extra.begin(); itr != extra.end(); ++itr)
+    {
+        PSendSysMessage("  extra: %s", (*itr)->GetName());
+    }
+
+    return true;
+}
+
 /**
  * @brief Handler for HandleDebugAnimCommand command.
  *
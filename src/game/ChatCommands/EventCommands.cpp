@@ -30,6 +30,7 @@
  * This file contains chat command handlers for controlling game events including:
  * - Event start and stop
  * - Event status display
+ * - Progress of event starts and stops through the maps
  * - Event configuration
  * - Holiday and seasonal event management
  */
@@ -103,6 +104,33 @@ bool ChatHandler::HandleEventListCommand(char* args)
     return true;
 }
 
+/**
+ * @brief Handler for HandleEventProgressCommand command.
+ *
+ * Lists the event starts and stops whose spawns, despawns and creature
+ * updates some loaded map has not applied yet.
+ *
+ * @param args Command arguments.
+ * @returns True if the command executed successfully, false otherwise.
+ */
+bool ChatHandler::HandleEventProgressCommand(char* /*args*/)
+{
+    std::vector<GameEventMgr::TransitionProgress> pending = sGameEventMgr.GetPendingTransitions();
+    if (pending.empty())
+    {
+        SendSysMessage("No game event start or stop is pending in any map.");
+        return true;
+    }
+
+    GameEventMgr::GameEventDataMap const& events = sGameEventMgr.GetEventMap();
+    for (std::vector<GameEventMgr::TransitionProgress>::const_iterator itr = pending.begin(); itr != pending.end(); ++itr)
+    {
+        PSendSysMessage("GameEvent %u \"%s\" %s: %u of %u map updates applied, %u ms", uint32(itr->eventId),
+            events[itr->eventId].description.c_str(), itr->activate ? "start" : "stop", itr->applied, itr->queued, itr->elapsed);
+    }
+    return true;
+}
+
 /**
  * @brief Handler for HandleEventInfoCommand command.
  *
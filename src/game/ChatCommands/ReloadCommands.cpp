@@ -851,6 +851,7 @@ bool ChatHandler::HandleReloadSpellElixirCommand(char* /*args*/)
 {
     sLog.outString("Re-Loading Spell Elixir types...");
     sSpellMgr.LoadSpellElixirs();
+    sSpellMgr.LoadSpellClassifications();
     SendGlobalSysMessage("DB table `spell_elixir` (spell elixir types) reloaded.", SEC_MODERATOR);
     return true;
 }
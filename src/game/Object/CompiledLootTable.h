@@ -0,0 +1,387 @@
+/**
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2026 MaNGOS <https://www.getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+/**
+ * @file CompiledLootTable.h
+ * @brief The loot templates of a store, flattened for loot generation
+ *
+ * LootTemplate keeps the rows of a *_loot_template table the way they were
+ * loaded: plain entries and references in one list, grouped entries in a list
+ * per group, and a reference is followed by looking its id up in the
+ * reference store at every kill. A CompiledLootTable holds the same templates
+ * after load in a handful of flat arrays:
+ *
+ * - a template is a range of entries and a range of groups
+ * - a reference entry holds the index of the referenced template, resolved
+ *   once after both stores are loaded
+ * - a group holds the running sum of its explicit chances, so the item
+ *   selected by a roll is found by binary search instead of subtracting
+ *   chance after chance (short groups are scanned); an entry of 100% or more
+ *   ends the sum, because the sequential walk never went past it
+ *
+ * Selection is the same as that of the sequential walk: for the same
+ * sequence of rolls the same items are produced. Only rolling, conditions and
+ * adding to the loot are left to the caller, through a policy with:
+ *
+ * - bool IsAllowed(Item const&), checked before an entry rolls and after a
+ *   group selected an item
+ * - bool Roll(Item const&), the chance of a plain entry or a reference
+ * - bool IsReferenceAllowed(Item const&), the condition of a reference that
+ *   took its chance
+ * - float RollChance(), a roll in [0, 100) for a group
+ * - uint32 RollIndex(uint32 count), a roll in [0, count) for the equal
+ *   chanced part of a group
+ * - void Add(Item const&)
+ *
+ * Items are copied into the table, next to the data used to walk it, so a
+ * loot touches a few contiguous arrays rather than a template, its lists and
+ * the templates it references.
+ *
+ * @tparam Item the loaded loot row, LootStoreItem
+ */
+
+#ifndef MANGOS_H_COMPILEDLOOTTABLE
+#define MANGOS_H_COMPILEDLOOTTABLE
+
+#include "Platform/Define.h"
+
+#include <algorithm>
+#include <limits>
+#include <unordered_map>
+#include <vector>
+
+template<class Item>
+class CompiledLootTable
+{
+    public:
+        static constexpr uint32 NoTemplate = 0xFFFFFFFF;
+
+        CompiledLootTable() : m_unresolved(0) {}
+
+        /**
+         * @brief Removes every template.
+         */
+        void Clear()
+        {
+            m_templates.clear();
+            m_entries.clear();
+            m_groups.clear();
+            m_chanced.clear();
+            m_cumulative.clear();
+            m_equal.clear();
+            m_index.clear();
+            m_unresolved = 0;
+        }
+
+        /**
+         * @brief Starts a new template; entries and groups added next belong to it.
+         *
+         * @param id the loot id of the template
+         * @return the index of the template, for Process()
+         */
+        uint32 AddTemplate(uint32 id)
+        {
+            Template tab;
+            tab.firstEntry = uint32(m_entries.size());
+            tab.entryCount = 0;
+            tab.firstGroup = uint32(m_groups.size());
+            tab.groupCount = 0;
+            m_templates.push_back(tab);
+
+            uint32 index = uint32(m_templates.size() - 1);
+            m_index[id] = index;
+            return index;
+        }
+
+        /**
+         * @brief Adds a plain, not grouped entry to the current template.
+         *
+         * @param item the entry
+         */
+        void AddItem(Item const& item)
+        {
+            m_entries.push_back(Entry(item, 0, 0, 0, false));
+            ++m_templates.back().entryCount;
+        }
+
+        /**
+         * @brief Adds a reference entry to the current template.
+         *
+         * @param item the entry, rolled and checked as any other entry
+         * @param referenceId the loot id of the referenced template
+         * @param group the group of the referenced template to process, 0 for all of it
+         * @param multiplier how often the reference is processed once it took its chance
+         */
+        void AddReference(Item const& item, uint32 referenceId, uint8 group, uint8 multiplier)
+        {
+            m_entries.push_back(Entry(item, referenceId, group, multiplier, true));
+            ++m_templates.back().entryCount;
+        }
+
+        /**
+         * @brief Starts the next group of the current template.
+         *
+         * Groups are numbered from 1 in the order they are added; an empty
+         * group still takes its number.
+         */
+        void AddGroup()
+        {
+            Group group;
+            group.firstChanced = uint32(m_chanced.size());
+            group.chancedCount = 0;
+            group.firstEqual = uint32(m_equal.size());
+            group.equalCount = 0;
+            m_groups.push_back(group);
+            ++m_templates.back().groupCount;
+        }
+
+        /**
+         * @brief Adds an entry to the current group.
+         *
+         * Explicitly chanced entries are selected in the order they are added.
+         *
+         * @param item the entry
+         * @param chance its chance in percent, 0 for an equal chanced entry
+         */
+        void AddGroupItem(Item const& item, float chance)
+        {
+            Group& group = m_groups.back();
+            if (chance == 0)
+            {
+                m_equal.push_back(item);
+                ++group.equalCount;
+                return;
+            }
+
+            float sum = group.chancedCount ? m_cumulative.back() : 0.0f;
+            if (chance >= 100.0f)
+            {
+                sum = std::numeric_limits<float>::infinity();
+            }
+            else
+            {
+                sum += chance;
+            }
+
+            m_chanced.push_back(item);
+            m_cumulative.push_back(sum);
+            ++group.chancedCount;
+        }
+
+        /**
+         * @brief Points every reference entry at its template in @p references.
+         *
+         * A reference to a missing template is kept and never processed, as
+         * the missing id has been reported at load. Call again whenever the
+         * referenced table is rebuilt.
+         *
+         * @param references the table holding the referenced templates, may be this one
+         * @return the number of references that did not resolve
+         */
+        uint32 ResolveReferences(CompiledLootTable const& references)
+        {
+            m_unresolved = 0;
+            for (typename EntryList::iterator itr = m_entries.begin(); itr != m_entries.end(); ++itr)
+            {
+                if (!itr->isReference)
+                {
+                    continue;
+                }
+
+                itr->reference = references.Find(itr->referenceId);
+                if (itr->reference == NoTemplate)
+                {
+                    ++m_unresolved;
+                }
+            }
+            return m_unresolved;
+        }
+
+        /**
+         * @brief Finds the index of a template.
+         *
+         * @param id the loot id
+         * @return the index, or NoTemplate
+         */
+        uint32 Find(uint32 id) const
+        {
+            typename IndexMap::const_iterator itr = m_index.find(id);
+            return itr != m_index.end() ? itr->second : NoTemplate;
+        }
+
+        /**
+         * @brief Rolls a template and hands every produced item to the policy.
+         *
+         * @param index the template, from AddTemplate() or Find()
+         * @param policy rolls, checks and collects items
+         * @param references the table the reference entries were resolved against
+         * @param groupId the only group to process, 0 for the whole template
+         */
+        template<class Policy>
+        void Process(uint32 index, Policy& policy, CompiledLootTable const& references, uint8 groupId = 0) const
+        {
+            Template const& tab = m_templates[index];
+
+            if (groupId)                                    // Group reference uses own processing of the group
+            {
+                if (groupId <= tab.groupCount)
+                {
+                    ProcessGroup(m_groups[tab.firstGroup + groupId - 1], policy);
+                }
+                return;
+            }
+
+            for (uint32 i = tab.firstEntry; i < tab.firstEntry + tab.entryCount; ++i)
+            {
+                Entry const& entry = m_entries[i];
+                if (!policy.IsAllowed(entry.item) || !policy.Roll(entry.item))
+                {
+                    continue;
+                }
+
+                if (!entry.isReference)
+                {
+                    policy.Add(entry.item);
+                    continue;
+                }
+
+                if (entry.reference == NoTemplate || !policy.IsReferenceAllowed(entry.item))
+                {
+                    continue;
+                }
+
+                for (uint32 loop = 0; loop < entry.multiplier; ++loop)
+                {
+                    references.Process(entry.reference, policy, references, entry.referenceGroup);
+                }
+            }
+
+            for (uint32 i = tab.firstGroup; i < tab.firstGroup + tab.groupCount; ++i)
+            {
+                ProcessGroup(m_groups[i], policy);
+            }
+        }
+
+        uint32 GetTemplateCount() const { return uint32(m_templates.size()); }
+        uint32 GetEntryCount() const { return uint32(m_entries.size()); }
+        uint32 GetGroupCount() const { return uint32(m_groups.size()); }
+        uint32 GetGroupItemCount() const { return uint32(m_chanced.size() + m_equal.size()); }
+        uint32 GetUnresolvedCount() const { return m_unresolved; }
+
+    private:
+        struct Template
+        {
+            uint32 firstEntry;
+            uint32 entryCount;
+            uint32 firstGroup;
+            uint32 groupCount;
+        };
+
+        struct Entry
+        {
+            Entry(Item const& item_, uint32 referenceId_, uint8 referenceGroup_, uint8 multiplier_, bool isReference_)
+                : item(item_), referenceId(referenceId_), reference(NoTemplate),
+                referenceGroup(referenceGroup_), multiplier(multiplier_), isReference(isReference_)
+            {}
+
+            Item item;
+            uint32 referenceId;
+            uint32 reference;                               // index in the referenced table, NoTemplate if unresolved
+            uint8 referenceGroup;
+            uint8 multiplier;
+            bool isReference;
+        };
+
+        struct Group
+        {
+            uint32 firstChanced;                            // in m_chanced and m_cumulative
+            uint32 chancedCount;
+            uint32 firstEqual;                              // in m_equal
+            uint32 equalCount;
+        };
+
+        // Groups up to this size are scanned; a binary search over a few
+        // values mispredicts more than it saves
+        static constexpr uint32 LinearSearchLimit = 16;
+
+        typedef std::vector<Entry> EntryList;
+        typedef std::unordered_map<uint32, uint32> IndexMap;
+
+        // Rolls an item from the group, returns NULL if all miss their chances
+        template<class Policy>
+        Item const* RollGroup(Group const& group, Policy& policy) const
+        {
+            if (group.chancedCount)
+            {
+                float const roll = policy.RollChance();
+                float const* begin = &m_cumulative[group.firstChanced];
+                float const* end = begin + group.chancedCount;
+                float const* selected = begin;
+                if (group.chancedCount > LinearSearchLimit)
+                {
+                    selected = std::upper_bound(begin, end, roll);
+                }
+                else
+                {
+                    while (selected != end && !(roll < *selected))
+                    {
+                        ++selected;
+                    }
+                }
+                if (selected != end)
+                {
+                    return &m_chanced[group.firstChanced + (selected - begin)];
+                }
+            }
+
+            if (group.equalCount)
+            {
+                return &m_equal[group.firstEqual + policy.RollIndex(group.equalCount)];
+            }
+
+            return NULL;
+        }
+
+        template<class Policy>
+        void ProcessGroup(Group const& group, Policy& policy) const
+        {
+            Item const* item = RollGroup(group, policy);
+            if (item && policy.IsAllowed(*item))
+            {
+                policy.Add(*item);
+            }
+        }
+
+        std::vector<Template> m_templates;
+        EntryList m_entries;
+        std::vector<Group> m_groups;
+        std::vector<Item> m_chanced;
+        std::vector<float> m_cumulative;                    // running sum of the chances in m_chanced, per group
+        std::vector<Item> m_equal;
+        IndexMap m_index;                                   // loot id -> template index
+        uint32 m_unresolved;
+};
+
+#endif
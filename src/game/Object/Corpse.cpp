@@ -33,6 +33,9 @@
 #include "World.h"
 #include "ObjectMgr.h"
 
+// player corpses turn into bones and expire all day long
+MANGOS_SLAB_POOL_DEFINE(Corpse, 32)
+
 /**
  * @brief Creates a corpse object of the specified type.
  *
@@ -50,6 +50,7 @@
 #define MANGOSSERVER_CORPSE_H
 
 #include "Platform/Define.h"
+#include "Utilities/SlabPool.h"
 #include <ctime>
 #include "Object.h"
 #include "Database/DatabaseEnv.h"
@@ -91,6 +92,8 @@ enum CorpseFlags
 class Corpse : public WorldObject
 {
     public:
+        MANGOS_SLAB_POOL_ALLOCATOR
+
         explicit Corpse(CorpseType type = CORPSE_BONES);
         ~Corpse();
 
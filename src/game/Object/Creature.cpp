@@ -230,6 +230,9 @@ bool CreatureCreatePos::PlaceOn(Creature* cr) const
     return true;
 }
 
+// creatures come and go with their grid cells, their memory is kept for the next load
+MANGOS_SLAB_POOL_DEFINE(Creature, 64)
+
 /**
  * @brief Creates a creature instance with default runtime state.
  *
@@ -3316,17 +3319,15 @@ void Creature::FillGuidsListFromThreatList(GuidVector& guids, uint32 maxamount /
 
 struct AddCreatureToRemoveListInMapsWorker
 {
-    AddCreatureToRemoveListInMapsWorker(ObjectGuid guid) : i_guid(guid) {}
+    AddCreatureToRemoveListInMapsWorker(uint32 guid, CreatureData const* data) : i_guid(guid), i_data(data) {}
 
     void operator()(Map* map)
     {
-        if (Creature* pCreature = map->GetCreature(i_guid))
-        {
-            pCreature->AddObjectToRemoveList();
-        }
+        Creature::AddToRemoveListInMap(map, i_guid, i_data);
     }
 
-    ObjectGuid i_guid;
+    uint32 i_guid;
+    CreatureData const* i_data;
 };
 
 /**
@@ -3337,25 +3338,32 @@ struct AddCreatureToRemoveListInMapsWorker
  */
 void Creature::AddToRemoveListInMaps(uint32 db_guid, CreatureData const* data)
 {
-    AddCreatureToRemoveListInMapsWorker worker(data->GetObjectGuid(db_guid));
+    AddCreatureToRemoveListInMapsWorker worker(db_guid, data);
     sMapMgr.DoForAllMapsWithMapId(data->mapid, worker);
 }
 
+/**
+ * @brief Schedules the spawned copy of a database creature in one map for removal.
+ *
+ * @param map The map copy.
+ * @param db_guid The database GUID.
+ * @param data The static creature spawn data.
+ */
+void Creature::AddToRemoveListInMap(Map* map, uint32 db_guid, CreatureData const* data)
+{
+    if (Creature* pCreature = map->GetCreature(data->GetObjectGuid(db_guid)))
+    {
+        pCreature->AddObjectToRemoveList();
+    }
+}
+
 struct SpawnCreatureInMapsWorker
 {
     SpawnCreatureInMapsWorker(uint32 guid, CreatureData const* data) : i_guid(guid), i_data(data) {}
 
     void operator()(Map* map)
     {
-        // We use spawn coords to spawn
-        if (map->IsCellLoaded(i_data->posX, i_data->posY))
-        {
-            Creature* pCreature = new Creature;
-            if (!pCreature->LoadFromDB(i_guid, map))
-            {
-                delete pCreature;
-            }
-        }
+        Creature::SpawnInMap(map, i_guid, i_data);
     }
 
     uint32 i_guid;
@@ -3374,6 +3382,39 @@ void Creature::SpawnInMaps(uint32 db_guid, CreatureData const* data)
     sMapMgr.DoForAllMapsWithMapId(data->mapid, worker);
 }
 
+/**
+ * @brief Spawns a database creature in one map copy if its spawn point is loaded.
+ *
+ * A copy already in the map, loaded with its grid after the spawn was
+ * requested, is kept unless it is about to be removed.
+ *
+ * @param map The map copy.
+ * @param db_guid The database GUID.
+ * @param data The static creature spawn data.
+ */
+void Creature::SpawnInMap(Map* map, uint32 db_guid, CreatureData const* data)
+{
+    // We use spawn coords to spawn
+    if (!map->IsCellLoaded(data->posX, data->posY))
+    {
+        return;
+    }
+
+    if (Creature* existing = map->GetCreature(data->GetObjectGuid(db_guid)))
+    {
+        if (!map->IsObjectPendingRemoval(existing))
+        {
+            return;
+        }
+    }
+
+    Creature* pCreature = new Creature;
+    if (!pCreature->LoadFromDB(db_guid, map))
+    {
+        delete pCreature;
+    }
+}
+
 /**
  * @brief Checks whether this creature has static database spawn data.
  *
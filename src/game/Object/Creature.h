@@ -50,6 +50,7 @@
 
 #include <unordered_map>
 #include "Platform/Define.h"
+#include "Utilities/SlabPool.h"
 #include <ctime>
 #include <string>
 #include <vector>
@@ -572,6 +573,7 @@ class Creature : public Unit
     CreatureAI* i_AI;
 
     public:
+        MANGOS_SLAB_POOL_ALLOCATOR
 
         /* Loot Variables */
         bool hasBeenLootedOnce;
@@ -862,6 +864,9 @@ class Creature : public Unit
         // Functions spawn/remove creature with DB guid in all loaded map copies (if point grid loaded in map)
         static void AddToRemoveListInMaps(uint32 db_guid, CreatureData const* data);
         static void SpawnInMaps(uint32 db_guid, CreatureData const* data);
+        // Same for one map copy, on that map's update thread
+        static void AddToRemoveListInMap(Map* map, uint32 db_guid, CreatureData const* data);
+        static void SpawnInMap(Map* map, uint32 db_guid, CreatureData const* data);
 
         void StartGroupLoot(Group* group, uint32 timer) override;
 
@@ -34,6 +34,9 @@
 #include "SpellMgr.h"
 #include "DBCStores.h"
 
+// one per persistent area aura, short lived
+MANGOS_SLAB_POOL_DEFINE(DynamicObject, 32)
+
 /**
  * @brief Creates an empty dynamic object instance.
  */
@@ -29,6 +29,7 @@
 #include "Object.h"
 #include "DBCEnums.h"
 #include "Unit.h"
+#include "Utilities/SlabPool.h"
 
 enum DynamicObjectType
 {
@@ -42,6 +43,8 @@ struct SpellEntry;
 class DynamicObject : public WorldObject
 {
     public:
+        MANGOS_SLAB_POOL_ALLOCATOR
+
         explicit DynamicObject();
 
         void AddToWorld() override;
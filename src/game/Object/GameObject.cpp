@@ -58,6 +58,8 @@
 #include "LuaEngine.h"
 #endif /* ENABLE_ELUNA */
 
+// loaded and unloaded with their grid cells, like creatures
+MANGOS_SLAB_POOL_DEFINE(GameObject, 64)
 
 /**
  * @brief Creates a game object instance with default runtime state.
@@ -1591,17 +1593,15 @@ void GameObject::AddToSkillupList(Player* player)
 
 struct AddGameObjectToRemoveListInMapsWorker
 {
-    AddGameObjectToRemoveListInMapsWorker(ObjectGuid guid) : i_guid(guid) {}
+    AddGameObjectToRemoveListInMapsWorker(uint32 guid, GameObjectData const* data) : i_guid(guid), i_data(data) {}
 
     void operator()(Map* map)
     {
-        if (GameObject* pGameobject = map->GetGameObject(i_guid))
-        {
-            pGameobject->AddObjectToRemoveList();
-        }
+        GameObject::AddToRemoveListInMap(map, i_guid, i_data);
     }
 
-    ObjectGuid i_guid;
+    uint32 i_guid;
+    GameObjectData const* i_data;
 };
 
 /**
@@ -1612,10 +1612,25 @@ struct AddGameObjectToRemoveListInMapsWorker
  */
 void GameObject::AddToRemoveListInMaps(uint32 db_guid, GameObjectData const* data)
 {
-    AddGameObjectToRemoveListInMapsWorker worker(ObjectGuid(HIGHGUID_GAMEOBJECT, data->id, db_guid));
+    AddGameObjectToRemoveListInMapsWorker worker(db_guid, data);
     sMapMgr.DoForAllMapsWithMapId(data->mapid, worker);
 }
 
+/**
+ * @brief Adds the spawned copy of a database game object in one map to its remove list.
+ *
+ * @param map The map copy.
+ * @param db_guid The database GUID.
+ * @param data The static spawn data.
+ */
+void GameObject::AddToRemoveListInMap(Map* map, uint32 db_guid, GameObjectData const* data)
+{
+    if (GameObject* pGameobject = map->GetGameObject(ObjectGuid(HIGHGUID_GAMEOBJECT, data->id, db_guid)))
+    {
+        pGameobject->AddObjectToRemoveList();
+    }
+}
+
 struct SpawnGameObjectInMapsWorker
 {
     SpawnGameObjectInMapsWorker(uint32 guid, GameObjectData const* data)
@@ -1623,23 +1638,7 @@ struct SpawnGameObjectInMapsWorker
 
     void operator()(Map* map)
     {
-        // Spawn if necessary (loaded grids only)
-        if (map->IsCellLoaded(i_data->posX, i_data->posY))
-        {
-            GameObject* pGameobject = new GameObject;
-            // DEBUG_LOG("Spawning gameobject %u", *itr);
-            if (!pGameobject->LoadFromDB(i_guid, map))
-            {
-                delete pGameobject;
-            }
-            else
-            {
-                if (pGameobject->isSpawnedByDefault())
-                {
-                    map->Add(pGameobject);
-                }
-            }
-        }
+        GameObject::SpawnInMap(map, i_guid, i_data);
     }
 
     uint32 i_guid;
@@ -1658,6 +1657,47 @@ void GameObject::SpawnInMaps(uint32 db_guid, GameObjectData const* data)
     sMapMgr.DoForAllMapsWithMapId(data->mapid, worker);
 }
 
+/**
+ * @brief Spawns a database game object in one map copy if its spawn point is loaded.
+ *
+ * A copy already in the map, loaded with its grid after the spawn was
+ * requested, is kept unless it is about to be removed.
+ *
+ * @param map The map copy.
+ * @param db_guid The database GUID.
+ * @param data The static spawn data.
+ */
+void GameObject::SpawnInMap(Map* map, uint32 db_guid, GameObjectData const* data)
+{
+    // Spawn if necessary (loaded grids only)
+    if (!map->IsCellLoaded(data->posX, data->posY))
+    {
+        return;
+    }
+
+    if (GameObject* existing = map->GetGameObject(ObjectGuid(HIGHGUID_GAMEOBJECT, data->id, db_guid)))
+    {
+        if (!map->IsObjectPendingRemoval(existing))
+        {
+            return;
+        }
+    }
+
+    GameObject* pGameobject = new GameObject;
+    // DEBUG_LOG("Spawning gameobject %u", db_guid);
+    if (!pGameobject->LoadFromDB(db_guid, map))
+    {
+        delete pGameobject;
+    }
+    else
+    {
+        if (pGameobject->isSpawnedByDefault())
+        {
+            map->Add(pGameobject);
+        }
+    }
+}
+
 /**
  * @brief Checks whether this object has static database spawn data.
  *
@@ -61,6 +61,7 @@
 #include "Object.h"
 #include "LootMgr.h"
 #include "Utilities/EventProcessor.h"
+#include "Utilities/SlabPool.h"
 #include <memory>
 
 // GCC have alternative #pragma pack(N) syntax and old gcc version not support pack(push,N), also any gcc version not support it at some platform
@@ -619,6 +620,8 @@ class GameObject : public WorldObject
 {
 
     public:
+        MANGOS_SLAB_POOL_ALLOCATOR
+
         explicit GameObject();
         ~GameObject();
 
@@ -707,6 +710,9 @@ class GameObject : public WorldObject
         // Functions spawn/remove gameobject with DB guid in all loaded map copies (if point grid loaded in map)
         static void AddToRemoveListInMaps(uint32 db_guid, GameObjectData const* data);
         static void SpawnInMaps(uint32 db_guid, GameObjectData const* data);
+        // Same for one map copy, on that map's update thread
+        static void AddToRemoveListInMap(Map* map, uint32 db_guid, GameObjectData const* data);
+        static void SpawnInMap(Map* map, uint32 db_guid, GameObjectData const* data);
 
         GameobjectTypes GetGoType() const { return GameobjectTypes(GetUInt32Value(GAMEOBJECT_TYPE_ID)); }
         void SetGoType(GameobjectTypes type) { SetUInt32Value(GAMEOBJECT_TYPE_ID, type); }
@@ -39,6 +39,7 @@
 #include "Language.h"
 #include "World.h"
 #include "PlayerRegistry.h"
+#include "SharedPacket.h"
 #ifdef ENABLE_ELUNA
 #include "LuaEngine.h"
 #endif /* ENABLE_ELUNA */
@@ -826,6 +827,8 @@ void Guild::BroadcastToOfficers(WorldSession* session, const std::string& msg, u
  */
 void Guild::BroadcastPacket(WorldPacket* packet)
 {
+    proto::SharedPacketScope shared(*packet);
+
     for (MemberList::const_iterator itr = members.begin(); itr != members.end(); ++itr)
     {
         Player* player = sPlayerRegistry.Find(ObjectGuid(HIGHGUID_PLAYER, itr->first));
@@ -844,6 +847,8 @@ void Guild::BroadcastPacket(WorldPacket* packet)
  */
 void Guild::BroadcastPacketToRank(WorldPacket* packet, uint32 rankId)
 {
+    proto::SharedPacketScope shared(*packet);
+
     for (MemberList::const_iterator itr = members.begin(); itr != members.end(); ++itr)
     {
         if (itr->second.RankId == rankId)
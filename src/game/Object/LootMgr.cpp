@@ -57,10 +57,9 @@ LootStore LootTemplates_Pickpocketing("pickpocketing_loot_template", "creature p
 LootStore LootTemplates_Reference("reference_loot_template",    "reference id",                   false);
 LootStore LootTemplates_Skinning("skinning_loot_template",     "creature skinning id",           true);
 
-class LootTemplate::LootGroup                               // A set of loot definitions for items (refs are not allowed)
+class LootTemplate::LootGroup : public LootRows::Group<LootStoreItem> // A set of loot definitions for items (refs are not allowed)
 {
     public:
-        void AddEntry(LootStoreItem& item);                 // Adds an entry to the group (at loading stage)
         bool HasQuestDrop() const;                          // True if group includes at least 1 quest drop entry
         bool HasQuestDropForPlayer(Player const* player) const; // The same for active quests of the player
 
@@ -79,19 +78,43 @@ class LootTemplate::LootGroup                               // A set of loot def
          * \return boolean True if there's a starting quest drop, false otherwise.
          */
         bool HasStartingQuestDropForPlayer(Player const* player) const;
-        void Process(Loot& loot) const;                     // Rolls an item from the group (if any) and adds the item to the loot
         float RawTotalChance() const;                       // Overall chance for the group (without equal chanced items)
         float TotalChance() const;                          // Overall chance for the group
 
         void Verify(LootStore const& lootstore, uint32 id, uint32 group_id) const;
         void CheckLootRefs(LootIdSet* ref_set) const;
-    private:
-        LootStoreItemList ExplicitlyChanced;                // Entries with chances defined in DB
-        LootStoreItemList EqualChanced;                     // Zero chances - every entry takes the same chance
-
-        LootStoreItem const* Roll() const;                  // Rolls an item from the group, returns NULL if all miss their chances
 };
 
+namespace
+{
+    // Rolls, conditions and loot insertion of LootTemplate::Process for the flattened table
+    class LootFillPolicy
+    {
+        public:
+            LootFillPolicy(Loot& loot, bool rate) : m_loot(loot), m_rate(rate) {}
+
+            bool IsAllowed(LootStoreItem const& item) const
+            {
+                return !DisableMgr::IsDisabledFor(DISABLE_TYPE_ITEM_DROP, item.itemid);
+            }
+
+            bool Roll(LootStoreItem const& item) const { return item.Roll(m_rate); }
+
+            bool IsReferenceAllowed(LootStoreItem const& item) const
+            {
+                return !item.conditionId || sObjectMgr.IsPlayerMeetToCondition(item.conditionId, NULL, NULL, m_loot.GetLootTarget(), CONDITION_FROM_REFERING_LOOT);
+            }
+
+            float RollChance() const { return rand_chance_f(); }
+            uint32 RollIndex(uint32 count) const { return uint32(irand(0, int32(count) - 1)); }
+            void Add(LootStoreItem const& item) { m_loot.AddItem(item); }
+
+        private:
+            Loot& m_loot;
+            bool m_rate;
+    };
+}
+
 // Remove all data and free all memory
 void LootStore::Clear()
 {
@@ -100,6 +123,7 @@ void LootStore::Clear()
         delete itr->second;
     }
     m_LootTemplates.clear();
+    m_table.Clear();
 }
 
 // Checks validity of the loot store
@@ -195,8 +219,11 @@ void LootStore::LoadLootTable()
         delete result;
 
         Verify();                                           // Checks validity of the loot store
+        Compile();
+        CheckCompiled();
 
         sLog.outString(">> Loaded %u loot definitions (%zu templates) from table %s", count, m_LootTemplates.size(), GetName());
+        sLog.outString(">> Flattened into %u entries and %u groups of %u items", m_table.GetEntryCount(), m_table.GetGroupCount(), m_table.GetGroupItemCount());
         sLog.outString();
     }
     else
@@ -303,6 +330,106 @@ LootTemplate const* LootStore::GetLootFor(uint32 loot_id) const
     return tab->second;
 }
 
+/**
+ * @brief Rebuilds the flattened table from the loaded templates.
+ */
+void LootStore::Compile()
+{
+    m_table.Clear();
+
+    for (LootTemplateMap::const_iterator tab = m_LootTemplates.begin(); tab != m_LootTemplates.end(); ++tab)
+    {
+        tab->second->Compile(m_table, tab->first);
+    }
+
+    ResolveReferences();
+}
+
+namespace
+{
+    // Deterministic rolls for CheckCompiled: every item allowed, every reference taken
+    // once its chance is, so a template's own rows and its flattened table must
+    // produce the same items from the same seed. Rolls fall halfway between
+    // hundredths, away from any sum of chances as the database writes them, where
+    // summing and subtracting could round apart.
+    class LootReplayPolicy
+    {
+        public:
+            explicit LootReplayPolicy(uint32 seed) : m_state(uint64(seed) * 0x9E3779B97F4A7C15ULL + 1) {}
+
+            bool IsAllowed(LootStoreItem const& /*item*/) const { return true; }
+            bool Roll(LootStoreItem const& item) { return item.chance >= 100.0f || item.chance > RollChance(); }
+            bool IsReferenceAllowed(LootStoreItem const& /*item*/) const { return true; }
+            float RollChance() { return (float(Next() % 10000) + 0.5f) * 0.01f; }
+            uint32 RollIndex(uint32 count) { return Next() % count; }
+            void Add(LootStoreItem const& item) { m_items.push_back(item.itemid); }
+
+            std::vector<uint32> const& GetItems() const { return m_items; }
+
+        private:
+            uint32 Next()                                   // xorshift64*
+            {
+                m_state ^= m_state >> 12;
+                m_state ^= m_state << 25;
+                m_state ^= m_state >> 27;
+                return uint32((m_state * 0x2545F4914F6CDD1DULL) >> 32);
+            }
+
+            uint64 m_state;
+            std::vector<uint32> m_items;
+    };
+}
+
+/**
+ * @brief Replays every template through its flattened form and its own rows.
+ *
+ * Each template is rolled a few times from fixed seeds by both; the flattened
+ * table selects exactly as the sequential roll did, so any difference is a
+ * compile bug and is reported with the template id.
+ *
+ * @return The number of templates whose two rolls disagree.
+ */
+uint32 LootStore::CheckCompiled() const
+{
+    uint32 const replays = 4;
+    uint32 mismatches = 0;
+
+    for (LootTemplateMap::const_iterator tab = m_LootTemplates.begin(); tab != m_LootTemplates.end(); ++tab)
+    {
+        uint32 const index = m_table.Find(tab->first);
+        for (uint32 seed = 1; seed <= replays; ++seed)
+        {
+            LootReplayPolicy sequential(tab->first * replays + seed);
+            LootReplayPolicy flattened(tab->first * replays + seed);
+            tab->second->ProcessSequentially(sequential);
+            if (index != LootStoreTable::NoTemplate)
+            {
+                m_table.Process(index, flattened, LootTemplates_Reference.GetTable());
+            }
+
+            if (sequential.GetItems() != flattened.GetItems())
+            {
+                sLog.outError("Table '%s' entry %u: flattened template rolled %zu items where its rows rolled %zu",
+                              GetName(), tab->first, flattened.GetItems().size(), sequential.GetItems().size());
+                ++mismatches;
+                break;
+            }
+        }
+    }
+
+    return mismatches;
+}
+
+/**
+ * @brief Points the reference entries of the table at the reference store.
+ *
+ * Reference ids missing from the store are reported by CheckLootRefs().
+ */
+void LootStore::ResolveReferences()
+{
+    m_table.ResolveReferences(LootTemplates_Reference.GetTable());
+}
+
 /**
  * @brief Loads the loot table and collects all template identifiers.
  *
@@ -1180,60 +1307,6 @@ ByteBuffer& operator<<(ByteBuffer& b, LootView const& lv)
 // --------- LootTemplate::LootGroup ---------
 //
 
-// Adds an entry to the group (at loading stage)
-
-/**
- * @brief Adds a loot entry to a loot group.
- *
- * @param item The loot store item to add.
- */
-void LootTemplate::LootGroup::AddEntry(LootStoreItem& item)
-{
-    if (item.chance != 0)
-    {
-        ExplicitlyChanced.push_back(item);
-    }
-    else
-    {
-        EqualChanced.push_back(item);
-    }
-}
-
-// Rolls an item from the group, returns NULL if all miss their chances
-
-/**
- * @brief Rolls one item from a loot group.
- *
- * @return Pointer to the selected loot item, or NULL if none is selected.
- */
-LootStoreItem const* LootTemplate::LootGroup::Roll() const
-{
-    if (!ExplicitlyChanced.empty())                         // First explicitly chanced entries are checked
-    {
-        float Roll = rand_chance_f();
-
-        for (uint32 i = 0; i < ExplicitlyChanced.size(); ++i) // check each explicitly chanced entry in the template and modify its chance based on quality.
-        {
-            if (ExplicitlyChanced[i].chance >= 100.0f)
-            {
-                return &ExplicitlyChanced[i];
-            }
-
-            Roll -= ExplicitlyChanced[i].chance;
-            if (Roll < 0)
-            {
-                return &ExplicitlyChanced[i];
-            }
-        }
-    }
-    if (!EqualChanced.empty())                              // If nothing selected yet - an item is taken from equal-chanced part
-    {
-        return &EqualChanced[irand(0, EqualChanced.size() - 1)];
-    }
-
-    return NULL;                                            // Empty drop from the group
-}
-
 // True if group includes at least 1 quest drop entry
 
 /**
@@ -1359,22 +1432,6 @@ bool LootTemplate::LootGroup::HasStartingQuestDropForPlayer(Player const* player
     return false;
 }
 
-// Rolls an item from the group (if any takes its chance) and adds the item to the loot
-
-/**
- * @brief Processes the group and adds the rolled item to loot.
- *
- * @param loot The loot container being filled.
- */
-void LootTemplate::LootGroup::Process(Loot& loot) const
-{
-    LootStoreItem const* item = Roll();
-    if (item != NULL && !DisableMgr::IsDisabledFor(DISABLE_TYPE_ITEM_DROP, item->itemid))
-    {
-        loot.AddItem(*item);
-    }
-}
-
 // Overall chance for the group without equal chanced items
 
 /**
@@ -1478,6 +1535,13 @@ void LootTemplate::LootGroup::CheckLootRefs(LootIdSet* ref_set) const
 // --------- LootTemplate ---------
 //
 
+/**
+ * @brief Creates an empty loot template, not yet part of a flattened table.
+ */
+LootTemplate::LootTemplate() : m_tableIndex(LootStoreTable::NoTemplate)
+{
+}
+
 // Adds an entry to the group (at loading stage)
 
 /**
@@ -1487,18 +1551,48 @@ void LootTemplate::LootGroup::CheckLootRefs(LootIdSet* ref_set) const
  */
 void LootTemplate::AddEntry(LootStoreItem& item)
 {
-    if (item.group > 0 && item.mincountOrRef > 0)           // Group
+    LootRows::AddEntry(Entries, Groups, item);
+}
+
+/**
+ * @brief Adds the template, its entries and groups to the flattened table.
+ *
+ * @param table The table of the store.
+ * @param id The loot template identifier.
+ */
+void LootTemplate::Compile(LootStoreTable& table, uint32 id)
+{
+    m_tableIndex = LootRows::Compile(Entries, Groups, table, id);
+}
+
+namespace
+{
+    // The reference store as the sequential roll saw it: looked up by id at every roll
+    template<class Policy>
+    struct SequentialReferences
     {
-        if (item.group >= Groups.size())
+        bool Has(uint32 id) const { return LootTemplates_Reference.GetLootFor(id) != NULL; }
+
+        void Process(uint32 id, Policy& policy, uint8 groupId) const
         {
-            Groups.resize(item.group); // Adds new group the the loot template if needed
+            LootTemplates_Reference.GetLootFor(id)->ProcessSequentially(policy, groupId);
         }
-        Groups[item.group - 1].AddEntry(item);              // Adds new entry to the group
-    }
-    else                                                    // Non-grouped entries and references are stored together
-    {
-        Entries.push_back(item);
-    }
+    };
+}
+
+/**
+ * @brief Rolls the template over its rows as loaded, references looked up by id.
+ *
+ * The roll generation made before the templates were flattened; see
+ * LootTemplateRows.h. Only LootStore::CheckCompiled() uses it.
+ *
+ * @param policy Rolls, checks and collects items, as for the flattened table.
+ * @param groupId Optional specific group identifier for reference processing.
+ */
+template<class Policy>
+void LootTemplate::ProcessSequentially(Policy& policy, uint8 groupId) const
+{
+    LootRows::Process(Entries, Groups, policy, SequentialReferences<Policy>(), groupId);
 }
 
 // Rolls for every item in the template and adds the rolled items the the loot
@@ -1506,6 +1600,9 @@ void LootTemplate::AddEntry(LootStoreItem& item)
 /**
  * @brief Processes the template and appends rolled items to loot.
  *
+ * Generation runs on the flattened table of the store, with references
+ * resolved at load and group selection by binary search.
+ *
  * @param loot The loot container being filled.
  * @param store The loot store owning the template.
  * @param rate true to apply loot rate modifiers.
@@ -1513,56 +1610,13 @@ void LootTemplate::AddEntry(LootStoreItem& item)
  */
 void LootTemplate::Process(Loot& loot, LootStore const& store, bool rate, uint8 groupId) const
 {
-    if (groupId)                                            // Group reference uses own processing of the group
-    {
-        if (groupId > Groups.size())
-        {
-            return; // Error message already printed at loading stage
-        }
-
-        Groups[groupId - 1].Process(loot);
-        return;
-    }
-
-    // Rolling non-grouped items
-    for (LootStoreItemList::const_iterator i = Entries.begin() ; i != Entries.end() ; ++i)
+    if (m_tableIndex == LootStoreTable::NoTemplate)
     {
-        if (DisableMgr::IsDisabledFor(DISABLE_TYPE_ITEM_DROP, i->itemid) || !i->Roll(rate))
-        {
-            continue; // Bad luck for the entry
-        }
-
-        if (i->mincountOrRef < 0)                           // References processing
-        {
-            LootTemplate const* Referenced = LootTemplates_Reference.GetLootFor(-i->mincountOrRef);
-
-            if (!Referenced)
-            {
-                continue; // Error message already printed at loading stage
-            }
-
-            // Check condition
-            if (i->conditionId && !sObjectMgr.IsPlayerMeetToCondition(i->conditionId, NULL, NULL, loot.GetLootTarget(), CONDITION_FROM_REFERING_LOOT))
-            {
-                continue;
-            }
-
-            for (uint32 loop = 0; loop < i->maxcount; ++loop) // Ref multiplicator
-            {
-                Referenced->Process(loot, store, rate, i->group);
-            }
-        }
-        else                                                // Plain entries (not a reference, not grouped)
-        {
-            loot.AddItem(*i); // Chance is already checked, just add
-        }
+        return;                                             // not compiled yet, still loading
     }
 
-    // Now processing groups
-    for (LootGroups::const_iterator i = Groups.begin() ; i != Groups.end() ; ++i)
-    {
-        i->Process(loot);
-    }
+    LootFillPolicy policy(loot, rate);
+    store.GetTable().Process(m_tableIndex, policy, LootTemplates_Reference.GetTable(), groupId);
 }
 
 // True if template includes at least 1 quest drop entry
@@ -2095,6 +2149,16 @@ void LoadLootTemplates_Reference()
     LootIdSet ids_set;
     LootTemplates_Reference.LoadAndCollectLootIds(ids_set);
 
+    // the reference store was rebuilt, the flattened tables must point into the new one
+    LootTemplates_Creature.ResolveReferences();
+    LootTemplates_Fishing.ResolveReferences();
+    LootTemplates_Gameobject.ResolveReferences();
+    LootTemplates_Item.ResolveReferences();
+    LootTemplates_Pickpocketing.ResolveReferences();
+    LootTemplates_Skinning.ResolveReferences();
+    LootTemplates_Disenchant.ResolveReferences();
+    LootTemplates_Mail.ResolveReferences();
+
     // check references and remove used
     LootTemplates_Creature.CheckLootRefs(&ids_set);
     LootTemplates_Fishing.CheckLootRefs(&ids_set);
@@ -32,6 +32,7 @@
 #include <set>
 #include "ByteBuffer.h"
 #include "ObjectGuid.h"
+#include "LootTemplateRows.h"
 #include "Utilities/LinkedReference/RefManager.h"
 
 #include <vector>
@@ -146,6 +147,7 @@ typedef std::vector<QuestItem> QuestItemList;
 typedef std::map<uint32, QuestItemList*> QuestItemMap;
 typedef std::vector<LootStoreItem> LootStoreItemList;
 typedef std::unordered_map<uint32, LootTemplate*> LootTemplateMap;
+typedef CompiledLootTable<LootStoreItem> LootStoreTable;
 
 typedef std::set<uint32> LootIdSet;
 
@@ -190,6 +192,13 @@ class LootStore
 
         LootTemplate const* GetLootFor(uint32 loot_id) const;
 
+        // Flattened templates used at loot generation, rebuilt at every load
+        LootStoreTable const& GetTable() const { return m_table; }
+        // Points reference entries at the current reference store (after it was reloaded)
+        void ResolveReferences();
+        // Replays every template through the flattened table and its own rows; returns the templates that disagree
+        uint32 CheckCompiled() const;
+
         char const* GetName() const { return m_name; }
         char const* GetEntryName() const { return m_entryName; }
         bool IsRatesAllowed() const { return m_ratesAllowed; }
@@ -197,7 +206,10 @@ class LootStore
         void LoadLootTable();
         void Clear();
     private:
+        void Compile();
+
         LootTemplateMap m_LootTemplates;
+        LootStoreTable m_table;
         char const* m_name;
         char const* m_entryName;
         bool m_ratesAllowed;
@@ -209,10 +221,17 @@ class LootTemplate
     typedef std::vector<LootGroup> LootGroups;
 
     public:
+        LootTemplate();
+
         // Adds an entry to the group (at loading stage)
         void AddEntry(LootStoreItem& item);
+        // Adds the template to the flattened table of its store (after loading)
+        void Compile(LootStoreTable& table, uint32 id);
         // Rolls for every item in the template and adds the rolled items the the loot
         void Process(Loot& loot, LootStore const& store, bool rate, uint8 GroupId = 0) const;
+        // As Process, over the rows as loaded rather than the flattened table (LootStore::CheckCompiled)
+        template<class Policy>
+        void ProcessSequentially(Policy& policy, uint8 groupId = 0) const;
 
         // True if template includes at least 1 quest drop entry
         bool HasQuestDrop(LootTemplateMap const& store, uint8 GroupId = 0) const;
@@ -245,6 +264,7 @@ class LootTemplate
     private:
         LootStoreItemList Entries;                          // not grouped only
         LootGroups        Groups;                           // groups have own (optimised) processing, grouped entries go there
+        uint32            m_tableIndex;                     // index in the flattened table of the store
 };
 
 //=====================================================
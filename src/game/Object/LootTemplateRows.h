@@ -0,0 +1,253 @@
+/**
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2026 MaNGOS <https://www.getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+/**
+ * @file LootTemplateRows.h
+ * @brief The rows of a loot template as loaded, and the sequential roll over them
+ *
+ * LootTemplate keeps its rows the way the *_loot_template table holds them:
+ * plain entries and references in one list, grouped entries in a list per
+ * group, split into explicitly and equally chanced items. This is that
+ * storage and everything done with it that CompiledLootTable has to agree
+ * with: which list a row goes to, how the rows are added to the flattened
+ * table, and the roll loot generation made before the tables were flattened
+ * -- references looked up by id at every roll, a group's item selected by
+ * subtracting chance after chance.
+ *
+ * Generation no longer rolls this way. The sequential roll is kept as the
+ * reference the flattened table is held to: LootStore::CheckCompiled()
+ * replays every loaded template through both after a load, and the unit tests
+ * do the same over millions of random ones. Both rolls take the same policy,
+ * described in CompiledLootTable.h.
+ *
+ * @tparam Item the loaded loot row, LootStoreItem
+ */
+
+#ifndef MANGOS_H_LOOTTEMPLATEROWS
+#define MANGOS_H_LOOTTEMPLATEROWS
+
+#include "CompiledLootTable.h"
+
+#include <vector>
+
+namespace LootRows
+{
+    /**
+     * @brief The rows of one loot group; LootTemplate::LootGroup builds on it.
+     */
+    template<class Item>
+    class Group
+    {
+        public:
+            /**
+             * @brief Adds a row at load: explicitly chanced unless its chance is 0.
+             */
+            void AddEntry(Item const& item)
+            {
+                if (item.chance != 0)
+                {
+                    ExplicitlyChanced.push_back(item);
+                }
+                else
+                {
+                    EqualChanced.push_back(item);
+                }
+            }
+
+            /**
+             * @brief Adds the group to the current template of a flattened table.
+             */
+            void Compile(CompiledLootTable<Item>& table) const
+            {
+                table.AddGroup();
+
+                for (typename std::vector<Item>::const_iterator i = ExplicitlyChanced.begin(); i != ExplicitlyChanced.end(); ++i)
+                {
+                    table.AddGroupItem(*i, i->chance);
+                }
+
+                for (typename std::vector<Item>::const_iterator i = EqualChanced.begin(); i != EqualChanced.end(); ++i)
+                {
+                    table.AddGroupItem(*i, 0.0f);
+                }
+            }
+
+            /**
+             * @brief Rolls one item from the group, walking the explicit chances in order.
+             *
+             * @return the selected row, or NULL if every entry missed its chance
+             */
+            template<class Policy>
+            Item const* Roll(Policy& policy) const
+            {
+                if (!ExplicitlyChanced.empty())                 // First explicitly chanced entries are checked
+                {
+                    float roll = policy.RollChance();
+
+                    for (size_t i = 0; i < ExplicitlyChanced.size(); ++i)
+                    {
+                        if (ExplicitlyChanced[i].chance >= 100.0f)
+                        {
+                            return &ExplicitlyChanced[i];
+                        }
+
+                        roll -= ExplicitlyChanced[i].chance;
+                        if (roll < 0)
+                        {
+                            return &ExplicitlyChanced[i];
+                        }
+                    }
+                }
+
+                if (!EqualChanced.empty())                      // If nothing selected yet - an item is taken from equal-chanced part
+                {
+                    return &EqualChanced[policy.RollIndex(uint32(EqualChanced.size()))];
+                }
+
+                return NULL;                                    // Empty drop from the group
+            }
+
+            /**
+             * @brief Rolls the group and adds the selected item, unless it is disallowed.
+             */
+            template<class Policy>
+            void Process(Policy& policy) const
+            {
+                Item const* item = Roll(policy);
+                if (item && policy.IsAllowed(*item))
+                {
+                    policy.Add(*item);
+                }
+            }
+
+        protected:
+            std::vector<Item> ExplicitlyChanced;                // Entries with chances defined in DB
+            std::vector<Item> EqualChanced;                     // Zero chances - every entry takes the same chance
+    };
+
+    /**
+     * @brief Adds a row to a template at load: grouped items to their group, the rest to the entries.
+     */
+    template<class Item, class GroupType>
+    void AddEntry(std::vector<Item>& entries, std::vector<GroupType>& groups, Item const& item)
+    {
+        if (item.group > 0 && item.mincountOrRef > 0)           // Group
+        {
+            if (item.group >= groups.size())
+            {
+                groups.resize(item.group);                      // Adds new group the the loot template if needed
+            }
+            groups[item.group - 1].AddEntry(item);
+        }
+        else                                                    // Non-grouped entries and references are stored together
+        {
+            entries.push_back(item);
+        }
+    }
+
+    /**
+     * @brief Adds a template, its entries and groups to a flattened table.
+     *
+     * @return the index of the template in @p table
+     */
+    template<class Item, class GroupType>
+    uint32 Compile(std::vector<Item> const& entries, std::vector<GroupType> const& groups, CompiledLootTable<Item>& table, uint32 id)
+    {
+        uint32 index = table.AddTemplate(id);
+
+        for (typename std::vector<Item>::const_iterator i = entries.begin(); i != entries.end(); ++i)
+        {
+            if (i->mincountOrRef < 0)                           // References processing
+            {
+                table.AddReference(*i, uint32(-i->mincountOrRef), i->group, i->maxcount);
+            }
+            else
+            {
+                table.AddItem(*i);
+            }
+        }
+
+        for (typename std::vector<GroupType>::const_iterator i = groups.begin(); i != groups.end(); ++i)
+        {
+            i->Compile(table);
+        }
+
+        return index;
+    }
+
+    /**
+     * @brief Rolls a template sequentially and hands every produced item to the policy.
+     *
+     * @param references looks referenced templates up at every roll, with
+     *        bool Has(uint32 id) and void Process(uint32 id, Policy&, uint8 groupId)
+     * @param groupId the only group to process, 0 for the whole template
+     */
+    template<class Item, class GroupType, class Policy, class References>
+    void Process(std::vector<Item> const& entries, std::vector<GroupType> const& groups, Policy& policy, References const& references, uint8 groupId)
+    {
+        if (groupId)                                            // Group reference uses own processing of the group
+        {
+            if (groupId <= groups.size())
+            {
+                groups[groupId - 1].Process(policy);
+            }
+            return;
+        }
+
+        // Rolling non-grouped items
+        for (typename std::vector<Item>::const_iterator i = entries.begin(); i != entries.end(); ++i)
+        {
+            if (!policy.IsAllowed(*i) || !policy.Roll(*i))
+            {
+                continue;
+            }
+
+            if (i->mincountOrRef >= 0)                          // Plain entries (not a reference, not grouped)
+            {
+                policy.Add(*i);
+                continue;
+            }
+
+            uint32 const referenceId = uint32(-i->mincountOrRef);
+            if (!references.Has(referenceId) || !policy.IsReferenceAllowed(*i))
+            {
+                continue;
+            }
+
+            for (uint32 loop = 0; loop < i->maxcount; ++loop)   // Ref multiplicator
+            {
+                references.Process(referenceId, policy, i->group);
+            }
+        }
+
+        // Now processing groups
+        for (typename std::vector<GroupType>::const_iterator i = groups.begin(); i != groups.end(); ++i)
+        {
+            i->Process(policy);
+        }
+    }
+}
+
+#endif
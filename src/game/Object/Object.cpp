@@ -297,6 +297,8 @@ elunaEvents(nullptr),
  */
 WorldObject::~WorldObject()
 {
+    DetachObservers();
+
 #ifdef ENABLE_ELUNA
     delete elunaEvents;
     elunaEvents = nullptr;
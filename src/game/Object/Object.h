@@ -41,6 +41,7 @@
 #include "Camera.h"
 #include "GameTime.h"
 #include "Geometry/Placement.h"
+#include "ObserverLinks.h"
 #ifdef ENABLE_ELUNA
 #include "LuaValue.h"
 #endif /* ENABLE_ELUNA */
@@ -763,6 +764,7 @@ struct WorldObjectChangeAccumulator;
 class WorldObject : public Object
 {
     friend struct WorldObjectChangeAccumulator;
+    friend class Player;                                    // maintains m_observers alongside m_clientGUIDs
 
     public:
 
@@ -824,6 +826,7 @@ class WorldObject : public Object
         virtual void SendMessageToSet(WorldPacket* data, bool self) const;
         virtual void SendMessageToSetInRange(WorldPacket* data, float dist, bool self) const;
         void SendMessageToSetExcept(WorldPacket* data, Player const* skipped_receiver) const;
+        bool HasReadersFor(uint16 opcode, bool self) const;
 
         void MonsterSay(const char* text, uint32 language, Unit const* target = NULL) const;
         void MonsterYell(const char* text, uint32 language, Unit const* target = NULL) const;
@@ -847,6 +850,19 @@ class WorldObject : public Object
         void UpdateObjectVisibility();
         virtual void UpdateVisibilityAndView();             // update visibility for object and object for all around
 
+        /// Players on this map whose client currently holds this object -- the same
+        /// relation as their m_clientGUIDs, kept from this side so a broadcast walks a
+        /// flat list instead of the cells around the object. Maintained by Player.
+        std::vector<Player*> const& GetObservers() const { return m_observers.items; }
+
+        /// Transports never enter m_clientGUIDs, so they have no observer list and
+        /// their broadcasts still go through the grid.
+        bool HasObserverList() const;
+
+        /// Drop every observer link, from both sides. Called when the object leaves
+        /// its map, so no list ever holds a player or an object from another map.
+        void DetachObservers();
+
         // main visibility check function in normal case (ignore grey zone distance check)
         bool IsVisibleFor(Player const* u, WorldObject const* viewPoint) const { return IsVisibleForInState(u, viewPoint, false); }
 
@@ -937,6 +953,7 @@ class WorldObject : public Object
 
         Geometry::Placement m_placement;
         ViewPoint m_viewPoint;
+        ObserverLinks::Side<Player> m_observers;
         WorldUpdateCounter m_updateTracker;
         bool m_isActiveObject;
         float m_visibilityDistanceOverride;
@@ -960,6 +977,9 @@ bool InFrontPhased(WorldObject const& a, WorldObject const& b, float dist, float
 bool InBackPhased(WorldObject const& a, WorldObject const& b, float dist, float arc);
 bool HasLineOfSight(WorldObject const& a, WorldObject const& b);
 bool HasLineOfSight(WorldObject const& a, Geometry::Vector3 const& point);
+/// HasLineOfSight from a to each target at once; inSight[i] is HasLineOfSight(a, *targets[i]).
+void HasLineOfSight(WorldObject const& a, std::vector<WorldObject const*> const& targets,
+                    std::vector<uint8>& inSight);
 bool IsPlaceable(WorldObject const& obj);
 
 // Terrain and grid answers about a position. The component supplies the geometry; the
@@ -181,6 +181,11 @@ void Object::BuildCreateUpdateBlockForPlayer(UpdateData* data, Player* target) c
  */
 void Object::SendCreateUpdateToPlayer(Player* player)
 {
+    if (!player->GetSession()->WantsOpcode(SMSG_UPDATE_OBJECT))
+    {
+        return;
+    }
+
     // send create update to player
     UpdateData upd;
     WorldPacket packet;
@@ -237,6 +242,11 @@ void Object::DestroyForPlayer(Player* target) const
 {
     MANGOS_ASSERT(target);
 
+    if (!target->GetSession()->WantsOpcode(SMSG_DESTROY_OBJECT))
+    {
+        return;
+    }
+
     WorldPacket data(SMSG_DESTROY_OBJECT, 8);
     data << GetObjectGuid();
     target->GetSession()->SendPacket(&data);
@@ -501,10 +501,16 @@ bool Object::PrintEntryError(char const* descr) const
  * @param update_players Map of players to their update data
  *
  * Builds update data for the specified player, adding them
- * to the update map if not already present.
+ * to the update map if not already present. A player whose session
+ * reads no object updates (a bot) is left out of the map altogether.
  */
 void Object::BuildUpdateDataForPlayer(Player* pl, UpdateDataMapType& update_players)
 {
+    if (!pl->GetSession()->WantsOpcode(SMSG_UPDATE_OBJECT))
+    {
+        return;
+    }
+
     UpdateDataMapType::iterator iter = update_players.find(pl);
 
     if (iter == update_players.end())
@@ -0,0 +1,155 @@
+/**
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2026 MaNGOS <https://www.getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+#ifndef OBSERVERLINKS_H
+#define OBSERVERLINKS_H
+
+#include <cstddef>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief The two halves of an observer link, kept in step.
+ *
+ * A link is an entry at each end: the observer in the object's observer list, the
+ * object in the observer's observed list. Each entry also records where its twin sits
+ * in the other end's list, so either end can drop a link by swapping its last entry
+ * into the hole and telling that entry's far end where it went -- O(1), never a scan.
+ * The observer's side also keeps its links by guid, which answers "is this linked?"
+ * and "unlink this guid" without walking the list either.
+ *
+ * Every change to either side goes through here, so one side can never gain or lose
+ * an entry the other does not.
+ */
+namespace ObserverLinks
+{
+    /// No lookup by far end: the object's side, which is only ever walked or emptied.
+    template<class Far>
+    struct NoSlots
+    {
+        void Place(Far*, size_t) {}
+        void Forget(Far*) {}
+    };
+
+    /// The observer's side: the slot of each link, by the far end's guid.
+    template<class Far, class Guid>
+    struct GuidSlots
+    {
+        static constexpr size_t npos = size_t(-1);
+
+        void Place(Far* far, size_t slot) { slots[far->GetObjectGuid()] = slot; }
+        void Forget(Far* far) { slots.erase(far->GetObjectGuid()); }
+
+        size_t Find(Guid const& guid) const
+        {
+            typename std::unordered_map<Guid, size_t>::const_iterator found = slots.find(guid);
+            return found == slots.end() ? npos : found->second;
+        }
+
+        std::unordered_map<Guid, size_t> slots;
+    };
+
+    /**
+     * @brief One end's half of its links
+     *
+     * items[i] is the far end of link i, and mirrors[i] where link i sits in that far
+     * end's own Side.
+     */
+    template<class Far, class Slots = NoSlots<Far> >
+    struct Side : Slots
+    {
+        std::vector<Far*> items;
+        std::vector<size_t> mirrors;
+    };
+
+    /**
+     * @brief Remove entry `slot` from `side`, moving its last entry into the hole
+     * @param farSide The member holding the far ends' own sides, whose twin of the
+     *        moved entry is told its new position
+     */
+    template<class Far, class Slots, class NearSide>
+    void Erase(Side<Far, Slots>& side, size_t slot, NearSide Far::* farSide)
+    {
+        Far* gone = side.items[slot];
+        size_t const last = side.items.size() - 1;
+        if (slot != last)
+        {
+            side.items[slot] = side.items[last];
+            side.mirrors[slot] = side.mirrors[last];
+            side.Place(side.items[slot], slot);
+            (side.items[slot]->*farSide).mirrors[side.mirrors[slot]] = slot;
+        }
+
+        side.items.pop_back();
+        side.mirrors.pop_back();
+        side.Forget(gone);
+    }
+
+    /**
+     * @brief Link `near` to `far`. The caller knows there is no such link yet.
+     * @param nearSide The member holding each near end's side
+     * @param farSide The member holding each far end's side
+     */
+    template<class Near, class Far, class NearSlots, class FarSlots>
+    void Link(Near* near, Side<Far, NearSlots> Near::* nearSide, Far* far, Side<Near, FarSlots> Far::* farSide)
+    {
+        Side<Far, NearSlots>& mine = near->*nearSide;
+        Side<Near, FarSlots>& theirs = far->*farSide;
+
+        mine.items.push_back(far);
+        mine.mirrors.push_back(theirs.items.size());
+        mine.Place(far, mine.items.size() - 1);
+
+        theirs.items.push_back(near);
+        theirs.mirrors.push_back(mine.items.size() - 1);
+        theirs.Place(near, theirs.items.size() - 1);
+    }
+
+    /**
+     * @brief Undo the link at `slot` of `near`'s side, at both ends
+     */
+    template<class Near, class Far, class NearSlots, class FarSlots>
+    void Unlink(Near* near, Side<Far, NearSlots> Near::* nearSide, size_t slot, Side<Near, FarSlots> Far::* farSide)
+    {
+        Side<Far, NearSlots>& mine = near->*nearSide;
+        Erase(mine.items[slot]->*farSide, mine.mirrors[slot], nearSide);
+        Erase(mine, slot, farSide);
+    }
+
+    /**
+     * @brief Undo every link of `near`, at both ends
+     */
+    template<class Near, class Far, class NearSlots, class FarSlots>
+    void UnlinkAll(Near* near, Side<Far, NearSlots> Near::* nearSide, Side<Near, FarSlots> Far::* farSide)
+    {
+        Side<Far, NearSlots>& mine = near->*nearSide;
+        while (!mine.items.empty())
+        {
+            Unlink(near, nearSide, mine.items.size() - 1, farSide);
+        }
+    }
+}
+
+#endif
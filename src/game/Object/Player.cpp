@@ -700,6 +700,7 @@ Player::~Player()
 {
     // Perform cleanup before deleting the player object
     CleanupsBeforeDelete();
+    DetachObservedObjects();
 
     // Ensure the social object is unloaded (should already be done in PlayerLogout)
     // m_social = NULL;
@@ -3525,9 +3525,22 @@ class Player : public Unit
         // Get an object by type mask
         Object* GetObjectByTypeMask(ObjectGuid guid, TypeMask typemask);
 
-        // Currently visible objects at the player's client
+        // Currently visible objects at the player's client. Change it only through the
+        // *ClientObject helpers below, which keep the objects' observer lists in step.
         GuidSet m_clientGUIDs;
 
+        // Record that the client now holds / no longer holds an object
+        void AddClientObject(WorldObject* target);
+        void RemoveClientObject(WorldObject* target);
+        void RemoveClientGuid(ObjectGuid guid);
+
+        // Re-link an object the client already holds, after the player changed map
+        void LinkClientObject(WorldObject* target);
+        void ClearClientObjects();
+
+        // Drop this player from every observer list it is in, leaving m_clientGUIDs as is
+        void DetachObservedObjects();
+
         // Check if an object is visible to the client
         bool HaveAtClient(WorldObject const* u) { return u == this || m_clientGUIDs.find(u->GetObjectGuid()) != m_clientGUIDs.end(); }
 
@@ -4004,8 +4017,15 @@ class Player : public Unit
         float m_summon_z; // Summon Z coordinate
 
     private:
+        friend class WorldObject;                           // DetachObservers unlinks from m_observedObjects
+
         uint32 m_created_date = 0;
 
+        // Same-map objects whose observer list holds this player: the far side of
+        // m_clientGUIDs' links, slotted by guid so either end can be torn down in O(1)
+        typedef ObserverLinks::Side<WorldObject, ObserverLinks::GuidSlots<WorldObject, ObjectGuid> > ObservedObjects;
+        ObservedObjects m_observedObjects;
+
         /// Context struct threaded through AhUsabilityRef::Evaluate thunks so
         /// the static callbacks can reach the Player instance without a capture.
         struct AhEvalCtx { const Player* self; };
@@ -27,6 +27,7 @@
 
 #include <set>
 #include "Player.h"
+#include "ObserverLinks.h"
 #include "Language.h"
 #include "Database/DatabaseEnv.h"
 #include "Log.h"
@@ -72,6 +73,7 @@
 #include "SQLStorages.h"
 #include "DisableMgr.h"
 #include "CinematicFlyover.h"
+#include <algorithm>
 #include <cmath>
 #include "Corpse.h"
 #ifdef ENABLE_ELUNA
@@ -171,6 +173,95 @@ bool Player::IsVisibleGloballyFor(Player* u) const
     return true;
 }
 
+/**
+ * @brief Records that the client now holds an object, and links the player into
+ *        the object's observer list when both share a map.
+ *
+ * Only same-map links are kept: maps update in parallel, and an observer list must
+ * only ever be touched from its own map's thread. Objects seen across a map seam (a
+ * deck from the shore) stay in m_clientGUIDs alone and are reached by the relay.
+ *
+ * @param target The object just created at the client.
+ */
+void Player::AddClientObject(WorldObject* target)
+{
+    if (m_clientGUIDs.insert(target->GetObjectGuid()).second)
+    {
+        LinkClientObject(target);
+    }
+}
+
+/**
+ * @brief Links the player into the observer list of an object its client already holds.
+ *
+ * Map::Remove drops the links but keeps the guids, so a player arriving on a map (a
+ * teleport, a step across a deck seam) still holds objects it has no link to. The
+ * arriving map calls this for each of them; an existing link is left as it is.
+ *
+ * @param target An object in m_clientGUIDs.
+ */
+void Player::LinkClientObject(WorldObject* target)
+{
+    if (target != this && target->HasObserverList() && target->FindMap() && target->FindMap() == FindMap() &&
+        m_observedObjects.Find(target->GetObjectGuid()) == ObservedObjects::npos)
+    {
+        ObserverLinks::Link(this, &Player::m_observedObjects, target, &WorldObject::m_observers);
+    }
+}
+
+/**
+ * @brief Records that the client no longer holds an object, unlinking the observer.
+ *
+ * @param target The object just destroyed at the client.
+ */
+void Player::RemoveClientObject(WorldObject* target)
+{
+    RemoveClientGuid(target->GetObjectGuid());
+}
+
+/**
+ * @brief As RemoveClientObject, for callers that only have the guid left.
+ *
+ * A guid the client no longer holds can have no link, so only one that was held is
+ * looked up; both steps are O(1), which keeps a visibility pass that drops many
+ * objects linear in what it drops.
+ *
+ * @param guid The guid dropped from the client.
+ */
+void Player::RemoveClientGuid(ObjectGuid guid)
+{
+    if (!m_clientGUIDs.erase(guid))
+    {
+        return;
+    }
+
+    size_t const slot = m_observedObjects.Find(guid);
+    if (slot != ObservedObjects::npos)
+    {
+        ObserverLinks::Unlink(this, &Player::m_observedObjects, slot, &WorldObject::m_observers);
+    }
+}
+
+/**
+ * @brief Forgets everything the client held, e.g. after it has loaded a new map.
+ */
+void Player::ClearClientObjects()
+{
+    DetachObservedObjects();
+    m_clientGUIDs.clear();
+}
+
+/**
+ * @brief Removes this player from every observer list it is in.
+ *
+ * Called when the player leaves its map; m_clientGUIDs is left alone because the
+ * teleport path still reads it before the client reloads.
+ */
+void Player::DetachObservedObjects()
+{
+    ObserverLinks::UnlinkAll(this, &Player::m_observedObjects, &WorldObject::m_observers);
+}
+
 /**
  * @brief Performs cleanup before an object is removed from a player's visibility.
  *
@@ -208,7 +299,7 @@ void Player::UpdateVisibilityOf(WorldObject const* viewPoint, WorldObject* targe
             }
 
             target->DestroyForPlayer(this);
-            m_clientGUIDs.erase(t_guid);
+            RemoveClientObject(target);
 
             DEBUG_FILTER_LOG(LOG_FILTER_VISIBILITY_CHANGES, "UpdateVisibilityOf(2p): %s out of range for player %u. Distance = %f", t_guid.GetString().c_str(), GetGUIDLow(), Where().DistanceTo(target->Where()));
         }
@@ -220,7 +311,7 @@ void Player::UpdateVisibilityOf(WorldObject const* viewPoint, WorldObject* targe
             target->SendCreateUpdateToPlayer(this);
             if (target->GetTypeId() != TYPEID_GAMEOBJECT || !((GameObject*)target)->IsTransport())
             {
-                m_clientGUIDs.insert(target->GetObjectGuid());
+                AddClientObject(target);
             }
 
             DEBUG_FILTER_LOG(LOG_FILTER_VISIBILITY_CHANGES, "UpdateVisibilityOf(2p): %s is visible now for player %u. Distance = %f", target->GetGuidStr().c_str(), GetGUIDLow(), Where().DistanceTo(target->Where()));
@@ -247,7 +338,7 @@ void Player::UpdateVisibilityOf(WorldObject const* viewPoint, WorldObject* targe
             ObjectGuid t_guid = target->GetObjectGuid();
 
             target->BuildOutOfRangeUpdateBlock(&data);
-            m_clientGUIDs.erase(t_guid);
+            RemoveClientObject(target);
 
             DEBUG_FILTER_LOG(LOG_FILTER_VISIBILITY_CHANGES, "UpdateVisibilityOf(4p): %s is out of range for %s. Distance = %f", t_guid.GetString().c_str(), GetGuidStr().c_str(), Where().DistanceTo(target->Where()));
         }
@@ -257,17 +348,22 @@ void Player::UpdateVisibilityOf(WorldObject const* viewPoint, WorldObject* targe
         if (target->IsVisibleForInState(this, viewPoint, false))
         {
             visibleNow.insert(target);
-            target->BuildCreateUpdateBlockForPlayer(&data, this);
+            // The bookkeeping below is the server's own and a bot needs it as much as
+            // anyone; the create block is only for a client to read.
+            if (GetSession()->WantsOpcode(SMSG_UPDATE_OBJECT))
+            {
+                target->BuildCreateUpdateBlockForPlayer(&data, this);
+            }
             if (GameObject* g = target->ToGameObject())
             {
                 if (!g->IsTransport())
                 {
-                    m_clientGUIDs.insert(g->GetObjectGuid());
+                    AddClientObject(g);
                 }
             }
             else
             {
-                m_clientGUIDs.insert(target->GetObjectGuid());
+                AddClientObject(target);
             }
             DEBUG_FILTER_LOG(LOG_FILTER_VISIBILITY_CHANGES, "UpdateVisibilityOf(4p): %s is visible now for %s. Distance = %f", target->GetGuidStr().c_str(), GetGuidStr().c_str(), Where().DistanceTo(target->Where()));
         }
@@ -608,6 +608,9 @@ int32 CompareAuraRanks(uint32 spellId_1, uint32 spellId_2)
     return 0;
 }
 
+static SpellSpecific ComputeSpellSpecific(SpellEntry const* spellInfo);
+static bool ComputePositiveEffect(SpellEntry const* spellproto, SpellEffectIndex effIndex);
+
 /**
  * @brief Classifies a spell into a spell-specific category.
  *
@@ -616,12 +619,28 @@ int32 CompareAuraRanks(uint32 spellId_1, uint32 spellId_2)
  */
 SpellSpecific GetSpellSpecific(uint32 spellId)
 {
+    if (SpellClassification const* classification = sSpellMgr.GetSpellClassification(spellId))
+    {
+        return classification->specific;
+    }
+
     SpellEntry const* spellInfo = sSpellStore.LookupEntry(spellId);
     if (!spellInfo)
     {
         return SPELL_NORMAL;
     }
 
+    return ComputeSpellSpecific(spellInfo);
+}
+
+/**
+ * @brief Evaluates the spell-specific rules for a spell entry.
+ *
+ * @param spellInfo The spell entry.
+ * @return The derived spell-specific classification.
+ */
+static SpellSpecific ComputeSpellSpecific(SpellEntry const* spellInfo)
+{
     switch (spellInfo->SpellClassSet)
     {
         case SPELLFAMILY_GENERIC:
@@ -955,6 +974,23 @@ bool IsExplicitNegativeTarget(uint32 targetA)
  * @return true if the effect is positive; otherwise false.
  */
 bool IsPositiveEffect(SpellEntry const* spellproto, SpellEffectIndex effIndex)
+{
+    if (SpellClassification const* classification = sSpellMgr.GetSpellClassification(spellproto))
+    {
+        return classification->positiveEffectMask & (1 << effIndex);
+    }
+
+    return ComputePositiveEffect(spellproto, effIndex);
+}
+
+/**
+ * @brief Evaluates the positivity rules for a spell effect.
+ *
+ * @param spellproto The spell entry.
+ * @param effIndex The effect index to evaluate.
+ * @return true if the effect is positive; otherwise false.
+ */
+static bool ComputePositiveEffect(SpellEntry const* spellproto, SpellEffectIndex effIndex)
 {
     //fast returns in some special cases
     switch (spellproto->ID)
@@ -1063,7 +1099,7 @@ bool IsPositiveEffect(SpellEntry const* spellproto, SpellEffectIndex effIndex)
                                 // this will place this spell auras as debuffs
                                 if (spellTriggeredProto->Effect[i] &&
                                     IsPositiveTarget(spellTriggeredProto->ImplicitTargetA[i], spellTriggeredProto->ImplicitTargetB[i]) &&
-                                    !IsPositiveEffect(spellTriggeredProto, SpellEffectIndex(i)))
+                                    !ComputePositiveEffect(spellTriggeredProto, SpellEffectIndex(i)))
                                 {
                                     return false;
                                 }
@@ -1209,6 +1245,11 @@ bool IsPositiveEffect(SpellEntry const* spellproto, SpellEffectIndex effIndex)
  */
 bool IsPositiveSpell(uint32 spellId)
 {
+    if (SpellClassification const* classification = sSpellMgr.GetSpellClassification(spellId))
+    {
+        return classification->positive;
+    }
+
     SpellEntry const* spellproto = sSpellStore.LookupEntry(spellId);
     if (!spellproto)
     {
@@ -1226,11 +1267,16 @@ bool IsPositiveSpell(uint32 spellId)
  */
 bool IsPositiveSpell(SpellEntry const* spellproto)
 {
+    if (SpellClassification const* classification = sSpellMgr.GetSpellClassification(spellproto))
+    {
+        return classification->positive;
+    }
+
     // spells with at least one negative effect are considered negative
     // some self-applied spells have negative effects but in self casting case negative check ignored.
     for (int i = 0; i < MAX_EFFECT_INDEX; ++i)
     {
-        if (spellproto->Effect[i] && !IsPositiveEffect(spellproto, SpellEffectIndex(i)))
+        if (spellproto->Effect[i] && !ComputePositiveEffect(spellproto, SpellEffectIndex(i)))
         {
             return false;
         }
@@ -1238,6 +1284,59 @@ bool IsPositiveSpell(SpellEntry const* spellproto)
     return true;
 }
 
+/**
+ * @brief Precomputes the classification of every spell in the store.
+ *
+ * The table is built aside and swapped in, so that the rules are always
+ * evaluated against the spell data and never against a stale table.
+ * Rebuilt on `spell_elixir` reload, the only table the rules read.
+ */
+void SpellMgr::LoadSpellClassifications()
+{
+    SpellClassificationTable classifications(sSpellStore.GetNumRows());
+    uint32 count = 0;
+
+    BarGoLink bar(sSpellStore.GetNumRows());
+    for (uint32 id = 0; id < sSpellStore.GetNumRows(); ++id)
+    {
+        bar.step();
+
+        SpellClassification& classification = classifications[id];
+        classification.specific = SPELL_NORMAL;
+        classification.positiveEffectMask = 0;
+        classification.positive = false;
+
+        SpellEntry const* spellInfo = sSpellStore.LookupEntry(id);
+        if (!spellInfo)
+        {
+            continue;
+        }
+
+        classification.specific = ComputeSpellSpecific(spellInfo);
+        classification.positive = true;
+        for (int i = 0; i < MAX_EFFECT_INDEX; ++i)
+        {
+            bool positive = ComputePositiveEffect(spellInfo, SpellEffectIndex(i));
+            if (positive)
+            {
+                classification.positiveEffectMask |= (1 << i);
+            }
+
+            if (spellInfo->Effect[i] && !positive)
+            {
+                classification.positive = false;
+            }
+        }
+
+        ++count;
+    }
+
+    mSpellClassifications.swap(classifications);
+
+    sLog.outString(">> Classified %u spells", count);
+    sLog.outString();
+}
+
 /**
  * @brief Checks whether a spell is treated as single-target.
  *
@@ -1177,6 +1177,20 @@ inline bool IsProfessionOrRidingSkill(uint32 skill)
 
 typedef std::map<uint32, uint32> SpellFacingFlagMap;
 
+/**
+ * Derived spell properties, computed once from the spell store by
+ * SpellMgr::LoadSpellClassifications() so that the hot classification
+ * helpers do not re-run their rules on every call.
+ */
+struct SpellClassification
+{
+    SpellSpecific specific;                                 // GetSpellSpecific() result
+    uint8 positiveEffectMask;                               // bit i set if IsPositiveEffect() for effect i
+    bool positive;                                          // IsPositiveSpell() result
+};
+
+typedef std::vector<SpellClassification> SpellClassificationTable;
+
 class SpellMgr
 {
     friend struct DoSpellBonuses;
@@ -1207,6 +1221,27 @@ class SpellMgr
 
         SpellElixirMap const& GetSpellElixirMap() const { return mSpellElixirs; }
 
+        // Precomputed classification, NULL before LoadSpellClassifications() or for entries not from sSpellStore
+        SpellClassification const* GetSpellClassification(SpellEntry const* spellInfo) const
+        {
+            if (spellInfo->ID >= mSpellClassifications.size() || sSpellStore.LookupEntry(spellInfo->ID) != spellInfo)
+            {
+                return NULL;
+            }
+
+            return &mSpellClassifications[spellInfo->ID];
+        }
+
+        SpellClassification const* GetSpellClassification(uint32 spellId) const
+        {
+            if (spellId >= mSpellClassifications.size() || !sSpellStore.LookupEntry(spellId))
+            {
+                return NULL;
+            }
+
+            return &mSpellClassifications[spellId];
+        }
+
         uint32 GetSpellElixirMask(uint32 spellid) const
         {
             SpellElixirMap::const_iterator itr = mSpellElixirs.find(spellid);
@@ -1530,6 +1565,7 @@ class SpellMgr
         void LoadSpellPetAuras();
         void LoadSpellAreas();
         void LoadFacingCasterFlags();
+        void LoadSpellClassifications();                    // must be after LoadSpellElixirs and ModDBCSpellAttributes
 
         // Edit DBC data spells at startup
         void ModDBCSpellAttributes();
@@ -1554,6 +1590,7 @@ class SpellMgr
         SpellAreaForAuraMap  mSpellAreaForAuraMap;
         SpellAreaForAreaMap  mSpellAreaForAreaMap;
         SpellFacingFlagMap  mSpellFacingFlagMap;
+        SpellClassificationTable mSpellClassifications;
 };
 
 #define sSpellMgr SpellMgr::Instance()
@@ -6475,8 +6475,12 @@ void Unit::OnRelocated()
         m_last_notified_position.y = Where().Y();
         m_last_notified_position.z = Where().Z();
 
-        GetViewPoint().Call_UpdateVisibilityForOwner();
-        UpdateObjectVisibility();
+        // most maps coalesce these into their visibility pass, see VisibilityScheduler
+        if (!GetMap()->ScheduleVisibilityUpdate(this))
+        {
+            GetViewPoint().Call_UpdateVisibilityForOwner();
+            UpdateObjectVisibility();
+        }
     }
     ScheduleAINotify(World::GetRelocationAINotifyDelay());
 }
@@ -358,6 +358,56 @@ void WorldObject::SendMessageToSet(WorldPacket* data, bool /*bToSelf*/) const
     }
 }
 
+/**
+ * @brief Whether a SendMessageToSet of this opcode would reach anyone who reads it.
+ *
+ * Lets a caller skip building a broadcast whose whole audience is bots. Only the
+ * observer list and the object's own session are weighed; any other audience --
+ * the grid walk, either side of the deck relay -- is assumed to read it.
+ *
+ * @param opcode The opcode of the packet about to be built.
+ * @param self True if the broadcast also goes to the object's own session.
+ * @return False only when no recipient would read the packet.
+ */
+bool WorldObject::HasReadersFor(uint16 opcode, bool self) const
+{
+    if (!IsInWorld() || !HasObserverList() || GetMap()->AsTransport())
+    {
+        return true;
+    }
+
+    MapManager::TransportsByMapType::const_iterator vessels =
+        sMapMgr.m_TransportsByMap.find(GetMapId());
+    if (vessels != sMapMgr.m_TransportsByMap.end())
+    {
+        for (Transport* vessel : vessels->second)
+        {
+            TransportMap* hull = vessel->AsMap();
+            if (hull && vessel->GetMap() == GetMap() && hull->HavePlayers())
+            {
+                return true;
+            }
+        }
+    }
+
+    if (self && GetTypeId() == TYPEID_PLAYER &&
+        static_cast<Player const*>(this)->GetSession()->WantsOpcode(opcode))
+    {
+        return true;
+    }
+
+    std::vector<Player*> const& observers = GetObservers();
+    for (std::vector<Player*>::const_iterator itr = observers.begin(); itr != observers.end(); ++itr)
+    {
+        WorldSession* session = (*itr)->GetSession();
+        if (session && session->WantsOpcode(opcode))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
 /**
  * @brief Broadcasts a packet to players within a specified range.
  *
@@ -425,6 +425,50 @@ bool HasLineOfSight(WorldObject const& a, WorldObject const& b)
     return HasLineOfSight(a, b.Where().Pos());
 }
 
+void HasLineOfSight(WorldObject const& a, std::vector<WorldObject const*> const& targets,
+                    std::vector<uint8>& inSight)
+{
+    inSight.assign(targets.size(), 0);
+
+    // A hull is asked one sight line at a time, in the frame each pair has in common.
+    Map const* map = a.GetMap();
+    if (!map || map->AsTransport())
+    {
+        for (size_t i = 0; i < targets.size(); ++i)
+        {
+            inSight[i] = HasLineOfSight(a, *targets[i]) ? 1 : 0;
+        }
+        return;
+    }
+
+    std::vector<Geometry::Vector3> points;
+    std::vector<size_t> slots;
+    points.reserve(targets.size());
+    slots.reserve(targets.size());
+    for (size_t i = 0; i < targets.size(); ++i)
+    {
+        if (!CanInteract(a, *targets[i]))
+        {
+            continue;
+        }
+        Geometry::Vector3 const& p = targets[i]->Where().Pos();
+        points.push_back(Geometry::Vector3(p.x, p.y, p.z + 2.0f));
+        slots.push_back(i);
+    }
+    if (points.empty())
+    {
+        return;
+    }
+
+    std::vector<uint8> clear;
+    map->IsInLineOfSight(Geometry::Vector3(a.Where().X(), a.Where().Y(), a.Where().Z() + 2.0f),
+                         points, clear);
+    for (size_t k = 0; k < slots.size(); ++k)
+    {
+        inSight[slots[k]] = clear[k];
+    }
+}
+
 bool IsPlaceable(WorldObject const& obj)
 {
     return obj.Where().IsFinite() &&
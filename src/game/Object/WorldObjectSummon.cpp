@@ -43,6 +43,7 @@
 
 
 #include "Geometry/Placement.h"
+#include <algorithm>
 #include <cmath>
 #include "Utilities/Errors.h"
 #include "Utilities/MathDefines.h"
@@ -54,6 +55,7 @@
 #include "World.h"
 #include "Creature.h"
 #include "Player.h"
+#include "ObserverLinks.h"
 #include "ObjectMgr.h"
 #include "ObjectGuid.h"
 #include "UpdateData.h"
@@ -622,6 +624,28 @@ void WorldObject::UpdateObjectVisibility()
     GetMap()->UpdateObjectVisibility(this, cell, p);
 }
 
+/**
+ * @brief Tells whether this object keeps a list of the players holding it.
+ *
+ * @return false for transports, which never enter m_clientGUIDs.
+ */
+bool WorldObject::HasObserverList() const
+{
+    GameObject const* go = GetTypeId() == TYPEID_GAMEOBJECT ? static_cast<GameObject const*>(this) : NULL;
+    return !go || !go->IsTransport();
+}
+
+/**
+ * @brief Unlinks this object from every player observing it.
+ *
+ * The players keep the guid in m_clientGUIDs, so the next visibility pass still sends
+ * them the out-of-range; only the pointer links go, which must never outlive a map.
+ */
+void WorldObject::DetachObservers()
+{
+    ObserverLinks::UnlinkAll(this, &WorldObject::m_observers, &Player::m_observedObjects);
+}
+
 /**
  * @brief Adds the world object to the map's update queue.
  */
@@ -0,0 +1,345 @@
+/**
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2026 MaNGOS <https://www.getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+#include "OpcodeProfiler.h"
+#include "Opcodes.h"
+
+#include <algorithm>
+
+namespace
+{
+    std::atomic<uint64> s_nextProfilerId(1);
+
+    // The block this thread writes to, handed back for reuse when the thread ends.
+    struct ThreadBlockCache
+    {
+        ThreadBlockCache() : profilerId(0), counters(NULL) {}
+        ~ThreadBlockCache() { Release(); }
+
+        void Release()
+        {
+            if (block)
+            {
+                block->store(false, std::memory_order_release);
+                block.reset();
+            }
+            profilerId = 0;
+            counters = NULL;
+        }
+
+        uint64 profilerId;
+        void* counters;                                     // OpcodeProfiler::Counters of the block
+        std::shared_ptr<std::atomic<bool> > block;          // aliases the block's inUse flag
+    };
+
+    thread_local ThreadBlockCache t_blockCache;
+    thread_local OpcodeProfiler::Scope* t_currentScope = NULL;
+
+    /// Counters have a single writer, so no read-modify-write is needed.
+    template<class T>
+    void Add(std::atomic<T>& counter, T value)
+    {
+        counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+    }
+
+    uint32 BucketOf(uint64 micros)
+    {
+        uint32 bucket = 0;
+        while (micros && bucket < OpcodeProfiler::BucketCount - 1)
+        {
+            micros >>= 1;
+            ++bucket;
+        }
+        return bucket;
+    }
+}
+
+OpcodeProfiler::OpcodeProfiler() : m_opcodeCount(NUM_MSG_TYPES), m_id(s_nextProfilerId++)
+{
+}
+
+OpcodeProfiler::OpcodeProfiler(uint32 opcodeCount) : m_opcodeCount(opcodeCount), m_id(s_nextProfilerId++)
+{
+}
+
+OpcodeProfiler::~OpcodeProfiler()
+{
+    if (t_blockCache.profilerId == m_id)
+    {
+        t_blockCache.Release();
+    }
+}
+
+/**
+ * @brief Gets this thread's counters of an opcode, claiming a block on first use.
+ *
+ * @param opcode The opcode.
+ * @return The counters only this thread writes.
+ */
+OpcodeProfiler::Counters& OpcodeProfiler::ThreadCounters(uint16 opcode)
+{
+    if (t_blockCache.profilerId != m_id)
+    {
+        t_blockCache.Release();
+
+        std::shared_ptr<Block> block;
+        {
+            std::lock_guard<std::mutex> guard(m_blockLock);
+            for (size_t i = 0; i < m_blocks.size() && !block; ++i)
+            {
+                bool idle = false;
+                if (m_blocks[i]->inUse.compare_exchange_strong(idle, true, std::memory_order_acquire))
+                {
+                    block = m_blocks[i];
+                }
+            }
+            if (!block)
+            {
+                block = std::make_shared<Block>(m_opcodeCount);
+                m_blocks.push_back(block);
+            }
+        }
+
+        t_blockCache.profilerId = m_id;
+        t_blockCache.counters = block->counters.get();
+        t_blockCache.block = std::shared_ptr<std::atomic<bool> >(block, &block->inUse);
+    }
+
+    return static_cast<Counters*>(t_blockCache.counters)[opcode];
+}
+
+/**
+ * @brief Records one handler call.
+ *
+ * @param opcode The handled opcode.
+ * @param micros The time the handler took.
+ * @param bytesIn The size of the handled packet.
+ */
+void OpcodeProfiler::Record(uint16 opcode, uint64 micros, size_t bytesIn)
+{
+    if (opcode >= m_opcodeCount)
+    {
+        return;
+    }
+
+    Counters& counters = ThreadCounters(opcode);
+    Add(counters.calls, uint64(1));
+    Add(counters.totalMicros, micros);
+    Add(counters.bytesIn, uint64(bytesIn));
+    Add(counters.buckets[BucketOf(micros)], uint32(1));
+    if (micros > counters.maxMicros.load(std::memory_order_relaxed))
+    {
+        counters.maxMicros.store(micros, std::memory_order_relaxed);
+    }
+}
+
+/**
+ * @brief Counts a sent packet against the innermost handler of its session on this thread.
+ *
+ * A handler that sends to other sessions -- chat, group and guild updates -- is not
+ * charged for it, and a handler of another session running inside it is skipped.
+ *
+ * @param session The session the packet is sent to.
+ * @param bytes The size of the sent packet.
+ */
+void OpcodeProfiler::NoteSent(WorldSession const* session, size_t bytes)
+{
+    for (Scope* scope = t_currentScope; scope; scope = scope->m_outer)
+    {
+        if (scope->m_session != session)
+        {
+            continue;
+        }
+
+        if (scope->m_opcode < scope->m_profiler.m_opcodeCount)
+        {
+            Add(scope->m_profiler.ThreadCounters(scope->m_opcode).bytesOut, uint64(bytes));
+        }
+        return;
+    }
+}
+
+OpcodeProfiler::Scope::Scope(OpcodeProfiler& profiler, WorldSession const* session, uint16 opcode, size_t bytesIn)
+    : m_profiler(profiler), m_session(session), m_opcode(opcode), m_bytesIn(bytesIn), m_start(std::chrono::steady_clock::now()), m_outer(t_currentScope)
+{
+    t_currentScope = this;
+}
+
+OpcodeProfiler::Scope::~Scope()
+{
+    t_currentScope = m_outer;
+    uint64 micros = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - m_start).count();
+    m_profiler.Record(m_opcode, micros, m_bytesIn);
+}
+
+/**
+ * @brief Sums the counters of every thread.
+ *
+ * @return One entry per opcode.
+ */
+std::vector<OpcodeProfiler::Sums> OpcodeProfiler::Sum() const
+{
+    std::vector<Sums> sums(m_opcodeCount, Sums());
+
+    std::lock_guard<std::mutex> guard(m_blockLock);
+    for (size_t b = 0; b < m_blocks.size(); ++b)
+    {
+        Counters const* counters = m_blocks[b]->counters.get();
+        for (uint32 op = 0; op < m_opcodeCount; ++op)
+        {
+            Counters const& c = counters[op];
+            Sums& s = sums[op];
+            uint64 calls = c.calls.load(std::memory_order_relaxed);
+            if (!calls)
+            {
+                continue;
+            }
+            s.calls += calls;
+            s.totalMicros += c.totalMicros.load(std::memory_order_relaxed);
+            s.maxMicros = std::max(s.maxMicros, c.maxMicros.load(std::memory_order_relaxed));
+            s.bytesIn += c.bytesIn.load(std::memory_order_relaxed);
+            s.bytesOut += c.bytesOut.load(std::memory_order_relaxed);
+            for (uint32 i = 0; i < BucketCount; ++i)
+            {
+                s.buckets[i] += c.buckets[i].load(std::memory_order_relaxed);
+            }
+        }
+    }
+    return sums;
+}
+
+/**
+ * @brief Gets the upper bound of a histogram bucket.
+ *
+ * @param bucket The bucket index.
+ * @return The largest duration, in microseconds, the bucket holds.
+ */
+uint64 OpcodeProfiler::BucketUpperMicros(uint32 bucket)
+{
+    return bucket ? (uint64(1) << bucket) - 1 : 0;
+}
+
+OpcodeProfile OpcodeProfiler::MakeProfile(uint16 opcode, Sums const& sums)
+{
+    OpcodeProfile profile;
+    profile.opcode = opcode;
+    profile.calls = sums.calls;
+    profile.totalMicros = sums.totalMicros;
+    profile.maxMicros = sums.maxMicros;
+    profile.bytesIn = sums.bytesIn;
+    profile.bytesOut = sums.bytesOut;
+
+    // the counters are read one by one while handlers run, so the buckets may
+    // hold a call or two more than calls; rank against what they hold
+    uint64 counted = 0;
+    for (uint32 i = 0; i < BucketCount; ++i)
+    {
+        counted += sums.buckets[i];
+    }
+
+    profile.p99Micros = 0;
+    uint64 rank = (counted * 99 + 99) / 100;                // ceil(0.99 * counted)
+    uint64 seen = 0;
+    for (uint32 i = 0; i < BucketCount && counted; ++i)
+    {
+        seen += sums.buckets[i];
+        if (seen >= rank)
+        {
+            profile.p99Micros = std::min(BucketUpperMicros(i), sums.maxMicros);
+            break;
+        }
+    }
+    return profile;
+}
+
+void OpcodeProfiler::SortByTotal(std::vector<OpcodeProfile>& profiles)
+{
+    std::sort(profiles.begin(), profiles.end(), [](OpcodeProfile const& a, OpcodeProfile const& b)
+    {
+        return a.totalMicros != b.totalMicros ? a.totalMicros > b.totalMicros : a.opcode < b.opcode;
+    });
+}
+
+/**
+ * @brief Gets the opcodes handled since start.
+ *
+ * @return The opcodes with at least one call, most total time first.
+ */
+std::vector<OpcodeProfile> OpcodeProfiler::GetTotals() const
+{
+    std::vector<Sums> sums = Sum();
+
+    std::vector<OpcodeProfile> profiles;
+    for (uint32 op = 0; op < m_opcodeCount; ++op)
+    {
+        if (sums[op].calls)
+        {
+            profiles.push_back(MakeProfile(uint16(op), sums[op]));
+        }
+    }
+    SortByTotal(profiles);
+    return profiles;
+}
+
+/**
+ * @brief Gets the opcodes handled since the previous call.
+ *
+ * @return The opcodes with at least one call in the interval, most total time first.
+ */
+std::vector<OpcodeProfile> OpcodeProfiler::TakeInterval()
+{
+    std::vector<Sums> sums = Sum();
+
+    std::lock_guard<std::mutex> guard(m_intervalLock);
+    if (m_intervalBase.empty())
+    {
+        m_intervalBase.assign(m_opcodeCount, Sums());
+    }
+
+    std::vector<OpcodeProfile> profiles;
+    for (uint32 op = 0; op < m_opcodeCount; ++op)
+    {
+        Sums const& base = m_intervalBase[op];
+        if (sums[op].calls <= base.calls)
+        {
+            continue;
+        }
+
+        Sums delta = sums[op];
+        delta.calls -= base.calls;
+        delta.totalMicros -= base.totalMicros;
+        delta.bytesIn -= base.bytesIn;
+        delta.bytesOut -= base.bytesOut;
+        for (uint32 i = 0; i < BucketCount; ++i)
+        {
+            delta.buckets[i] -= std::min(delta.buckets[i], base.buckets[i]);
+        }
+        profiles.push_back(MakeProfile(uint16(op), delta));
+    }
+    m_intervalBase.swap(sums);
+
+    SortByTotal(profiles);
+    return profiles;
+}
@@ -0,0 +1,157 @@
+/**
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2026 MaNGOS <https://www.getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+#ifndef MANGOS_H_OPCODEPROFILER
+#define MANGOS_H_OPCODEPROFILER
+
+#include "Platform/Define.h"
+#include "Policies/Singleton.h"
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+class WorldSession;
+
+// Time spent in each client opcode handler, always on.
+//
+// Every thread that runs handlers -- world thread, map threads, session workers -- gets
+// its own block of per-opcode counters on first use and is the only writer of it, so a
+// handler call costs two clock reads and a handful of uncontended relaxed stores. Readers
+// sum the blocks of all threads. A block outlives its thread and is handed to the next
+// thread that asks, so short-lived threads neither lose their counts nor leak memory.
+//
+// Durations also go into a log2 histogram (bucket b holds [2^(b-1), 2^b) microseconds),
+// from which the 99th percentile is read as the upper bound of its bucket.
+//
+// Bytes out are the packets a session sends while one of its own handlers runs on this
+// thread, see Scope and NoteSent(); what a handler sends to other sessions is not its.
+
+struct OpcodeProfile
+{
+    uint16 opcode;
+    uint64 calls;
+    uint64 totalMicros;
+    uint64 maxMicros;                                       // since start, also in interval reports
+    uint64 p99Micros;
+    uint64 bytesIn;
+    uint64 bytesOut;
+};
+
+class OpcodeProfiler
+{
+    public:
+        static const uint32 BucketCount = 24;               // last bucket: 2^22 us (4 s) and up
+
+        OpcodeProfiler();                                   // every client opcode
+        explicit OpcodeProfiler(uint32 opcodeCount);
+        ~OpcodeProfiler();
+
+        // Times one handler call and attributes the packets its session sends meanwhile to it.
+        class Scope
+        {
+            public:
+                Scope(OpcodeProfiler& profiler, WorldSession const* session, uint16 opcode, size_t bytesIn);
+                ~Scope();
+
+            private:
+                friend class OpcodeProfiler;
+
+                Scope(Scope const&);
+                Scope& operator=(Scope const&);
+
+                OpcodeProfiler& m_profiler;
+                WorldSession const* m_session;
+                uint16 m_opcode;
+                size_t m_bytesIn;
+                std::chrono::steady_clock::time_point m_start;
+                Scope* m_outer;                             // a handler that runs another one
+        };
+
+        void Record(uint16 opcode, uint64 micros, size_t bytesIn);
+        // Counts a packet sent to a session against that session's innermost handler
+        // running on this thread, if any.
+        static void NoteSent(WorldSession const* session, size_t bytes);
+
+        // Opcodes seen since start, most total time first.
+        std::vector<OpcodeProfile> GetTotals() const;
+        // Opcodes seen since the previous call, most total time first.
+        std::vector<OpcodeProfile> TakeInterval();
+
+        static uint64 BucketUpperMicros(uint32 bucket);
+
+    private:
+        OpcodeProfiler(OpcodeProfiler const&);
+        OpcodeProfiler& operator=(OpcodeProfiler const&);
+
+        struct Counters
+        {
+            std::atomic<uint64> calls;
+            std::atomic<uint64> totalMicros;
+            std::atomic<uint64> maxMicros;
+            std::atomic<uint64> bytesIn;
+            std::atomic<uint64> bytesOut;
+            std::atomic<uint32> buckets[BucketCount];
+        };
+
+        struct Block
+        {
+            explicit Block(uint32 opcodeCount) : counters(new Counters[opcodeCount]()), inUse(true) {}
+
+            std::unique_ptr<Counters[]> counters;
+            std::atomic<bool> inUse;                        // released by its thread at exit
+        };
+
+        /// Plain sums of the blocks, for one opcode.
+        struct Sums
+        {
+            uint64 calls;
+            uint64 totalMicros;
+            uint64 maxMicros;
+            uint64 bytesIn;
+            uint64 bytesOut;
+            uint64 buckets[BucketCount];
+        };
+
+        Counters& ThreadCounters(uint16 opcode);
+        std::vector<Sums> Sum() const;
+        static OpcodeProfile MakeProfile(uint16 opcode, Sums const& sums);
+        static void SortByTotal(std::vector<OpcodeProfile>& profiles);
+
+        uint32 m_opcodeCount;
+        uint64 m_id;                                        // tells thread caches of different profilers apart
+
+        mutable std::mutex m_blockLock;                     // taken once per thread, and by readers
+        std::vector<std::shared_ptr<Block> > m_blocks;
+
+        std::mutex m_intervalLock;
+        std::vector<Sums> m_intervalBase;
+};
+
+#define sOpcodeProfiler MaNGOS::Singleton<OpcodeProfiler>::Instance()
+
+#endif
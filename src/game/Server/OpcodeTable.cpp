@@ -34,6 +34,9 @@
  * Opcode processing modes:
  * - PROCESS_INPLACE: Process immediately in network thread
  * - PROCESS_THREADUNSAFE: Process in world update thread
+ * - PROCESS_THREADSAFE: Process in the map update of the player's map
+ * - PROCESS_SESSIONSAFE: Handler reads nothing but its own session and data that is
+ *   only written at load, so session workers may run it for many sessions at once
  *
  * Session status requirements:
  * - STATUS_NEVER: Never process (deprecated/debug opcodes)
@@ -170,15 +173,15 @@ void InitializeOpcodes()
     OPCODE(SMSG_PET_NAME_QUERY_RESPONSE,                   STATUS_NEVER,    PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
     OPCODE(CMSG_GUILD_QUERY,                               STATUS_AUTHED,   PROCESS_THREADUNSAFE, &WorldSession::HandleGuildQueryOpcode);
     OPCODE(SMSG_GUILD_QUERY_RESPONSE,                      STATUS_NEVER,    PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
-    OPCODE(CMSG_ITEM_QUERY_SINGLE,                         STATUS_LOGGEDIN, PROCESS_INPLACE,      &WorldSession::HandleItemQuerySingleOpcode);
+    OPCODE(CMSG_ITEM_QUERY_SINGLE,                         STATUS_LOGGEDIN, PROCESS_SESSIONSAFE,  &WorldSession::HandleItemQuerySingleOpcode);
     OPCODE(CMSG_ITEM_QUERY_MULTIPLE,                       STATUS_NEVER,    PROCESS_INPLACE,      &WorldSession::Handle_NULL);
     OPCODE(SMSG_ITEM_QUERY_SINGLE_RESPONSE,                STATUS_NEVER,    PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
     OPCODE(SMSG_ITEM_QUERY_MULTIPLE_RESPONSE,              STATUS_NEVER,    PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
-    OPCODE(CMSG_PAGE_TEXT_QUERY,                           STATUS_LOGGEDIN, PROCESS_THREADUNSAFE, &WorldSession::HandlePageTextQueryOpcode);
+    OPCODE(CMSG_PAGE_TEXT_QUERY,                           STATUS_LOGGEDIN, PROCESS_SESSIONSAFE,  &WorldSession::HandlePageTextQueryOpcode);
     OPCODE(SMSG_PAGE_TEXT_QUERY_RESPONSE,                  STATUS_NEVER,    PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
     OPCODE(CMSG_QUEST_QUERY,                               STATUS_LOGGEDIN, PROCESS_THREADUNSAFE, &WorldSession::HandleQuestQueryOpcode);
     OPCODE(SMSG_QUEST_QUERY_RESPONSE,                      STATUS_NEVER,    PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
-    OPCODE(CMSG_GAMEOBJECT_QUERY,                          STATUS_LOGGEDIN, PROCESS_INPLACE,      &WorldSession::HandleGameObjectQueryOpcode);
+    OPCODE(CMSG_GAMEOBJECT_QUERY,                          STATUS_LOGGEDIN, PROCESS_SESSIONSAFE,  &WorldSession::HandleGameObjectQueryOpcode);
     OPCODE(SMSG_GAMEOBJECT_QUERY_RESPONSE,                 STATUS_NEVER,    PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
     OPCODE(CMSG_CREATURE_QUERY,                            STATUS_LOGGEDIN, PROCESS_INPLACE,      &WorldSession::HandleCreatureQueryOpcode);
     OPCODE(SMSG_CREATURE_QUERY_RESPONSE,                   STATUS_NEVER,    PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
@@ -546,7 +549,7 @@ void InitializeOpcodes()
     OPCODE(SMSG_NOTIFICATION,                              STATUS_NEVER,    PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
     OPCODE(CMSG_PLAYED_TIME,                               STATUS_LOGGEDIN, PROCESS_THREADSAFE,   &WorldSession::HandlePlayedTime);
     OPCODE(SMSG_PLAYED_TIME,                               STATUS_NEVER,    PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
-    OPCODE(CMSG_QUERY_TIME,                                STATUS_LOGGEDIN, PROCESS_THREADSAFE,   &WorldSession::HandleQueryTimeOpcode);
+    OPCODE(CMSG_QUERY_TIME,                                STATUS_LOGGEDIN, PROCESS_SESSIONSAFE,  &WorldSession::HandleQueryTimeOpcode);
     OPCODE(SMSG_QUERY_TIME_RESPONSE,                       STATUS_NEVER,    PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
     OPCODE(SMSG_LOG_XPGAIN,                                STATUS_NEVER,    PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
     OPCODE(SMSG_AURACASTLOG,                               STATUS_NEVER,    PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
@@ -560,7 +563,7 @@ void InitializeOpcodes()
     OPCODE(SMSG_START_MIRROR_TIMER,                        STATUS_NEVER,    PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
     OPCODE(SMSG_PAUSE_MIRROR_TIMER,                        STATUS_NEVER,    PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
     OPCODE(SMSG_STOP_MIRROR_TIMER,                         STATUS_NEVER,    PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
-    OPCODE(CMSG_PING,                                      STATUS_AUTHED,   PROCESS_THREADUNSAFE, &WorldSession::HandlePingOpcode);
+    OPCODE(CMSG_PING,                                      STATUS_AUTHED,   PROCESS_SESSIONSAFE,  &WorldSession::HandlePingOpcode);
     OPCODE(SMSG_PONG,                                      STATUS_NEVER,    PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
     OPCODE(SMSG_CLEAR_COOLDOWN,                            STATUS_NEVER,    PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
     OPCODE(SMSG_GAMEOBJECT_PAGETEXT,                       STATUS_NEVER,    PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
@@ -790,7 +793,7 @@ void InitializeOpcodes()
     OPCODE(MSG_PETITION_RENAME,                            STATUS_LOGGEDIN, PROCESS_THREADUNSAFE, &WorldSession::HandlePetitionRenameOpcode);
     OPCODE(SMSG_INIT_WORLD_STATES,                         STATUS_NEVER,    PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
     OPCODE(SMSG_UPDATE_WORLD_STATE,                        STATUS_NEVER,    PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
-    OPCODE(CMSG_ITEM_NAME_QUERY,                           STATUS_LOGGEDIN, PROCESS_THREADUNSAFE, &WorldSession::HandleItemNameQueryOpcode);
+    OPCODE(CMSG_ITEM_NAME_QUERY,                           STATUS_LOGGEDIN, PROCESS_SESSIONSAFE,  &WorldSession::HandleItemNameQueryOpcode);
     OPCODE(SMSG_ITEM_NAME_QUERY_RESPONSE,                  STATUS_NEVER,    PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
     OPCODE(SMSG_PET_ACTION_FEEDBACK,                       STATUS_NEVER,    PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
     OPCODE(CMSG_CHAR_RENAME,                               STATUS_AUTHED,   PROCESS_THREADUNSAFE, &WorldSession::HandleCharRenameOpcode);
@@ -963,7 +966,7 @@ void InitializeOpcodes()
     OPCODE(SMSG_SPELL_CHANCE_RESIST_PUSHBACK,              STATUS_NEVER,    PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);      /// 0x403: @TODO need to check usage in vanilla WoW
     OPCODE(CMSG_IGNORE_DIMINISHING_RETURNS_CHEAT,          STATUS_NEVER,    PROCESS_INPLACE,      &WorldSession::Handle_NULL);     /// 0x404: @TODO need to check usage in vanilla WoW
     OPCODE(SMSG_IGNORE_DIMINISHING_RETURNS_CHEAT,          STATUS_NEVER,    PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);       /// 0x405: @TODO need to check usage in vanilla WoW
-    OPCODE(CMSG_KEEP_ALIVE,                                STATUS_AUTHED,   PROCESS_THREADUNSAFE, &WorldSession::HandleKeepAliveOpcode);       /// 0x406: @TODO need to check usage in vanilla WoW
+    OPCODE(CMSG_KEEP_ALIVE,                                STATUS_AUTHED,   PROCESS_SESSIONSAFE,  &WorldSession::HandleKeepAliveOpcode);       /// 0x406: @TODO need to check usage in vanilla WoW
     OPCODE(SMSG_RAID_READY_CHECK_ERROR,                    STATUS_NEVER,    PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);       /// 0x407: @TODO need to check usage in vanilla WoW
     OPCODE(CMSG_OPT_OUT_OF_LOOT,                           STATUS_AUTHED,   PROCESS_THREADUNSAFE, &WorldSession::HandleOptOutOfLootOpcode);        /// 0x408: @TODO need to check usage in vanilla WoW
     OPCODE(CMSG_SET_GRANTABLE_LEVELS,                      STATUS_NEVER,    PROCESS_INPLACE,      &WorldSession::Handle_NULL);     /// 0x40B: @TODO need to check usage in vanilla WoW
@@ -45,7 +45,8 @@ enum PacketProcessing
 {
     PROCESS_INPLACE = 0,
     PROCESS_THREADUNSAFE,
-    PROCESS_THREADSAFE
+    PROCESS_THREADSAFE,
+    PROCESS_SESSIONSAFE                                     // touches only its own session and load-time data, see SessionWorkerFilter
 };
 
 struct OpcodeHandler
@@ -0,0 +1,278 @@
+/**
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2026 MaNGOS <https://www.getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+#include "PacketCapture.h"
+
+#include <algorithm>
+
+PacketCaptureWriter sPacketCapture;
+
+namespace
+{
+    uint32 const CaptureMagic = 0x5041434D;                 // "MCAP"
+    uint32 const CaptureVersion = 1;
+
+    // Far above anything a client may send; past it the stream is not a capture.
+    uint32 const MaxCapturedPacketSize = 0x100000;
+    uint32 const MaxStringLength = 256;
+}
+
+PacketCaptureWriter::PacketCaptureWriter() : m_open(false), m_file(NULL), m_ticks(0), m_packets(0)
+{
+}
+
+PacketCaptureWriter::~PacketCaptureWriter()
+{
+    Close();
+}
+
+bool PacketCaptureWriter::Open(std::string const& path, uint32 seed)
+{
+    std::lock_guard<std::mutex> guard(m_lock);
+    if (m_file)
+    {
+        return false;
+    }
+
+    m_file = fopen(path.c_str(), "wb");
+    if (!m_file)
+    {
+        return false;
+    }
+
+    // Ticks come every 50 ms whatever happens; a large buffer keeps them to one
+    // write every few seconds on a quiet realm.
+    setvbuf(m_file, NULL, _IOFBF, 1 << 20);
+
+    m_ticks = 0;
+    m_packets = 0;
+    PutUInt32(CaptureMagic);
+    PutUInt32(CaptureVersion);
+    PutUInt32(seed);
+    m_open.store(true, std::memory_order_relaxed);
+    return true;
+}
+
+void PacketCaptureWriter::Close()
+{
+    std::lock_guard<std::mutex> guard(m_lock);
+    m_open.store(false, std::memory_order_relaxed);
+    if (m_file)
+    {
+        fclose(m_file);
+        m_file = NULL;
+    }
+}
+
+void PacketCaptureWriter::Put(uint8 const* data, size_t len)
+{
+    if (m_file && len)
+    {
+        fwrite(data, 1, len, m_file);
+    }
+}
+
+void PacketCaptureWriter::PutUInt32(uint32 value)
+{
+    uint8 const bytes[4] = { uint8(value), uint8(value >> 8), uint8(value >> 16), uint8(value >> 24) };
+    Put(bytes, sizeof(bytes));
+}
+
+void PacketCaptureWriter::PutRecordHead(CaptureRecordType type, uint32 session)
+{
+    uint8 const tag = uint8(type);
+    Put(&tag, 1);
+    PutUInt32(session);
+}
+
+void PacketCaptureWriter::PutString(std::string const& value)
+{
+    uint32 const length = uint32(std::min<size_t>(value.size(), MaxStringLength));
+    PutUInt32(length);
+    Put(reinterpret_cast<uint8 const*>(value.data()), length);
+}
+
+void PacketCaptureWriter::WriteTick(uint32 diff)
+{
+    std::lock_guard<std::mutex> guard(m_lock);
+    if (!m_file)
+    {
+        return;
+    }
+    PutRecordHead(CAPTURE_TICK, 0);
+    PutUInt32(diff);
+    ++m_ticks;
+}
+
+void PacketCaptureWriter::WriteAttach(uint32 session, uint32 build, std::string const& account, std::string const& address)
+{
+    std::lock_guard<std::mutex> guard(m_lock);
+    if (!m_file)
+    {
+        return;
+    }
+    PutRecordHead(CAPTURE_ATTACH, session);
+    PutUInt32(build);
+    PutString(account);
+    PutString(address);
+}
+
+void PacketCaptureWriter::WritePacket(uint32 session, WorldPacket const& packet)
+{
+    std::lock_guard<std::mutex> guard(m_lock);
+    if (!m_file)
+    {
+        return;
+    }
+    PutRecordHead(CAPTURE_PACKET, session);
+    PutUInt32(packet.GetOpcode());
+    PutUInt32(uint32(packet.size()));
+    if (!packet.empty())
+    {
+        Put(packet.contents(), packet.size());
+    }
+    ++m_packets;
+}
+
+void PacketCaptureWriter::WriteDetach(uint32 session)
+{
+    std::lock_guard<std::mutex> guard(m_lock);
+    if (!m_file)
+    {
+        return;
+    }
+    PutRecordHead(CAPTURE_DETACH, session);
+}
+
+PacketCaptureReader::PacketCaptureReader() : m_file(NULL), m_seed(0), m_truncated(false)
+{
+}
+
+PacketCaptureReader::~PacketCaptureReader()
+{
+    if (m_file)
+    {
+        fclose(m_file);
+    }
+}
+
+bool PacketCaptureReader::Open(std::string const& path)
+{
+    m_file = fopen(path.c_str(), "rb");
+    if (!m_file)
+    {
+        return false;
+    }
+
+    uint32 magic = 0;
+    uint32 version = 0;
+    return GetUInt32(magic) && magic == CaptureMagic &&
+           GetUInt32(version) && version == CaptureVersion &&
+           GetUInt32(m_seed);
+}
+
+bool PacketCaptureReader::Get(uint8* data, size_t len)
+{
+    return !len || (m_file && fread(data, 1, len, m_file) == len);
+}
+
+bool PacketCaptureReader::GetUInt32(uint32& value)
+{
+    uint8 bytes[4];
+    if (!Get(bytes, sizeof(bytes)))
+    {
+        return false;
+    }
+    value = uint32(bytes[0]) | (uint32(bytes[1]) << 8) | (uint32(bytes[2]) << 16) | (uint32(bytes[3]) << 24);
+    return true;
+}
+
+bool PacketCaptureReader::GetString(std::string& value)
+{
+    uint32 length;
+    if (!GetUInt32(length) || length > MaxStringLength)
+    {
+        return false;
+    }
+    value.resize(length);
+    return !length || Get(reinterpret_cast<uint8*>(&value[0]), length);
+}
+
+bool PacketCaptureReader::Next(CaptureRecord& record)
+{
+    uint8 tag;
+    if (!m_file || fread(&tag, 1, 1, m_file) != 1)
+    {
+        return false;                                       // a clean end
+    }
+
+    m_truncated = true;                                     // until the record is whole
+    if (!GetUInt32(record.session))
+    {
+        return false;
+    }
+
+    record.type = CaptureRecordType(tag);
+    switch (record.type)
+    {
+        case CAPTURE_TICK:
+            if (!GetUInt32(record.diff))
+            {
+                return false;
+            }
+            break;
+        case CAPTURE_ATTACH:
+            if (!GetUInt32(record.build) || !GetString(record.account) || !GetString(record.address))
+            {
+                return false;
+            }
+            break;
+        case CAPTURE_PACKET:
+        {
+            uint32 opcode, size;
+            if (!GetUInt32(opcode) || !GetUInt32(size) || size > MaxCapturedPacketSize)
+            {
+                return false;
+            }
+            record.packet.Initialize(uint16(opcode), size);
+            if (size)
+            {
+                record.packet.resize(size);
+                if (!Get(const_cast<uint8*>(record.packet.contents()), size))
+                {
+                    return false;
+                }
+            }
+            break;
+        }
+        case CAPTURE_DETACH:
+            break;
+        default:
+            return false;
+    }
+
+    m_truncated = false;
+    return true;
+}
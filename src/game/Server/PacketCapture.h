@@ -0,0 +1,142 @@
+/**
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2026 MaNGOS <https://www.getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+#ifndef MANGOS_H_PACKETCAPTURE
+#define MANGOS_H_PACKETCAPTURE
+
+#include "Platform/Define.h"
+#include "WorldPacket.h"
+
+#include <atomic>
+#include <cstdio>
+#include <mutex>
+#include <string>
+
+// What clients asked of a world, tick by tick, so that `mangosd --replay` can ask it
+// again of the same world loaded from the same database snapshot.
+//
+// A capture is one binary stream: a header (magic, version, the seed every thread's
+// RNG was given as the capture began) and then records back to back, little-endian,
+// each led by its type and session id:
+//
+//   Tick   - the world thread starts an update of `diff` ms
+//   Attach - a session was admitted: its client build, account name and address
+//   Packet - a packet was routed to a session
+//   Detach - a session's connection went away
+//
+// Records go down in the order the gateway and the world thread reached the writer.
+// A tick record is written as its update starts, so a packet lands after the tick that
+// was running when it arrived and replay hands it over before the next update runs.
+// Live, that running tick may already have read it; where in the tick it arrived is
+// not recorded, so replay can see such a packet one tick later than the server did.
+
+enum CaptureRecordType
+{
+    CAPTURE_TICK        = 1,
+    CAPTURE_ATTACH      = 2,
+    CAPTURE_PACKET      = 3,
+    CAPTURE_DETACH      = 4
+};
+
+struct CaptureRecord
+{
+    CaptureRecordType type;
+    uint32 session;                                         // 0 for ticks
+    uint32 diff;                                            // ticks
+    uint32 build;                                           // attaches
+    std::string account;                                    // attaches
+    std::string address;                                    // attaches
+    WorldPacket packet;                                     // packets
+};
+
+// Thread-safe: the network threads write attaches, packets and detaches while the
+// world thread writes ticks. IsOpen() is a relaxed load, so the hooks cost nothing
+// on a server that is not capturing.
+class PacketCaptureWriter
+{
+    public:
+        PacketCaptureWriter();
+        ~PacketCaptureWriter();
+
+        bool Open(std::string const& path, uint32 seed);
+        void Close();
+        bool IsOpen() const { return m_open.load(std::memory_order_relaxed); }
+
+        void WriteTick(uint32 diff);
+        void WriteAttach(uint32 session, uint32 build, std::string const& account, std::string const& address);
+        void WritePacket(uint32 session, WorldPacket const& packet);
+        void WriteDetach(uint32 session);
+
+        uint64 GetTickCount() const { return m_ticks; }
+        uint64 GetPacketCount() const { return m_packets; }
+
+    private:
+        PacketCaptureWriter(PacketCaptureWriter const&);
+        PacketCaptureWriter& operator=(PacketCaptureWriter const&);
+
+        void Put(uint8 const* data, size_t len);            // caller holds m_lock
+        void PutUInt32(uint32 value);
+        void PutRecordHead(CaptureRecordType type, uint32 session);
+        void PutString(std::string const& value);
+
+        std::mutex m_lock;
+        std::atomic<bool> m_open;
+        FILE* m_file;
+        uint64 m_ticks;                                     // m_lock
+        uint64 m_packets;                                   // m_lock
+};
+
+// Reads a capture back. A record cut short -- the server died mid-write -- ends the
+// stream and is reported by IsTruncated() rather than read as garbage.
+class PacketCaptureReader
+{
+    public:
+        PacketCaptureReader();
+        ~PacketCaptureReader();
+
+        bool Open(std::string const& path);
+        uint32 GetSeed() const { return m_seed; }
+
+        // False at the end of the stream, or at the first unreadable record.
+        bool Next(CaptureRecord& record);
+        bool IsTruncated() const { return m_truncated; }
+
+    private:
+        PacketCaptureReader(PacketCaptureReader const&);
+        PacketCaptureReader& operator=(PacketCaptureReader const&);
+
+        bool Get(uint8* data, size_t len);
+        bool GetUInt32(uint32& value);
+        bool GetString(std::string& value);
+
+        FILE* m_file;
+        uint32 m_seed;
+        bool m_truncated;
+};
+
+// The server's own capture, opened by Master when Capture.File is set.
+extern PacketCaptureWriter sPacketCapture;
+
+#endif
@@ -37,40 +37,132 @@ bool SessionMailbox::Enqueue(std::unique_ptr<WorldPacket> packet)
     if (!packet)
         return false;
 
-    std::lock_guard<std::mutex> guard(m_stateLock);
+    std::lock_guard<std::mutex> guard(m_inboxLock);
     if (m_closed)
         return false;
 
-    WorldPacket* accepted = packet.get();
-    m_packets.add(accepted);
+    m_inbox.push_back(packet.get());
     (void)packet.release();
     return true;
 }
 
+bool SessionMailbox::Enqueue(WorldPacket const& packet)
+{
+    {
+        std::lock_guard<std::mutex> guard(m_inboxLock);
+        if (m_closed)
+            return false;
+
+        if (!m_free.empty())
+        {
+            // Initialize() keeps the recycled packet's buffer, so a copy that fits costs no allocation.
+            WorldPacket* reused = m_free.back();
+            m_free.pop_back();
+            reused->Initialize(packet.GetOpcode(), packet.size());
+            if (packet.size())
+                reused->append(packet.contents(), packet.size());
+            m_inbox.push_back(reused);
+            ++m_recycled;
+            return true;
+        }
+    }
+
+    // Freelist empty: allocate outside the lock, then queue.
+    std::unique_ptr<WorldPacket> copy(new WorldPacket(packet));
+    std::lock_guard<std::mutex> guard(m_inboxLock);
+    if (m_closed)
+        return false;
+
+    m_inbox.push_back(copy.get());
+    (void)copy.release();
+    ++m_allocated;
+    return true;
+}
+
 bool SessionMailbox::Next(WorldPacket*& packet)
 {
-    std::lock_guard<std::mutex> guard(m_stateLock);
+    std::lock_guard<std::mutex> guard(m_drainLock);
     if (m_closed)
         return false;
-    return m_packets.next(packet);
+    if (m_drainPos == m_drained.size() && !Refill())
+        return false;
+    packet = m_drained[m_drainPos++];
+    return true;
+}
+
+bool SessionMailbox::Refill()
+{
+    m_drained.clear();
+    m_drainPos = 0;
+
+    std::lock_guard<std::mutex> guard(m_inboxLock);
+    m_drained.swap(m_inbox);
+
+    // Recycled packets reach the producer on the same trip through the lock.
+    while (!m_returned.empty() && m_free.size() < FreeListLimit)
+    {
+        m_free.push_back(m_returned.back());
+        m_returned.pop_back();
+    }
+    return !m_drained.empty();
+}
+
+void SessionMailbox::Recycle(WorldPacket* packet)
+{
+    if (!packet)
+        return;
+
+    {
+        std::lock_guard<std::mutex> guard(m_drainLock);
+        if (!m_closed && m_returned.size() < FreeListLimit && packet->size() <= MaxRecycledSize)
+        {
+            m_returned.push_back(packet);
+            return;
+        }
+    }
+    delete packet;
 }
 
 void SessionMailbox::Close()
 {
+    std::vector<WorldPacket*> packets;
     {
-        std::lock_guard<std::mutex> guard(m_stateLock);
+        std::lock_guard<std::mutex> drainGuard(m_drainLock);
+        std::lock_guard<std::mutex> inboxGuard(m_inboxLock);
         if (m_closed)
             return;
         m_closed = true;
+
+        // Packets before m_drainPos were handed out by Next() and belong to the caller.
+        packets.assign(m_drained.begin() + m_drainPos, m_drained.end());
+        packets.insert(packets.end(), m_inbox.begin(), m_inbox.end());
+        packets.insert(packets.end(), m_free.begin(), m_free.end());
+        packets.insert(packets.end(), m_returned.begin(), m_returned.end());
+        m_drained.clear();
+        m_drainPos = 0;
+        m_inbox.clear();
+        m_free.clear();
+        m_returned.clear();
     }
 
-    WorldPacket* packet = nullptr;
-    while (m_packets.next(packet))
+    for (WorldPacket* packet : packets)
         delete packet;
 }
 
 bool SessionMailbox::IsClosed() const
 {
-    std::lock_guard<std::mutex> guard(m_stateLock);
+    std::lock_guard<std::mutex> guard(m_inboxLock);
     return m_closed;
 }
+
+size_t SessionMailbox::GetRecycledCount() const
+{
+    std::lock_guard<std::mutex> guard(m_inboxLock);
+    return m_recycled;
+}
+
+size_t SessionMailbox::GetAllocatedCount() const
+{
+    std::lock_guard<std::mutex> guard(m_inboxLock);
+    return m_allocated;
+}
@@ -26,12 +26,21 @@
 #ifndef MANGOS_H_SESSIONMAILBOX
 #define MANGOS_H_SESSIONMAILBOX
 
-#include "LockedQueue/LockedQueue.h"
 #include "WorldPacket.h"
 
+#include <cstddef>
 #include <memory>
 #include <mutex>
+#include <vector>
 
+// Incoming packets of one session. The network thread appends to an inbox vector under
+// a single lock; the consumer -- world thread or map thread -- swaps the whole inbox out
+// in one locked step and then walks the drained batch without touching that lock again.
+// The filter of Next() runs on the drained batch and keeps its head-of-line semantics:
+// the first packet it rejects stays put, and so does everything behind it.
+//
+// Packets handed back through Recycle() are reused by Enqueue(const WorldPacket&), which
+// copies into the buffer they already own instead of allocating a new packet.
 class SessionMailbox
 {
     public:
@@ -39,24 +48,55 @@ class SessionMailbox
         ~SessionMailbox();
 
         bool Enqueue(std::unique_ptr<WorldPacket> packet);
+        bool Enqueue(WorldPacket const& packet);
         bool Next(WorldPacket*& packet);
 
         template<class Checker>
         bool Next(WorldPacket*& packet, Checker& checker)
         {
-            std::lock_guard<std::mutex> guard(m_stateLock);
+            std::lock_guard<std::mutex> guard(m_drainLock);
             if (m_closed)
                 return false;
-            return m_packets.next(packet, checker);
+            if (m_drainPos == m_drained.size() && !Refill())
+                return false;
+            if (!checker.Process(m_drained[m_drainPos]))
+                return false;
+            packet = m_drained[m_drainPos++];
+            return true;
         }
 
+        // Hand a packet obtained from Next() back for reuse; the mailbox owns it again.
+        void Recycle(WorldPacket* packet);
+
         void Close();
         bool IsClosed() const;
 
+        // Packets reused from the freelist and packets that had to be allocated.
+        size_t GetRecycledCount() const;
+        size_t GetAllocatedCount() const;
+
+        // Recycled packets kept per mailbox; a packet larger than MaxRecycledSize is freed.
+        static const size_t FreeListLimit = 32;
+        static const size_t MaxRecycledSize = 4096;
+
     private:
-        mutable std::mutex m_stateLock;
+        // Swap the inbox into the drained batch. Caller holds m_drainLock.
+        bool Refill();
+
+        // Lock order: m_drainLock, then m_inboxLock. m_closed is written under both.
+        mutable std::mutex m_drainLock;
+        mutable std::mutex m_inboxLock;
         bool m_closed = false;
-        MaNGOS::LockedQueue<WorldPacket*> m_packets;
+
+        std::vector<WorldPacket*> m_inbox;     // producer side, m_inboxLock
+        std::vector<WorldPacket*> m_free;      // producer side, m_inboxLock
+
+        std::vector<WorldPacket*> m_drained;   // consumer side, m_drainLock
+        size_t m_drainPos = 0;
+        std::vector<WorldPacket*> m_returned;  // consumer side, m_drainLock
+
+        size_t m_recycled = 0;                 // m_inboxLock
+        size_t m_allocated = 0;                // m_inboxLock
 };
 
 #endif
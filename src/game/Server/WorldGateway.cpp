@@ -34,6 +34,7 @@
 #include "IClientLink.h"
 #include "Log.h"
 #include "OpcodeTable.h"
+#include "PacketCapture.h"
 #include "SessionMailbox.h"
 #include "SharedDefines.h"
 #include "World.h"
@@ -259,6 +260,11 @@ proto::SessionId WorldGateway::Attach(proto::AuthRequest const& request,
         Detach(sessionId);
         throw;
     }
+
+    if (sPacketCapture.IsOpen())
+    {
+        sPacketCapture.WriteAttach(sessionId, request.build, request.account, request.peerAddress);
+    }
     return sessionId;
 }
 
@@ -275,7 +281,11 @@ void WorldGateway::Deliver(proto::SessionId session, WorldPacket&& packet)
         mailbox = route->second;
     }
 
-    mailbox->Enqueue(std::make_unique<WorldPacket>(std::move(packet)));
+    if (sPacketCapture.IsOpen())
+    {
+        sPacketCapture.WritePacket(session, packet);
+    }
+    mailbox->Enqueue(packet);
 }
 
 void WorldGateway::Detach(proto::SessionId session)
@@ -292,5 +302,9 @@ void WorldGateway::Detach(proto::SessionId session)
         m_routes.erase(route);
     }
 
+    if (sPacketCapture.IsOpen())
+    {
+        sPacketCapture.WriteDetach(session);
+    }
     mailbox->Close();
 }
@@ -60,6 +60,7 @@
 #include "Database/DatabaseEnv.h"
 #include "Log.h"
 #include "OpcodeTable.h"
+#include "OpcodeProfiler.h"
 #include "SessionMailbox.h"
 #include "WorldPacket.h"
 #include "WorldSession.h"
@@ -172,7 +173,7 @@ static std::string SafeWardenLogToken(std::string const& value)
 bool MapSessionFilter::Process(WorldPacket* packet)
 {
     OpcodeHandler const& opHandle = opcodeTable[packet->GetOpcode()];
-    if (opHandle.packetProcessing == PROCESS_INPLACE)
+    if (opHandle.packetProcessing == PROCESS_INPLACE || opHandle.packetProcessing == PROCESS_SESSIONSAFE)
     {
         return true;
     }
@@ -194,7 +195,7 @@ bool WorldSessionFilter::Process(WorldPacket* packet)
 {
     OpcodeHandler const& opHandle = opcodeTable[packet->GetOpcode()];
     // check if packet handler is supposed to be safe
-    if (opHandle.packetProcessing == PROCESS_INPLACE)
+    if (opHandle.packetProcessing == PROCESS_INPLACE || opHandle.packetProcessing == PROCESS_SESSIONSAFE)
     {
         return true;
     }
@@ -203,6 +204,19 @@ bool WorldSessionFilter::Process(WorldPacket* packet)
     return !MapSessionFilterHelper(m_pSession, opHandle);
 }
 
+/**
+ * @brief Process packet on a session worker
+ * @param packet Packet to process
+ * @return True if packet should be processed
+ *
+ * Only handlers classified PROCESS_SESSIONSAFE may run concurrently
+ * with the other sessions.
+ */
+bool SessionWorkerFilter::Process(WorldPacket* packet)
+{
+    return opcodeTable[packet->GetOpcode()].packetProcessing == PROCESS_SESSIONSAFE;
+}
+
 /// WorldSession constructor
 WorldSession::WorldSession(uint32 id, std::shared_ptr<proto::IClientLink> link,
                            std::shared_ptr<SessionMailbox> mailbox, AccountTypes sec,
@@ -280,6 +294,24 @@ char const* WorldSession::GetPlayerName() const
     return GetPlayer() ? GetPlayer()->GetName() : "<none>";
 }
 
+bool WorldSession::WantsOpcode(uint16 opcode) const
+{
+    if (m_link)
+    {
+        return true;
+    }
+
+#ifdef ENABLE_PLAYERBOTS
+    if (GetPlayer() && GetPlayer()->GetPlayerbotAI())
+    {
+        return GetPlayer()->GetPlayerbotAI()->ConsumesOutgoingOpcode(opcode);
+    }
+#endif
+
+    // No socket and no bot: SendPacket would drop it anyway.
+    return false;
+}
+
 /// Send a packet to the client
 void WorldSession::SendPacket(WorldPacket const* packet)
 {
@@ -348,6 +380,8 @@ void WorldSession::SendPacket(WorldPacket const* packet)
 
 #endif                                                  // !MANGOS_DEBUG
 
+    OpcodeProfiler::NoteSent(this, packet->size());
+
     m_link->SendPacket(*packet);
 }
 
@@ -968,6 +1002,51 @@ void WorldSession::LogUnprocessedTail(WorldPacket* packet)
 
 /// Update the WorldSession (triggered by World update)
 bool WorldSession::Update(PacketFilter& updater)
+{
+    ProcessIncomingPackets(updater);
+
+#ifdef ENABLE_PLAYERBOTS
+    if (GetPlayer() && GetPlayer()->GetPlayerbotMgr())
+    {
+        GetPlayer()->GetPlayerbotMgr()->UpdateSessions(0);
+    }
+#endif
+
+    ///- Cleanup client link if needed
+    if (m_link && m_link->IsClosed())
+    {
+        m_link.reset();
+    }
+
+    // check if we are safe to proceed with logout
+    // logout procedure should happen only in World::UpdateSessions() method!!!
+    if (updater.ProcessLogout())
+    {
+        ///- If necessary, log the player out
+        time_t currTime = time(NULL);
+        if (!m_link || (ShouldLogOut(currTime) && !m_playerLoading))
+        {
+            LogoutPlayer(true);
+        }
+
+        if (!m_link)
+        {
+            return false;                                    // Will remove this session from the world session map
+        }
+    }
+
+    return true;
+}
+
+/// Handle the session-safe packets at the head of the queue (triggered by World::UpdateSessions on a session worker)
+void WorldSession::UpdateSessionSafe()
+{
+    SessionWorkerFilter updater(this);
+    ProcessIncomingPackets(updater);
+}
+
+/// Retrieve the packets accepted by the filter and call their handlers
+void WorldSession::ProcessIncomingPackets(PacketFilter& updater)
 {
     ///- Retrieve packets from the receive queue and call the appropriate handlers
     /// not process packets if the client link already closed
@@ -1002,7 +1081,7 @@ bool WorldSession::Update(PacketFilter& updater)
                     // lag can cause STATUS_LOGGEDIN opcodes to arrive after the player started a transfer
 
 #ifdef ENABLE_PLAYERBOTS
-                    if (_player && _player->GetPlayerbotMgr())
+                    if (_player && _player->GetPlayerbotMgr() && updater.ProcessBotForwarding())
                     {
                         _player->GetPlayerbotMgr()->HandleMasterIncomingPacket(*packet);
                     }
@@ -1085,40 +1164,8 @@ bool WorldSession::Update(PacketFilter& updater)
             }
         }
 
-        delete packet;
-    }
-
-#ifdef ENABLE_PLAYERBOTS
-    if (GetPlayer() && GetPlayer()->GetPlayerbotMgr())
-    {
-        GetPlayer()->GetPlayerbotMgr()->UpdateSessions(0);
-    }
-#endif
-
-    ///- Cleanup client link if needed
-    if (m_link && m_link->IsClosed())
-    {
-        m_link.reset();
-    }
-
-    // check if we are safe to proceed with logout
-    // logout procedure should happen only in World::UpdateSessions() method!!!
-    if (updater.ProcessLogout())
-    {
-        ///- If necessary, log the player out
-        time_t currTime = time(NULL);
-        if (!m_link || (ShouldLogOut(currTime) && !m_playerLoading))
-        {
-            LogoutPlayer(true);
-        }
-
-        if (!m_link)
-        {
-            return false;                                    // Will remove this session from the world session map
-        }
+        m_mailbox->Recycle(packet);
     }
-
-    return true;
 }
 
 #ifdef ENABLE_PLAYERBOTS
@@ -1719,6 +1766,8 @@ void WorldSession::ExecuteOpcode(OpcodeHandler const& opHandle, WorldPacket* pac
     }
 #endif /* ENABLE_ELUNA */
 
+    OpcodeProfiler::Scope profile(sOpcodeProfiler, this, packet->GetOpcode(), packet->size());
+
     // need prevent do internal far teleports in handlers because some handlers do lot steps
     // or call code that can do far teleports in some conditions unexpectedly for generic way work code
     if (_player)
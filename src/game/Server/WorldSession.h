@@ -161,6 +161,15 @@ class PacketFilter
             return true;
         }
 
+        /**
+         * @brief Process bot forwarding
+         * @return True if handled packets are passed on to the player's bots
+         */
+        virtual bool ProcessBotForwarding() const
+        {
+            return true;
+        }
+
     protected:
         WorldSession* const m_pSession;
 };
@@ -232,6 +241,59 @@ class WorldSessionFilter : public PacketFilter
         bool Process(WorldPacket* packet) override;
 };
 
+/**
+ * @brief Session worker filter class
+ *
+ * Process only PROCESS_SESSIONSAFE packets, on the session workers of
+ * World::UpdateSessions(). The first other packet ends the run, so that
+ * packets are still handled in the order they arrived.
+ */
+class SessionWorkerFilter : public PacketFilter
+{
+    public:
+        /**
+         * @brief Constructor
+         * @param pSession World session
+         */
+        explicit SessionWorkerFilter(WorldSession* pSession) : PacketFilter(pSession) {}
+
+        /**
+         * @brief Destructor
+         */
+        ~SessionWorkerFilter() {}
+
+        /**
+         * @brief Process packet
+         * @param packet World packet to process
+         * @return True if processed successfully
+         */
+        bool Process(WorldPacket* packet) override;
+
+        /**
+         * @brief Process bot forwarding
+         *
+         * Forwarding reaches the bots' sessions, which other workers may be
+         * updating; bot AI reacts to nothing session-safe anyway.
+         *
+         * @return False (packets not forwarded)
+         */
+        bool ProcessBotForwarding() const override
+        {
+            return false;
+        }
+
+        /**
+         * @brief Process logout
+         *
+         * Logout touches the world, never done from a session worker.
+         * @return Always false
+         */
+        bool ProcessLogout() const override
+        {
+            return false;
+        }
+};
+
 /**
  * @brief World session class
  *
@@ -294,6 +356,15 @@ class WorldSession
         void SizeError(WorldPacket const& packet, uint32 size) const;
 
         void SendPacket(WorldPacket const* packet);
+
+        /**
+         * @brief Whether anything reads a packet of this opcode sent here.
+         *
+         * A client reads everything; a bot session has no client, only the handful of
+         * opcodes its AI inspects. Callers that would build a packet for this session
+         * alone ask first and skip the building when the answer is no.
+         */
+        bool WantsOpcode(uint16 opcode) const;
         void SetPendingAddonInfo(std::unique_ptr<WorldPacket> packet);
         void SendPendingAddonInfo();
         void OnAuthenticatedAdmission();
@@ -384,6 +455,15 @@ class WorldSession
 
         bool Update(PacketFilter& updater);
 
+        /**
+         * @brief Handle the PROCESS_SESSIONSAFE packets at the head of the queue
+         *
+         * Runs on a session worker, concurrently with other sessions and with
+         * nothing else: World::UpdateSessions() waits for the workers before
+         * the serial session update and the map update start.
+         */
+        void UpdateSessionSafe();
+
         /// Handle the authentication waiting queue (to be completed)
         void SendAuthWaitQue(uint32 position);
 
@@ -933,6 +1013,7 @@ class WorldSession
         bool VerifyMovementInfo(MovementInfo const& movementInfo) const;
         void HandleMoverRelocation(MovementInfo& movementInfo);
 
+        void ProcessIncomingPackets(PacketFilter& updater);
         void ExecuteOpcode(OpcodeHandler const& opHandle, WorldPacket* packet);
 
         void HandleWardenLifecycle(
@@ -0,0 +1,224 @@
+/**
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2026 MaNGOS <https://www.getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+/**
+ * @file MapTickProfile.cpp
+ * @brief Per-phase timing of map updates
+ *
+ * Each map times the phases of its updates so that a live realm shows where
+ * its tick goes: rolling histograms per phase for `.debug maptick`, and the
+ * breakdown of any tick longer than MapUpdate.SlowTickThreshold for the map
+ * tick log.
+ *
+ * @see Map::Update for where the phases are marked
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include "MapTickProfile.h"
+
+std::atomic<uint32> MapTickProfile::s_slowTickThreshold(0);
+
+namespace
+{
+    char const* const s_phaseNames[MAP_TICK_PHASE_COUNT] =
+    {
+        "sessions",
+        "players",
+        "cells",
+        "hostile refs",
+        "active objects",
+        "visibility",
+        "object updates",
+        "grid states",
+        "cell unloads",
+        "game events",
+        "scripts",
+        "eluna",
+        "instance data",
+        "weather",
+        "transports"
+    };
+
+    uint32 BucketOf(uint64 micros)
+    {
+        uint32 bucket = 0;
+        while (micros && bucket < MapTickProfile::BucketCount - 1)
+        {
+            micros >>= 1;
+            ++bucket;
+        }
+        return bucket;
+    }
+
+    uint64 BucketUpperMicros(uint32 bucket)
+    {
+        return bucket ? (uint64(1) << bucket) - 1 : 0;
+    }
+}
+
+char const* GetMapTickPhaseName(MapTickPhase phase)
+{
+    return phase < MAP_TICK_PHASE_COUNT ? s_phaseNames[phase] : "unknown";
+}
+
+MapTickProfile::MapTickProfile() : m_lastTickTotal(0), m_slowTickTotal(0), m_ticksEnded(0), m_currentWindow(0)
+{
+    memset(m_currentTick, 0, sizeof(m_currentTick));
+    memset(m_lastTick, 0, sizeof(m_lastTick));
+    memset(m_slowTick, 0, sizeof(m_slowTick));
+    ClearWindow(m_windows[0]);
+    ClearWindow(m_windows[1]);
+}
+
+void MapTickProfile::ClearWindow(Window& window)
+{
+    memset(&window, 0, sizeof(window));
+}
+
+void MapTickProfile::BeginTick(Clock::time_point now)
+{
+    memset(m_currentTick, 0, sizeof(m_currentTick));
+    m_tickStart = m_lastMark = now;
+}
+
+void MapTickProfile::Mark(MapTickPhase phase, Clock::time_point now)
+{
+    m_currentTick[phase] += std::chrono::duration_cast<std::chrono::microseconds>(now - m_lastMark).count();
+    m_lastMark = now;
+}
+
+uint64 MapTickProfile::EndTick(Clock::time_point now)
+{
+    Window* window = &m_windows[m_currentWindow];
+    if (window->ticks >= WindowTicks)
+    {
+        m_currentWindow ^= 1;
+        window = &m_windows[m_currentWindow];
+        ClearWindow(*window);
+    }
+
+    ++window->ticks;
+    for (uint32 phase = 0; phase < MAP_TICK_PHASE_COUNT; ++phase)
+    {
+        uint64 micros = m_currentTick[phase];
+        window->totalMicros[phase] += micros;
+        window->maxMicros[phase] = std::max(window->maxMicros[phase], micros);
+        ++window->buckets[phase][BucketOf(micros)];
+    }
+
+    memcpy(m_lastTick, m_currentTick, sizeof(m_lastTick));
+    m_lastTickTotal = std::chrono::duration_cast<std::chrono::microseconds>(now - m_tickStart).count();
+    ++m_ticksEnded;
+    return m_lastTickTotal;
+}
+
+void MapTickProfile::CaptureSlowTick()
+{
+    memcpy(m_slowTick, m_lastTick, sizeof(m_slowTick));
+    m_slowTickTotal = m_lastTickTotal;
+}
+
+MapTickProfile::PhaseStats MapTickProfile::GetPhaseStats(MapTickPhase phase) const
+{
+    PhaseStats stats;
+    memset(&stats, 0, sizeof(stats));
+
+    uint32 buckets[BucketCount];
+    uint64 total = 0;
+    for (uint32 i = 0; i < BucketCount; ++i)
+    {
+        buckets[i] = m_windows[0].buckets[phase][i] + m_windows[1].buckets[phase][i];
+    }
+    for (uint32 w = 0; w < 2; ++w)
+    {
+        stats.ticks += m_windows[w].ticks;
+        total += m_windows[w].totalMicros[phase];
+        stats.maxMicros = std::max(stats.maxMicros, m_windows[w].maxMicros[phase]);
+    }
+    if (!stats.ticks)
+    {
+        return stats;
+    }
+
+    stats.avgMicros = total / stats.ticks;
+
+    uint64 p50Rank = (uint64(stats.ticks) + 1) / 2;
+    uint64 p99Rank = (uint64(stats.ticks) * 99 + 99) / 100;
+    uint64 seen = 0;
+    for (uint32 i = 0; i < BucketCount; ++i)
+    {
+        uint64 before = seen;
+        seen += buckets[i];
+        if (before < p50Rank && seen >= p50Rank)
+        {
+            stats.p50Micros = std::min(BucketUpperMicros(i), stats.maxMicros);
+        }
+        if (before < p99Rank && seen >= p99Rank)
+        {
+            stats.p99Micros = std::min(BucketUpperMicros(i), stats.maxMicros);
+            break;
+        }
+    }
+    return stats;
+}
+
+std::string MapTickProfile::FormatStats() const
+{
+    std::string text;
+    for (uint32 phase = 0; phase < MAP_TICK_PHASE_COUNT; ++phase)
+    {
+        PhaseStats stats = GetPhaseStats(MapTickPhase(phase));
+        if (!stats.maxMicros)
+        {
+            continue;
+        }
+
+        char part[128];
+        snprintf(part, sizeof(part), "%s%s avg " UI64FMTD "us p99 " UI64FMTD "us max " UI64FMTD "us", text.empty() ? "" : ", ",
+            s_phaseNames[phase], stats.avgMicros, stats.p99Micros, stats.maxMicros);
+        text += part;
+    }
+    return text;
+}
+
+std::string MapTickProfile::FormatTick(Breakdown const& breakdown)
+{
+    std::string text;
+    for (uint32 phase = 0; phase < MAP_TICK_PHASE_COUNT; ++phase)
+    {
+        if (!breakdown[phase])
+        {
+            continue;
+        }
+
+        char part[64];
+        snprintf(part, sizeof(part), "%s%s " UI64FMTD "us", text.empty() ? "" : ", ", s_phaseNames[phase], breakdown[phase]);
+        text += part;
+    }
+    return text;
+}
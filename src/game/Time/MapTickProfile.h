@@ -0,0 +1,236 @@
+/**
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2026 MaNGOS <https://www.getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+#ifndef MAPTICKPROFILE_H
+#define MAPTICKPROFILE_H
+
+#include "Platform/Define.h"
+
+#include <atomic>
+#include <chrono>
+#include <string>
+
+/**
+ * @brief The phases of Map::Update, in the order they run
+ */
+enum MapTickPhase
+{
+    MAP_TICK_SESSIONS = 0,                                  ///< packets of the map's players
+    MAP_TICK_PLAYERS,                                       ///< Player::Update
+    MAP_TICK_CELLS,                                         ///< objects in cells around players
+    MAP_TICK_HOSTILE_REFS,                                  ///< dropping creatures out of reach from combat
+    MAP_TICK_ACTIVE_OBJECTS,                                ///< cells around active non-players
+    MAP_TICK_VISIBILITY,                                    ///< queued relocation visibility updates
+    MAP_TICK_OBJECT_UPDATES,                                ///< SendObjectUpdates
+    MAP_TICK_GRID_STATES,
+    MAP_TICK_CELL_UNLOADS,
+    MAP_TICK_GAME_EVENTS,                                   ///< queued game event spawns
+    MAP_TICK_SCRIPTS,
+    MAP_TICK_ELUNA,
+    MAP_TICK_INSTANCE_DATA,
+    MAP_TICK_WEATHER,
+    MAP_TICK_TRANSPORTS,                                    ///< vessels, with their decks
+    MAP_TICK_PHASE_COUNT
+};
+
+/**
+ * @brief Get the short name of a map tick phase
+ * @param phase The phase
+ * @return Name for reports, e.g. "cells"
+ */
+char const* GetMapTickPhaseName(MapTickPhase phase);
+
+/**
+ * @brief MapTickProfile times the phases of one map's updates
+ *
+ * Map::Update calls BeginTick(), then Mark() after each phase to charge the
+ * time since the previous mark to it, then EndTick(). Each phase keeps a log2
+ * histogram of its per-tick microseconds (bucket b holds [2^(b-1), 2^b)) over
+ * a rolling window of the last WindowTicks to 2 * WindowTicks ticks, and the
+ * breakdown of the last tick and of the last slow tick.
+ *
+ * Written by the thread updating the map and read by commands on the world
+ * thread, which never runs while maps update.
+ */
+class MapTickProfile
+{
+    public:
+        static const uint32 BucketCount = 20;               ///< last bucket: 2^19 us (0.5 s) and up
+        static const uint32 WindowTicks = 600;              ///< one minute at the default MapUpdateInterval
+
+        /**
+         * @brief Rolling statistics of one phase
+         */
+        struct PhaseStats
+        {
+            uint32 ticks;                                   ///< ticks in the window
+            uint64 avgMicros;
+            uint64 p50Micros;                               ///< upper bound of the histogram bucket
+            uint64 p99Micros;                               ///< upper bound of the histogram bucket
+            uint64 maxMicros;
+        };
+
+        MapTickProfile();
+
+        typedef std::chrono::steady_clock Clock;
+
+        /**
+         * @brief Start timing a tick
+         */
+        void BeginTick() { BeginTick(Clock::now()); }
+
+        /**
+         * @brief Start timing a tick at a given time
+         * @param now When the tick starts
+         */
+        void BeginTick(Clock::time_point now);
+
+        /**
+         * @brief Charge the time since the previous mark to a phase
+         * @param phase The phase that just ran
+         */
+        void Mark(MapTickPhase phase) { Mark(phase, Clock::now()); }
+
+        /**
+         * @brief Charge the time from the previous mark to a given time to a phase
+         * @param phase The phase that just ran
+         * @param now When it finished
+         */
+        void Mark(MapTickPhase phase, Clock::time_point now);
+
+        /**
+         * @brief Finish the tick and add it to the window
+         * @return Microseconds from BeginTick() to now
+         */
+        uint64 EndTick() { return EndTick(Clock::now()); }
+
+        /**
+         * @brief Finish the tick at a given time and add it to the window
+         * @param now When the tick finished
+         * @return Microseconds from BeginTick() to now
+         */
+        uint64 EndTick(Clock::time_point now);
+
+        /**
+         * @brief Keep the tick just ended as the last slow tick
+         */
+        void CaptureSlowTick();
+
+        /**
+         * @brief Get rolling statistics of a phase
+         * @param phase The phase
+         * @return Statistics over the current window
+         */
+        PhaseStats GetPhaseStats(MapTickPhase phase) const;
+
+        /**
+         * @brief Get the time a phase took in the last tick
+         * @param phase The phase
+         * @return Microseconds
+         */
+        uint64 GetLastTickMicros(MapTickPhase phase) const { return m_lastTick[phase]; }
+
+        /**
+         * @brief Get the total time of the last tick
+         * @return Microseconds
+         */
+        uint64 GetLastTickTotal() const { return m_lastTickTotal; }
+
+        /**
+         * @brief Get the total time of the last slow tick
+         * @return Microseconds, 0 if no tick was slow yet
+         */
+        uint64 GetSlowTickTotal() const { return m_slowTickTotal; }
+
+        /**
+         * @brief Get the number of ticks ended since the map was created
+         * @return Tick count, so a reader can tell whether the map ran since it last looked
+         */
+        uint64 GetTicksEnded() const { return m_ticksEnded; }
+
+        /**
+         * @brief Describe the last tick, non-zero phases only
+         * @return e.g. "players 1200us, cells 8100us"
+         */
+        std::string FormatLastTick() const { return FormatTick(m_lastTick); }
+
+        /**
+         * @brief Describe the last slow tick, non-zero phases only
+         * @return Empty if no tick was slow yet
+         */
+        std::string FormatSlowTick() const { return FormatTick(m_slowTick); }
+
+        /**
+         * @brief Describe the rolling statistics, phases that took time only
+         * @return e.g. "cells avg 900us p99 2047us max 3100us, ..."
+         */
+        std::string FormatStats() const;
+
+        /**
+         * @brief Set the tick length, in ms, from which a map logs its phase breakdown
+         * @param thresholdMs 0 to log none
+         */
+        static void SetSlowTickThreshold(uint32 thresholdMs) { s_slowTickThreshold.store(thresholdMs, std::memory_order_relaxed); }
+
+        /**
+         * @brief Get the slow tick threshold
+         * @return Milliseconds, 0 if off
+         */
+        static uint32 GetSlowTickThreshold() { return s_slowTickThreshold.load(std::memory_order_relaxed); }
+
+    private:
+        typedef uint64 Breakdown[MAP_TICK_PHASE_COUNT];
+
+        /**
+         * @brief The histograms of one window
+         */
+        struct Window
+        {
+            uint32 ticks;
+            uint64 totalMicros[MAP_TICK_PHASE_COUNT];
+            uint64 maxMicros[MAP_TICK_PHASE_COUNT];
+            uint32 buckets[MAP_TICK_PHASE_COUNT][BucketCount];
+        };
+
+        static std::string FormatTick(Breakdown const& breakdown);
+        static void ClearWindow(Window& window);
+
+        Clock::time_point m_tickStart;
+        Clock::time_point m_lastMark;
+
+        Breakdown m_currentTick;
+        Breakdown m_lastTick;
+        uint64 m_lastTickTotal;
+        Breakdown m_slowTick;
+        uint64 m_slowTickTotal;
+        uint64 m_ticksEnded;
+
+        Window m_windows[2];                                ///< the current one, and the one before
+        uint32 m_currentWindow;
+
+        static std::atomic<uint32> s_slowTickThreshold;
+};
+
+#endif
@@ -48,6 +48,7 @@
 #include "World.h"
 #include "SocialMgr.h"
 #include "Chat.h"
+#include "SharedPacket.h"
 
 Channel::Channel(const std::string& name)
     : m_announce(true), m_moderate(false), m_name(name), m_flags(0), m_channelId(0)
@@ -839,6 +840,8 @@ void Channel::SetOwner(ObjectGuid guid, bool exclaim)
  */
 void Channel::SendToAll(WorldPacket* data, ObjectGuid guid)
 {
+    proto::SharedPacketScope shared(*data);
+
     for (PlayerList::const_iterator i = m_players.begin(); i != m_players.end(); ++i)
     {
         if (Player* plr = sObjectMgr.GetPlayer(i->first))
@@ -270,11 +270,17 @@ ChatCommand* ChatHandler::getCommandTable()
         { "lootrecipient",  SEC_GAMEMASTER,     false, &ChatHandler::HandleDebugGetLootRecipientCommand,    "", NULL },
         { "getitemvalue",   SEC_ADMINISTRATOR,  false, &ChatHandler::HandleDebugGetItemValueCommand,        "", NULL },
         { "getvalue",       SEC_ADMINISTRATOR,  false, &ChatHandler::HandleDebugGetValueCommand,            "", NULL },
+        { "maptick",        SEC_ADMINISTRATOR,  true,  &ChatHandler::HandleDebugMapTickCommand,             "", NULL },
         { "minion",         SEC_GAMEMASTER,     false, &ChatHandler::HandleDebugMinionCommand,              "", NULL },
         { "moditemvalue",   SEC_ADMINISTRATOR,  false, &ChatHandler::HandleDebugModItemValueCommand,        "", NULL },
         { "modvalue",       SEC_ADMINISTRATOR,  false, &ChatHandler::HandleDebugModValueCommand,            "", NULL },
+        { "objectpools",    SEC_ADMINISTRATOR,  true,  &ChatHandler::HandleDebugObjectPoolsCommand,         "", NULL },
+        { "observers",      SEC_ADMINISTRATOR,  false, &ChatHandler::HandleDebugObserversCommand,           "", NULL },
+        { "opcodes",        SEC_ADMINISTRATOR,  true,  &ChatHandler::HandleDebugOpcodesCommand,             "", NULL },
+        { "packetpools",    SEC_ADMINISTRATOR,  true,  &ChatHandler::HandleDebugPacketPoolsCommand,         "", NULL },
         { "play",           SEC_MODERATOR,      false, NULL,                                                "", debugPlayCommandTable },
         { "recv",           SEC_ADMINISTRATOR,  false, &ChatHandler::HandleDebugRecvOpcodeCommand,          "", NULL },
+        { "scripts",        SEC_ADMINISTRATOR,  false, &ChatHandler::HandleDebugScriptsCommand,             "", NULL },
         { "send",           SEC_ADMINISTRATOR,  false, NULL,                                                "", debugSendCommandTable },
         { "setaurastate",   SEC_ADMINISTRATOR,  false, &ChatHandler::HandleDebugSetAuraStateCommand,        "", NULL },
         { "setitemvalue",   SEC_ADMINISTRATOR,  false, &ChatHandler::HandleDebugSetItemValueCommand,        "", NULL },
@@ -283,12 +289,14 @@ ChatCommand* ChatHandler::getCommandTable()
         { "spellcoefs",     SEC_ADMINISTRATOR,  true,  &ChatHandler::HandleDebugSpellCoefsCommand,          "", NULL },
         { "spellmods",      SEC_ADMINISTRATOR,  false, &ChatHandler::HandleDebugSpellModsCommand,           "", NULL },
         { "uws",            SEC_ADMINISTRATOR,  false, &ChatHandler::HandleDebugUpdateWorldStateCommand,    "", NULL },
+        { "visibility",     SEC_ADMINISTRATOR,  false, &ChatHandler::HandleDebugVisibilityCommand,          "", NULL },
         { NULL,             0,                  false, NULL,                                                "", NULL }
     };
 
     static ChatCommand eventCommandTable[] =
     {
         { "list",           SEC_GAMEMASTER,     true,  &ChatHandler::HandleEventListCommand,           "", NULL },
+        { "progress",       SEC_GAMEMASTER,     true,  &ChatHandler::HandleEventProgressCommand,       "", NULL },
         { "start",          SEC_GAMEMASTER,     true,  &ChatHandler::HandleEventStartCommand,          "", NULL },
         { "stop",           SEC_GAMEMASTER,     true,  &ChatHandler::HandleEventStopCommand,           "", NULL },
         { "",               SEC_GAMEMASTER,     true,  &ChatHandler::HandleEventInfoCommand,           "", NULL },
@@ -304,6 +304,13 @@ class ChatHandler
         bool HandleDebugMinionCommand(char* args);
         bool HandleDebugModItemValueCommand(char* args);
         bool HandleDebugModValueCommand(char* args);
+        bool HandleDebugObjectPoolsCommand(char* args);
+        bool HandleDebugPacketPoolsCommand(char* args);
+        bool HandleDebugOpcodesCommand(char* args);
+        bool HandleDebugMapTickCommand(char* args);
+        bool HandleDebugScriptsCommand(char* args);
+        bool HandleDebugVisibilityCommand(char* args);
+        bool HandleDebugObserversCommand(char* args);
         bool HandleDebugSetAuraStateCommand(char* args);
         bool HandleDebugSetItemValueCommand(char* args);
         bool HandleDebugSetValueCommand(char* args);
@@ -329,6 +336,7 @@ class ChatHandler
         bool HandleDebugSendSpellFailCommand(char* args);
 
         bool HandleEventListCommand(char* args);
+        bool HandleEventProgressCommand(char* args);
         bool HandleEventStartCommand(char* args);
         bool HandleEventStopCommand(char* args);
         bool HandleEventInfoCommand(char* args);
@@ -193,6 +193,56 @@ bool DynamicCollision::IsInLineOfSight(float x1, float y1, float z1, float x2, f
     return NearestHitFraction(x1, y1, z1, x2, y2, z2, phasemask) > 1.0f;
 }
 
+void DynamicCollision::IsInLineOfSight(const Vector3& from, const std::vector<Vector3>& targets,
+                                       std::vector<uint8_t>& clear, uint32_t phasemask) const
+{
+    auto inv = [](float d) { return std::fabs(d) > 1e-9f ? 1.0f / d : 1e30f; };
+
+    std::vector<Vector3> invDirs(targets.size());
+    std::vector<uint8_t> live(targets.size(), 0);
+    float minx = from.x, miny = from.y, maxx = from.x, maxy = from.y;
+    bool any = false;
+    for (size_t i = 0; i < targets.size(); ++i)
+    {
+        const Vector3 seg = targets[i] - from;
+        if (!clear[i] || Geometry::dot(seg, seg) < 1e-6f)
+        {
+            continue;
+        }
+        live[i] = 1;
+        any = true;
+        invDirs[i] = Vector3{inv(seg.x), inv(seg.y), inv(seg.z)};
+        minx = std::min(minx, targets[i].x);
+        miny = std::min(miny, targets[i].y);
+        maxx = std::max(maxx, targets[i].x);
+        maxy = std::max(maxy, targets[i].y);
+    }
+    if (!any)
+    {
+        return;
+    }
+
+    ForEachCandidate(minx, miny, maxx, maxy, [&](const GameObjectModel& model)
+    {
+        if (!model.IsCollidable() || !(model.GetPhaseMask() & phasemask))
+        {
+            return;
+        }
+        for (size_t i = 0; i < targets.size(); ++i)
+        {
+            if (!live[i] || !clear[i] ||
+                !model.GetBounds().intersectsRay(from, invDirs[i], 1.0f))
+            {
+                continue;
+            }
+            if (model.SegmentHitFraction(from, targets[i]) <= 1.0f)
+            {
+                clear[i] = 0;
+            }
+        }
+    });
+}
+
 void DynamicCollision::AddSurfaces(float x, float y, float zTop, float zBottom,
                                    uint32_t filter, world::terrain::Column& out) const
 {
@@ -83,6 +83,13 @@ class DynamicCollision : public world::terrain::ILiveGeometry
         float NearestHitFraction(float x1, float y1, float z1, float x2, float y2,
                                  float z2, uint32_t phasemask) const;
 
+        // The batched form of IsInLineOfSight, shaped like FusedTerrain's: `clear` is
+        // sized to `targets`, a set entry is cleared when a collidable body blocks it and
+        // a zero entry is skipped. The buckets are swept once for the whole fan.
+        void IsInLineOfSight(const world::terrain::Vec3& from,
+                             const std::vector<world::terrain::Vec3>& targets,
+                             std::vector<uint8_t>& clear, uint32_t phasemask) const;
+
         // Every collidable surface crossing the window over (x,y), appended to the
         // terrain engine's column. `filter` is the phase mask: this is the ILiveGeometry
         // side of the seam, so the engine hands it back without having looked at it.
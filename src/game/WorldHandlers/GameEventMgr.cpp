@@ -762,6 +762,7 @@ void GameEventMgr::UnApplyEvent(uint16 event_id)
     CharacterDatabase.PExecute("DELETE FROM `game_event_status` WHERE `event` = %u", event_id);
 
     sLog.outString("GameEvent %u \"%s\" removed.", event_id, mGameEvent[event_id].description.c_str());
+    BeginTransition(event_id, false);
     // un-spawn positive event tagged objects
     GameEventUnspawn(event_id);
     // spawn negative event tagget objects
@@ -769,6 +770,7 @@ void GameEventMgr::UnApplyEvent(uint16 event_id)
     GameEventSpawn(event_nid);
     // restore equipment or model
     UpdateCreatureData(event_id, false);
+    EndTransition();
     // Remove quests that are events only to non event npc
     UpdateEventQuests(event_id, false);
     SendEventMails(event_nid);
@@ -791,6 +793,7 @@ void GameEventMgr::ApplyNewEvent(uint16 event_id, bool resume)
     }
 
     sLog.outString("GameEvent %u \"%s\" started.", event_id, mGameEvent[event_id].description.c_str());
+    BeginTransition(event_id, true);
     // spawn positive event tagget objects
     GameEventSpawn(event_id);
     // un-spawn negative event tagged objects
@@ -798,6 +801,7 @@ void GameEventMgr::ApplyNewEvent(uint16 event_id, bool resume)
     GameEventUnspawn(event_nid);
     // Change equipement or model
     UpdateCreatureData(event_id, true);
+    EndTransition();
     // Add quests that are events only to non event npc
     UpdateEventQuests(event_id, true);
 
@@ -843,7 +847,10 @@ void GameEventMgr::GameEventSpawn(int16 event_id)
 
             sObjectMgr.AddCreatureToGrid(*itr, data);
 
-            Creature::SpawnInMaps(*itr, data);
+            if (!QueueMapWork(GAME_EVENT_WORK_SPAWN_CREATURE, data->mapid, *itr))
+            {
+                Creature::SpawnInMaps(*itr, data);
+            }
         }
     }
 
@@ -873,7 +880,10 @@ void GameEventMgr::GameEventSpawn(int16 event_id)
 
             sObjectMgr.AddGameobjectToGrid(*itr, data);
 
-            GameObject::SpawnInMaps(*itr, data);
+            if (!QueueMapWork(GAME_EVENT_WORK_SPAWN_GAMEOBJECT, data->mapid, *itr))
+            {
+                GameObject::SpawnInMaps(*itr, data);
+            }
         }
     }
 
@@ -927,7 +937,10 @@ void GameEventMgr::GameEventUnspawn(int16 event_id)
             sObjectMgr.RemoveCreatureFromGrid(*itr, data);
 
             // Remove spawned cases
-            Creature::AddToRemoveListInMaps(*itr, data);
+            if (!QueueMapWork(GAME_EVENT_WORK_DESPAWN_CREATURE, data->mapid, *itr))
+            {
+                Creature::AddToRemoveListInMaps(*itr, data);
+            }
         }
     }
 
@@ -957,7 +970,10 @@ void GameEventMgr::GameEventUnspawn(int16 event_id)
             sObjectMgr.RemoveGameobjectFromGrid(*itr, data);
 
             // Remove spawned cases
-            GameObject::AddToRemoveListInMaps(*itr, data);
+            if (!QueueMapWork(GAME_EVENT_WORK_DESPAWN_GAMEOBJECT, data->mapid, *itr))
+            {
+                GameObject::AddToRemoveListInMaps(*itr, data);
+            }
         }
     }
 
@@ -1011,6 +1027,29 @@ GameEventCreatureData const* GameEventMgr::GetCreatureUpdateDataForActiveEvent(u
     return NULL;
 }
 
+/**
+ * @brief Applies or removes event creature data on one map's copy of a creature.
+ *
+ * @param map The map copy.
+ * @param guid The creature guid.
+ * @param data The static creature spawn data.
+ * @param event_data The event-specific creature data.
+ * @param activate True to apply event data; false to remove it.
+ */
+static void UpdateCreatureDataInMap(Map* map, ObjectGuid guid, CreatureData const* data, GameEventCreatureData const* event_data, bool activate)
+{
+    if (Creature* pCreature = map->GetCreature(guid))
+    {
+        pCreature->UpdateEntry(data->id, TEAM_NONE, data, activate ? event_data : NULL);
+
+        // spells not casted for event remove case (sent NULL into update), do it
+        if (!activate)
+        {
+            pCreature->ApplyGameEventSpells(event_data, false);
+        }
+    }
+}
+
 struct GameEventUpdateCreatureDataInMapsWorker
 {
     GameEventUpdateCreatureDataInMapsWorker(ObjectGuid guid, CreatureData const* data, GameEventCreatureData* event_data, bool activate)
@@ -1018,16 +1057,7 @@ struct GameEventUpdateCreatureDataInMapsWorker
 
     void operator()(Map* map)
     {
-        if (Creature* pCreature = map->GetCreature(i_guid))
-        {
-            pCreature->UpdateEntry(i_data->id, TEAM_NONE, i_data, i_activate ? i_event_data : NULL);
-
-            // spells not casted for event remove case (sent NULL into update), do it
-            if (!i_activate)
-            {
-                pCreature->ApplyGameEventSpells(i_event_data, false);
-            }
-        }
+        UpdateCreatureDataInMap(map, i_guid, i_data, i_event_data, i_activate);
     }
 
     ObjectGuid i_guid;
@@ -1054,11 +1084,204 @@ void GameEventMgr::UpdateCreatureData(int16 event_id, bool activate)
         }
 
         // Update if spawned
+        if (QueueMapWork(GAME_EVENT_WORK_UPDATE_CREATURE, data->mapid, itr->first, activate, &itr->second))
+        {
+            continue;
+        }
+
         GameEventUpdateCreatureDataInMapsWorker worker(data->GetObjectGuid(itr->first), data, &itr->second, activate);
         sMapMgr.DoForAllMapsWithMapId(data->mapid, worker);
     }
 }
 
+/**
+ * @brief Starts tracking the map work of an event start or stop.
+ *
+ * With a map update budget configured, the spawns, despawns and creature
+ * updates that follow are queued to each loaded copy of their map instead of
+ * being applied at once; see QueueMapWork().
+ *
+ * @param event_id The event id being started or stopped.
+ * @param activate True for a start, false for a stop.
+ */
+void GameEventMgr::BeginTransition(uint16 event_id, bool activate)
+{
+    // at server startup nothing else is running yet, apply at once as before
+    if (!m_IsGameEventsInit || !sWorld.getConfig(CONFIG_UINT32_EVENT_MAP_UPDATE_BUDGET))
+    {
+        return;
+    }
+
+    std::lock_guard<std::mutex> guard(m_transitionLock);
+    PruneTransitions();
+    m_transitions.emplace_back(event_id, activate, getMSTime());
+    m_currentTransition = &m_transitions.back();
+}
+
+/**
+ * @brief Ends queuing the map work of the current event start or stop.
+ */
+void GameEventMgr::EndTransition()
+{
+    if (GameEventTransition* transition = m_currentTransition)
+    {
+        m_currentTransition = NULL;
+        CompleteMapWork(transition);                        // the extra count held while queuing
+    }
+}
+
+/**
+ * @brief Queues one object's share of the current event start or stop to every loaded copy of its map.
+ *
+ * @param type What to do with the object.
+ * @param mapId The map id of the object's spawn.
+ * @param dbGuid The object's database guid.
+ * @param activate True to apply event creature data; false to remove it.
+ * @param eventData The event creature data, for creature updates.
+ * @return True if queued, false if the caller should apply it at once.
+ */
+bool GameEventMgr::QueueMapWork(GameEventMapWorkType type, uint32 mapId, uint32 dbGuid, bool activate /*= false*/, GameEventCreatureData const* eventData /*= NULL*/)
+{
+    if (!m_currentTransition)
+    {
+        return false;
+    }
+
+    GameEventMapWork work;
+    work.type = type;
+    work.dbGuid = dbGuid;
+    work.activate = activate;
+    work.eventData = eventData;
+    work.transition = m_currentTransition;
+
+    auto queueToMap = [&work](Map* map)
+    {
+        work.transition->Queue();
+        map->QueueGameEventWork(work);
+    };
+    sMapMgr.DoForAllMapsWithMapId(mapId, queueToMap);
+    return true;
+}
+
+/**
+ * @brief Applies one queued piece of an event start or stop, on the map's update thread.
+ *
+ * @param map The map copy the work was queued to.
+ * @param work The work item.
+ */
+void GameEventMgr::ApplyMapWork(Map* map, GameEventMapWork const& work)
+{
+    switch (work.type)
+    {
+        case GAME_EVENT_WORK_SPAWN_CREATURE:
+            if (CreatureData const* data = sObjectMgr.GetCreatureData(work.dbGuid))
+            {
+                Creature::SpawnInMap(map, work.dbGuid, data);
+            }
+            break;
+        case GAME_EVENT_WORK_DESPAWN_CREATURE:
+            if (CreatureData const* data = sObjectMgr.GetCreatureData(work.dbGuid))
+            {
+                Creature::AddToRemoveListInMap(map, work.dbGuid, data);
+            }
+            break;
+        case GAME_EVENT_WORK_SPAWN_GAMEOBJECT:
+            if (GameObjectData const* data = sObjectMgr.GetGOData(work.dbGuid))
+            {
+                GameObject::SpawnInMap(map, work.dbGuid, data);
+            }
+            break;
+        case GAME_EVENT_WORK_DESPAWN_GAMEOBJECT:
+            if (GameObjectData const* data = sObjectMgr.GetGOData(work.dbGuid))
+            {
+                GameObject::AddToRemoveListInMap(map, work.dbGuid, data);
+            }
+            break;
+        case GAME_EVENT_WORK_UPDATE_CREATURE:
+            if (CreatureData const* data = sObjectMgr.GetCreatureData(work.dbGuid))
+            {
+                UpdateCreatureDataInMap(map, data->GetObjectGuid(work.dbGuid), data, work.eventData, work.activate);
+            }
+            break;
+    }
+
+    CompleteMapWork(work.transition);
+}
+
+/**
+ * @brief Counts a queued piece of work as done without applying it, for a map being unloaded.
+ *
+ * @param work The work item.
+ */
+void GameEventMgr::DiscardMapWork(GameEventMapWork const& work)
+{
+    CompleteMapWork(work.transition);
+}
+
+/**
+ * @brief Counts one piece of an event start or stop as done, logging when it was the last.
+ *
+ * @param transition The event start or stop.
+ */
+void GameEventMgr::CompleteMapWork(GameEventTransition* transition)
+{
+    // Once the last piece is counted the transition may be pruned by another
+    // thread, so take what the log needs first. The extra count held while
+    // queuing keeps it pending until queuing has ended.
+    uint16 event_id = transition->eventId;
+    bool activate = transition->activate;
+    uint32 startTime = transition->startTime;
+    uint32 queued = transition->queued.load();
+
+    if (transition->Complete())
+    {
+        sLog.outString("GameEvent %u \"%s\" %s in all maps: %u map updates in %u ms.", event_id, mGameEvent[event_id].description.c_str(),
+            activate ? "started" : "removed", queued - 1, getMSTimeDiff(startTime, getMSTime()));
+    }
+}
+
+/**
+ * @brief Drops the event starts and stops applied in every map. Needs m_transitionLock.
+ */
+void GameEventMgr::PruneTransitions()
+{
+    for (std::list<GameEventTransition>::iterator itr = m_transitions.begin(); itr != m_transitions.end();)
+    {
+        if (&*itr != m_currentTransition && itr->IsDone())
+        {
+            itr = m_transitions.erase(itr);
+        }
+        else
+        {
+            ++itr;
+        }
+    }
+}
+
+/**
+ * @brief Lists the event starts and stops still being applied in some map.
+ *
+ * @return One entry per event start or stop, oldest first.
+ */
+std::vector<GameEventMgr::TransitionProgress> GameEventMgr::GetPendingTransitions()
+{
+    std::vector<TransitionProgress> pending;
+
+    std::lock_guard<std::mutex> guard(m_transitionLock);
+    PruneTransitions();
+    for (std::list<GameEventTransition>::const_iterator itr = m_transitions.begin(); itr != m_transitions.end(); ++itr)
+    {
+        TransitionProgress progress;
+        progress.eventId = itr->eventId;
+        progress.activate = itr->activate;
+        progress.queued = itr->queued.load() - 1;
+        progress.applied = std::min(itr->applied.load(), progress.queued);
+        progress.elapsed = getMSTimeDiff(itr->startTime, getMSTime());
+        pending.push_back(progress);
+    }
+    return pending;
+}
+
 /**
  * @brief Toggles event-specific quest availability.
  *
@@ -1190,6 +1413,7 @@ int16 GameEventMgr::GetGameEventId<Pool>(uint32 guid_or_poolid)
 GameEventMgr::GameEventMgr()
 {
     m_IsGameEventsInit = false;
+    m_currentTransition = NULL;
 }
 
 /**
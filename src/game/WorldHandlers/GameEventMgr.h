@@ -33,13 +33,17 @@
 #include <map>
 #include <set>
 #include <list>
+#include <atomic>
+#include <mutex>
 #include "SharedDefines.h"
 #include "Platform/Define.h"
+#include "Timer.h"
 
 #define max_ge_check_delay 86400                            // 1 day in seconds
 
 class Creature;
 class GameObject;
+class Map;
 class MapPersistentState;
 
 struct GameEventData
@@ -78,6 +82,81 @@ struct GameEventMail
 
 typedef std::pair<uint32, GameEventCreatureData> GameEventCreatureDataPair;
 
+/// What a game event start or stop has left to do in one map copy
+enum GameEventMapWorkType
+{
+    GAME_EVENT_WORK_SPAWN_CREATURE,
+    GAME_EVENT_WORK_DESPAWN_CREATURE,
+    GAME_EVENT_WORK_SPAWN_GAMEOBJECT,
+    GAME_EVENT_WORK_DESPAWN_GAMEOBJECT,
+    GAME_EVENT_WORK_UPDATE_CREATURE                         // apply or restore event entry, equipment or model
+};
+
+/// Progress of one game event start or stop through the maps
+struct GameEventTransition
+{
+    GameEventTransition(uint16 _eventId, bool _activate, uint32 _startTime)
+        : eventId(_eventId), activate(_activate), startTime(_startTime), queued(1), applied(0), pending(1) {}
+
+    uint16 eventId;
+    bool activate;
+    uint32 startTime;                                       // getMSTime()
+    std::atomic<uint32> queued;                             // one extra while work is still being queued
+    std::atomic<uint32> applied;
+    std::atomic<uint32> pending;                            // queued - applied, counted down by the maps
+
+    /// Counts one more piece of work queued to a map
+    void Queue() { ++queued; ++pending; }
+    /// Counts one piece as applied; true for the piece that finished the transition, after which it may be pruned
+    bool Complete() { ++applied; return --pending == 0; }
+    bool IsDone() const { return pending.load() == 0; }
+};
+
+/// One object of a game event, in one map copy, applied by that map's update
+struct GameEventMapWork
+{
+    GameEventMapWorkType type;
+    uint32 dbGuid;
+    bool activate;                                          // GAME_EVENT_WORK_UPDATE_CREATURE only
+    GameEventCreatureData const* eventData;                 // GAME_EVENT_WORK_UPDATE_CREATURE only
+    GameEventTransition* transition;
+};
+
+/**
+ * @brief Applies the game event work queued to one map copy until a time budget is spent.
+ *
+ * Items are applied in queue order, at least one per call, so a large holiday
+ * reaches every loaded copy of its map over a few updates instead of stalling one
+ * tick. Map::ProcessGameEventWork drains its queue with this.
+ *
+ * @param queue The map copy's queue; anything with a next(GameEventMapWork&).
+ * @param budget Milliseconds after which no further item is started.
+ * @param apply Called with each item taken from the queue.
+ * @param clock Returns the current time in milliseconds, as getMSTime() does.
+ * @return The number of items applied.
+ */
+template<class Queue, class Apply, class Clock>
+uint32 ApplyGameEventWork(Queue& queue, uint32 budget, Apply apply, Clock clock)
+{
+    uint32 startTime = clock();
+    uint32 count = 0;
+
+    GameEventMapWork work;
+    do
+    {
+        if (!queue.next(work))
+        {
+            break;
+        }
+
+        apply(work);
+        ++count;
+    }
+    while (getMSTimeDiff(startTime, clock()) < budget);
+
+    return count;
+}
+
 class GameEventMgr
 {
     public:
@@ -102,6 +181,21 @@ class GameEventMgr
             int16 GetGameEventId(uint32 guid_or_poolid);
 
         GameEventCreatureData const* GetCreatureUpdateDataForActiveEvent(uint32 lowguid) const;
+
+        // Map side of event starts and stops, see Map::ProcessGameEventWork
+        void ApplyMapWork(Map* map, GameEventMapWork const& work);
+        void DiscardMapWork(GameEventMapWork const& work);
+
+        /// Event starts and stops not yet applied in every map, for .event progress
+        struct TransitionProgress
+        {
+            uint16 eventId;
+            bool activate;
+            uint32 queued;
+            uint32 applied;
+            uint32 elapsed;                                 // ms
+        };
+        std::vector<TransitionProgress> GetPendingTransitions();
     private:
         void ApplyNewEvent(uint16 event_id, bool resume);
         void UnApplyEvent(uint16 event_id);
@@ -110,6 +204,11 @@ class GameEventMgr
         void UpdateCreatureData(int16 event_id, bool activate);
         void UpdateEventQuests(uint16 event_id, bool activate);
         void SendEventMails(int16 event_id);
+        void BeginTransition(uint16 event_id, bool activate);
+        void EndTransition();
+        bool QueueMapWork(GameEventMapWorkType type, uint32 mapId, uint32 dbGuid, bool activate = false, GameEventCreatureData const* eventData = NULL);
+        void CompleteMapWork(GameEventTransition* transition);
+        void PruneTransitions();
         // To implement for GameObjectAI - see code in CMangos
         // void OnEventHappened(uint16 event_id, bool activate, bool resume);
         // void ComputeEventStartAndEndTime(GameEventData& data);
@@ -141,6 +240,10 @@ class GameEventMgr
         GameEventDataMap  mGameEvent;
         ActiveEvents m_ActiveEvents;
         bool m_IsGameEventsInit;
+
+        std::list<GameEventTransition> m_transitions;       // guarded by m_transitionLock, nodes stay put for queued work
+        std::mutex m_transitionLock;
+        GameEventTransition* m_currentTransition;           // set while a start or stop queues its map work
 };
 
 #define sGameEventMgr MaNGOS::Singleton<GameEventMgr>::Instance()
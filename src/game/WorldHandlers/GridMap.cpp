@@ -519,6 +519,13 @@ bool TerrainInfo::IsInLineOfSight(float x1, float y1, float z1, float x2, float
     return m_terrain.IsInLineOfSight(x1, y1, z1, x2, y2, z2);
 }
 
+void TerrainInfo::IsInLineOfSight(Geometry::Vector3 const& from,
+                                  std::vector<Geometry::Vector3> const& targets,
+                                  std::vector<uint8>& clear) const
+{
+    m_terrain.IsInLineOfSight(from, targets, clear);
+}
+
 float TerrainInfo::NearestHitFraction(float x1, float y1, float z1, float x2, float y2,
                                       float z2) const
 {
@@ -233,6 +233,10 @@ class TerrainInfo : public Referencable<AtomicLong>
         bool IsInLineOfSight(float x1, float y1, float z1, float x2, float y2, float z2) const;
         float NearestHitFraction(float x1, float y1, float z1, float x2, float y2, float z2) const;
 
+        // Static line of sight from one point to many; see FusedTerrain for the mask.
+        void IsInLineOfSight(Geometry::Vector3 const& from, std::vector<Geometry::Vector3> const& targets,
+                             std::vector<uint8>& clear) const;
+
         // Ages the tile cache and reclaims what no active grid holds.
         void CleanUpGrids(const uint32 diff);
 
@@ -43,6 +43,7 @@
  * @see Map for grid management
  */
 
+#include <algorithm>
 #include <set>
 #include "GridNotifiers.h"
 #include "WorldPacket.h"
@@ -107,7 +108,7 @@ void VisibleNotifier::Notify()
     data.AddOutOfRangeGUID(i_clientGUIDs);
     for (GuidSet::iterator itr = i_clientGUIDs.begin(); itr != i_clientGUIDs.end(); ++itr)
     {
-        player.m_clientGUIDs.erase(*itr);
+        player.RemoveClientGuid(*itr);
 
         DEBUG_FILTER_LOG(LOG_FILTER_VISIBILITY_CHANGES, "%s is out of range (no in active cells set) now for %s",
             itr->GetString().c_str(), player.GetGuidStr().c_str());
@@ -116,15 +117,20 @@ void VisibleNotifier::Notify()
     if (data.HasData())
     {
         // send create/outofrange packet to player (except player create updates that already sent using SendUpdateToPlayer)
-        WorldPacket packet;
-        bool const built = BuildPacket(&packet);
-        if (i_initialBatch && !built)
+        // A session that reads no object updates (a bot) skips the packet, not what follows
+        // it; the initial batch is still built, since Map::Add waits on it being sent.
+        if (i_initialBatch || player.GetSession()->WantsOpcode(SMSG_UPDATE_OBJECT))
         {
-            sLog.outError("Failed to build initial object update batch for player %u", player.GetGUIDLow());
-            player.GetSession()->KickPlayer();
-            return;
+            WorldPacket packet;
+            bool const built = BuildPacket(&packet);
+            if (i_initialBatch && !built)
+            {
+                sLog.outError("Failed to build initial object update batch for player %u", player.GetGUIDLow());
+                player.GetSession()->KickPlayer();
+                return;
+            }
+            player.GetSession()->SendPacket(&packet);
         }
-        player.GetSession()->SendPacket(&packet);
 
         // send out of range to other players if need
         GuidSet const& oor = data.GetOutOfRangeGUIDs();
@@ -222,6 +228,24 @@ void ObjectMessageDeliverer::Visit(CameraMapType& m)
     }
 }
 
+/**
+ * @brief Collects camera owners whose client holds the object.
+ *
+ * @param m The camera map to visit.
+ */
+void ObserverCollector::Visit(CameraMapType& m)
+{
+    for (CameraMapType::iterator iter = m.begin(); iter != m.end(); ++iter)
+    {
+        Player* owner = iter->getSource()->GetOwner();
+        if (owner != &i_object && owner->HaveAtClient(&i_object) &&
+            std::find(i_found.begin(), i_found.end(), owner) == i_found.end())
+        {
+            i_found.push_back(owner);
+        }
+    }
+}
+
 /**
  * @brief Delivers a packet to nearby cameras within an optional distance filter.
  *
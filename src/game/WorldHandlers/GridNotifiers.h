@@ -101,6 +101,17 @@ namespace MaNGOS
         template<class SKIP> void Visit(GridRefManager<SKIP>&) {}
     };
 
+    // Collects the camera owners a grid broadcast would reach and whose client holds
+    // the object -- what its observer list should contain. Map::CheckObservers only.
+    struct ObserverCollector
+    {
+        WorldObject const& i_object;
+        std::vector<Player*>& i_found;
+        ObserverCollector(WorldObject const& obj, std::vector<Player*>& found) : i_object(obj), i_found(found) {}
+        void Visit(CameraMapType& m);
+        template<class SKIP> void Visit(GridRefManager<SKIP>&) {}
+    };
+
     struct MessageDistDeliverer
     {
         Player const& i_player;
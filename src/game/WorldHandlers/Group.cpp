@@ -64,6 +64,7 @@
 #include "LootMgr.h"
 #include "LFGMgr.h"
 #include "LFGHandler.h"
+#include "SharedPacket.h"
 
 #ifdef ENABLE_ELUNA
 #include "LuaEngine.h"
@@ -1748,6 +1749,8 @@ void Group::UpdatePlayerOutOfRange(Player* pPlayer)
  */
 void Group::BroadcastPacket(WorldPacket* packet, bool ignorePlayersInBGRaid, int group, ObjectGuid ignore)
 {
+    proto::SharedPacketScope shared(*packet);
+
     for (GroupReference* itr = GetFirstMember(); itr != NULL; itr = itr->next())
     {
         Player* pl = itr->getSource();
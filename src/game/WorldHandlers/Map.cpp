@@ -75,12 +75,18 @@
 #include "ObjectGridLoader.h"
 #include "LivingWorldCellEnvelope.h"
 #include "Corpse.h"
+#include "SharedPacket.h"
 
 #ifdef ENABLE_ELUNA
 #include "LuaEngine.h"
 #include "ElunaConfig.h"
 #include "ElunaLoader.h"
 #endif /* ENABLE_ELUNA */
+#ifdef ENABLE_PLAYERBOTS
+#include "PlayerbotAIConfig.h"
+#include "PlayerbotPerformanceMonitor.h"
+#include "PlayerbotUpdateScheduler.h"
+#endif
 
 /**
  * @brief Map destructor
@@ -125,6 +131,12 @@ Map::~Map()
         sScriptMgr.DecreaseScheduledScriptCount(m_scriptSchedule.size());
     }
 
+    GameEventMapWork work;
+    while (m_gameEventWork.next(work))
+    {
+        sGameEventMgr.DiscardMapWork(work);
+    }
+
     if (m_persistentState)
     {
         m_persistentState->SetUsedByMapState(NULL);          // field pointer can be deleted after this
@@ -242,6 +254,8 @@ void Map::InitVisibilityDistance()
 {
     // init visibility for continents
     m_VisibleDistance = World::GetMaxVisibleDistanceOnContinents();
+    m_visibilityScheduler.SetInterval(World::GetVisibilityUpdateIntervalOnContinents());
+    m_visibilityScheduler.SetBatchLimit(World::GetVisibilityUpdateBatchLimit());
 }
 
 /**
@@ -719,6 +733,7 @@ bool Map::Add(Player* player, InitialWorldEntryHook* initialEntry)
     EnsureGridLoadedAtEnter(cell, player);
     PromoteEnvelopeNeighboursToFull(cell.GridX(), cell.GridY());
     player->AddToWorld();
+    RelinkObservers(player);
 
     // The hook needs committed membership to derive the correct world anchor,
     // but must finish its preamble before any object block enters the batch.
@@ -803,6 +818,7 @@ template<class T>
 
     AddToGrid(obj, grid, cell);
     obj->AddToWorld();
+    RelinkObservers(obj);
 
     if (obj->IsActiveObject())
     {
@@ -817,6 +833,44 @@ template<class T>
     obj->SetAsNewObject(false);
 }
 
+/**
+ * @brief Re-links an object that has just joined this map to the players who hold it.
+ *
+ * Without this a player who crossed a seam keeps every guid in m_clientGUIDs, so
+ * AddClientObject never fires for them again and MessageBroadcast stops reaching the
+ * player from objects still in plain view. Both directions: what a player holds, and
+ * who holds the object.
+ *
+ * @param obj The object just added to the world on this map.
+ */
+void Map::RelinkObservers(WorldObject* obj)
+{
+    if (Player* player = obj->ToPlayer())
+    {
+        for (GuidSet::const_iterator itr = player->m_clientGUIDs.begin(); itr != player->m_clientGUIDs.end(); ++itr)
+        {
+            if (WorldObject* target = GetWorldObject(*itr))
+            {
+                player->LinkClientObject(target);
+            }
+        }
+    }
+
+    if (!obj->HasObserverList())
+    {
+        return;
+    }
+
+    for (MapRefManager::iterator itr = m_mapRefManager.begin(); itr != m_mapRefManager.end(); ++itr)
+    {
+        Player* viewer = itr->getSource();
+        if (viewer && viewer != obj && viewer->HaveAtClient(obj))
+        {
+            viewer->LinkClientObject(obj);
+        }
+    }
+}
+
 /**
  * @brief Broadcasts a packet from a player to nearby visible objects.
  *
@@ -826,6 +880,24 @@ template<class T>
  */
 void Map::MessageBroadcast(Player const* player, WorldPacket* msg, bool to_self)
 {
+    proto::SharedPacketScope shared(*msg);                 // one payload for every recipient
+
+    // The visibility system already knows exactly who holds this player; the grid
+    // walk below is only for the rare object that keeps no observer list.
+    if (player->HasObserverList())
+    {
+        if (to_self)
+        {
+            if (WorldSession* session = player->GetSession())
+            {
+                session->SendPacket(msg);
+            }
+        }
+
+        SendToObservers(player, msg);
+        return;
+    }
+
     CellPair p = MaNGOS::ComputeCellPair(player->Where().X(), player->Where().Y());
 
     if (p.x_coord >= TOTAL_NUMBER_OF_CELLS_PER_MAP || p.y_coord >= TOTAL_NUMBER_OF_CELLS_PER_MAP)
@@ -855,6 +927,14 @@ void Map::MessageBroadcast(Player const* player, WorldPacket* msg, bool to_self)
  */
 void Map::MessageBroadcast(WorldObject const* obj, WorldPacket* msg)
 {
+    proto::SharedPacketScope shared(*msg);
+
+    if (obj->HasObserverList())
+    {
+        SendToObservers(obj, msg);
+        return;
+    }
+
     CellPair p = MaNGOS::ComputeCellPair(obj->Where().X(), obj->Where().Y());
 
     if (p.x_coord >= TOTAL_NUMBER_OF_CELLS_PER_MAP || p.y_coord >= TOTAL_NUMBER_OF_CELLS_PER_MAP)
@@ -878,6 +958,87 @@ void Map::MessageBroadcast(WorldObject const* obj, WorldPacket* msg)
     cell.Visit(p, message, *this, *obj, GetBroadcastRadius());
 }
 
+/**
+ * @brief Sends a packet to every player whose client holds the object.
+ *
+ * @param obj The source world object.
+ * @param msg The packet to send.
+ */
+void Map::SendToObservers(WorldObject const* obj, WorldPacket* msg)
+{
+    std::vector<Player*> const& observers = obj->GetObservers();
+    for (std::vector<Player*>::const_iterator itr = observers.begin(); itr != observers.end(); ++itr)
+    {
+        WorldSession* session = (*itr)->GetSession();
+        if (session && session->WantsOpcode(msg->GetOpcode()))
+        {
+            session->SendPacket(msg);
+        }
+    }
+}
+
+/**
+ * @brief Compares an object's observer list against the grid visit it replaces.
+ *
+ * Walks the cells a grid broadcast would visit and collects every camera owner whose
+ * client holds the object, then reports who the list is missing and who it holds
+ * that the grid did not find. Extras can be legitimate -- a far-sight camera or a
+ * viewer beyond the broadcast radius still holds the object -- missing entries never
+ * are. Debug aid only; it does the very walk the list exists to avoid.
+ *
+ * @param obj The object to check.
+ * @param missing Receives players the grid found that the list does not hold.
+ * @param extra Receives players the list holds that the grid did not find.
+ * @return The number of entries whose own m_clientGUIDs disagrees with the list.
+ */
+uint32 Map::CheckObservers(WorldObject const* obj, std::vector<Player*>& missing, std::vector<Player*>& extra)
+{
+    missing.clear();
+    extra.clear();
+
+    std::vector<Player*> const& observers = obj->GetObservers();
+
+    uint32 broken = 0;
+    for (std::vector<Player*>::const_iterator itr = observers.begin(); itr != observers.end(); ++itr)
+    {
+        if (!(*itr)->HaveAtClient(obj) || (*itr)->FindMap() != this)
+        {
+            ++broken;
+        }
+    }
+
+    CellPair p = MaNGOS::ComputeCellPair(obj->Where().X(), obj->Where().Y());
+    if (p.x_coord >= TOTAL_NUMBER_OF_CELLS_PER_MAP || p.y_coord >= TOTAL_NUMBER_OF_CELLS_PER_MAP)
+    {
+        return broken;
+    }
+
+    std::vector<Player*> found;
+    Cell cell(p);
+    cell.SetNoCreate();
+    MaNGOS::ObserverCollector collector(*obj, found);
+    TypeContainerVisitor<MaNGOS::ObserverCollector, WorldTypeMapContainer > visitor(collector);
+    cell.Visit(p, visitor, *this, *obj, GetBroadcastRadius());
+
+    for (std::vector<Player*>::const_iterator itr = found.begin(); itr != found.end(); ++itr)
+    {
+        if (std::find(observers.begin(), observers.end(), *itr) == observers.end())
+        {
+            missing.push_back(*itr);
+        }
+    }
+
+    for (std::vector<Player*>::const_iterator itr = observers.begin(); itr != observers.end(); ++itr)
+    {
+        if (std::find(found.begin(), found.end(), *itr) == found.end())
+        {
+            extra.push_back(*itr);
+        }
+    }
+
+    return broken;
+}
+
 /**
  * @brief Broadcasts a packet from a player to objects within a fixed distance.
  *
@@ -889,6 +1050,8 @@ void Map::MessageBroadcast(WorldObject const* obj, WorldPacket* msg)
  */
 void Map::MessageDistBroadcast(Player const* player, WorldPacket* msg, float dist, bool to_self, bool own_team_only)
 {
+    proto::SharedPacketScope shared(*msg);
+
     CellPair p = MaNGOS::ComputeCellPair(player->Where().X(), player->Where().Y());
 
     if (p.x_coord >= TOTAL_NUMBER_OF_CELLS_PER_MAP || p.y_coord >= TOTAL_NUMBER_OF_CELLS_PER_MAP)
@@ -919,6 +1082,8 @@ void Map::MessageDistBroadcast(Player const* player, WorldPacket* msg, float dis
  */
 void Map::MessageDistBroadcast(WorldObject const* obj, WorldPacket* msg, float dist)
 {
+    proto::SharedPacketScope shared(*msg);
+
     CellPair p = MaNGOS::ComputeCellPair(obj->Where().X(), obj->Where().Y());
 
     if (p.x_coord >= TOTAL_NUMBER_OF_CELLS_PER_MAP || p.y_coord >= TOTAL_NUMBER_OF_CELLS_PER_MAP)
@@ -990,6 +1155,8 @@ void Map::VisitNearbyCellsOf(WorldObject* obj,
  */
 void Map::Update(const uint32& t_diff)
 {
+    m_tickProfile.BeginTick();
+
     /// update worldsessions for existing players
     for (m_mapRefIter = m_mapRefManager.begin(); m_mapRefIter != m_mapRefManager.end(); ++m_mapRefIter)
     {
@@ -1002,6 +1169,14 @@ void Map::Update(const uint32& t_diff)
             pSession->Update(updater);
         }
     }
+    m_tickProfile.Mark(MAP_TICK_SESSIONS);
+
+#ifdef ENABLE_PLAYERBOTS
+    // Bot AI is evaluated inside Player::Update below, so this loop is the tick the bot
+    // budget covers. Past it, bots are deferred rather than the real players on this map.
+    ai::PlayerbotUpdateScheduler& botScheduler = ai::ThreadPlayerbotUpdateScheduler();
+    botScheduler.BeginTick(uint64(sPlayerbotAIConfig.mapTickBudgetMs) * 1000, sPlayerbotAIConfig.maxDeferredTicks);
+#endif
 
     /// update players at tick
     for (m_mapRefIter = m_mapRefManager.begin(); m_mapRefIter != m_mapRefManager.end(); ++m_mapRefIter)
@@ -1014,6 +1189,17 @@ void Map::Update(const uint32& t_diff)
         }
     }
 
+#ifdef ENABLE_PLAYERBOTS
+    if (uint64 overrunMicros = botScheduler.EndTick())
+    {
+        if (sPlayerbotAIConfig.performanceMetricsInterval)
+        {
+            ai::sPlayerbotPerformanceMonitor.RecordAiBudgetOverrun(overrunMicros);
+        }
+    }
+#endif
+    m_tickProfile.Mark(MAP_TICK_PLAYERS);
+
     /// update active cells around players and active objects
     resetMarkedCells();
 
@@ -1035,6 +1221,7 @@ void Map::Update(const uint32& t_diff)
         }
 
         VisitNearbyCellsOf(plr, grid_object_update, world_object_update);
+        m_tickProfile.Mark(MAP_TICK_CELLS);
 
         // Collect and remove references to creatures too far away from player's m_HostileRefManager
         // Combat state will change on next tick, if case
@@ -1067,8 +1254,10 @@ void Map::Update(const uint32& t_diff)
 
                 VisitNearbyCellsOf(*it, grid_object_update, world_object_update);
             }
+            m_tickProfile.Mark(MAP_TICK_HOSTILE_REFS);
         }
     }
+    m_tickProfile.Mark(MAP_TICK_CELLS);
 
     // non-player active objects
     if (!m_activeNonPlayers.empty())
@@ -1090,9 +1279,15 @@ void Map::Update(const uint32& t_diff)
             VisitNearbyCellsOf(obj, grid_object_update, world_object_update);
         }
     }
+    m_tickProfile.Mark(MAP_TICK_ACTIVE_OBJECTS);
+
+    ///- Visibility of the units that moved since the last pass, before their create/destroy blocks go out
+    ProcessVisibilityUpdates(t_diff);
+    m_tickProfile.Mark(MAP_TICK_VISIBILITY);
 
     // Send world objects and item update field changes
     SendObjectUpdates();
+    m_tickProfile.Mark(MAP_TICK_OBJECT_UPDATES);
 
     // Don't unload grids if it's battleground, since we may have manually added GOs,creatures, those doesn't load from DB at grid re-load !
     // This isn't really bother us, since as soon as we have instanced BG-s, the whole map unloads as the BG gets ended
@@ -1108,13 +1303,22 @@ void Map::Update(const uint32& t_diff)
         }
     }
 
+    m_tickProfile.Mark(MAP_TICK_GRID_STATES);
+
     ProcessPendingCellUnloads();
+    m_tickProfile.Mark(MAP_TICK_CELL_UNLOADS);
+
+    ///- Apply what started or stopped game events left to do here
+    ProcessGameEventWork();
+    m_tickProfile.Mark(MAP_TICK_GAME_EVENTS);
 
     ///- Process necessary scripts
+    m_scriptSchedule.BeginTick();
     if (!m_scriptSchedule.empty())
     {
         ScriptsProcess();
     }
+    m_tickProfile.Mark(MAP_TICK_SCRIPTS);
 
 #ifdef ENABLE_ELUNA
     if (Eluna* e = GetEluna())
@@ -1127,13 +1331,16 @@ void Map::Update(const uint32& t_diff)
         e->OnMapUpdate(this, t_diff);
     }
 #endif /* ENABLE_ELUNA */
+    m_tickProfile.Mark(MAP_TICK_ELUNA);
 
     if (i_data)
     {
         i_data->Update(t_diff);
     }
+    m_tickProfile.Mark(MAP_TICK_INSTANCE_DATA);
 
     m_weatherSystem->UpdateWeathers(t_diff);
+    m_tickProfile.Mark(MAP_TICK_WEATHER);
 
     // LAST ACT, and it must stay last: every vessel sailing this map takes its tick here,
     // and that tick runs the vessel's deck map nested inside it. A deckhand's spell can
@@ -1157,6 +1364,18 @@ void Map::Update(const uint32& t_diff)
             }
         }
     }
+    m_tickProfile.Mark(MAP_TICK_TRANSPORTS);
+
+    uint64 tickMicros = m_tickProfile.EndTick();
+    if (uint32 slowTickMs = MapTickProfile::GetSlowTickThreshold())
+    {
+        if (tickMicros >= uint64(slowTickMs) * 1000)
+        {
+            m_tickProfile.CaptureSlowTick();
+            sLog.outMapTick("Map %u instance %u: slow tick " UI64FMTD " us, %u players: %s", GetId(), GetInstanceId(),
+                tickMicros, GetPlayersCountExceptGMs(), m_tickProfile.FormatSlowTick().c_str());
+        }
+    }
 }
 
 /**
@@ -1198,6 +1417,12 @@ void Map::Remove(Player* player, bool remove)
         m_mapRefIter = m_mapRefIter->nocheck_prev();
     }
     player->GetMapRef().unlink();
+
+    // Observer links never cross a map, so both sides go here, before any early
+    // return. The guids stay in m_clientGUIDs; only the pointers are dropped.
+    player->DetachObservers();
+    player->DetachObservedObjects();
+
     CellPair p = MaNGOS::ComputeCellPair(player->Where().X(), player->Where().Y());
     if (p.x_coord >= TOTAL_NUMBER_OF_CELLS_PER_MAP || p.y_coord >= TOTAL_NUMBER_OF_CELLS_PER_MAP)
     {
@@ -1278,6 +1503,7 @@ template<class T>
     }
 
     UpdateObjectVisibility(obj, cell, p);                   // i think will be better to call this function while object still in grid, this changes nothing but logically is better(as for me)
+    obj->DetachObservers();
     RemoveFromGrid(obj, grid, cell);
 
     obj->ResetMap();
@@ -2159,6 +2385,7 @@ uint32 Map::GetPlayersCountExceptGMs() const
  */
 void Map::SendToPlayers(WorldPacket const* data) const
 {
+    proto::SharedPacketScope shared(*data);
     for (MapRefManager::const_iterator itr = m_mapRefManager.begin(); itr != m_mapRefManager.end(); ++itr)
     {
         itr->getSource()->GetSession()->SendPacket(data);
@@ -2493,6 +2720,8 @@ void DungeonMap::InitVisibilityDistance()
 {
     // init visibility distance for instances
     m_VisibleDistance = World::GetMaxVisibleDistanceInInstances();
+    m_visibilityScheduler.SetInterval(World::GetVisibilityUpdateIntervalInInstances());
+    m_visibilityScheduler.SetBatchLimit(World::GetVisibilityUpdateBatchLimit());
 }
 
 /**
@@ -2854,6 +3083,8 @@ void BattleGroundMap::InitVisibilityDistance()
 {
     // init visibility distance for BG/Arenas
     m_VisibleDistance = World::GetMaxVisibleDistanceInBGArenas();
+    m_visibilityScheduler.SetInterval(World::GetVisibilityUpdateIntervalInBGArenas());
+    m_visibilityScheduler.SetBatchLimit(World::GetVisibilityUpdateBatchLimit());
 }
 
 /**
@@ -2990,15 +3221,12 @@ bool Map::ScriptsStart(DBScriptType type, uint32 id, Object* source, Object* tar
 
     if (execParams)                                         // Check if the execution should be uniquely
     {
-        for (ScriptScheduleMap::const_iterator searchItr = m_scriptSchedule.begin(); searchItr != m_scriptSchedule.end(); ++searchItr)
+        if (m_scriptSchedule.IsScheduled(type, id,
+            (execParams & SCRIPT_EXEC_PARAM_UNIQUE_BY_SOURCE) ? sourceGuid : ObjectGuid(),
+            (execParams & SCRIPT_EXEC_PARAM_UNIQUE_BY_TARGET) ? targetGuid : ObjectGuid(), ownerGuid))
         {
-            if (searchItr->second.IsSameScript(type, id,
-                (execParams & SCRIPT_EXEC_PARAM_UNIQUE_BY_SOURCE) ? sourceGuid : ObjectGuid(),
-                (execParams & SCRIPT_EXEC_PARAM_UNIQUE_BY_TARGET) ? targetGuid : ObjectGuid(), ownerGuid))
-            {
-                DEBUG_FILTER_LOG(LOG_FILTER_DB_SCRIPTS, "DB-SCRIPTS: Process table `dbscripts [type=%d]` id %u. Skip script as script already started for source %s, target %s - ScriptsStartParams %u", type, id, sourceGuid.GetString().c_str(), targetGuid.GetString().c_str(), execParams);
-                return true;
-            }
+            DEBUG_FILTER_LOG(LOG_FILTER_DB_SCRIPTS, "DB-SCRIPTS: Process table `dbscripts [type=%d]` id %u. Skip script as script already started for source %s, target %s - ScriptsStartParams %u", type, id, sourceGuid.GetString().c_str(), targetGuid.GetString().c_str(), execParams);
+            return true;
         }
     }
 
@@ -3008,7 +3236,7 @@ bool Map::ScriptsStart(DBScriptType type, uint32 id, Object* source, Object* tar
     {
         ScriptAction sa(type, this, sourceGuid, targetGuid, ownerGuid, &(*iter));
 
-        m_scriptSchedule.insert(ScriptScheduleMap::value_type(time_t(sWorld.GetGameTime() + iter->delay), sa));
+        m_scriptSchedule.Add(time_t(sWorld.GetGameTime() + iter->delay), sa);
 
         sScriptMgr.IncreaseScheduledScriptsCount();
     }
@@ -3035,7 +3263,7 @@ void Map::ScriptCommandStart(ScriptInfo const& script, uint32 delay, Object* sou
 
     ScriptAction sa(DBS_INTERNAL, this, sourceGuid, targetGuid, ownerGuid, &script);
 
-    m_scriptSchedule.insert(ScriptScheduleMap::value_type(time_t(sWorld.GetGameTime() + delay), sa));
+    m_scriptSchedule.Add(time_t(sWorld.GetGameTime() + delay), sa);
 
     sScriptMgr.IncreaseScheduledScriptsCount();
 }
@@ -3052,40 +3280,115 @@ void Map::ScriptsProcess()
         return;
     }
 
-    ///- Process overdue queued scripts
-    ScriptScheduleMap::iterator iter = m_scriptSchedule.begin();
-    // ok as multimap is a *sorted* associative container
-    while (!m_scriptSchedule.empty() && (iter->first <= sWorld.GetGameTime()))
+    ///- Process overdue queued scripts, steps added meanwhile included
+    ScriptSchedule<ScriptAction>::StepId step;
+    while (ScriptAction* action = m_scriptSchedule.Next(sWorld.GetGameTime(), step))
     {
-        if (iter->second.HandleScriptStep())
+        if (action->HandleScriptStep())
         {
-            // Terminate following script steps of this script
-            DBScriptType type = iter->second.GetType();
-            uint32 id = iter->second.GetId();
-            ObjectGuid sourceGuid = iter->second.GetSourceGuid();
-            ObjectGuid targetGuid = iter->second.GetTargetGuid();
-            ObjectGuid ownerGuid = iter->second.GetOwnerGuid();
+            // Terminate following script steps of this script, this step included
+            size_t removed = m_scriptSchedule.RemoveScript(action->GetType(), action->GetId(),
+                             action->GetSourceGuid(), action->GetTargetGuid(), action->GetOwnerGuid());
 
-            for (ScriptScheduleMap::iterator rmItr = m_scriptSchedule.begin(); rmItr != m_scriptSchedule.end();)
-            {
-                if (rmItr->second.IsSameScript(type, id, sourceGuid, targetGuid, ownerGuid))
-                {
-                    m_scriptSchedule.erase(rmItr++);
-                    sScriptMgr.DecreaseScheduledScriptCount();
-                }
-                else
-                {
-                    ++rmItr;
-                }
-            }
+            sScriptMgr.DecreaseScheduledScriptCount(removed);
         }
         else
         {
-            m_scriptSchedule.erase(iter);
+            m_scriptSchedule.Finish(step);
 
             sScriptMgr.DecreaseScheduledScriptCount();
         }
-        iter = m_scriptSchedule.begin();
+    }
+}
+
+/**
+ * @brief Queues a game event spawn, despawn or creature update for this map copy.
+ *
+ * @param work The work item, see GameEventMgr::QueueMapWork.
+ */
+void Map::QueueGameEventWork(GameEventMapWork const& work)
+{
+    m_gameEventWork.add(work);
+}
+
+/**
+ * @brief Gets the number of queued game event work items.
+ *
+ * @return The number of items not yet applied.
+ */
+size_t Map::GetPendingGameEventWork() const
+{
+    return m_gameEventWork.size();
+}
+
+/**
+ * @brief Applies queued game event work until Event.MapUpdateBudget is spent.
+ *
+ * See ApplyGameEventWork() for the order and the at-least-one rule.
+ */
+void Map::ProcessGameEventWork()
+{
+    auto apply = [this](GameEventMapWork const& work)
+    {
+        sGameEventMgr.ApplyMapWork(this, work);
+    };
+    ApplyGameEventWork(m_gameEventWork, sWorld.getConfig(CONFIG_UINT32_EVENT_MAP_UPDATE_BUDGET), apply, getMSTime);
+}
+
+/**
+ * @brief Queues the visibility update of a unit that moved past the relocation limit.
+ *
+ * @param unit The relocated unit, on this map.
+ * @return false if this map updates visibility at relocation and the caller must do it now.
+ */
+bool Map::ScheduleVisibilityUpdate(Unit* unit)
+{
+    return m_visibilityScheduler.Schedule(unit->GetObjectGuid());
+}
+
+/**
+ * @brief Runs the visibility pass once Visibility.UpdateInterval.* has passed.
+ *
+ * The queued units are updated once each, in cell order, so consecutive
+ * updates visit the same cells while they are still warm. Units that left
+ * the map since they were queued are skipped.
+ *
+ * @param diff The elapsed update time in milliseconds.
+ */
+void Map::ProcessVisibilityUpdates(uint32 diff)
+{
+    if (!m_visibilityScheduler.Update(diff))
+    {
+        return;
+    }
+
+    std::vector<ObjectGuid> batch;
+    m_visibilityScheduler.TakeBatch(batch);
+
+    typedef std::pair<uint32, Unit*> CellUnit;
+    std::vector<CellUnit> units;
+    units.reserve(batch.size());
+    for (std::vector<ObjectGuid>::const_iterator itr = batch.begin(); itr != batch.end(); ++itr)
+    {
+        Unit* unit = GetUnit(*itr);
+        if (!unit || !unit->IsInWorld())
+        {
+            continue;
+        }
+
+        CellPair p = MaNGOS::ComputeCellPair(unit->Where().X(), unit->Where().Y());
+        units.push_back(CellUnit(p.y_coord * TOTAL_NUMBER_OF_CELLS_PER_MAP + p.x_coord, unit));
+    }
+
+    std::stable_sort(units.begin(), units.end(), [](CellUnit const& a, CellUnit const& b) { return a.first < b.first; });
+
+    for (std::vector<CellUnit>::const_iterator itr = units.begin(); itr != units.end(); ++itr)
+    {
+        Unit* unit = itr->second;
+        CellPair p(itr->first % TOTAL_NUMBER_OF_CELLS_PER_MAP, itr->first / TOTAL_NUMBER_OF_CELLS_PER_MAP);
+
+        unit->GetViewPoint().Call_UpdateVisibilityForOwner();
+        UpdateObjectVisibility(unit, Cell(p), p);
     }
 }
 
@@ -3234,13 +3537,6 @@ void Map::SendObjectUpdates()
     WorldPacket packet;                                     // here we allocate a std::vector with a size of 0x10000
     for (UpdateDataMapType::iterator iter = update_players.begin(); iter != update_players.end(); ++iter)
     {
-#ifdef ENABLE_PLAYERBOTS
-        // Don't waste CPU building packets for bots - they have no network client
-        if (iter->first->GetPlayerbotAI())
-        {
-            continue;
-        }
-#endif
         iter->second.BuildPacket(&packet);
         iter->first->GetSession()->SendPacket(&packet);
         packet.clear();                                     // clean the string
@@ -3385,6 +3681,18 @@ bool Map::IsInLineOfSight(float srcX, float srcY, float srcZ, float destX, float
            && m_dyn_tree.IsInLineOfSight(srcX, srcY, srcZ, destX, destY, destZ, PHASE_ANY);
 }
 
+/**
+ * Line of sight from one point to each of many, written into clear (1 = in sight).
+ * Static terrain is asked first; only what it leaves clear reaches the dynamic bodies.
+ */
+void Map::IsInLineOfSight(Geometry::Vector3 const& src, std::vector<Geometry::Vector3> const& dests,
+                          std::vector<uint8>& clear) const
+{
+    clear.assign(dests.size(), 1);
+    m_TerrainData->IsInLineOfSight(src, dests, clear);
+    m_dyn_tree.IsInLineOfSight(src, dests, clear, PHASE_ANY);
+}
+
 /**
  * get the hit position and return true if we hit something (in this case the dest position will hold the hit-position)
  * otherwise the result pos will be the dest pos
@@ -62,6 +62,7 @@
 #include <list>
 #include <utility>
 #include "Platform/Define.h"
+#include "LockedQueue/LockedQueue.h"
 #include "DBCStructure.h"
 #include "GridDefines.h"
 #include "Cell.h"
@@ -71,6 +72,10 @@
 #include "GameSystem/GridRefManager.h"
 #include "MapRefManager.h"
 #include "ScriptMgr.h"
+#include "ScriptSchedule.h"
+#include "GameEventMgr.h"
+#include "MapTickProfile.h"
+#include "VisibilityScheduler.h"
 #include "CreatureLinkingMgr.h"
 #include "DynamicCollision.h"
 #ifdef ENABLE_ELUNA
@@ -185,9 +190,15 @@ class Map : public GridRefManager<NGridType>
         void MessageDistBroadcast(Player const*, WorldPacket*, float dist, bool to_self, bool own_team_only = false);
         void MessageDistBroadcast(WorldObject const*, WorldPacket*, float dist);
 
+        /// Debug consistency check of WorldObject::GetObservers() against a grid visit.
+        uint32 CheckObservers(WorldObject const* obj, std::vector<Player*>& missing, std::vector<Player*>& extra);
+
         float GetVisibilityDistance() const { return m_VisibleDistance; }
         // function for setting up visibility distance for maps on per-type/per-Id basis
         virtual void InitVisibilityDistance();
+        // queues the visibility update of a relocated unit for the next visibility pass; false if the caller must update now
+        bool ScheduleVisibilityUpdate(Unit* unit);
+        VisibilityScheduler const& GetVisibilityScheduler() const { return m_visibilityScheduler; }
 
         /**
          * Packet delivery radius: the map visibility distance, extended while a
@@ -271,6 +282,11 @@ class Map : public GridRefManager<NGridType>
         MapPersistentState* GetPersistentState() const { return m_persistentState; }
 
         void AddObjectToRemoveList(WorldObject* obj);
+        bool IsObjectPendingRemoval(WorldObject* obj) const { return i_objectsToRemove.find(obj) != i_objectsToRemove.end(); }
+
+        // Game event spawns, despawns and creature updates for this copy, applied under Event.MapUpdateBudget
+        void QueueGameEventWork(GameEventMapWork const& work);
+        size_t GetPendingGameEventWork() const;
 
         void UpdateObjectVisibility(WorldObject* obj, Cell cell, CellPair cellpair);
 
@@ -304,6 +320,8 @@ class Map : public GridRefManager<NGridType>
         };
         bool ScriptsStart(DBScriptType type, uint32 id, Object* source, Object* target, ScriptExecutionParam execParams = SCRIPT_EXEC_PARAM_NONE);
         void ScriptCommandStart(ScriptInfo const& script, uint32 delay, Object* source, Object* target);
+        ScriptSchedule<ScriptAction> const& GetScriptSchedule() const { return m_scriptSchedule; }
+        MapTickProfile const& GetTickProfile() const { return m_tickProfile; }
 
         // must called with AddToWorld
         void AddToActive(WorldObject* obj);
@@ -384,6 +402,8 @@ class Map : public GridRefManager<NGridType>
         float GetHeight(float x, float y, float z) const;
         bool GetHeightInRange(float x, float y, float& z, float maxSearchDist = 4.0f) const;
         bool IsInLineOfSight(float x1, float y1, float z1, float x2, float y2, float z2) const;
+        void IsInLineOfSight(Geometry::Vector3 const& src, std::vector<Geometry::Vector3> const& dests,
+                             std::vector<uint8>& clear) const;
         bool GetHitPosition(float srcX, float srcY, float srcZ, float& destX, float& destY, float& destZ, float modifyDist) const;
 
         // Object Model insertion/remove/test for dynamic vmaps use
@@ -505,6 +525,11 @@ class Map : public GridRefManager<NGridType>
         void EnsureGridLoadedAtEnter(Cell const&, Player* player = nullptr);
         void PromoteEnvelopeNeighboursToFull(uint32 gridX, uint32 gridY);
 
+        /// Map::Remove drops an object's observer links but the players keep its guid, so
+        /// an object arriving here -- a teleport, a step across a deck seam -- is re-linked
+        /// both ways to whatever on this map its clients still hold.
+        void RelinkObservers(WorldObject* obj);
+
         NGridType* getNGrid(uint32 x, uint32 y) const
         {
             MANGOS_ASSERT(x < MAX_NUMBER_OF_GRIDS);
@@ -520,6 +545,7 @@ class Map : public GridRefManager<NGridType>
         uint32 i_InstanceId;
         uint32 m_unloadTimer;
         float m_VisibleDistance;
+        VisibilityScheduler m_visibilityScheduler;
         std::multiset<float> m_cinematicViewerRadii;  ///< radii of active cinematic flyover viewers on this map
         float m_cinematicViewerRadius;                ///< cached largest of m_cinematicViewerRadii (0 when none)
         MapPersistentState* m_persistentState;
@@ -555,8 +581,15 @@ class Map : public GridRefManager<NGridType>
 
         std::set<WorldObject*> i_objectsToRemove;
 
-        typedef std::multimap<time_t, ScriptAction> ScriptScheduleMap;
-        ScriptScheduleMap m_scriptSchedule;
+        ScriptSchedule<ScriptAction> m_scriptSchedule;
+        MapTickProfile m_tickProfile;
+
+        void ProcessGameEventWork();
+        void ProcessVisibilityUpdates(uint32 diff);
+        void SendToObservers(WorldObject const* obj, WorldPacket* msg);
+        // Queued on the world thread, by event updates and .event commands alike, and
+        // drained by whichever thread updates this map.
+        MaNGOS::LockedQueue<GameEventMapWork> m_gameEventWork;
 
         InstanceData* i_data;
 
@@ -70,6 +70,43 @@ namespace
         snprintf(leaf, sizeof(leaf), "mmaps/%04u%02i%02i.mmtile", mapId, x, y);
         return sWorld.GetDataPath() + leaf;
     }
+
+    /// The extractor leaves mmaps/<map>.manifest beside each navmesh: one sorted
+    /// "<mmtile> <hash of its inputs>" line per tile. Two servers that log the same
+    /// digest for a map are walking the same bake, which is what an operator asks first
+    /// when a path differs between them. No manifest (an older bake) logs nothing.
+    void LogBakeManifest(uint32 mapId)
+    {
+        char leaf[64];
+        snprintf(leaf, sizeof(leaf), "mmaps/%04u.manifest", mapId);
+        const std::string fileName = sWorld.GetDataPath() + leaf;
+
+        FILE* file = fopen(fileName.c_str(), "rb");
+        if (!file)
+        {
+            return;
+        }
+
+        uint32 tiles = 0;
+        uint64 digest = UI64LIT(14695981039346656037);  // FNV-1a over every tile line
+        char line[256];
+        while (fgets(line, sizeof(line), file))
+        {
+            if (line[0] == '#' || line[0] == '\n')
+            {
+                continue;
+            }
+            ++tiles;
+            for (const char* c = line; *c; ++c)
+            {
+                digest = (digest ^ uint8(*c)) * UI64LIT(1099511628211);
+            }
+        }
+        fclose(file);
+
+        DETAIL_LOG("MMAP:loadMapData: %04u.mmap baked from %u tiles, manifest " I64FMT,
+                   mapId, tiles, digest);
+    }
 }
 
 namespace MMAP
@@ -299,6 +336,7 @@ namespace MMAP
 
 
         DEBUG_FILTER_LOG(LOG_FILTER_MAP_LOADING, "MMAP:loadMapData: Loaded %04u.mmap", mapId);
+        LogBakeManifest(mapId);
 
         // store inside our map list
         MMapData* mmap_data = new MMapData(mesh);
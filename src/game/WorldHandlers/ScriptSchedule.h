@@ -0,0 +1,274 @@
+/**
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2026 MaNGOS <https://www.getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+/**
+ * @file ScriptSchedule.h
+ * @brief The pending DB script steps of a map, by due time and by script
+ *
+ * Map::ScriptsProcess runs due steps in time order, steps of equal time in the
+ * order they were scheduled. A step that ends its script removes the remaining
+ * steps of the same script, and Map::ScriptsStart asks whether a script is
+ * already running before starting it again. Both used to scan every pending
+ * step of the map.
+ *
+ * Steps live in a table keyed by a sequence number. A binary heap orders the
+ * sequence numbers by due time, and an ordered index keyed by (type, id,
+ * source, target, owner) finds the steps of one script. A removed step only
+ * leaves the table and the index; the heap drops its stale entry when it
+ * surfaces, and is rebuilt should stale entries ever outnumber live ones.
+ *
+ * Matching follows ScriptAction::IsSameScript: type and id must be equal, an
+ * empty source, target or owner guid in the query matches any.
+ *
+ * @tparam Action ScriptAction, or anything with GetType(), GetId(),
+ *         GetSourceGuid(), GetTargetGuid(), GetOwnerGuid() and IsSameScript()
+ */
+
+#ifndef MANGOS_H_SCRIPTSCHEDULE
+#define MANGOS_H_SCRIPTSCHEDULE
+
+#include "Platform/Define.h"
+#include "ObjectGuid.h"
+
+#include <algorithm>
+#include <ctime>
+#include <functional>
+#include <map>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+template<class Action>
+class ScriptSchedule
+{
+    public:
+        /// Identifies a step handed out by Next() until it is finished.
+        typedef uint64 StepId;
+
+        ScriptSchedule() : m_nextStep(1), m_stepsLastTick(0), m_stepsTotal(0), m_removedByTermination(0) {}
+
+        bool empty() const { return m_steps.empty(); }
+        size_t size() const { return m_steps.size(); }
+
+        /// Queue @p action to run once the game time reaches @p when.
+        void Add(time_t when, Action const& action)
+        {
+            StepId step = m_nextStep++;
+            typename IndexMap::iterator indexItr = m_index.insert(typename IndexMap::value_type(KeyOf(action), step));
+            m_steps.insert(typename StepMap::value_type(step, Step(when, action, indexItr)));
+            m_heap.push_back(HeapEntry(when, step));
+            std::push_heap(m_heap.begin(), m_heap.end(), std::greater<HeapEntry>());
+        }
+
+        /**
+         * @brief The next step due at @p now
+         *
+         * The step stays scheduled, and so visible to IsScheduled(), until
+         * Finish() or RemoveScript() drops it; new steps may be added meanwhile.
+         *
+         * @return The step, or NULL if none is due
+         */
+        Action* Next(time_t now, StepId& step)
+        {
+            while (!m_heap.empty())
+            {
+                HeapEntry const& top = m_heap.front();
+                typename StepMap::iterator itr = m_steps.find(top.second);
+                if (itr == m_steps.end())
+                {
+                    PopHeap();                              // removed meanwhile
+                    continue;
+                }
+                if (top.first > now)
+                {
+                    return NULL;
+                }
+                step = top.second;
+                PopHeap();
+                ++m_stepsLastTick;
+                ++m_stepsTotal;
+                return &itr->second.ScriptAction;
+            }
+            return NULL;
+        }
+
+        /// Drop a step from Next() that did not end its script.
+        void Finish(StepId step)
+        {
+            typename StepMap::iterator itr = m_steps.find(step);
+            if (itr != m_steps.end())
+            {
+                Erase(itr);
+            }
+        }
+
+        /// True if a step of a matching script is scheduled.
+        template<class TypeT>
+        bool IsScheduled(TypeT type, uint32 id, ObjectGuid sourceGuid, ObjectGuid targetGuid, ObjectGuid ownerGuid) const
+        {
+            std::pair<typename IndexMap::const_iterator, typename IndexMap::const_iterator> range = Candidates(uint32(type), id, sourceGuid);
+            for (typename IndexMap::const_iterator itr = range.first; itr != range.second; ++itr)
+            {
+                if (m_steps.find(itr->second)->second.ScriptAction.IsSameScript(type, id, sourceGuid, targetGuid, ownerGuid))
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        /**
+         * @brief Remove every step of matching scripts
+         * @return The number of steps removed
+         */
+        template<class TypeT>
+        size_t RemoveScript(TypeT type, uint32 id, ObjectGuid sourceGuid, ObjectGuid targetGuid, ObjectGuid ownerGuid)
+        {
+            std::vector<StepId> matching;
+            std::pair<typename IndexMap::const_iterator, typename IndexMap::const_iterator> range = Candidates(uint32(type), id, sourceGuid);
+            for (typename IndexMap::const_iterator itr = range.first; itr != range.second; ++itr)
+            {
+                if (m_steps.find(itr->second)->second.ScriptAction.IsSameScript(type, id, sourceGuid, targetGuid, ownerGuid))
+                {
+                    matching.push_back(itr->second);
+                }
+            }
+
+            for (size_t i = 0; i < matching.size(); ++i)
+            {
+                Erase(m_steps.find(matching[i]));
+            }
+            m_removedByTermination += matching.size();
+
+            if (m_heap.size() > 2 * m_steps.size() + 64)
+            {
+                RebuildHeap();
+            }
+            return matching.size();
+        }
+
+        /// Start counting the steps of a new map tick.
+        void BeginTick() { m_stepsLastTick = 0; }
+
+        uint32 GetStepsLastTick() const { return m_stepsLastTick; }
+        uint64 GetStepsTotal() const { return m_stepsTotal; }
+        uint64 GetRemovedByTermination() const { return m_removedByTermination; }
+
+    private:
+        /// (type, id, source, target, owner), guids as raw values
+        struct Key
+        {
+            uint32 Type;
+            uint32 Id;
+            uint64 Source;
+            uint64 Target;
+            uint64 Owner;
+
+            bool operator<(Key const& other) const
+            {
+                if (Type != other.Type) { return Type < other.Type; }
+                if (Id != other.Id) { return Id < other.Id; }
+                if (Source != other.Source) { return Source < other.Source; }
+                if (Target != other.Target) { return Target < other.Target; }
+                return Owner < other.Owner;
+            }
+        };
+
+        typedef std::multimap<Key, StepId> IndexMap;
+        typedef std::pair<time_t, StepId> HeapEntry;        // equal times run in scheduling order
+
+        struct Step
+        {
+            Step(time_t when, Action const& action, typename IndexMap::iterator indexItr)
+                : When(when), ScriptAction(action), IndexItr(indexItr) {}
+
+            time_t When;
+            Action ScriptAction;
+            typename IndexMap::iterator IndexItr;
+        };
+
+        typedef std::unordered_map<StepId, Step> StepMap;
+
+        static Key KeyOf(Action const& action)
+        {
+            Key key;
+            key.Type = uint32(action.GetType());
+            key.Id = action.GetId();
+            key.Source = action.GetSourceGuid().GetRawValue();
+            key.Target = action.GetTargetGuid().GetRawValue();
+            key.Owner = action.GetOwnerGuid().GetRawValue();
+            return key;
+        }
+
+        /// The index range that may match: one source, or every source if the query has none.
+        std::pair<typename IndexMap::const_iterator, typename IndexMap::const_iterator> Candidates(uint32 type, uint32 id, ObjectGuid sourceGuid) const
+        {
+            Key low = { type, id, 0, 0, 0 };
+            Key high = { type, id, ~UI64LIT(0), ~UI64LIT(0), ~UI64LIT(0) };
+            if (!sourceGuid.IsEmpty())
+            {
+                low.Source = high.Source = sourceGuid.GetRawValue();
+            }
+            return std::make_pair(m_index.lower_bound(low), m_index.upper_bound(high));
+        }
+
+        void Erase(typename StepMap::iterator itr)
+        {
+            m_index.erase(itr->second.IndexItr);
+            m_steps.erase(itr);
+        }
+
+        void PopHeap()
+        {
+            std::pop_heap(m_heap.begin(), m_heap.end(), std::greater<HeapEntry>());
+            m_heap.pop_back();
+        }
+
+        void RebuildHeap()
+        {
+            std::vector<HeapEntry> live;
+            live.reserve(m_steps.size());
+            for (size_t i = 0; i < m_heap.size(); ++i)
+            {
+                if (m_steps.find(m_heap[i].second) != m_steps.end())
+                {
+                    live.push_back(m_heap[i]);
+                }
+            }
+            std::make_heap(live.begin(), live.end(), std::greater<HeapEntry>());
+            m_heap.swap(live);
+        }
+
+        StepMap m_steps;
+        IndexMap m_index;
+        std::vector<HeapEntry> m_heap;                      // min-heap on (time, step)
+        StepId m_nextStep;
+
+        uint32 m_stepsLastTick;
+        uint64 m_stepsTotal;
+        uint64 m_removedByTermination;
+};
+
+#endif
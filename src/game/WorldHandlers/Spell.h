@@ -60,6 +60,7 @@
 #include "SharedDefines.h"
 #include "DBCEnums.h"
 #include "ObjectGuid.h"
+#include "SpellTargetInfoList.h"
 #include "LootMgr.h"
 #include "Unit.h"
 #include "Player.h"
@@ -428,7 +429,7 @@ class Spell
 
         template<typename T> WorldObject* FindCorpseUsing();
 
-        bool CheckTarget(Unit* target, SpellEffectIndex eff);
+        bool CheckTarget(Unit* target, SpellEffectIndex eff, uint8 const* inSight = NULL);
         bool CanAutoCast(Unit* target);
 
         static void  SendCastResult(Player* caster, SpellEntry const* spellInfo, SpellCastResult result);
@@ -642,8 +643,8 @@ class Spell
             uint8 effectMask;
         };
 
-        typedef std::list<TargetInfo>     TargetList;
-        typedef std::list<GOTargetInfo>   GOTargetList;
+        typedef SpellTargetInfoList<TargetInfo>   TargetList;
+        typedef SpellTargetInfoList<GOTargetInfo> GOTargetList;
         typedef std::list<ItemTargetInfo> ItemTargetList;
 
         TargetList     m_UniqueTargetInfo;
@@ -147,9 +147,11 @@ CurrentSpellTypes Spell::GetCurrentContainer()
  *
  * @param target The target being checked.
  * @param eff The effect index being validated.
+ * @param inSight The caster's line of sight to the target, when the caller already asked
+ *        for it in a batch; NULL to ask here.
  * @return True if the target is valid for the effect; otherwise, false.
  */
-bool Spell::CheckTarget(Unit* target, SpellEffectIndex eff)
+bool Spell::CheckTarget(Unit* target, SpellEffectIndex eff, uint8 const* inSight)
 {
     // Check targets for creature type mask and remove not appropriate (skip explicit self target case, maybe need other explicit targets)
     if (m_spellInfo->ImplicitTargetA[eff] != TARGET_SELF)
@@ -249,7 +251,7 @@ bool Spell::CheckTarget(Unit* target, SpellEffectIndex eff)
                 {
                     if (WorldObject* caster = GetCastingObject())
                     {
-                        if (!HasLineOfSight(*target, *caster))
+                        if (inSight ? !*inSight : !HasLineOfSight(*caster, *target))
                         {
                             return false;
                         }
@@ -156,7 +156,7 @@ void Spell::SendCastResult(Player* caster, SpellEntry const* spellInfo, SpellCas
  */
 void Spell::SendSpellStart()
 {
-    if (!IsNeedSendToClient())
+    if (!IsNeedSendToClient() || !m_caster->HasReadersFor(SMSG_SPELL_START, true))
     {
         return;
     }
@@ -199,8 +199,8 @@ void Spell::SendSpellStart()
  */
 void Spell::SendSpellGo()
 {
-    // not send invisible spell casting
-    if (!IsNeedSendToClient())
+    // not send invisible spell casting, nor a visible one only bots would see
+    if (!IsNeedSendToClient() || !m_caster->HasReadersFor(SMSG_SPELL_GO, true))
     {
         return;
     }
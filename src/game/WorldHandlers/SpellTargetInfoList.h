@@ -0,0 +1,210 @@
+/**
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2026 MaNGOS <https://www.getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+/**
+ * @file SpellTargetInfoList.h
+ * @brief Flat, guid-indexed storage for the unique targets of a spell cast
+ *
+ * Spell::AddUnitTarget and Spell::AddGOTarget look every candidate up by guid
+ * once per effect index. Over a std::list that is quadratic in the number of
+ * targets of an area spell, with a heap node per target. Here the records sit
+ * in one vector, in insertion order, and lists past a few entries get an open
+ * addressing guid -> position index beside them.
+ *
+ * The vector storage is handed back to a per-thread free list when the list is
+ * destroyed, so a map thread casting area spells all day allocates it once.
+ *
+ * Records must not be added while the list is being walked: like any vector,
+ * an insertion may move them.
+ */
+
+#ifndef MANGOS_H_SPELLTARGETINFOLIST
+#define MANGOS_H_SPELLTARGETINFOLIST
+
+#include "Platform/Define.h"
+#include "ObjectGuid.h"
+
+#include <vector>
+
+template<typename T>
+class SpellTargetInfoList
+{
+    public:
+        typedef typename std::vector<T>::iterator iterator;
+        typedef typename std::vector<T>::const_iterator const_iterator;
+
+        /// Lists up to this size are searched linearly, larger ones get an index
+        static const size_t LinearSearchLimit = 8;
+        /// Storage kept per thread for reuse, and the largest capacity worth keeping
+        static const size_t FreeListLimit = 16;
+        static const size_t FreeListMaxCapacity = 1024;
+
+        SpellTargetInfoList() {}
+
+        ~SpellTargetInfoList()
+        {
+            if (m_items.capacity() == 0 || m_items.capacity() > FreeListMaxCapacity)
+            {
+                return;
+            }
+
+            std::vector<std::vector<T> >& freeList = FreeList();
+            if (freeList.size() < FreeListLimit)
+            {
+                m_items.clear();
+                freeList.push_back(std::vector<T>());
+                freeList.back().swap(m_items);
+            }
+        }
+
+        iterator begin() { return m_items.begin(); }
+        iterator end() { return m_items.end(); }
+        const_iterator begin() const { return m_items.begin(); }
+        const_iterator end() const { return m_items.end(); }
+
+        size_t size() const { return m_items.size(); }
+        bool empty() const { return m_items.empty(); }
+
+        void clear()
+        {
+            m_items.clear();
+            m_index.clear();
+        }
+
+        /**
+         * @brief Find the record of a target
+         * @param guid Target guid
+         * @return The record, or NULL if the target is not in the list
+         */
+        T* Find(ObjectGuid const& guid)
+        {
+            if (m_index.empty())
+            {
+                for (iterator itr = m_items.begin(); itr != m_items.end(); ++itr)
+                {
+                    if (itr->targetGUID == guid)
+                    {
+                        return &*itr;
+                    }
+                }
+                return NULL;
+            }
+
+            size_t mask = m_index.size() - 1;
+            for (size_t slot = Hash(guid) & mask; m_index[slot]; slot = (slot + 1) & mask)
+            {
+                T& item = m_items[m_index[slot] - 1];
+                if (item.targetGUID == guid)
+                {
+                    return &item;
+                }
+            }
+            return NULL;
+        }
+
+        /**
+         * @brief Append the record of a target not yet in the list
+         * @param info Target record, its guid must not be present already
+         */
+        void push_back(T const& info)
+        {
+            if (m_items.capacity() == 0)
+            {
+                std::vector<std::vector<T> >& freeList = FreeList();
+                if (!freeList.empty())
+                {
+                    m_items.swap(freeList.back());
+                    freeList.pop_back();
+                }
+            }
+
+            m_items.push_back(info);
+
+            if (m_items.size() <= LinearSearchLimit)
+            {
+                return;
+            }
+
+            // keep the index at most half full
+            if (m_items.size() * 2 > m_index.size())
+            {
+                Reindex();
+            }
+            else
+            {
+                Insert(m_items.size() - 1);
+            }
+        }
+
+    private:
+        SpellTargetInfoList(SpellTargetInfoList const&);
+        SpellTargetInfoList& operator=(SpellTargetInfoList const&);
+
+        static size_t Hash(ObjectGuid const& guid)
+        {
+            uint64 raw = guid.GetRawValue();
+            raw ^= raw >> 33;
+            raw *= UI64LIT(0xff51afd7ed558ccd);
+            raw ^= raw >> 33;
+            return size_t(raw);
+        }
+
+        void Insert(size_t position)
+        {
+            size_t mask = m_index.size() - 1;
+            size_t slot = Hash(m_items[position].targetGUID) & mask;
+            while (m_index[slot])
+            {
+                slot = (slot + 1) & mask;
+            }
+            m_index[slot] = uint32(position + 1);
+        }
+
+        void Reindex()
+        {
+            size_t slots = 32;
+            while (slots < m_items.size() * 4)
+            {
+                slots *= 2;
+            }
+
+            m_index.assign(slots, 0);
+            for (size_t i = 0; i < m_items.size(); ++i)
+            {
+                Insert(i);
+            }
+        }
+
+        static std::vector<std::vector<T> >& FreeList()
+        {
+            static thread_local std::vector<std::vector<T> > freeList;
+            return freeList;
+        }
+
+        std::vector<T> m_items;
+        std::vector<uint32> m_index;                        // position + 1, 0 for an empty slot
+};
+
+#endif
@@ -348,11 +348,27 @@ void Spell::FillTargetMap()
             }
         }
 
-        for (UnitList::iterator itr = tmpUnitLists[effToIndex[i]].begin(); itr != tmpUnitLists[effToIndex[i]].end();)
+        // An area effect asks the same question of every target it caught -- can the caster
+        // see it -- so ask it once for all of them: one terrain gather instead of one each.
+        UnitList& unitList = tmpUnitLists[effToIndex[i]];
+        std::vector<uint8> inSight;
+        WorldObject* castingObject = GetCastingObject();
+        if (unitList.size() > 1 && castingObject &&
+            m_spellInfo->Effect[i] != SPELL_EFFECT_SUMMON_PLAYER &&
+            m_spellInfo->Effect[i] != SPELL_EFFECT_DUMMY &&
+            m_spellInfo->Effect[i] != SPELL_EFFECT_RESURRECT_NEW &&
+            !DisableMgr::IsDisabledFor(DISABLE_TYPE_SPELL, m_spellInfo->ID, NULL, SPELL_DISABLE_LOS))
         {
-            if (!CheckTarget(*itr, SpellEffectIndex(i)))
+            std::vector<WorldObject const*> seen(unitList.begin(), unitList.end());
+            HasLineOfSight(*castingObject, seen, inSight);
+        }
+
+        size_t slot = 0;
+        for (UnitList::iterator itr = unitList.begin(); itr != unitList.end(); ++slot)
+        {
+            if (!CheckTarget(*itr, SpellEffectIndex(i), inSight.empty() ? NULL : &inSight[slot]))
             {
-                itr = tmpUnitLists[effToIndex[i]].erase(itr);
+                itr = unitList.erase(itr);
                 continue;
             }
             else
@@ -524,16 +540,13 @@ void Spell::AddUnitTarget(Unit* pVictim, SpellEffectIndex effIndex)
     ObjectGuid targetGUID = pVictim->GetObjectGuid();
 
     // Lookup target in already in list
-    for (TargetList::iterator ihit = m_UniqueTargetInfo.begin(); ihit != m_UniqueTargetInfo.end(); ++ihit)
+    if (TargetInfo* known = m_UniqueTargetInfo.Find(targetGUID))
     {
-        if (targetGUID == ihit->targetGUID)                 // Found in list
+        if (!immuned)
         {
-            if (!immuned)
-            {
-                ihit->effectMask |= 1 << effIndex;          // Add only effect mask if not immuned
-            }
-            return;
+            known->effectMask |= 1 << effIndex;             // Add only effect mask if not immuned
         }
+        return;
     }
 
     // This is new target calculate data for him
@@ -642,13 +655,10 @@ void Spell::AddGOTarget(GameObject* pVictim, SpellEffectIndex effIndex)
     ObjectGuid targetGUID = pVictim->GetObjectGuid();
 
     // Lookup target in already in list
-    for (GOTargetList::iterator ihit = m_UniqueGOTargetInfo.begin(); ihit != m_UniqueGOTargetInfo.end(); ++ihit)
+    if (GOTargetInfo* known = m_UniqueGOTargetInfo.Find(targetGUID))
     {
-        if (targetGUID == ihit->targetGUID)                 // Found in list
-        {
-            ihit->effectMask |= (1 << effIndex);            // Add only effect mask
-            return;
-        }
+        known->effectMask |= (1 << effIndex);               // Add only effect mask
+        return;
     }
 
     // This is new target calculate data for him
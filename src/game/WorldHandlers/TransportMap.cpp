@@ -151,7 +151,7 @@ namespace
         }
 
         minion->DestroyForPlayer(client);
-        client->m_clientGUIDs.erase(minion->GetObjectGuid());
+        client->RemoveClientObject(minion);
     }
 
     /**
@@ -417,6 +417,7 @@ bool TransportMap::Add(Player* passenger, InitialWorldEntryHook* initialEntry)
     EnsureGridLoadedAtEnter(cell, passenger);
     PromoteEnvelopeNeighboursToFull(cell.GridX(), cell.GridY());
     passenger->AddToWorld();
+    RelinkObservers(passenger);
 
     // As on an ordinary map, derive the client-visible world anchor only after
     // membership commits and before vessel/passenger blocks are accumulated.
@@ -0,0 +1,134 @@
+/**
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2026 MaNGOS <https://www.getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+#include "VisibilityScheduler.h"
+
+#include <algorithm>
+
+/**
+ * @brief Creates a scheduler that is off: units update at their relocation.
+ */
+VisibilityScheduler::VisibilityScheduler()
+    : m_interval(0), m_timer(0), m_batchLimit(0), m_backlog(false),
+    m_scheduled(0), m_coalesced(0), m_passes(0), m_updated(0), m_lastPassSize(0)
+{
+}
+
+/**
+ * @brief Sets the time between two passes.
+ *
+ * Units already queued stay queued; when the scheduler is switched off they
+ * are flushed by the next Update(). The first unit queued after this runs on
+ * the next tick, as after any quiet spell.
+ *
+ * @param interval milliseconds, 0 to update every unit at its relocation
+ */
+void VisibilityScheduler::SetInterval(uint32 interval)
+{
+    m_interval = interval;
+    m_timer = interval;
+}
+
+/**
+ * @brief Queues the visibility update of a unit.
+ *
+ * @param guid the unit that moved
+ * @return false if the scheduler is off and the caller must update now
+ */
+bool VisibilityScheduler::Schedule(ObjectGuid guid)
+{
+    if (!m_interval)
+    {
+        return false;
+    }
+
+    ++m_scheduled;
+    if (!m_pending.insert(guid).second)
+    {
+        ++m_coalesced;                                      // the pass will see its latest position
+        return true;
+    }
+
+    m_queue.push_back(guid);
+    return true;
+}
+
+/**
+ * @brief Advances the pass timer.
+ *
+ * @param diff milliseconds since the last call
+ * @return true if a pass is due and units are waiting
+ */
+bool VisibilityScheduler::Update(uint32 diff)
+{
+    if (m_queue.empty())
+    {
+        m_timer = std::min(m_timer + diff, m_interval);
+        return false;
+    }
+
+    if (!m_interval || m_backlog)
+    {
+        return true;
+    }
+
+    m_timer += diff;
+    if (m_timer < m_interval)
+    {
+        return false;
+    }
+
+    m_timer = 0;
+    return true;
+}
+
+/**
+ * @brief Takes the units of the current pass, oldest first.
+ *
+ * @param batch receives the guids, at most the batch limit
+ */
+void VisibilityScheduler::TakeBatch(std::vector<ObjectGuid>& batch)
+{
+    size_t count = m_queue.size();
+    if (m_batchLimit && count > m_batchLimit)
+    {
+        count = m_batchLimit;
+    }
+
+    batch.reserve(batch.size() + count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        ObjectGuid guid = m_queue.front();
+        m_queue.pop_front();
+        m_pending.erase(guid);
+        batch.push_back(guid);
+    }
+
+    m_backlog = !m_queue.empty();
+    m_timer = 0;
+    ++m_passes;
+    m_updated += count;
+    m_lastPassSize = uint32(count);
+}
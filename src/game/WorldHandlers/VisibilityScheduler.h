@@ -0,0 +1,122 @@
+/**
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2026 MaNGOS <https://www.getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+/**
+ * @file VisibilityScheduler.h
+ * @brief Relocation driven visibility updates of a map, coalesced into passes
+ *
+ * A unit that moved further than Visibility.RelocationLowerLimit from where
+ * its visibility was last updated used to rebuild what it sees, and who sees
+ * it, right in the relocation. A charge, a blink or a bot running across a
+ * zone does that over and over, a few yards at a time.
+ *
+ * With an interval set the map queues the unit here instead. Every interval
+ * the map takes the queued units, oldest first, sorts them by cell and
+ * updates each one once, however often it moved in between. A batch limit
+ * caps the units of one pass; the rest stay queued, in order, and run on
+ * the next tick rather than waiting another interval.
+ *
+ * The scheduler only keeps guids; the map resolves them at the pass, so a
+ * unit that left the map in the meantime is simply skipped.
+ */
+
+#ifndef MANGOS_H_VISIBILITYSCHEDULER
+#define MANGOS_H_VISIBILITYSCHEDULER
+
+#include "Platform/Define.h"
+#include "ObjectGuid.h"
+
+#include <deque>
+#include <unordered_set>
+#include <vector>
+
+class VisibilityScheduler
+{
+    public:
+        VisibilityScheduler();
+
+        /**
+         * @brief Sets the time between two passes.
+         *
+         * @param interval milliseconds, 0 to update every unit at its relocation
+         */
+        void SetInterval(uint32 interval);
+        uint32 GetInterval() const { return m_interval; }
+
+        /**
+         * @brief Caps the units updated by one pass.
+         *
+         * @param limit units, 0 for no limit
+         */
+        void SetBatchLimit(uint32 limit) { m_batchLimit = limit; }
+        uint32 GetBatchLimit() const { return m_batchLimit; }
+
+        /**
+         * @brief Queues the visibility update of a unit.
+         *
+         * @param guid the unit that moved
+         * @return false if the scheduler is off and the caller must update now
+         */
+        bool Schedule(ObjectGuid guid);
+
+        /**
+         * @brief Advances the pass timer.
+         *
+         * @param diff milliseconds since the last call
+         * @return true if a pass is due and units are waiting
+         */
+        bool Update(uint32 diff);
+
+        /**
+         * @brief Takes the units of the current pass, oldest first.
+         *
+         * @param batch receives the guids, at most the batch limit
+         */
+        void TakeBatch(std::vector<ObjectGuid>& batch);
+
+        size_t GetPendingCount() const { return m_queue.size(); }
+        uint64 GetScheduledTotal() const { return m_scheduled; }
+        uint64 GetCoalescedTotal() const { return m_coalesced; }
+        uint64 GetPassesTotal() const { return m_passes; }
+        uint64 GetUpdatedTotal() const { return m_updated; }
+        uint32 GetLastPassSize() const { return m_lastPassSize; }
+
+    private:
+        uint32 m_interval;
+        uint32 m_timer;                                     // milliseconds since the last pass
+        uint32 m_batchLimit;
+        bool m_backlog;                                     // the last pass hit the batch limit
+
+        std::deque<ObjectGuid> m_queue;                     // in the order units were queued
+        std::unordered_set<ObjectGuid> m_pending;           // the same guids, for coalescing
+
+        uint64 m_scheduled;                                 // relocations handed to the scheduler
+        uint64 m_coalesced;                                 // of those, units already queued
+        uint64 m_passes;
+        uint64 m_updated;                                   // units taken by passes
+        uint32 m_lastPassSize;
+};
+
+#endif
@@ -55,6 +55,7 @@
 #include "SystemConfig.h"
 #include "Log.h"
 #include "OpcodeTable.h"
+#include "OpcodeProfiler.h"
 #include "WorldSession.h"
 #include "WorldPacket.h"
 #include "Player.h"
@@ -102,6 +103,7 @@
 #include "UpdateTime.h"
 #include "GameTime.h"
 #include "ScheduledExit.h"
+#include "SharedPacket.h"
 
 #ifdef ENABLE_ELUNA
 #include "LuaEngine.h"
@@ -160,6 +162,11 @@ uint32 World::m_relocation_ai_notify_delay    = 1000u;
 bool   World::m_visibility_observer_sweep_enabled  = true;
 uint32 World::m_visibility_observer_sweep_interval = 2000u;
 
+uint32 World::m_visibility_update_interval_continents = 100u;
+uint32 World::m_visibility_update_interval_instances  = 100u;
+uint32 World::m_visibility_update_interval_bgarenas   = 100u;
+uint32 World::m_visibility_update_batch_limit         = 0u;
+
 namespace
 {
     int32 GetScheduledExitWarningTextId(MaNGOS::ScheduledExitMode mode,
@@ -262,6 +269,8 @@ World::~World()
     eluna = nullptr;
 #endif /* ENABLE_ELUNA */
 
+    m_sessionWorkers.Deactivate();
+
     ///- Empty the kicked session set
     while (!m_sessions.empty())
     {
@@ -732,6 +741,9 @@ void World::SetInitialWorldSettings()
     sLog.outString("Modifying in-memory dbc spell attributes...");
     sSpellMgr.ModDBCSpellAttributes();
 
+    sLog.outString("Classifying spells...");
+    sSpellMgr.LoadSpellClassifications();                   // must be after LoadSpellElixirs and ModDBCSpellAttributes
+
     sLog.outString("Loading ReservedNames...");
     sObjectMgr.LoadReservedPlayersNames();
 
@@ -867,6 +879,9 @@ void World::SetInitialWorldSettings()
     // for AhBot
     m_timers[WUPDATE_AHBOT].SetInterval(20 * IN_MILLISECONDS); // every 20 sec
 
+    // for the opcode handler report
+    m_timers[WUPDATE_OPCODE_PROFILE].SetInterval(getConfig(CONFIG_UINT32_OPCODE_PROFILE_LOG_INTERVAL) * IN_MILLISECONDS);
+
     // for AutoBroadcast
     sLog.outString("Starting AutoBroadcast System");
     if (m_broadcastEnable)
@@ -903,9 +918,22 @@ void World::SetInitialWorldSettings()
     sMapMgr.Initialize();
     sLog.outString();
 
+    if (uint32 sessionThreads = getConfig(CONFIG_UINT32_SESSION_UPDATE_THREADS))
+    {
+        if (m_sessionWorkers.Activate(sessionThreads))
+        {
+            sLog.outString(">> Session-safe packets handled by %u threads", sessionThreads);
+        }
+        else
+        {
+            sLog.outError("World: could not start %u session update threads, handling all packets on the world thread", sessionThreads);
+        }
+    }
+
     ///- Initialize Battlegrounds
     sLog.outString("Starting BattleGround System");
     sBattleGroundMgr.CreateInitialBattleGrounds();
+    sBattleGroundMgr.InitQueueMatchThreads();
 
     ///- Initialize Outdoor PvP
     sLog.outString("Starting Outdoor PvP System");
@@ -998,6 +1026,24 @@ void World::SetInitialWorldSettings()
 
 namespace
 {
+    /// The opcode handlers that took the most time since the previous report.
+    void LogOpcodeProfile(uint32 intervalSeconds)
+    {
+        std::vector<OpcodeProfile> profiles = sOpcodeProfiler.TakeInterval();
+        if (profiles.empty())
+        {
+            return;
+        }
+
+        sLog.outString("Opcode handlers, last %u s, by total time:", intervalSeconds);
+        for (size_t i = 0; i < profiles.size() && i < 10; ++i)
+        {
+            OpcodeProfile const& p = profiles[i];
+            sLog.outString("  %s calls=" UI64FMTD " total_us=" UI64FMTD " p99_us=" UI64FMTD " max_us=" UI64FMTD " in=" UI64FMTD " out=" UI64FMTD,
+                LookupOpcodeName(p.opcode), p.calls, p.totalMicros, p.p99Micros, p.maxMicros, p.bytesIn, p.bytesOut);
+        }
+    }
+
     /// "Eluna, ScriptDev3" -- or "none" for an empty list.
     std::string JoinList(const std::vector<std::string>& items)
     {
@@ -1471,6 +1517,16 @@ void World::Update(uint32 diff)
     }
 #endif /* ENABLE_ELUNA */
 
+    ///- Report the client opcode handlers that took the most time
+    if (m_timers[WUPDATE_OPCODE_PROFILE].Passed())
+    {
+        m_timers[WUPDATE_OPCODE_PROFILE].Reset();
+        if (uint32 interval = getConfig(CONFIG_UINT32_OPCODE_PROFILE_LOG_INTERVAL))
+        {
+            LogOpcodeProfile(interval);
+        }
+    }
+
     ///- Delete all characters which have been deleted X days before
     if (m_timers[WUPDATE_DELETECHARS].Passed())
     {
@@ -1839,6 +1895,8 @@ void World::SendWorldText(int32 string_id, ...)
 /// Sends a packet to all players with optional account access level restrictions
 void World::SendGlobalMessage(WorldPacket* packet, AccountTypes minSec)
 {
+    proto::SharedPacketScope shared(*packet);
+
     for (SessionMap::const_iterator itr = m_sessions.begin(); itr != m_sessions.end(); ++itr)
     {
         if (WorldSession* session = itr->second)
@@ -1962,6 +2020,10 @@ void World::KickAll()
             botMgr->LogoutAllBots();
         }
     }
+
+    // Event values are written behind, once a pass. Whatever the last partial pass and
+    // the logouts above changed is queued here, ahead of the delay thread's final drain.
+    sRandomPlayerbotMgr.FlushEventValues();
 #endif
 
     m_QueuedSessions.clear();                               // prevent send queue update packet and login queued sessions
@@ -2467,6 +2529,32 @@ void World::UpdateSessions(uint32 diff)
         AddSession_(sess);
     }
 
+    ///- Let the session workers handle queries, pings and keep-alives first.
+    /// Nothing else runs meanwhile: the map threads only start after us.
+    if (m_sessionWorkers.Activated() && !m_sessions.empty())
+    {
+        std::vector<WorldSession*> sessions;
+        sessions.reserve(m_sessions.size());
+        for (SessionMap::const_iterator itr = m_sessions.begin(); itr != m_sessions.end(); ++itr)
+        {
+            sessions.push_back(itr->second);
+        }
+
+        size_t const chunk = 64;
+        for (size_t begin = 0; begin < sessions.size(); begin += chunk)
+        {
+            size_t const end = std::min(begin + chunk, sessions.size());
+            m_sessionWorkers.Schedule([&sessions, begin, end]()
+            {
+                for (size_t i = begin; i < end; ++i)
+                {
+                    sessions[i]->UpdateSessionSafe();
+                }
+            });
+        }
+        m_sessionWorkers.Wait();
+    }
+
     ///- Then send an update signal to remaining ones
     for (SessionMap::iterator itr = m_sessions.begin(), next; itr != m_sessions.end(); itr = next)
     {
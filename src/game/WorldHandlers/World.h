@@ -42,6 +42,7 @@
 #include "ScheduledExit.h"
 #include "Utilities/Util.h"
 #include "Timer.h"
+#include "Threading/TaskPool.h"
 #include "Policies/Singleton.h"
 #include "SharedDefines.h"
 #include "AuctionHouseBot/BrowsePending.h"
@@ -99,6 +100,7 @@ enum WorldTimers
     WUPDATE_EVENTS,
     WUPDATE_DELETECHARS,
     WUPDATE_AHBOT,
+    WUPDATE_OPCODE_PROFILE,
     WUPDATE_COUNT
 };
 
@@ -194,6 +196,7 @@ enum eConfigUInt32Values
     CONFIG_UINT32_BATTLEGROUND_INVITATION_TYPE,
     CONFIG_UINT32_BATTLEGROUND_PREMATURE_FINISH_TIMER,
     CONFIG_UINT32_BATTLEGROUND_PREMADE_GROUP_WAIT_FOR_MATCH,
+    CONFIG_UINT32_BATTLEGROUND_QUEUE_MATCH_THREADS,
     CONFIG_UINT32_BATTLEGROUND_QUEUE_ANNOUNCER_JOIN,
     CONFIG_UNIT32_GUILD_PETITION_COST,
     CONFIG_UINT32_GUILD_EVENT_LOG_COUNT,
@@ -209,6 +212,10 @@ enum eConfigUInt32Values
     CONFIG_UINT32_CHARDELETE_METHOD,
     CONFIG_UINT32_CHARDELETE_MIN_LEVEL,
     CONFIG_UINT32_NUMTHREADS,
+    CONFIG_UINT32_SESSION_UPDATE_THREADS,
+    CONFIG_UINT32_EVENT_MAP_UPDATE_BUDGET,
+    CONFIG_UINT32_OPCODE_PROFILE_LOG_INTERVAL,
+    CONFIG_UINT32_MAP_SLOW_TICK_THRESHOLD,
     CONFIG_UINT32_GUID_RESERVE_SIZE_CREATURE,
     CONFIG_UINT32_GUID_RESERVE_SIZE_GAMEOBJECT,
     CONFIG_UINT32_CREATURE_RESPAWN_AGGRO_DELAY,
@@ -653,6 +660,11 @@ class World
         static bool   GetVisibilityObserverSweepEnabled()   { return m_visibility_observer_sweep_enabled; }
         static uint32 GetVisibilityObserverSweepInterval()  { return m_visibility_observer_sweep_interval; }
 
+        static uint32 GetVisibilityUpdateIntervalOnContinents() { return m_visibility_update_interval_continents; }
+        static uint32 GetVisibilityUpdateIntervalInInstances()  { return m_visibility_update_interval_instances; }
+        static uint32 GetVisibilityUpdateIntervalInBGArenas()   { return m_visibility_update_interval_bgarenas; }
+        static uint32 GetVisibilityUpdateBatchLimit()           { return m_visibility_update_batch_limit; }
+
         void InitServerMaintenanceCheck();
         void ServerMaintenanceStart();
 
@@ -809,6 +821,7 @@ class World
         uint32 mail_timer_expires;
 
         SessionMap m_sessions;
+        MaNGOS::TaskPool m_sessionWorkers;                  // handles session-safe packets before the serial update
         uint32 m_maxActiveSessionCount;
         uint32 m_maxQueuedSessionCount;
 
@@ -840,6 +853,11 @@ class World
         static bool   m_visibility_observer_sweep_enabled;
         static uint32 m_visibility_observer_sweep_interval;
 
+        static uint32 m_visibility_update_interval_continents;
+        static uint32 m_visibility_update_interval_instances;
+        static uint32 m_visibility_update_interval_bgarenas;
+        static uint32 m_visibility_update_batch_limit;
+
         // CLI command holder to be thread safe
         MaNGOS::LockedQueue<CliCommandHolder*> cliCmdQueue;
 
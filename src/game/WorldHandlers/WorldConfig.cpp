@@ -97,6 +97,7 @@
 #include "CommandMgr.h"
 #include "GitRevision.h"
 #include "UpdateTime.h"
+#include "MapTickProfile.h"
 #include "GameTime.h"
 #include "SystemConfig.h"
 #include "AuctionHouseBot/AuctionIntentExecutor.h"
@@ -376,6 +377,13 @@ void World::LoadConfigSettings(bool reload)
     }
 
     setConfig(CONFIG_UINT32_NUMTHREADS, "MapUpdateThreads", 2);
+    setConfig(CONFIG_UINT32_SESSION_UPDATE_THREADS, "SessionUpdateThreads", 2);
+    setConfig(CONFIG_UINT32_OPCODE_PROFILE_LOG_INTERVAL, "OpcodeProfile.LogInterval", 300);
+    if (reload)
+    {
+        m_timers[WUPDATE_OPCODE_PROFILE].SetInterval(getConfig(CONFIG_UINT32_OPCODE_PROFILE_LOG_INTERVAL) * IN_MILLISECONDS);
+        m_timers[WUPDATE_OPCODE_PROFILE].Reset();
+    }
 
     setConfigMin(CONFIG_UINT32_INTERVAL_MAPUPDATE, "MapUpdateInterval", 100, MIN_MAP_UPDATE_DELAY);
     if (reload)
@@ -383,6 +391,9 @@ void World::LoadConfigSettings(bool reload)
         sMapMgr.SetMapUpdateInterval(getConfig(CONFIG_UINT32_INTERVAL_MAPUPDATE));
     }
 
+    setConfig(CONFIG_UINT32_MAP_SLOW_TICK_THRESHOLD, "MapUpdate.SlowTickThreshold", 0);
+    MapTickProfile::SetSlowTickThreshold(getConfig(CONFIG_UINT32_MAP_SLOW_TICK_THRESHOLD));
+
     setConfig(CONFIG_UINT32_INTERVAL_CHANGEWEATHER, "ChangeWeatherInterval", 10 * MINUTE * IN_MILLISECONDS);
 
     if (configNoReload(reload, CONFIG_UINT32_PORT_WORLD, "WorldServerPort", DEFAULT_WORLDSERVER_PORT))
@@ -539,6 +550,7 @@ void World::LoadConfigSettings(bool reload)
     setConfig(CONFIG_UINT32_CHATFLOOD_MUTE_TIME,     "ChatFlood.MuteTime", 10);
 
     setConfig(CONFIG_BOOL_EVENT_ANNOUNCE, "Event.Announce", false);
+    setConfig(CONFIG_UINT32_EVENT_MAP_UPDATE_BUDGET, "Event.MapUpdateBudget", 5);
 
     setConfig(CONFIG_UINT32_CREATURE_FAMILY_ASSISTANCE_DELAY, "CreatureFamilyAssistanceDelay", 1500);
     setConfig(CONFIG_UINT32_CREATURE_FAMILY_FLEE_DELAY,       "CreatureFamilyFleeDelay",       7000);
@@ -590,6 +602,7 @@ void World::LoadConfigSettings(bool reload)
     setConfig(CONFIG_UINT32_BATTLEGROUND_INVITATION_TYPE,              "Battleground.InvitationType", 0);
     setConfig(CONFIG_UINT32_BATTLEGROUND_PREMATURE_FINISH_TIMER,       "BattleGround.PrematureFinishTimer", 5 * MINUTE * IN_MILLISECONDS);
     setConfig(CONFIG_UINT32_BATTLEGROUND_PREMADE_GROUP_WAIT_FOR_MATCH, "BattleGround.PremadeGroupWaitForMatch", 0);
+    setConfig(CONFIG_UINT32_BATTLEGROUND_QUEUE_MATCH_THREADS,          "Battleground.QueueMatchThreads", 2);
     setConfig(CONFIG_BOOL_OUTDOORPVP_SI_ENABLED,                       "OutdoorPvp.SIEnabled", true);
     setConfig(CONFIG_BOOL_OUTDOORPVP_EP_ENABLED,                       "OutdoorPvp.EPEnabled", true);
 
@@ -696,6 +709,11 @@ void World::LoadConfigSettings(bool reload)
     m_visibility_observer_sweep_enabled  = sConfig.GetBoolDefault("Visibility.ObserverSweep.Enable", true);
     m_visibility_observer_sweep_interval = sConfig.GetIntDefault("Visibility.ObserverSweep.Interval", 2000);
 
+    m_visibility_update_interval_continents = sConfig.GetIntDefault("Visibility.UpdateInterval.Continents", 100);
+    m_visibility_update_interval_instances  = sConfig.GetIntDefault("Visibility.UpdateInterval.Instances", 100);
+    m_visibility_update_interval_bgarenas   = sConfig.GetIntDefault("Visibility.UpdateInterval.BG", 100);
+    m_visibility_update_batch_limit         = sConfig.GetIntDefault("Visibility.UpdateBatchLimit", 0);
+
     m_VisibleUnitGreyDistance = sConfig.GetFloatDefault("Visibility.Distance.Grey.Unit", 1);
     if (m_VisibleUnitGreyDistance >  MAX_VISIBILITY_DISTANCE)
     {
@@ -141,6 +141,13 @@ namespace Movement
         unit.m_movementInfo.SetMovementFlags((MovementFlags)moveFlags);
         move_spline.Initialize(args);
 
+        // The spline above is the server's; the packet is only for clients, and a unit
+        // among nothing but bots -- a city full of them -- has none to tell.
+        if (!unit.HasReadersFor(vesselGuid.IsEmpty() ? SMSG_MONSTER_MOVE : SMSG_MONSTER_MOVE_TRANSPORT, true))
+        {
+            return move_spline.Duration();
+        }
+
         WorldPacket data(SMSG_MONSTER_MOVE, 64);
         data << unit.GetPackGUID();
 
@@ -222,6 +229,11 @@ namespace Movement
         unit.m_movementInfo.RemoveMovementFlag(MovementFlags(MOVEFLAG_FORWARD | MOVEFLAG_SPLINE_ENABLED));
         move_spline.Initialize(args);
 
+        if (!unit.HasReadersFor(vesselGuid.IsEmpty() ? SMSG_MONSTER_MOVE : SMSG_MONSTER_MOVE_TRANSPORT, true))
+        {
+            return;
+        }
+
         WorldPacket data(SMSG_MONSTER_MOVE, 64);
         data << unit.GetPackGUID();
 
@@ -0,0 +1,275 @@
+/**
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2026 MaNGOS <https://www.getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+#include "CaptureReplay.h"
+
+#include "IClientLink.h"
+#include "Log.h"
+#include "Map.h"
+#include "MapManager.h"
+#include "MapTickProfile.h"
+#include "Server/WorldGateway.h"
+#include "Utilities/RNGen.h"
+#include "World.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+    /// What the world sent back, summed over every replayed session.
+    struct ReplayTraffic
+    {
+        std::atomic<uint64> packets{0};
+        std::atomic<uint64> bytes{0};
+    };
+
+    /**
+     * @brief The client end of a replayed session: counts what it is sent, then drops it.
+     *
+     * The bytes include the 4-byte server header, so they compare with what
+     * the live realm put on the wire for the same load.
+     */
+    class ReplayLink final : public proto::IClientLink
+    {
+        public:
+
+            ReplayLink(ReplayTraffic& traffic, std::string const& address)
+                : m_traffic(traffic), m_address(address), m_closed(false)
+            {
+            }
+
+            void SendPacket(const WorldPacket& packet) override
+            {
+                if (!m_closed.load(std::memory_order_relaxed))
+                {
+                    m_traffic.packets.fetch_add(1, std::memory_order_relaxed);
+                    m_traffic.bytes.fetch_add(packet.size() + 4, std::memory_order_relaxed);
+                }
+            }
+
+            void Close() override { m_closed.store(true); }
+            const std::string& GetRemoteAddress() const override { return m_address; }
+            bool IsClosed() const override { return m_closed.load(); }
+
+        private:
+
+            ReplayTraffic& m_traffic;
+            std::string m_address;
+            std::atomic<bool> m_closed;
+    };
+
+    /**
+     * @brief Every sample of one measure, in microseconds.
+     *
+     * A replay is short and its samples are few enough to keep, so the
+     * percentiles are exact rather than the histogram bounds the live
+     * profilers report.
+     */
+    class Samples
+    {
+        public:
+
+            void Add(uint64 micros) { m_values.push_back(micros); }
+            bool Empty() const { return m_values.empty(); }
+
+            /// e.g. "avg 812us p50 640us p99 4100us max 9210us"
+            std::string Format()
+            {
+                std::sort(m_values.begin(), m_values.end());
+                uint64 total = 0;
+                for (uint64 value : m_values)
+                {
+                    total += value;
+                }
+
+                char buf[128];
+                snprintf(buf, sizeof(buf), "avg " UI64FMTD "us p50 " UI64FMTD "us p99 " UI64FMTD "us max " UI64FMTD "us",
+                         total / m_values.size(), Percentile(50), Percentile(99), m_values.back());
+                return buf;
+            }
+
+        private:
+
+            uint64 Percentile(uint32 percent) const
+            {
+                return m_values[(m_values.size() - 1) * percent / 100];
+            }
+
+            std::vector<uint64> m_values;
+    };
+}
+
+CaptureReplay::CaptureReplay()
+{
+}
+
+CaptureReplay::~CaptureReplay()
+{
+}
+
+bool CaptureReplay::Open(std::string const& path)
+{
+    if (!m_reader.Open(path))
+    {
+        sLog.outError("Replay: %s is not a packet capture", path.c_str());
+        return false;
+    }
+
+    // The capture seeded every thread's generator as it opened; doing the same
+    // here, before the world loads, is what makes the rolls repeat.
+    m_path = path;
+    RNG::Seed(m_reader.GetSeed());
+    sLog.outString("Replay: %s, seed %u", path.c_str(), m_reader.GetSeed());
+    return true;
+}
+
+void CaptureReplay::Run()
+{
+    typedef std::chrono::steady_clock Clock;
+
+    WorldGateway gateway;
+    ReplayTraffic traffic;
+    std::unordered_map<uint32, proto::SessionId> sessions; // captured id -> ours
+    std::unordered_map<Map const*, uint64> mapTicks;       // ticks each map had ended when last seen
+
+    Samples worldTicks;
+    Samples mapTotals;
+    Samples phases[MAP_TICK_PHASE_COUNT];
+    uint64 simulatedMs = 0;
+    uint64 packetsIn = 0;
+    uint32 refused = 0;
+
+    sLog.outString("Replay: running %s", m_path.c_str());
+    Clock::time_point const start = Clock::now();
+
+    CaptureRecord record;
+    while (!World::IsStopped() && m_reader.Next(record))
+    {
+        switch (record.type)
+        {
+            case CAPTURE_ATTACH:
+            {
+                // The same admission a live client gets, minus the proof of the
+                // session key: the account row and its bans, locks and security
+                // are all read from the snapshot.
+                proto::AuthRequest request;
+                request.build = record.build;
+                request.account = record.account;
+                request.peerAddress = record.address;
+
+                proto::AuthLookup const lookup = gateway.LookupAccount(request);
+                proto::SessionId const session = lookup.status == proto::AuthStatus::Ok
+                    ? gateway.Attach(request, std::make_shared<ReplayLink>(traffic, record.address), lookup.context)
+                    : proto::INVALID_SESSION_ID;
+                if (session == proto::INVALID_SESSION_ID)
+                {
+                    sLog.outError("Replay: account %s was refused, its packets are skipped", record.account.c_str());
+                    ++refused;
+                    break;
+                }
+                sessions[record.session] = session;
+                break;
+            }
+            case CAPTURE_PACKET:
+            {
+                auto const session = sessions.find(record.session);
+                if (session != sessions.end())
+                {
+                    gateway.Deliver(session->second, std::move(record.packet));
+                    ++packetsIn;
+                }
+                break;
+            }
+            case CAPTURE_DETACH:
+            {
+                auto const session = sessions.find(record.session);
+                if (session != sessions.end())
+                {
+                    gateway.Detach(session->second);
+                    sessions.erase(session);
+                }
+                break;
+            }
+            case CAPTURE_TICK:
+            {
+                ++World::m_worldLoopCounter;
+
+                Clock::time_point const tickStart = Clock::now();
+                sWorld.Update(record.diff);
+                worldTicks.Add(std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - tickStart).count());
+                simulatedMs += record.diff;
+
+                // Only the maps that ran this tick; the others still show their last one.
+                sMapMgr.DoForAllMaps([&](Map* map)
+                {
+                    MapTickProfile const& profile = map->GetTickProfile();
+                    uint64& seen = mapTicks[map];
+                    if (seen == profile.GetTicksEnded())
+                    {
+                        return;
+                    }
+                    seen = profile.GetTicksEnded();
+
+                    mapTotals.Add(profile.GetLastTickTotal());
+                    for (uint32 phase = 0; phase < MAP_TICK_PHASE_COUNT; ++phase)
+                    {
+                        phases[phase].Add(profile.GetLastTickMicros(MapTickPhase(phase)));
+                    }
+                });
+                break;
+            }
+        }
+    }
+
+    uint64 const wallMs = std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - start).count();
+    if (m_reader.IsTruncated())
+    {
+        sLog.outError("Replay: the capture ends in a partial record, which was ignored");
+    }
+
+    sLog.outString("Replay: " UI64FMTD " ms of play in " UI64FMTD " ms, " UI64FMTD " packets in, " UI64FMTD " packets (" UI64FMTD " bytes) out, %u sessions refused",
+                   simulatedMs, wallMs, packetsIn, traffic.packets.load(), traffic.bytes.load(), refused);
+    if (worldTicks.Empty())
+    {
+        sLog.outString("Replay: the capture holds no ticks");
+        return;
+    }
+
+    sLog.outString("Replay: world tick %s", worldTicks.Format().c_str());
+    if (!mapTotals.Empty())
+    {
+        sLog.outString("Replay: map tick %s", mapTotals.Format().c_str());
+        for (uint32 phase = 0; phase < MAP_TICK_PHASE_COUNT; ++phase)
+        {
+            sLog.outString("Replay:   %-14s %s", GetMapTickPhaseName(MapTickPhase(phase)), phases[phase].Format().c_str());
+        }
+    }
+}
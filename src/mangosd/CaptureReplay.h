@@ -0,0 +1,88 @@
+/**
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2026 MaNGOS <https://www.getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+#ifndef MANGOS_H_CAPTUREREPLAY
+#define MANGOS_H_CAPTUREREPLAY
+
+#include "Server/PacketCapture.h"
+
+#include "Platform/Define.h"
+
+#include <string>
+
+/**
+ * @brief Feeds a packet capture back into a headless world and times it.
+ *
+ * `mangosd --replay <file>` loads the world as usual but opens no listener and
+ * starts no services. Instead the capture written under Capture.File is read
+ * back: sessions attach and detach through a WorldGateway of our own, packets
+ * reach their sessions' mailboxes as they did live, and each recorded tick runs
+ * sWorld.Update() with the recorded diff -- back to back, without the world
+ * loop's sleep, so a minute of play replays in however long the work takes.
+ *
+ * What comes out is the wall time of every world tick and the per-phase time of
+ * every map tick (see MapTickProfile), as averages and percentiles. That makes
+ * two builds comparable on the same load, which a live realm never is.
+ *
+ * The replay is only as faithful as its start: restore the database snapshot
+ * taken when the capture was opened before every run, or characters will not
+ * be where the packets expect them. See Open() for the seed.
+ */
+class CaptureReplay
+{
+    public:
+
+        CaptureReplay();
+        ~CaptureReplay();
+
+        CaptureReplay(const CaptureReplay&) = delete;
+        CaptureReplay& operator=(const CaptureReplay&) = delete;
+
+        /**
+         * @brief Open a capture and seed the RNG the way the capture did.
+         *
+         * Must be called before the world loads, as Master opens a capture, so
+         * that the rolls made while loading repeat too.
+         *
+         * @param path The capture file.
+         * @return false if the file is missing or is not a capture.
+         */
+        bool Open(std::string const& path);
+
+        /**
+         * @brief Replay every record, then log the timings.
+         *
+         * Returns early if the world is stopped meanwhile. Sessions still
+         * attached at the end are left for Master's shutdown to kick.
+         */
+        void Run();
+
+    private:
+
+        std::string m_path;
+        PacketCaptureReader m_reader;
+};
+
+#endif
@@ -30,6 +30,7 @@
 #include "CliService.h"
 #include "RASession.h"
 #include "AhService.h"
+#include "CaptureReplay.h"
 
 #include "Config/Config.h"
 #include "Console/ConsoleUI.h"
@@ -37,9 +38,11 @@
 #include "Database/DatabaseEnv.h"
 #include "Log.h"
 #include "MapManager.h"
+#include "Server/PacketCapture.h"
 #include "Server/WorldNetwork.h"
 #include "SystemConfig.h"
 #include "Timer.h"
+#include "Utilities/RNGen.h"
 #include "World.h"
 #include "Server/WardenCheckCatalogLoader.h"
 
@@ -56,6 +59,7 @@ extern int m_ServiceStatus;
 #endif
 
 #include <chrono>
+#include <random>
 #include <string>
 #include <thread>
 #include <vector>
@@ -279,6 +283,55 @@ void Master::StopServices()
     m_services.clear();
 }
 
+void Master::PublishRealm()
+{
+    const uint8 recommendedOrNew =
+        sWorld.getConfig(CONFIG_BOOL_REALM_RECOMMENDED_OR_NEW)
+            ? REALM_FLAG_NEW_PLAYERS : REALM_FLAG_RECOMMENDED;
+    const uint8 realmStatus =
+        sWorld.getConfig(CONFIG_BOOL_REALM_RECOMMENDED_OR_NEW_ENABLED)
+            ? recommendedOrNew : uint8(REALM_FLAG_NONE);
+
+    std::string builds = AcceptableClientBuildsListStr();
+    LoginDatabase.escape_string(builds);
+    LoginDatabase.DirectPExecute(
+        "UPDATE `realmlist` SET `realmflags` = %u, `population` = 0, "
+        "`realmbuilds` = '%s' WHERE `id` = '%u'",
+        realmStatus, builds.c_str(), realmID);
+}
+
+void Master::StartCapture()
+{
+    const std::string captureFile = sConfig.GetStringDefault("Capture.File", "");
+    if (captureFile.empty())
+    {
+        return;
+    }
+
+    // Opened before the world loads, so the seed covers the rolls made while
+    // loading as well. A replay has to start from a copy of the databases as
+    // they are at this moment.
+    const uint32 seed = std::random_device()();
+    if (!sPacketCapture.Open(captureFile, seed))
+    {
+        sLog.outError("Cannot open the packet capture %s, not capturing", captureFile.c_str());
+        return;
+    }
+
+    RNG::Seed(seed);
+    sLog.outString("Capturing client packets to %s (seed %u)", captureFile.c_str(), seed);
+}
+
+void Master::StopCapture()
+{
+    if (sPacketCapture.IsOpen())
+    {
+        sLog.outString("[shutdown] closing the packet capture (" UI64FMTD " ticks, " UI64FMTD " packets)",
+                       sPacketCapture.GetTickCount(), sPacketCapture.GetPacketCount());
+        sPacketCapture.Close();
+    }
+}
+
 void Master::PublishConsoleStatus(uint32 diff)
 {
 #ifdef _WIN32
@@ -329,7 +382,12 @@ void Master::WorldLoop()
         ++World::m_worldLoopCounter;
 
         const uint32 current = getMSTime();
-        sWorld.Update(getMSTimeDiff(previous, current));
+        const uint32 diff = getMSTimeDiff(previous, current);
+        if (sPacketCapture.IsOpen())
+        {
+            sPacketCapture.WriteTick(diff);
+        }
+        sWorld.Update(diff);
         previous = current;
 
         const uint32 spent = getMSTimeDiff(current, getMSTime());
@@ -394,26 +452,31 @@ int Master::Run()
         return 1;
     }
 
+    // Either way the seed is fixed before the world loads.
+    std::unique_ptr<CaptureReplay> replay;
+    if (!m_replayFile.empty())
+    {
+        replay.reset(new CaptureReplay());
+        if (!replay->Open(m_replayFile))
+        {
+            StopDatabases();
+            return 1;
+        }
+    }
+    else
+    {
+        StartCapture();
+    }
+
     sWorld.SetInitialWorldSettings();
 
+    if (!replay)
+    {
 #ifndef _WIN32
-    detachDaemon();
+        detachDaemon();
 #endif
-
-    // Publish this realm's flags and the client builds it accepts.
-    const uint8 recommendedOrNew =
-        sWorld.getConfig(CONFIG_BOOL_REALM_RECOMMENDED_OR_NEW)
-            ? REALM_FLAG_NEW_PLAYERS : REALM_FLAG_RECOMMENDED;
-    const uint8 realmStatus =
-        sWorld.getConfig(CONFIG_BOOL_REALM_RECOMMENDED_OR_NEW_ENABLED)
-            ? recommendedOrNew : uint8(REALM_FLAG_NONE);
-
-    std::string builds = AcceptableClientBuildsListStr();
-    LoginDatabase.escape_string(builds);
-    LoginDatabase.DirectPExecute(
-        "UPDATE `realmlist` SET `realmflags` = %u, `population` = 0, "
-        "`realmbuilds` = '%s' WHERE `id` = '%u'",
-        realmStatus, builds.c_str(), realmID);
+        PublishRealm();
+    }
 
     // Async transactions are forbidden during start-up; enable them only now
     // that the world is fully loaded.
@@ -422,16 +485,25 @@ int Master::Run()
     WorldDatabase.AllowAsyncTransactions();
     LoginDatabase.AllowAsyncTransactions();
 
-    if (!sWorldNetwork.Start(uint16(sWorld.getConfig(CONFIG_UINT32_PORT_WORLD)),
-                             sConfig.GetStringDefault("BindIP", "0.0.0.0")))
+    if (replay)
     {
-        StopDatabases();
-        return 1;
+        replay->Run();
     }
+    else
+    {
+        if (!sWorldNetwork.Start(uint16(sWorld.getConfig(CONFIG_UINT32_PORT_WORLD)),
+                                 sConfig.GetStringDefault("BindIP", "0.0.0.0")))
+        {
+            StopCapture();
+            StopDatabases();
+            return 1;
+        }
 
-    StartServices();
+        StartServices();
 
-    WorldLoop();
+        WorldLoop();
+        StopCapture();
+    }
 
     ShutdownWorld();
     StopServices();
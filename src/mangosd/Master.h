@@ -31,6 +31,7 @@
 #include "Platform/Define.h"
 
 #include <memory>
+#include <string>
 #include <vector>
 
 /**
@@ -65,6 +66,17 @@ class Master
          */
         int Run();
 
+        /**
+         * @brief Replay a packet capture instead of serving clients.
+         *
+         * Run() then loads the world, replays the capture as fast as it goes
+         * (see CaptureReplay), logs the timings and shuts down. No listener, no
+         * services, no realm list update.
+         *
+         * @param captureFile A file written under Capture.File.
+         */
+        void SetReplay(std::string const& captureFile) { m_replayFile = captureFile; }
+
     private:
 
         bool StartDatabases();
@@ -74,6 +86,13 @@ class Master
         void StartServices();
         void StopServices();
 
+        /// Announce this realm's flags and accepted builds in the realm list.
+        void PublishRealm();
+
+        /// Start recording client packets if Capture.File is set.
+        void StartCapture();
+        void StopCapture();
+
         /// The world heartbeat. Returns when World::IsStopped() becomes true.
         void WorldLoop();
 
@@ -85,6 +104,7 @@ class Master
         void ShutdownWorld();
 
         std::vector<std::unique_ptr<IService>> m_services;
+        std::string m_replayFile;
 };
 
 #endif
@@ -161,6 +161,7 @@ static void usage(const char* prog)
         "    -v, --version              print version and exist\n\r"
         "    -c <config_file>           use config_file as configuration file\n\r"
         "    -a, --ahbot <config_file>  use config_file as ahbot configuration file\n\r"
+        "    --replay <capture_file>    replay a packet capture as fast as possible and report timings\n\r"
 #ifdef WIN32
         "    Running as service functions:\n\r"
         "    -s run                     run as service\n\r"
@@ -204,9 +205,10 @@ int main(int argc, char** argv)
     char const* cfg_file = MANGOSD_CONFIG_LOCATION;
 
     char serviceDaemonMode = '\0';
+    std::string replayFile;
 
     // Walked by hand rather than with ACE_Get_Opt (gone with the rest of ACE) or
-    // getopt (absent on MSVC). Four options do not justify a dependency.
+    // getopt (absent on MSVC). Five options do not justify a dependency.
     for (int i = 1; i < argc; ++i)
     {
         const std::string arg = argv[i];
@@ -225,6 +227,10 @@ int main(int argc, char** argv)
         {
             sAuctionBotConfig.SetConfigFileName(argv[++i]);
         }
+        else if (arg == "--replay" && hasValue)
+        {
+            replayFile = argv[++i];
+        }
         else if (arg == "-s" && hasValue)
         {
             const std::string mode = argv[++i];
@@ -376,6 +382,10 @@ int main(int argc, char** argv)
     // runs the world loop on this thread and returns once the world has stopped
     // and every service has been joined.
     Master master;
+    if (!replayFile.empty())
+    {
+        master.SetReplay(replayFile);
+    }
     const int runCode = master.Run();
 
     ///- Remove signal handling before leaving
@@ -20,6 +20,8 @@
 #include "PlayerbotAI.h"
 #include "PlayerbotFactory.h"
 #include "PlayerbotSecurity.h"
+#include "PlayerbotPerformanceMonitor.h"
+#include "PlayerbotUpdateScheduler.h"
 #include "Util.h"
 #include <cstdarg>
 
@@ -90,7 +92,8 @@ PlayerbotAI::PlayerbotAI() : PlayerbotAIBase(), bot(NULL), aiObjectContext(NULL)
     m_jumpStartX(0.f), m_jumpStartY(0.f), m_jumpStartZ(0.f),
     m_jumpSinAngle(0.f), m_jumpCosAngle(1.f), m_jumpXYSpeed(0.f),
     m_pendingJump(false), m_jumpHere(false), m_jumpRequestTime(0),
-    m_jumpTargetX(0.f), m_jumpTargetY(0.f), m_jumpTargetZ(0.f), m_jumpTargetO(0.f)
+    m_jumpTargetX(0.f), m_jumpTargetY(0.f), m_jumpTargetZ(0.f), m_jumpTargetO(0.f),
+    m_scheduleDeferrals(0)
 {
     for (int i = 0 ; i < BOT_STATE_MAX; i++)
     {
@@ -109,7 +112,8 @@ PlayerbotAI::PlayerbotAI(Player* bot)
     m_jumpStartX(0.f), m_jumpStartY(0.f), m_jumpStartZ(0.f),
     m_jumpSinAngle(0.f), m_jumpCosAngle(1.f), m_jumpXYSpeed(0.f),
     m_pendingJump(false), m_jumpHere(false), m_jumpRequestTime(0),
-    m_jumpTargetX(0.f), m_jumpTargetY(0.f), m_jumpTargetZ(0.f), m_jumpTargetO(0.f)
+    m_jumpTargetX(0.f), m_jumpTargetY(0.f), m_jumpTargetZ(0.f), m_jumpTargetO(0.f),
+    m_scheduleDeferrals(0)
 {
     this->bot = bot;
 
@@ -408,7 +412,53 @@ void PlayerbotAI::UpdateAI(uint32 elapsed)
         UpdateJump();
     }
 
+    // Only a bot that is actually due asks for budget; one still waiting out its delay
+    // costs nothing and is left to PlayerbotAIBase to count down.
+    ai::PlayerbotUpdateScheduler& scheduler = ai::ThreadPlayerbotUpdateScheduler();
+    if (IsDueAfter(elapsed))
+    {
+        if (!scheduler.Admit(GetUpdatePriority(), m_scheduleDeferrals))
+        {
+            // Still due next tick: nothing is subtracted from the delay, so it stays due.
+            ++m_scheduleDeferrals;
+            if (sPlayerbotAIConfig.performanceMetricsInterval)
+            {
+                ai::sPlayerbotPerformanceMonitor.RecordAiBudgetDeferred();
+            }
+            return;
+        }
+        m_scheduleDeferrals = 0;
+    }
+
+    if (!scheduler.IsActive())
+    {
+        PlayerbotAIBase::UpdateAI(elapsed);
+        return;
+    }
+
+    std::uint64_t const startedAtMicros = ai::PlayerbotPerformanceNowMicros();
     PlayerbotAIBase::UpdateAI(elapsed);
+    scheduler.Charge(ai::PlayerbotPerformanceNowMicros() - startedAtMicros);
+}
+
+ai::PlayerbotUpdatePriority PlayerbotAI::GetUpdatePriority()
+{
+    Player* owner = GetMaster();
+    bool const realMaster = owner && !owner->GetPlayerbotAI();
+
+    if (bot->IsInCombat() || (realMaster && owner->IsInCombat()))
+    {
+        return ai::PLAYERBOT_UPDATE_COMBAT;
+    }
+
+    // A zone is the cheapest "near" there is, and the one the random bot manager already
+    // keeps a count for. A bot someone is giving orders to is near by definition.
+    if (realMaster || sRandomPlayerbotMgr.HasRealPlayerInZone(bot->GetZoneId()))
+    {
+        return ai::PLAYERBOT_UPDATE_NEAR;
+    }
+
+    return ai::PLAYERBOT_UPDATE_IDLE;
 }
 
 void PlayerbotAI::UpdateAIInternal(uint32 elapsed)
@@ -591,7 +641,7 @@ void PlayerbotAI::ResyncObserversAfterTeleport()
         if (observer->HaveAtClient(bot))
         {
             bot->DestroyForPlayer(observer);
-            observer->m_clientGUIDs.erase(bot->GetObjectGuid());
+            observer->RemoveClientObject(bot);
         }
 
         // Through the CAMERA, not the body. HaveAtClient above is a statement about what the
@@ -786,6 +836,19 @@ void PlayerbotAI::HandleBotOutgoingPacket(const WorldPacket& packet)
     }
 }
 
+/**
+ * Whether HandleBotOutgoingPacket does anything with a packet of this opcode.
+ * Everything else sent to a bot is read by nobody, so the server need not build it.
+ * @param opcode The opcode.
+ * @return True if the bot reads it.
+ */
+bool PlayerbotAI::ConsumesOutgoingOpcode(uint16 opcode) const
+{
+    // The cases HandleBotOutgoingPacket reads before (or instead of) queueing.
+    static uint16 const inlineOpcodes[] = { SMSG_CAST_FAILED, SMSG_SPELL_FAILURE, SMSG_SPELL_DELAYED };
+    return botOutgoingPacketHandlers.Consumes(inlineOpcodes, opcode);
+}
+
 /**
  * Handles spell interruption for the bot.
  * @param spellid The ID of the interrupted spell.
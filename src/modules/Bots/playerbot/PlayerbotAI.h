@@ -7,7 +7,9 @@
 #include "strategy/ExternalEventHelper.h"
 #include "ChatFilter.h"
 #include "PlayerbotEventQueue.h"
+#include "PlayerbotPacketPolicy.h"
 #include "PlayerbotSecurity.h"
+#include "PlayerbotUpdateScheduler.h"
 
 class Player;
 class PlayerbotMgr;
@@ -86,6 +88,11 @@ class PacketHandlingHelper
         void AddHandler(uint16 opcode, string handler);
         void Handle(ExternalEventHelper &helper);
         void AddPacket(const WorldPacket& packet);
+        template <std::size_t InlineCount>
+        bool Consumes(uint16 const (&inlineOpcodes)[InlineCount], uint16 opcode) const
+        {
+            return ai::PlayerbotConsumesOutgoingOpcode(handlers, inlineOpcodes, opcode);
+        }
         bool IsEmpty()
         {
             return queue.size() == 0;
@@ -143,6 +150,7 @@ class PlayerbotAI : public PlayerbotAIBase
         virtual void UpdateAIInternal(uint32 elapsed);
         void HandleCommand(uint32 type, const string& text, Player& fromPlayer);
         void HandleBotOutgoingPacket(const WorldPacket& packet);
+        bool ConsumesOutgoingOpcode(uint16 opcode) const;
         void HandleMasterIncomingPacket(const WorldPacket& packet);
         void HandleMasterOutgoingPacket(const WorldPacket& packet);
         void HandleTeleportAck();
@@ -300,5 +308,12 @@ class PlayerbotAI : public PlayerbotAIBase
         uint32 m_jumpRequestTime;
         float  m_jumpTargetX, m_jumpTargetY, m_jumpTargetZ, m_jumpTargetO;
 
+        uint32 m_scheduleDeferrals; ///< Consecutive map ticks the update scheduler has turned this bot away.
+
         void UpdateJump();
+
+        /**
+         * @brief Where this bot stands in the map tick's AI budget.
+         */
+        ai::PlayerbotUpdatePriority GetUpdatePriority();
 };
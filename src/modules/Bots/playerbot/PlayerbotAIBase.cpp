@@ -92,6 +92,16 @@ bool PlayerbotAIBase::CanUpdateAI() const
     return nextAICheckDelay < 100;
 }
 
+/**
+ * @brief Checks if the AI will be due once the given time has elapsed.
+ * @param elapsed The time about to be passed to UpdateAI.
+ * @return True if UpdateAI(elapsed) would evaluate, false otherwise.
+ */
+bool PlayerbotAIBase::IsDueAfter(uint32 elapsed) const
+{
+    return nextAICheckDelay < elapsed + 100;
+}
+
 /**
  * @brief Yields the current thread.
  * This function can be used to pause the execution of the current thread.
@@ -26,6 +26,13 @@ class PlayerbotAIBase
          */
         bool CanUpdateAI() const;
 
+        /**
+         * @brief Checks if the AI will be due once the given time has elapsed.
+         * @param elapsed The time about to be passed to UpdateAI.
+         * @return True if UpdateAI(elapsed) would evaluate, false otherwise.
+         */
+        bool IsDueAfter(uint32 elapsed) const;
+
         /**
          * @brief Sets the delay for the next AI check.
          * @param delay The delay in milliseconds.
@@ -78,6 +78,8 @@ PlayerbotAIConfig::PlayerbotAIConfig()
     logInGroupOnly(false),
     logValuesPerTick(false),
     performanceMetricsInterval(0),
+    mapTickBudgetMs(0),
+    maxDeferredTicks(0),
     fleeingEnabled(false),
     randomBotMinLevel(0),
     randomBotMaxLevel(0),
@@ -251,6 +253,8 @@ bool PlayerbotAIConfig::Initialize()
         configuredPerformanceMetricsInterval = 0;
     }
     performanceMetricsInterval = static_cast<uint32>(configuredPerformanceMetricsInterval);
+    mapTickBudgetMs = config.GetIntDefault("AiPlayerbot.MapTickBudgetMs", 20);
+    maxDeferredTicks = config.GetIntDefault("AiPlayerbot.MaxDeferredTicks", 10);
     fleeingEnabled = config.GetBoolDefault("AiPlayerbot.FleeingEnabled", true);
     randomBotMinLevel = config.GetIntDefault("AiPlayerbot.RandomBotMinLevel", 1);
     randomBotMaxLevel = config.GetIntDefault("AiPlayerbot.RandomBotMaxLevel", 255);
@@ -82,6 +82,8 @@ class PlayerbotAIConfig
         uint32 randomBotHomeAreaMaxLevel; ///< Bots at or below this level stay in the starting SUB-AREA -- Shadowglen, Northshire. 0 disables.
         bool logInGroupOnly, logValuesPerTick;
         uint32 performanceMetricsInterval; ///< Seconds between aggregate performance reports; 0 disables instrumentation.
+        uint32 mapTickBudgetMs; ///< Bot AI time (ms) one map tick may spend before idle and distant bots are deferred; 0 disables.
+        uint32 maxDeferredTicks; ///< Map ticks in a row a bot may be deferred before it is updated regardless of budget.
         bool fleeingEnabled; ///< Indicates if fleeing is enabled for bots.
         std::string randomBotCombatStrategies, randomBotNonCombatStrategies;
         std::string botTankStrategies, botDpsStrategies, botHealStrategies, botGroupNonCombatStrategies;
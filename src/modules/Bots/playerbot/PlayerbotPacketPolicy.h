@@ -54,4 +54,23 @@ namespace ai
 
         return &handler;
     }
+
+    // Whether a bot reads an outgoing packet at all: one of the opcodes its AI inspects
+    // inline, or one with a queued handler. The server builds nothing else for a bot.
+    template <typename HandlerMap, std::size_t InlineCount>
+    bool PlayerbotConsumesOutgoingOpcode(
+        HandlerMap const& handlers,
+        typename HandlerMap::key_type const (&inlineOpcodes)[InlineCount],
+        typename HandlerMap::key_type const& opcode)
+    {
+        for (std::size_t i = 0; i < InlineCount; ++i)
+        {
+            if (inlineOpcodes[i] == opcode)
+            {
+                return true;
+            }
+        }
+
+        return FindPlayerbotEventHandler(handlers, opcode) != nullptr;
+    }
 }
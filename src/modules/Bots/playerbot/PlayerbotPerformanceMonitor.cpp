@@ -49,10 +49,15 @@ namespace ai
             "Playerbot performance: built packets=" UI64FMTD " bytes=" UI64FMTD
             "; event queries=" UI64FMTD " total_us=" UI64FMTD " max_us=" UI64FMTD
             "; AI evaluations inclusive_of_event_queries=" UI64FMTD " deferred=" UI64FMTD
-            " total_us=" UI64FMTD " max_us=" UI64FMTD,
+            " total_us=" UI64FMTD " max_us=" UI64FMTD
+            "; AI budget deferrals=" UI64FMTD
+            " overruns=" UI64FMTD " total_us=" UI64FMTD " max_us=" UI64FMTD,
             snapshot.builtPacketCount, snapshot.builtPacketBytes,
             snapshot.eventQueryCount, snapshot.eventQueryTotalMicros, snapshot.eventQueryMaxMicros,
             snapshot.aiEvaluationCount, snapshot.aiDeferredCount,
-            snapshot.aiEvaluationTotalMicros, snapshot.aiEvaluationMaxMicros);
+            snapshot.aiEvaluationTotalMicros, snapshot.aiEvaluationMaxMicros,
+            snapshot.aiBudgetDeferredCount,
+            snapshot.aiBudgetOverrunCount, snapshot.aiBudgetOverrunTotalMicros,
+            snapshot.aiBudgetOverrunMaxMicros);
     }
 }
@@ -43,6 +43,10 @@ namespace ai
         std::uint64_t aiDeferredCount = 0;
         std::uint64_t aiEvaluationTotalMicros = 0;
         std::uint64_t aiEvaluationMaxMicros = 0;
+        std::uint64_t aiBudgetDeferredCount = 0;
+        std::uint64_t aiBudgetOverrunCount = 0;
+        std::uint64_t aiBudgetOverrunTotalMicros = 0;
+        std::uint64_t aiBudgetOverrunMaxMicros = 0;
     };
 
     class PlayerbotPerformanceMonitor
@@ -58,7 +62,11 @@ namespace ai
                 m_aiEvaluationCount(0),
                 m_aiDeferredCount(0),
                 m_aiEvaluationTotalMicros(0),
-                m_aiEvaluationMaxMicros(0)
+                m_aiEvaluationMaxMicros(0),
+                m_aiBudgetDeferredCount(0),
+                m_aiBudgetOverrunCount(0),
+                m_aiBudgetOverrunTotalMicros(0),
+                m_aiBudgetOverrunMaxMicros(0)
             {
             }
 
@@ -87,6 +95,20 @@ namespace ai
                 m_aiDeferredCount.fetch_add(1, std::memory_order_relaxed);
             }
 
+            /// A due bot turned away by PlayerbotUpdateScheduler, to be retried next tick.
+            void RecordAiBudgetDeferred()
+            {
+                m_aiBudgetDeferredCount.fetch_add(1, std::memory_order_relaxed);
+            }
+
+            /// A map tick whose bot AI ran past its PlayerbotUpdateScheduler budget.
+            void RecordAiBudgetOverrun(std::uint64_t overrunMicros)
+            {
+                m_aiBudgetOverrunCount.fetch_add(1, std::memory_order_relaxed);
+                m_aiBudgetOverrunTotalMicros.fetch_add(overrunMicros, std::memory_order_relaxed);
+                UpdateMax(m_aiBudgetOverrunMaxMicros, overrunMicros);
+            }
+
             bool TakeSnapshotIfDue(std::uint64_t nowMicros, std::uint64_t intervalMicros,
                 PlayerbotPerformanceSnapshot& snapshot)
             {
@@ -121,6 +143,10 @@ namespace ai
                 snapshot.aiDeferredCount = m_aiDeferredCount.exchange(0, std::memory_order_acq_rel);
                 snapshot.aiEvaluationTotalMicros = m_aiEvaluationTotalMicros.exchange(0, std::memory_order_acq_rel);
                 snapshot.aiEvaluationMaxMicros = m_aiEvaluationMaxMicros.exchange(0, std::memory_order_acq_rel);
+                snapshot.aiBudgetDeferredCount = m_aiBudgetDeferredCount.exchange(0, std::memory_order_acq_rel);
+                snapshot.aiBudgetOverrunCount = m_aiBudgetOverrunCount.exchange(0, std::memory_order_acq_rel);
+                snapshot.aiBudgetOverrunTotalMicros = m_aiBudgetOverrunTotalMicros.exchange(0, std::memory_order_acq_rel);
+                snapshot.aiBudgetOverrunMaxMicros = m_aiBudgetOverrunMaxMicros.exchange(0, std::memory_order_acq_rel);
                 return true;
             }
 
@@ -144,6 +170,10 @@ namespace ai
             std::atomic<std::uint64_t> m_aiDeferredCount;
             std::atomic<std::uint64_t> m_aiEvaluationTotalMicros;
             std::atomic<std::uint64_t> m_aiEvaluationMaxMicros;
+            std::atomic<std::uint64_t> m_aiBudgetDeferredCount;
+            std::atomic<std::uint64_t> m_aiBudgetOverrunCount;
+            std::atomic<std::uint64_t> m_aiBudgetOverrunTotalMicros;
+            std::atomic<std::uint64_t> m_aiBudgetOverrunMaxMicros;
     };
 
     inline std::uint64_t PlayerbotPerformanceNowMicros()
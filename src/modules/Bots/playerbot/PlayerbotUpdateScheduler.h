@@ -0,0 +1,142 @@
+/**
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2026 MaNGOS <https://www.getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+namespace ai
+{
+    /// How much a bot's next decision matters to the real players around it. Lower is
+    /// more urgent; the order is what Admit relies on.
+    enum PlayerbotUpdatePriority
+    {
+        PLAYERBOT_UPDATE_COMBAT = 0, ///< The bot, or the real player it follows, is fighting.
+        PLAYERBOT_UPDATE_NEAR   = 1, ///< Grouped with, or sharing a zone with, a real player.
+        PLAYERBOT_UPDATE_IDLE   = 2  ///< Nobody is watching.
+    };
+
+    /**
+     * @brief Per-map-tick time budget for bot AI evaluation.
+     *
+     * A map update begins a tick with a budget, every bot asks Admit before it evaluates
+     * and pays for what it used with Charge, and EndTick reports how far past the budget
+     * the tick went. Each priority may only spend up to its own share of the budget, so
+     * an idle bot early in the player list cannot use up the headroom a bot in combat
+     * later in the list needs. A bot turned away is simply due again next tick; once it
+     * has been turned away maxDeferrals times in a row it is admitted whatever the
+     * budget says, so nobody starves and an overrun is the worst case.
+     *
+     * One instance per map thread (see ThreadPlayerbotUpdateScheduler) and no locking:
+     * a map updates on one thread from start to finish.
+     */
+    class PlayerbotUpdateScheduler
+    {
+        public:
+            PlayerbotUpdateScheduler()
+                : m_budgetMicros(0), m_spentMicros(0), m_maxDeferrals(0),
+                m_admitted(0), m_deferred(0), m_active(false)
+            {
+            }
+
+            /// A zero budget admits everything; the scheduler then only keeps count.
+            void BeginTick(std::uint64_t budgetMicros, std::uint32_t maxDeferrals)
+            {
+                m_budgetMicros = budgetMicros;
+                m_maxDeferrals = maxDeferrals;
+                m_spentMicros = 0;
+                m_admitted = 0;
+                m_deferred = 0;
+                m_active = true;
+            }
+
+            bool Admit(PlayerbotUpdatePriority priority, std::uint32_t deferrals)
+            {
+                if (!m_active || !m_budgetMicros ||
+                    (m_maxDeferrals && deferrals >= m_maxDeferrals) ||
+                    m_spentMicros < ShareOf(priority))
+                {
+                    ++m_admitted;
+                    return true;
+                }
+
+                ++m_deferred;
+                return false;
+            }
+
+            void Charge(std::uint64_t micros)
+            {
+                m_spentMicros += micros;
+            }
+
+            /// @return how far the tick overran its budget, 0 if it did not.
+            std::uint64_t EndTick()
+            {
+                m_active = false;
+                if (!m_budgetMicros || m_spentMicros <= m_budgetMicros)
+                {
+                    return 0;
+                }
+                return m_spentMicros - m_budgetMicros;
+            }
+
+            bool IsActive() const { return m_active; }
+            std::uint64_t GetSpentMicros() const { return m_spentMicros; }
+            std::uint32_t GetAdmitted() const { return m_admitted; }
+            std::uint32_t GetDeferred() const { return m_deferred; }
+
+        private:
+            /// Combat gets the whole budget, bots near players three quarters, idle bots
+            /// half: whatever the idle ones leave is what the rest start from.
+            std::uint64_t ShareOf(PlayerbotUpdatePriority priority) const
+            {
+                switch (priority)
+                {
+                    case PLAYERBOT_UPDATE_COMBAT:
+                        return m_budgetMicros;
+                    case PLAYERBOT_UPDATE_NEAR:
+                        return m_budgetMicros * 3 / 4;
+                    default:
+                        return m_budgetMicros / 2;
+                }
+            }
+
+            std::uint64_t m_budgetMicros;
+            std::uint64_t m_spentMicros;
+            std::uint32_t m_maxDeferrals;
+            std::uint32_t m_admitted;
+            std::uint32_t m_deferred;
+            bool m_active;
+    };
+
+    /// The scheduler of the map this thread is updating. Outside a map tick -- the
+    /// world thread, a bot's owner updating it from elsewhere -- it is inactive and
+    /// admits everything.
+    inline PlayerbotUpdateScheduler& ThreadPlayerbotUpdateScheduler()
+    {
+        static thread_local PlayerbotUpdateScheduler scheduler;
+        return scheduler;
+    }
+}
@@ -28,7 +28,8 @@
  * It handles the creation, updating, and processing of these bots, ensuring they
  * behave in a way that simulates real player activity.
  */
-RandomPlayerbotMgr::RandomPlayerbotMgr() : PlayerbotHolder(), processTicks(0), m_processBotCursor(0), m_starterZoneCountsPass(-1), m_freeBotsPass(-1)
+RandomPlayerbotMgr::RandomPlayerbotMgr() : PlayerbotHolder(), processTicks(0), m_processBotCursor(0), m_starterZoneCountsPass(-1), m_freeBotsPass(-1),
+    m_eventValuesLoaded(false)
 {
 }
 
@@ -45,15 +46,6 @@ void RandomPlayerbotMgr::UpdateAIInternal(uint32 elapsed)
         return;
     }
 
-    if (sPlayerbotAIConfig.randomBotKeepGroups)
-    {
-        if (!processTicks)
-        {
-            EnsureGroupedBotsOnline();
-        }
-        LoadGroupedBots();
-    }
-
     if (!processTicks)
     {
         // Both statements in this block are DirectExecute, and they have to be. Reported by
@@ -106,6 +98,23 @@ void RandomPlayerbotMgr::UpdateAIInternal(uint32 elapsed)
             "AND NOT EXISTS (SELECT 1 FROM `character_spell` `s` WHERE `s`.`guid` = `c`.`guid`)");
     }
 
+    // After the two deletes above, which are direct, so the store never holds a row they
+    // were meant to remove. Everything below -- EnsureGroupedBotsOnline included, which
+    // asks after every grouped bot -- then reads from memory.
+    if (!m_eventValuesLoaded)
+    {
+        LoadEventValues();
+    }
+
+    if (sPlayerbotAIConfig.randomBotKeepGroups)
+    {
+        if (!processTicks)
+        {
+            EnsureGroupedBotsOnline();
+        }
+        LoadGroupedBots();
+    }
+
     sLog.outBasic("Processing random bots...");
 
     uint32 cachedMin = GetEventValue(0, "config_min");
@@ -275,6 +284,8 @@ void RandomPlayerbotMgr::UpdateAIInternal(uint32 elapsed)
         botProcessed, (uint32)examined, overBudget ? " (budget reached, more pending)" : "", allianceNewBots, hordeNewBots, playerBots.size(),
         overBudget ? sPlayerbotAIConfig.randomBotCatchupInterval : sPlayerbotAIConfig.randomBotUpdateInterval);
 
+    FlushEventValues();
+
     if (processTicks++ == 1)
     {
         PrintStats();
@@ -437,10 +448,8 @@ uint32 RandomPlayerbotMgr::AddRandomBot(bool alliance)
     }
 
     // Strike it from the cached list, because leaving it in lets the same bot be drawn
-    // twice in one pass. A rebuild below excludes it too, but only because SetEventValue
-    // records the bot in m_pendingAddGuids and GetFreeBots merges that in: the INSERT it
-    // issues is asynchronous, so the database this rebuild queries would still be showing
-    // the bot as free.
+    // twice in one pass. A rebuild below excludes it too, because GetFreeBots reads the
+    // event store, which has the 'add' the moment SetEventValue runs.
     for (vector<uint32>::iterator i = bots.begin(); i != bots.end(); ++i)
     {
         if (*i == bot)
@@ -1564,44 +1573,20 @@ list<uint32> RandomPlayerbotMgr::GetBots()
 {
     list<uint32> bots;
 
-    // Query the database to get the list of random bots
-    QueryResult* results = CharacterDatabase.Query(
-            "SELECT `bot` FROM `ai_playerbot_random_bots` WHERE `owner` = 0 AND `event` = 'add'");
-
-    if (results)
+    // From the event store rather than the table. The store is written the moment an
+    // 'add' is banked, so a bot EnsureGroupedBotsOnline queued a moment ago is already
+    // on the roster, which the table would not show until the next flush landed.
+    if (!m_eventValuesLoaded)
     {
-        do
-        {
-            Field* fields = results->Fetch();
-            uint32 bot = fields[0].GetUInt32();
-            bots.push_back(bot);
-        } while (results->NextRow());
-        delete results;
+        LoadEventValues();
     }
 
-    // A bot banked earlier -- EnsureGroupedBotsOnline runs before the roster is listed --
-    // may still have its INSERT queued on the delay thread, so the query above cannot see
-    // it. Left out, a grouped bot is not logged in until the next interval, which is the
-    // one thing EnsureGroupedBotsOnline exists to prevent. This query is also the place
-    // that learns a write has landed, so it retires the entries it can see.
+    std::lock_guard<std::mutex> guard(m_cacheMutex);
+    for (std::map<EventValueKey, EventValueEntry>::const_iterator i = m_eventValueCache.begin(); i != m_eventValueCache.end(); ++i)
     {
-        std::lock_guard<std::mutex> guard(m_cacheMutex);
-        const uint32 now = getMSTime();
-        for (std::map<uint32, uint32>::iterator i = m_pendingAddGuids.begin(); i != m_pendingAddGuids.end(); )
+        if (i->second.value && i->first.second == "add")
         {
-            if (find(bots.begin(), bots.end(), i->first) != bots.end())
-            {
-                m_pendingAddGuids.erase(i++);
-            }
-            else if (getMSTimeDiff(i->second, now) > PendingAddMaxMs)
-            {
-                m_pendingAddGuids.erase(i++);
-            }
-            else
-            {
-                bots.push_back(i->first);
-                ++i;
-            }
+            bots.push_back(i->first.first);
         }
     }
 
@@ -1635,46 +1620,15 @@ vector<uint32> RandomPlayerbotMgr::GetFreeBots(bool alliance)
         accountList << *i;
     }
 
+    // Same source as GetBots, for the same reason: a bot already banked is not free,
+    // whether or not its row has been flushed yet. Otherwise a grouped bot queued by
+    // EnsureGroupedBotsOnline is drawn as a free bot and handed a spurious randomize, and a
+    // pass that exhausts a faction's cached list and rebuilds it here counts every bot it
+    // has just admitted twice against the roster target.
     set<uint32> bots;
-    QueryResult* results = CharacterDatabase.PQuery(
-            "SELECT `bot` FROM `ai_playerbot_random_bots` WHERE `event` = 'add'"
-        );
-
-    if (results)
-    {
-        do
-        {
-            Field* fields = results->Fetch();
-            bots.insert(fields[0].GetUInt32());
-        } while (results->NextRow());
-        delete results;
-    }
-
-    // Same reason as the merge in GetBots, in the opposite direction: a bot already banked
-    // is not free, however the database still reads. Two ways in. A grouped bot queued by
-    // EnsureGroupedBotsOnline would otherwise be drawn as a free bot and handed a spurious
-    // randomize; and when a pass exhausts a faction's cached list and rebuilds it here,
-    // every bot the pass has just admitted would come straight back and be counted twice
-    // against the roster target. Retires observed entries, as GetBots does.
     {
-        std::lock_guard<std::mutex> guard(m_cacheMutex);
-        const uint32 now = getMSTime();
-        for (std::map<uint32, uint32>::iterator i = m_pendingAddGuids.begin(); i != m_pendingAddGuids.end(); )
-        {
-            if (bots.find(i->first) != bots.end())
-            {
-                m_pendingAddGuids.erase(i++);
-            }
-            else if (getMSTimeDiff(i->second, now) > PendingAddMaxMs)
-            {
-                m_pendingAddGuids.erase(i++);
-            }
-            else
-            {
-                bots.insert(i->first);
-                ++i;
-            }
-        }
+        std::list<uint32> roster = GetBots();
+        bots.insert(roster.begin(), roster.end());
     }
 
     vector<uint32> guids;
@@ -1927,7 +1881,7 @@ void RandomPlayerbotMgr::EnsureGroupedBotsOnline()
 uint32 RandomPlayerbotMgr::GetEventValue(uint32 bot, string event, bool cacheMisses)
 {
     uint32 value = 0;
-    auto key = std::make_pair(bot, event);
+    EventValueKey key = std::make_pair(bot, event);
     {
         std::lock_guard<std::mutex> guard(m_cacheMutex);
         auto it = m_eventValueCache.find(key);
@@ -1938,9 +1892,18 @@ uint32 RandomPlayerbotMgr::GetEventValue(uint32 bot, string event, bool cacheMis
                 return it->second.value;
             }
         }
+
+        // The store is the whole table once loaded, so a missing or lapsed row is a zero
+        // and there is nothing for a query to add. This is also what keeps map workers,
+        // which reach here through IsRandomBot, off the database entirely.
+        if (m_eventValuesLoaded)
+        {
+            return 0;
+        }
     }
 
-    // Query the database to get the event value for the specified bot
+    // Only reached before the bulk load, by the few callers that run ahead of the first
+    // pass. Query the database to get the event value for the specified bot
     bool const performanceMetricsEnabled = sPlayerbotAIConfig.performanceMetricsInterval != 0;
     std::uint64_t const queryStartedAtMicros = performanceMetricsEnabled ? ai::PlayerbotPerformanceNowMicros() : 0;
     QueryResult* results = CharacterDatabase.PQuery(
@@ -1971,13 +1934,9 @@ uint32 RandomPlayerbotMgr::GetEventValue(uint32 bot, string event, bool cacheMis
 
     if (!value && cacheMisses)
     {
-        // Record the miss. A row that does not exist never reached the line above at
-        // all, and one that has already expired can never satisfy the freshness test
-        // again because its stored timestamp does not move -- so either way every
-        // later call fell through to a fresh synchronous SELECT. Most events are
-        // absent for a healthy bot, and ProcessBot asks after several of them per bot
-        // per pass, so that was the bulk of what the update budget was buying. Any
-        // SetEventValue overwrites this entry, so a real value is never masked.
+        // Record the miss, so a healthy bot's absent events cost one SELECT each rather
+        // than one per call. Any SetEventValue overwrites this entry, so a real value is
+        // never masked, and the bulk load replaces it outright.
         std::lock_guard<std::mutex> guard(m_cacheMutex);
         m_eventValueCache[key] = {0, (uint32)time(0), sPlayerbotAIConfig.randomBotUpdateInterval};
     }
@@ -1987,42 +1946,183 @@ uint32 RandomPlayerbotMgr::GetEventValue(uint32 bot, string event, bool cacheMis
 
 uint32 RandomPlayerbotMgr::SetEventValue(uint32 bot, string event, uint32 value, uint32 validIn)
 {
-    // Delete the existing event value for the specified bot
-    CharacterDatabase.PExecute("DELETE FROM `ai_playerbot_random_bots` WHERE `owner` = 0 and `bot` = '%u' and `event` = '%s'",
-        bot, event.c_str());
-    if (value)
+    EventValueKey key = std::make_pair(bot, event);
+    EventValueEntry entry = {value, (uint32)time(0), validIn};
+
+    std::lock_guard<std::mutex> guard(m_cacheMutex);
+
+    if (event == "add")
     {
-        // Insert the new event value for the specified bot
-        CharacterDatabase.PExecute(
-                "INSERT INTO `ai_playerbot_random_bots` (`owner`, `bot`, `time`, `validIn`, `event`, `value`) VALUES ('%u', '%u', '%u', '%u', '%s', '%u')",
-            0, bot, (uint32)time(0), validIn, event.c_str(), value);
+        m_randomBotCache[bot] = (value != 0);
     }
 
+    // A zero is a deleted row. Before the load the entry stays as a cached miss, as it
+    // always has; after it, absence already reads as zero.
+    if (value || !m_eventValuesLoaded)
     {
-        std::lock_guard<std::mutex> guard(m_cacheMutex);
+        m_eventValueCache[key] = entry;
+    }
+    else
+    {
+        m_eventValueCache.erase(key);
+    }
 
-        if (event == "add")
-        {
-            m_randomBotCache[bot] = (value != 0);
+    // The database catches up at the next FlushEventValues. Coalesced by key, so a bot
+    // whose 'logout' is rescheduled three times in a pass writes one row, not three.
+    m_dirtyEventValues[key] = entry;
 
-            // The statements above are asynchronous, and GetBots and GetFreeBots both read
-            // 'add' rows back from the database inside the same pass. Record what was
-            // banked, and when, so those two can see it before the delay thread drains and
-            // can retire the entry once they observe the write for themselves.
-            if (value)
+    return value;
+}
+
+void RandomPlayerbotMgr::RescheduleEvent(uint32 bot, string event, uint32 validIn)
+{
+    if (!m_eventValuesLoaded)
+    {
+        LoadEventValues();
+    }
+
+    EventValueKey key = std::make_pair(bot, event);
+
+    std::lock_guard<std::mutex> guard(m_cacheMutex);
+    std::map<EventValueKey, EventValueEntry>::iterator it = m_eventValueCache.find(key);
+    if (it == m_eventValueCache.end() || !it->second.value)
+    {
+        return;
+    }
+
+    it->second.lastChangeTime = (uint32)time(0);
+    it->second.validIn = validIn;
+    m_dirtyEventValues[key] = it->second;
+}
+
+void RandomPlayerbotMgr::LoadEventValues()
+{
+    std::map<EventValueKey, EventValueEntry> loaded;
+
+    uint32 startTime = getMSTime();
+    QueryResult* results = CharacterDatabase.Query(
+            "SELECT `bot`, `event`, `value`, `time`, `validIn` FROM `ai_playerbot_random_bots` WHERE `owner` = 0");
+    if (results)
+    {
+        do
+        {
+            Field* fields = results->Fetch();
+            uint32 value = fields[2].GetUInt32();
+            if (!value)
             {
-                m_pendingAddGuids[bot] = getMSTime();
+                continue;
             }
-            else
+
+            EventValueEntry entry = {value, fields[3].GetUInt32(), fields[4].GetUInt32()};
+            loaded[std::make_pair(fields[0].GetUInt32(), fields[1].GetCppString())] = entry;
+        } while (results->NextRow());
+        delete results;
+    }
+
+    std::lock_guard<std::mutex> guard(m_cacheMutex);
+
+    // Anything written before the load is newer than the table, whose copy of it may
+    // still be queued behind the flush.
+    for (std::map<EventValueKey, EventValueEntry>::const_iterator i = m_dirtyEventValues.begin(); i != m_dirtyEventValues.end(); ++i)
+    {
+        if (i->second.value)
+        {
+            loaded[i->first] = i->second;
+        }
+        else
+        {
+            loaded.erase(i->first);
+        }
+    }
+
+    m_eventValueCache.swap(loaded);
+    m_eventValuesLoaded = true;
+
+    sLog.outString(">> [Playerbots] Loaded %u random bot event values in %u ms",
+        (uint32)m_eventValueCache.size(), getMSTimeDiff(startTime, getMSTime()));
+}
+
+void RandomPlayerbotMgr::FlushEventValues()
+{
+    std::map<EventValueKey, EventValueEntry> pending;
+    {
+        std::lock_guard<std::mutex> guard(m_cacheMutex);
+        pending.swap(m_dirtyEventValues);
+    }
+
+    if (pending.empty())
+    {
+        return;
+    }
+
+    // Every dirty key loses its old row and every non-zero one gets a new row, which is
+    // the same delete-then-insert SetEventValue used to issue per call -- just grouped by
+    // event, so the delete can name its bots in one IN list, and chunked. It goes out as
+    // a single transaction: the delay thread runs its queue in order, so this batch lands
+    // after every statement queued before it and before any queued after, and a reader
+    // never sees a key between its delete and its insert.
+    std::map<std::string, std::vector<uint32> > deletes;
+    std::vector<std::pair<const EventValueKey*, const EventValueEntry*> > inserts;
+    for (std::map<EventValueKey, EventValueEntry>::const_iterator i = pending.begin(); i != pending.end(); ++i)
+    {
+        deletes[i->first.second].push_back(i->first.first);
+        if (i->second.value)
+        {
+            inserts.push_back(std::make_pair(&i->first, &i->second));
+        }
+    }
+
+    CharacterDatabase.BeginTransaction();
+
+    for (std::map<std::string, std::vector<uint32> >::const_iterator i = deletes.begin(); i != deletes.end(); ++i)
+    {
+        const std::vector<uint32>& bots = i->second;
+        for (size_t first = 0; first < bots.size(); first += EventValueFlushChunk)
+        {
+            size_t last = std::min(bots.size(), first + EventValueFlushChunk);
+            ostringstream sql;
+            sql << "DELETE FROM `ai_playerbot_random_bots` WHERE `owner` = 0 AND `event` = '" << i->first << "' AND `bot` IN (";
+            for (size_t j = first; j < last; ++j)
             {
-                m_pendingAddGuids.erase(bot);
+                sql << (j == first ? "" : ",") << bots[j];
             }
+            sql << ")";
+            CharacterDatabase.Execute(sql.str().c_str());
         }
+    }
 
-        m_eventValueCache[std::make_pair(bot, event)] = {value, (uint32)time(0), validIn};
+    for (size_t first = 0; first < inserts.size(); first += EventValueFlushChunk)
+    {
+        size_t last = std::min(inserts.size(), first + EventValueFlushChunk);
+        ostringstream sql;
+        sql << "INSERT INTO `ai_playerbot_random_bots` (`owner`, `bot`, `time`, `validIn`, `event`, `value`) VALUES ";
+        for (size_t j = first; j < last; ++j)
+        {
+            const EventValueKey& key = *inserts[j].first;
+            const EventValueEntry& entry = *inserts[j].second;
+            sql << (j == first ? "" : ",") << "(0," << key.first << "," << entry.lastChangeTime << ","
+                << entry.validIn << ",'" << key.second << "'," << entry.value << ")";
+        }
+        CharacterDatabase.Execute(sql.str().c_str());
     }
 
-    return value;
+    CharacterDatabase.CommitTransaction();
+
+    sLog.outDetail("Flushed %u random bot event values (%u rows written)",
+        (uint32)pending.size(), (uint32)inserts.size());
+}
+
+void RandomPlayerbotMgr::ResetEventValues()
+{
+    {
+        std::lock_guard<std::mutex> guard(m_cacheMutex);
+        m_dirtyEventValues.clear();
+        m_eventValueCache.clear();
+        m_eventValuesLoaded = true;
+    }
+
+    // Queued, so it still lands after any flush already on its way.
+    CharacterDatabase.Execute("DELETE FROM `ai_playerbot_random_bots`");
 }
 
 void RandomPlayerbotMgr::CalculateAreaCreatureStats()
@@ -2248,7 +2348,7 @@ bool ChatHandler::HandlePlayerbotConsoleCommand(char* args)
     if (cmd == "reset")
     {
         // Reset all random bots
-        CharacterDatabase.PExecute("DELETE FROM `ai_playerbot_random_bots`");
+        sRandomPlayerbotMgr.ResetEventValues();
         sLog.outBasic("Random bots were reset for all players");
         return true;
     }
@@ -2296,10 +2396,8 @@ bool ChatHandler::HandlePlayerbotConsoleCommand(char* args)
                         sRandomPlayerbotMgr.IncreaseLevel(bot);
                     }
                     uint32 randomTime = urand(sPlayerbotAIConfig.minRandomBotRandomizeTime, sPlayerbotAIConfig.maxRandomBotRandomizeTime);
-                    CharacterDatabase.PExecute("UPDATE `ai_playerbot_random_bots` SET `validIn` = '%u' WHERE `event` = 'randomize' AND `bot` = '%u'",
-                        randomTime, bot->GetGUIDLow());
-                    CharacterDatabase.PExecute("UPDATE `ai_playerbot_random_bots` SET `validIn` = '%u' WHERE `event` = 'logout' AND `bot` = '%u'",
-                        sPlayerbotAIConfig.maxRandomBotInWorldTime, bot->GetGUIDLow());
+                    sRandomPlayerbotMgr.RescheduleEvent(bot->GetGUIDLow(), "randomize", randomTime);
+                    sRandomPlayerbotMgr.RescheduleEvent(bot->GetGUIDLow(), "logout", sPlayerbotAIConfig.maxRandomBotInWorldTime);
                 } while (results->NextRow());
 
                 delete results;
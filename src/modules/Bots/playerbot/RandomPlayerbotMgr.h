@@ -11,6 +11,7 @@
 #include <set>
 #include <unordered_map>
 #include <mutex>
+#include <atomic>
 
 class WorldPacket;
 class Player;
@@ -198,6 +199,28 @@ class RandomPlayerbotMgr : public PlayerbotHolder
          */
         virtual void UpdateAIInternal(uint32 elapsed);
 
+        /**
+         * @brief Writes every event value changed since the last flush to the database.
+         *
+         * One transaction on the asynchronous queue, so the batch lands whole and after
+         * anything this thread queued before it. Called at the end of each pass and at
+         * shutdown; harmless when nothing is pending.
+         */
+        void FlushEventValues();
+
+        /**
+         * @brief Drops every stored event value, in memory and in the database.
+         */
+        void ResetEventValues();
+
+        /**
+         * @brief Restarts the validity window of an existing event, keeping its value.
+         * @param bot The player ID.
+         * @param event The event name.
+         * @param validIn The new validity duration, counted from now.
+         */
+        void RescheduleEvent(uint32 bot, string event, uint32 validIn);
+
     protected:
         /**
          * @brief Internal handler for bot login.
@@ -224,6 +247,14 @@ class RandomPlayerbotMgr : public PlayerbotHolder
          */
         uint32 SetEventValue(uint32 bot, string event, uint32 value, uint32 validIn);
 
+        /**
+         * @brief Bulk-loads every owner 0 row of ai_playerbot_random_bots into the store.
+         *
+         * Writes made before the load are kept over what the database returns, since
+         * their flush may not have landed yet.
+         */
+        void LoadEventValues();
+
         /**
          * @brief Gets the list of random player bots.
          * @return The list of random player bots.
@@ -357,22 +388,6 @@ class RandomPlayerbotMgr : public PlayerbotHolder
         std::map<uint32, uint32> m_starterZoneCounts; ///< starting zone -> active residents, rebuilt once per pass
         int m_starterZoneCountsPass;                  ///< the pass m_starterZoneCounts was built for
         std::unordered_map<uint32, bool> m_randomBotCache;
-        // Guids whose "add" event has been written but whose asynchronous INSERT may not
-        // have reached the database yet, against the pass that wrote it. GetBots and
-        // GetFreeBots both read 'add' rows straight from the database, so without this a
-        // bot banked earlier is invisible to the roster and simultaneously visible in the
-        // free pool. An entry is dropped when one of those two queries returns the guid,
-        // which is the write proving it landed, and after PendingAddMaxMs regardless so that
-        // an INSERT which never lands cannot pin a guid indefinitely. Keyed by the time it
-        // was banked, not the pass, because passes are not a fixed length: a pass that runs
-        // over its budget reschedules at RandomBotCatchupInterval rather than
-        // RandomBotUpdateInterval, so counting passes gives the least headroom during the
-        // startup flood, which is when the delay thread's queue is deepest and the headroom
-        // is most needed.
-        std::map<uint32, uint32> m_pendingAddGuids;
-        // Generous, because the only cost of holding an entry too long is that a guid whose
-        // INSERT genuinely failed keeps its roster injection for a minute.
-        static const uint32 PendingAddMaxMs = 60000;
         // Both caches are read from map worker threads -- PlayerbotAI::UpdateAI, the trade
         // and grind values, AiFactory -- and written from the world thread. Concurrent
         // access to std::map/unordered_map is undefined behaviour rather than a stale
@@ -387,7 +402,19 @@ class RandomPlayerbotMgr : public PlayerbotHolder
             uint32 lastChangeTime;
             uint32 validIn;
         };
-        std::map<std::pair<uint32, std::string>, EventValueEntry> m_eventValueCache;
+        typedef std::pair<uint32, std::string> EventValueKey;
+        // Once m_eventValuesLoaded is set this is the whole of the owner 0 table, expired
+        // rows included, and an absent key simply means no row: reads never go to the
+        // database again. Before the load it is a read-through cache as it always was.
+        std::map<EventValueKey, EventValueEntry> m_eventValueCache;
+        // Writes not yet flushed, last one wins. A zero value is a pending delete.
+        std::map<EventValueKey, EventValueEntry> m_dirtyEventValues;
+        // Set under m_cacheMutex with the store it describes, but atomic because the
+        // load-on-first-use checks read it before taking the lock.
+        std::atomic<bool> m_eventValuesLoaded;
+        // Rows per DELETE ... IN / multi-row INSERT in a flush, so a startup storm of
+        // several thousand writes does not turn into one statement the server refuses.
+        static const size_t EventValueFlushChunk = 500;
 };
 
 #define sRandomPlayerbotMgr MaNGOS::Singleton<RandomPlayerbotMgr>::Instance()
@@ -31,6 +31,7 @@
 
 #include "Auth/Sha1.h"
 #include "Opcodes.h"
+#include "SharedPacket.h"
 #include "Utilities/Util.h"
 
 #include <cstring>
@@ -150,17 +151,43 @@ void ClientConnection::SendPacket(WorldPacket const& packet)
     try
     {
         std::lock_guard<std::mutex> guard(m_sendOrderLock);
-        if (m_closed.load() || !m_sender)
+        if (m_closed.load() || (!m_sender && !m_gatherSender))
         {
             return;
         }
 
         m_gateway.TracePacket(m_traceSession.load(std::memory_order_relaxed), packet, false);
-        std::vector<uint8> const frame = PacketCodec::Encode(packet,
-            [this](uint8* header, std::size_t len)
+        PacketCodec::HeaderEncryptor const encryptor = [this](uint8* header, std::size_t len)
+        {
+            m_crypt.EncryptSend(header, len);
+        };
+
+        if (m_sharedSender)
+        {
+            // A broadcast: the payload was snapshotted once for every recipient, so
+            // only the header is built here and the queue holds a reference.
+            net::SharedPayload payload = SharedPacketScope::Find(packet);
+            if (payload)
             {
-                m_crypt.EncryptSend(header, len);
-            });
+                uint8 header[MAX_SERVER_HEADER_SIZE];
+                std::size_t const headerLen = PacketCodec::EncodeHeader(packet, encryptor, header);
+                m_sharedSender(header, headerLen, std::move(payload));
+                return;
+            }
+        }
+
+        if (m_gatherSender)
+        {
+            // Only the header is per connection. The payload goes straight from the
+            // packet into the send queue -- one copy, no intermediate frame.
+            uint8 header[MAX_SERVER_HEADER_SIZE];
+            std::size_t const headerLen = PacketCodec::EncodeHeader(packet, encryptor, header);
+            m_gatherSender(header, headerLen,
+                           packet.empty() ? NULL : packet.contents(), packet.size());
+            return;
+        }
+
+        std::vector<uint8> const frame = PacketCodec::Encode(packet, encryptor);
         m_sender(frame.data(), frame.size());
     }
     catch (...)
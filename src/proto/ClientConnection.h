@@ -48,6 +48,8 @@ public:
 
     void setPeerAddress(std::string const& address) override { m_address = address; }
     void setSender(net::Sender sender) override { m_sender = std::move(sender); }
+    void setGatherSender(net::GatherSender sender) override { m_gatherSender = std::move(sender); }
+    void setSharedSender(net::SharedSender sender) override { m_sharedSender = std::move(sender); }
     void setCloser(net::Closer closer) override { m_closer = std::move(closer); }
     std::vector<uint8_t> onConnect() override;
     std::vector<uint8_t> onData(uint8_t const* data, std::size_t len) override;
@@ -87,6 +89,16 @@ private:
     bool m_authStarted = false;
     std::atomic<bool> m_closed{false};
     net::Sender m_sender;
+
+    /// Preferred by SendPacket when the transport offers it: the encrypted header
+    /// and the packet's own buffer go to the socket queue as two spans, so the
+    /// payload -- shared by every recipient of a broadcast -- is never copied into
+    /// a per-connection frame first.
+    net::GatherSender m_gatherSender;
+
+    /// Preferred over both when a SharedPacketScope holds the packet's payload:
+    /// the queue keeps a reference to that one buffer instead of a copy.
+    net::SharedSender m_sharedSender;
     net::Closer m_closer;
 
     static std::atomic<uint32> s_openConnections;
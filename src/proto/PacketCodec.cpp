@@ -32,8 +32,9 @@
 
 namespace proto
 {
-    PacketCodec::PacketCodec(HeaderDecryptor decryptor)
+    PacketCodec::PacketCodec(HeaderDecryptor decryptor, Peer from)
         : m_decryptor(std::move(decryptor)),
+          m_from(from),
           m_headerFill(0),
           m_haveHeader(false),
           m_opcode(0),
@@ -50,6 +51,9 @@ namespace proto
             return DecodeStatus::Ok;
         }
 
+        const size_t headerSize = m_from == Peer::Client ? CLIENT_HEADER_SIZE
+                                                         : SERVER_HEADER_SIZE;
+
         size_t offset = 0;
 
         while (offset < len)
@@ -57,23 +61,23 @@ namespace proto
             // ---- Phase 1: collect and decode the fixed-size header -------------
             if (!m_haveHeader)
             {
-                const size_t want = CLIENT_HEADER_SIZE - m_headerFill;
+                const size_t want = headerSize - m_headerFill;
                 const size_t take = std::min(want, len - offset);
 
                 std::memcpy(m_header + m_headerFill, data + offset, take);
                 m_headerFill += take;
                 offset       += take;
 
-                if (m_headerFill < CLIENT_HEADER_SIZE)
+                if (m_headerFill < headerSize)
                 {
                     return DecodeStatus::Ok; // header still incomplete
                 }
 
-                // Decrypt exactly once, now that all six bytes are in hand. Doing
+                // Decrypt exactly once, now that the whole header is in hand. Doing
                 // it per-fragment would corrupt the stream cipher's keystream.
                 if (m_decryptor)
                 {
-                    m_decryptor(m_header, CLIENT_HEADER_SIZE);
+                    m_decryptor(m_header, headerSize);
                 }
 
                 // Read the fields out byte by byte rather than casting the buffer
@@ -81,21 +85,37 @@ namespace proto
                 // endian, so a struct needs a byte-swap dance anyway, and the cast
                 // itself is an aliasing violation on a char buffer.
                 const uint32 size = (uint32(m_header[0]) << 8) | uint32(m_header[1]);
-                const uint32 cmd  =  uint32(m_header[2])
-                                  | (uint32(m_header[3]) << 8)
-                                  | (uint32(m_header[4]) << 16)
-                                  | (uint32(m_header[5]) << 24);
-
-                // `size` counts the four opcode bytes, so anything below that is
-                // impossible and would underflow the payload length below.
-                if (size < 4 || size > MAX_CLIENT_PACKET_SIZE
-                    || cmd > MAX_CLIENT_PACKET_SIZE)
+
+                if (m_from == Peer::Server)
                 {
-                    return DecodeStatus::Malformed;
+                    // `size` counts the two opcode bytes. A server may send up to
+                    // what the field holds; the client-side ceiling is ours alone.
+                    if (size < 2)
+                    {
+                        return DecodeStatus::Malformed;
+                    }
+
+                    m_opcode        = uint16(uint32(m_header[2]) | (uint32(m_header[3]) << 8));
+                    m_payloadNeeded = size - 2;
+                }
+                else
+                {
+                    const uint32 cmd =  uint32(m_header[2])
+                                     | (uint32(m_header[3]) << 8)
+                                     | (uint32(m_header[4]) << 16)
+                                     | (uint32(m_header[5]) << 24);
+
+                    // `size` counts the four opcode bytes, so anything below that is
+                    // impossible and would underflow the payload length below.
+                    if (size < 4 || size > MAX_CLIENT_PACKET_SIZE
+                        || cmd > MAX_CLIENT_PACKET_SIZE)
+                    {
+                        return DecodeStatus::Malformed;
+                    }
+
+                    m_opcode        = uint16(cmd);
+                    m_payloadNeeded = size - 4;
                 }
-
-                m_opcode        = uint16(cmd);
-                m_payloadNeeded = size - 4;
                 m_haveHeader    = true;
 
                 m_payload.clear();
@@ -137,8 +157,9 @@ namespace proto
         return DecodeStatus::Ok;
     }
 
-    std::vector<uint8> PacketCodec::Encode(const WorldPacket& packet,
-                                           const HeaderEncryptor& encryptor)
+    size_t PacketCodec::EncodeHeader(const WorldPacket& packet,
+                                     const HeaderEncryptor& encryptor,
+                                     uint8 (&header)[MAX_SERVER_HEADER_SIZE])
     {
         // The size field counts the two opcode bytes along with the payload.
         const uint32 size = uint32(packet.size()) + 2;
@@ -154,7 +175,6 @@ namespace proto
         const bool large = size > 0x7FFF;
 #endif
 
-        uint8  header[5];
         size_t headerLen = 0;
 
         if (large)
@@ -173,6 +193,15 @@ namespace proto
             encryptor(header, headerLen);
         }
 
+        return headerLen;
+    }
+
+    std::vector<uint8> PacketCodec::Encode(const WorldPacket& packet,
+                                           const HeaderEncryptor& encryptor)
+    {
+        uint8 header[MAX_SERVER_HEADER_SIZE];
+        const size_t headerLen = EncodeHeader(packet, encryptor, header);
+
         std::vector<uint8> wire;
         wire.reserve(headerLen + packet.size());
         wire.insert(wire.end(), header, header + headerLen);
@@ -187,4 +216,37 @@ namespace proto
 
         return wire;
     }
+
+    std::vector<uint8> PacketCodec::EncodeClient(const WorldPacket& packet,
+                                                 const HeaderEncryptor& encryptor)
+    {
+        // The size field counts the four opcode bytes along with the payload.
+        const uint32 size   = uint32(packet.size()) + 4;
+        const uint32 opcode = uint32(packet.GetOpcode());
+
+        uint8 header[CLIENT_HEADER_SIZE];
+        header[0] = uint8((size >> 8) & 0xFF);
+        header[1] = uint8(size & 0xFF);
+        header[2] = uint8(opcode & 0xFF);
+        header[3] = uint8((opcode >> 8) & 0xFF);
+        header[4] = uint8((opcode >> 16) & 0xFF);
+        header[5] = uint8((opcode >> 24) & 0xFF);
+
+        if (encryptor)
+        {
+            encryptor(header, CLIENT_HEADER_SIZE);
+        }
+
+        std::vector<uint8> wire;
+        wire.reserve(CLIENT_HEADER_SIZE + packet.size());
+        wire.insert(wire.end(), header, header + CLIENT_HEADER_SIZE);
+
+        if (!packet.empty())
+        {
+            wire.insert(wire.end(), packet.contents(),
+                        packet.contents() + packet.size());
+        }
+
+        return wire;
+    }
 }
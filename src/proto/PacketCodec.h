@@ -44,6 +44,14 @@ namespace proto
     /// included. Source: WorldSocket.cpp:654 (`header.size > 10240`).
     static const uint32 MAX_CLIENT_PACKET_SIZE = 10240;
 
+    /// Largest server -> client header: a three-byte size + uint16 opcode. Only
+    /// expansions past TBC ever emit it; 1.12.x and 2.4.3 headers are four bytes.
+    static const size_t MAX_SERVER_HEADER_SIZE = 5;
+
+    /// Fixed size of the 1.12.x server -> client header: uint16 size + uint16
+    /// opcode. What a synthetic client reads; see PacketCodec::Peer::Server.
+    static const size_t SERVER_HEADER_SIZE = 4;
+
     /**
      * @brief Result of handing a run of received bytes to the codec.
      */
@@ -77,12 +85,27 @@ namespace proto
             /// Encrypts an outgoing header in place, whose length varies (4 or 5).
             typedef std::function<void(uint8* header, size_t len)> HeaderEncryptor;
 
+            /**
+             * @brief The end of the connection whose bytes Feed() is reading.
+             *
+             * The server decodes what a client sent, which is the default. A
+             * synthetic client (the load generator) decodes what a server sent:
+             * the four-byte 1.12.x header, whose opcode is only two bytes wide.
+             */
+            enum class Peer
+            {
+                Client, ///< Six-byte headers, at most MAX_CLIENT_PACKET_SIZE.
+                Server  ///< Four-byte headers, any size the field can carry.
+            };
+
             /**
              * @param decryptor Header decryption hook. May be empty, in which case
              *                  headers are read as plain text -- which is the state
              *                  of the connection until the session key is known.
+             * @param from      The peer whose stream Feed() will be given.
              */
-            explicit PacketCodec(HeaderDecryptor decryptor = HeaderDecryptor());
+            explicit PacketCodec(HeaderDecryptor decryptor = HeaderDecryptor(),
+                                 Peer from = Peer::Client);
 
             /**
              * @brief Feed received bytes; append every packet completed by them.
@@ -113,6 +136,41 @@ namespace proto
             static std::vector<uint8> Encode(const WorldPacket& packet,
                                              const HeaderEncryptor& encryptor);
 
+            /**
+             * @brief Serialise only the header of a packet, leaving the payload
+             *        where it is.
+             *
+             * The header is the only per-connection part of a frame -- it is what
+             * the session cipher runs over -- so a caller that can hand the socket
+             * a header and a payload separately never has to copy the payload into
+             * a frame of its own. Encode() is exactly this followed by the payload.
+             *
+             * @param packet    Packet whose header to build.
+             * @param encryptor Header encryption hook; may be empty before the
+             *                  session key is known.
+             * @param header    Receives the header; MAX_SERVER_HEADER_SIZE bytes.
+             * @return Number of bytes written to @p header (4 or 5).
+             */
+            static size_t EncodeHeader(const WorldPacket& packet,
+                                       const HeaderEncryptor& encryptor,
+                                       uint8 (&header)[MAX_SERVER_HEADER_SIZE]);
+
+            /**
+             * @brief Serialise a packet the way a client sends it: the six-byte
+             *        header followed by payload.
+             *
+             * The reverse of what Feed() accepts from Peer::Client, for tools and
+             * tests that stand in for a client. The size field counts the four
+             * opcode bytes.
+             *
+             * @param packet    Packet to serialise.
+             * @param encryptor Header encryption hook, handed all six bytes; may be
+             *                  empty before the session key is known.
+             * @return The complete wire representation.
+             */
+            static std::vector<uint8> EncodeClient(const WorldPacket& packet,
+                                                   const HeaderEncryptor& encryptor);
+
             /// Install the header decryptor, once the session key has been agreed.
             void SetHeaderDecryptor(HeaderDecryptor decryptor)
             {
@@ -122,6 +180,7 @@ namespace proto
         private:
 
             HeaderDecryptor m_decryptor;
+            Peer            m_from;          ///< whose header layout Feed() reads
 
             uint8  m_header[CLIENT_HEADER_SIZE]; ///< partially received header
             size_t m_headerFill;                 ///< bytes of m_header filled so far
@@ -0,0 +1,73 @@
+/**
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2026 MaNGOS <https://www.getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+#ifndef MANGOS_PROTO_SHAREDPACKET_H
+#define MANGOS_PROTO_SHAREDPACKET_H
+
+#include "WorldPacket.h"
+#include "net/ISession.hpp"
+
+namespace proto
+{
+    /**
+     * @brief Serialises a broadcast's payload once for every connection it reaches.
+     *
+     * Open one on the stack around a loop that hands the same packet to many
+     * sessions. While it lives, ClientConnection::SendPacket finds the packet's
+     * bytes already snapshotted into an immutable, reference-counted buffer and
+     * queues a reference to it behind each connection's own encrypted header,
+     * instead of copying the payload into every socket's send queue.
+     *
+     * Scopes nest per thread and are looked up by packet address, so a send of any
+     * other packet from inside the loop is unaffected. The packet must not change
+     * while its scope is open. Payloads under MinSharedPayload bytes are not
+     * snapshotted at all: copying them is cheaper than another scatter entry.
+     */
+    class SharedPacketScope
+    {
+        public:
+
+            static const size_t MinSharedPayload = 128;
+
+            explicit SharedPacketScope(WorldPacket const& packet);
+            ~SharedPacketScope();
+
+            /// The shared payload of an open scope for this packet, or empty.
+            static net::SharedPayload Find(WorldPacket const& packet);
+
+        private:
+
+            SharedPacketScope(SharedPacketScope const&);
+            SharedPacketScope& operator=(SharedPacketScope const&);
+
+            WorldPacket const* m_packet;
+            net::SharedPayload m_payload;
+            SharedPacketScope* m_outer;
+
+            static thread_local SharedPacketScope* s_innermost;
+    };
+}
+
+#endif
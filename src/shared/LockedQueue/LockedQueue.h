@@ -99,14 +99,14 @@ namespace MaNGOS
             }
 
             /// True when the queue holds no elements (lock held).
-            bool empty()
+            bool empty() const
             {
                 std::lock_guard<std::mutex> guard(_lock);
                 return _queue.empty();
             }
 
             /// Number of elements currently queued (lock held).
-            size_t size()
+            size_t size() const
             {
                 std::lock_guard<std::mutex> guard(_lock);
                 return _queue.size();
@@ -114,7 +114,7 @@ namespace MaNGOS
 
         private:
 
-            std::mutex  _lock;   ///< Serialises access to the queue
+            mutable std::mutex _lock;   ///< Serialises access to the queue
             StorageType _queue;  ///< Storage backing the queue
     };
 }
@@ -118,7 +118,7 @@ Log::Log() :
     elunaErrLogfile(NULL),
 #endif /* ENABLE_ELUNA */
 
-    eventAiErLogfile(NULL), scriptErrLogFile(NULL), worldLogfile(NULL),
+    eventAiErLogfile(NULL), scriptErrLogFile(NULL), worldLogfile(NULL), mapTickLogfile(NULL),
     m_consoleBody(NULL), m_consoleThread(NULL), m_consoleAsync(false), m_colored(false),
     m_includeTime(false), m_gmlog_per_account(false), m_scriptLibName(NULL)
 {
@@ -337,6 +337,11 @@ void Log::CloseLogFiles()
         fclose(worldLogfile);
         worldLogfile = NULL;
     }
+    if (mapTickLogfile != NULL)
+    {
+        fclose(mapTickLogfile);
+        mapTickLogfile = NULL;
+    }
 }
 
 void Log::Flush()
@@ -575,6 +580,7 @@ void Log::Initialize()
 
     eventAiErLogfile = openLogFile("EventAIErrorLogFile", NULL, "a");
     raLogfile = openLogFile("RaLogFile", NULL, "a");
+    mapTickLogfile = openLogFile("MapTickLogFile", NULL, "a");
     // Packet logging is opt-in via PacketLoggingEnabled (default off): open the
     // packet log only when explicitly enabled, so it stays off even on legacy
     // configs that still set WorldLogFile with LogLevel=3 (and a disabled server
@@ -1249,6 +1255,25 @@ void Log::outRALog(const char* str, ...)
     fflush(stdout);
 }
 
+void Log::outMapTick(const char* str, ...)
+{
+    if (!str || !mapTickLogfile)
+    {
+        return;
+    }
+
+    // several map threads report at once, keep their lines whole
+    std::lock_guard<std::mutex> guard(m_mapTickLogMtx);
+
+    va_list ap;
+    outTimestamp(mapTickLogfile);
+    va_start(ap, str);
+    vfprintf(mapTickLogfile, str, ap);
+    fprintf(mapTickLogfile, "\n");
+    va_end(ap);
+    fflush(mapTickLogfile);
+}
+
 void Log::WaitBeforeContinueIfNeed()
 {
     int mode = sConfig.GetIntDefault("WaitAtStartupError", 0);
@@ -336,6 +336,12 @@ class Log : public MaNGOS::Singleton<Log>
          * @param str...
          */
         void outRALog(const char* str, ...)       ATTR_PRINTF(2, 3);
+        /**
+         * @brief Writes a line to MapTickLogFile, from any map update thread.
+         *
+         * @param str...
+         */
+        void outMapTick(const char* str, ...)     ATTR_PRINTF(2, 3);
         /**
          * @brief
          *
@@ -557,6 +563,8 @@ class Log : public MaNGOS::Singleton<Log>
         FILE* scriptErrLogFile; /**< TODO */
         FILE* worldLogfile; /**< TODO */
         std::mutex m_worldLogMtx; /**< Serializes packet-dump writes to worldLogfile */
+        FILE* mapTickLogfile; /**< Slow map ticks and map tick reports */
+        std::mutex m_mapTickLogMtx; /**< Serializes writes to mapTickLogfile */
         std::mutex m_fileMtx; /**< Serializes writes to the main logfile so concurrent map-update worker threads cannot tear lines */
 
         ConsoleLogWriter* m_consoleBody; /**< Off-thread console writer Runnable (owned via thread refcount) */
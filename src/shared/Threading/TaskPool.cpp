@@ -0,0 +1,135 @@
+/**
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2026 MaNGOS <https://www.getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+#include "TaskPool.h"
+
+namespace MaNGOS
+{
+    TaskPool::TaskPool() : m_pending(0), m_stop(false)
+    {
+    }
+
+    TaskPool::~TaskPool()
+    {
+        Deactivate();
+    }
+
+    bool TaskPool::Activate(size_t threads)
+    {
+        if (!threads || Activated())
+        {
+            return false;
+        }
+
+        {
+            std::lock_guard<std::mutex> guard(m_mutex);
+            m_stop = false;
+        }
+
+        m_workers.reserve(threads);
+        for (size_t i = 0; i < threads; ++i)
+        {
+            m_workers.emplace_back([this] { WorkerLoop(); });
+        }
+        return true;
+    }
+
+    void TaskPool::Deactivate()
+    {
+        if (!Activated())
+        {
+            return;
+        }
+
+        Wait();
+
+        {
+            std::lock_guard<std::mutex> guard(m_mutex);
+            m_stop = true;
+        }
+        m_taskAdded.notify_all();
+
+        for (std::thread& worker : m_workers)
+        {
+            if (worker.joinable())
+            {
+                worker.join();
+            }
+        }
+        m_workers.clear();
+    }
+
+    void TaskPool::Schedule(std::function<void()> task)
+    {
+        if (!Activated())
+        {
+            task();
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> guard(m_mutex);
+            m_tasks.push(std::move(task));
+            ++m_pending;
+        }
+        m_taskAdded.notify_one();
+    }
+
+    void TaskPool::Wait()
+    {
+        std::unique_lock<std::mutex> guard(m_mutex);
+        m_taskDone.wait(guard, [this] { return m_pending == 0; });
+    }
+
+    void TaskPool::WorkerLoop()
+    {
+        for (;;)
+        {
+            std::function<void()> task;
+
+            {
+                std::unique_lock<std::mutex> guard(m_mutex);
+                m_taskAdded.wait(guard, [this] { return m_stop || !m_tasks.empty(); });
+
+                // Retire only on an empty queue, so a stop racing a batch cannot drop it.
+                if (m_tasks.empty())
+                {
+                    return;
+                }
+
+                task = std::move(m_tasks.front());
+                m_tasks.pop();
+            }
+
+            task();
+
+            {
+                std::lock_guard<std::mutex> guard(m_mutex);
+                --m_pending;
+            }
+            m_taskDone.notify_all();
+        }
+    }
+}
@@ -0,0 +1,97 @@
+/**
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2026 MaNGOS <https://www.getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+/**
+ * @file TaskPool.h
+ * @brief A fixed pool of worker threads for fork/join batches of independent tasks.
+ *
+ * MapUpdater's shape, for work that is not a map: the caller queues a batch with
+ * Schedule(), then blocks in Wait() until every task in it has run. Nothing is
+ * returned through the pool; a task writes its result wherever its closure points.
+ */
+
+#ifndef MANGOS_TASKPOOL_H
+#define MANGOS_TASKPOOL_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+namespace MaNGOS
+{
+    class TaskPool
+    {
+        public:
+            TaskPool();
+            ~TaskPool();
+
+            TaskPool(const TaskPool&) = delete;
+            TaskPool& operator=(const TaskPool&) = delete;
+
+            /**
+             * @brief Start @p threads workers.
+             * @return false if the pool is already running or @p threads is 0.
+             */
+            bool Activate(size_t threads);
+
+            /// Drain outstanding tasks, then stop and join the workers.
+            void Deactivate();
+
+            /// True while worker threads are running.
+            bool Activated() const { return !m_workers.empty(); }
+
+            size_t GetThreadCount() const { return m_workers.size(); }
+
+            /**
+             * @brief Queue @p task for a worker.
+             *
+             * On a pool that is not running the task runs here and now, so callers need
+             * no separate serial path for a thread count of zero.
+             */
+            void Schedule(std::function<void()> task);
+
+            /// Block until every task scheduled so far has finished.
+            void Wait();
+
+        private:
+            void WorkerLoop();
+
+            std::vector<std::thread>          m_workers;
+            std::queue<std::function<void()> > m_tasks;
+
+            std::mutex              m_mutex;      ///< Guards m_tasks, m_pending and m_stop
+            std::condition_variable m_taskAdded;  ///< Wakes a worker when work arrives
+            std::condition_variable m_taskDone;   ///< Wakes Wait() once m_pending hits zero
+
+            size_t m_pending; ///< Scheduled but not yet finished tasks
+            bool   m_stop;    ///< Set by Deactivate() to retire the workers
+    };
+}
+
+#endif
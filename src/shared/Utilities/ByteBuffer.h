@@ -34,6 +34,7 @@
 #include <list>
 #include "Utilities/ByteConverter.h"
 #include "Utilities/Errors.h"
+#include "Utilities/PacketBufferPool.h"
 
 /**
  * @brief Exception thrown when ByteBuffer operations exceed buffer bounds
@@ -891,7 +892,7 @@ class ByteBuffer
 
     protected:
         size_t _rpos, _wpos; /**< TODO */
-        std::vector<uint8> _storage; /**< TODO */
+        std::vector<uint8, MaNGOS::PacketBufferAllocator<uint8> > _storage; /**< Pooled, see PacketBufferPool.h */
 };
 
 template <typename T>
@@ -0,0 +1,152 @@
+/**
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2026 MaNGOS <https://www.getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+#include "PacketBufferPool.h"
+
+#include <atomic>
+
+namespace MaNGOS
+{
+    namespace
+    {
+        size_t const ClassCount = PacketBufferPoolStats::ClassCount;
+        size_t const ClassSizes[ClassCount] = { 256, 1024, 4096, 16384, 65536 };
+        /// Blocks of each class a thread keeps, about 1.3 MiB per thread at most.
+        size_t const ClassLimits[ClassCount] = { 128, 64, 64, 16, 8 };
+
+        std::atomic<size_t> s_allocations[ClassCount];
+        std::atomic<size_t> s_hits[ClassCount];
+        std::atomic<size_t> s_oversized(0);
+
+        /// Smallest class holding @p size bytes, ClassCount if none does.
+        size_t ClassOf(size_t size)
+        {
+            size_t index = 0;
+            while (index < ClassCount && ClassSizes[index] < size)
+            {
+                ++index;
+            }
+            return index;
+        }
+
+        struct FreeBlock
+        {
+            FreeBlock* Next;
+        };
+
+        /// Plain data, so that buffers freed by late thread_local or static destructors still find it.
+        struct ThreadFreeLists
+        {
+            FreeBlock* Head[ClassCount];
+            size_t Count[ClassCount];
+            bool Closed;                                    ///< The thread is exiting, free to the heap
+        };
+
+        thread_local ThreadFreeLists t_freeLists;
+
+        /// Empties the free lists of an exiting thread.
+        struct ThreadFreeListsReaper
+        {
+            bool Armed;
+
+            ThreadFreeListsReaper() : Armed(false) {}
+
+            ~ThreadFreeListsReaper()
+            {
+                ThreadFreeLists& lists = t_freeLists;
+                lists.Closed = true;
+                for (size_t i = 0; i < ClassCount; ++i)
+                {
+                    while (FreeBlock* block = lists.Head[i])
+                    {
+                        lists.Head[i] = block->Next;
+                        ::operator delete(block);
+                    }
+                    lists.Count[i] = 0;
+                }
+            }
+        };
+
+        thread_local ThreadFreeListsReaper t_reaper;
+    }
+
+    void* PacketBufferPool::Allocate(size_t size)
+    {
+        size_t index = ClassOf(size);
+        if (index == ClassCount)
+        {
+            s_oversized.fetch_add(1, std::memory_order_relaxed);
+            return ::operator new(size);
+        }
+
+        s_allocations[index].fetch_add(1, std::memory_order_relaxed);
+
+        ThreadFreeLists& lists = t_freeLists;
+        if (FreeBlock* block = lists.Head[index])
+        {
+            lists.Head[index] = block->Next;
+            --lists.Count[index];
+            s_hits[index].fetch_add(1, std::memory_order_relaxed);
+            return block;
+        }
+
+        return ::operator new(ClassSizes[index]);
+    }
+
+    void PacketBufferPool::Release(void* block, size_t size)
+    {
+        if (!block)
+        {
+            return;
+        }
+
+        size_t index = ClassOf(size);
+        ThreadFreeLists& lists = t_freeLists;
+        if (index == ClassCount || lists.Closed || lists.Count[index] >= ClassLimits[index])
+        {
+            ::operator delete(block);
+            return;
+        }
+
+        t_reaper.Armed = true;
+        FreeBlock* freed = static_cast<FreeBlock*>(block);
+        freed->Next = lists.Head[index];
+        lists.Head[index] = freed;
+        ++lists.Count[index];
+    }
+
+    PacketBufferPoolStats PacketBufferPool::GetStats()
+    {
+        PacketBufferPoolStats stats;
+        for (size_t i = 0; i < ClassCount; ++i)
+        {
+            stats.ClassSize[i] = ClassSizes[i];
+            stats.Allocations[i] = s_allocations[i].load(std::memory_order_relaxed);
+            stats.Hits[i] = s_hits[i].load(std::memory_order_relaxed);
+        }
+        stats.Oversized = s_oversized.load(std::memory_order_relaxed);
+        return stats;
+    }
+}
@@ -0,0 +1,103 @@
+/**
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2026 MaNGOS <https://www.getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+/**
+ * @file PacketBufferPool.h
+ * @brief Thread-local, size-classed storage for ByteBuffer and WorldPacket.
+ *
+ * Nearly every outbound packet is built into a fresh buffer and freed once it
+ * has been encoded, which made packet storage one of the busiest users of the
+ * heap on the map threads. ByteBuffer now allocates through
+ * PacketBufferAllocator, which rounds a request up to one of a few size classes
+ * and serves it from a free list of the calling thread:
+ *
+ * | Class | Typical contents                         |
+ * |-------|------------------------------------------|
+ * | 256   | opcode replies, chat, queries            |
+ * | 1 KiB | movement, auras, small updates           |
+ * | 4 KiB | ByteBuffer's default, update-object      |
+ * | 16 KiB| larger update-object blocks, lists       |
+ * | 64 KiB| bulk: initial object updates, addon data |
+ *
+ * Bigger requests go straight to the heap and are counted as oversized. Each
+ * thread keeps a bounded number of blocks per class, so a thread that frees
+ * more packets than it builds returns the surplus to the heap.
+ */
+
+#ifndef MANGOS_PACKETBUFFERPOOL_H
+#define MANGOS_PACKETBUFFERPOOL_H
+
+#include <cstddef>
+#include <new>
+
+namespace MaNGOS
+{
+    /// Counters of every size class, summed over all threads.
+    struct PacketBufferPoolStats
+    {
+        static const size_t ClassCount = 5;
+
+        size_t ClassSize[ClassCount];
+        size_t Allocations[ClassCount];
+        size_t Hits[ClassCount];          ///< Allocations served from a thread free list
+        size_t Oversized;                 ///< Allocations above the largest class
+    };
+
+    class PacketBufferPool
+    {
+        public:
+            /// Storage for @p size bytes, from a free list when one has a block.
+            static void* Allocate(size_t size);
+
+            /// Give back storage of Allocate() with the same @p size.
+            static void Release(void* block, size_t size);
+
+            static PacketBufferPoolStats GetStats();
+    };
+
+    /// std::allocator replacement that routes vector storage through PacketBufferPool.
+    template<typename T>
+    struct PacketBufferAllocator
+    {
+        typedef T value_type;
+
+        PacketBufferAllocator() {}
+        template<typename U> PacketBufferAllocator(PacketBufferAllocator<U> const&) {}
+
+        T* allocate(size_t n)
+        {
+            return static_cast<T*>(PacketBufferPool::Allocate(n * sizeof(T)));
+        }
+
+        void deallocate(T* p, size_t n)
+        {
+            PacketBufferPool::Release(p, n * sizeof(T));
+        }
+
+        template<typename U> bool operator==(PacketBufferAllocator<U> const&) const { return true; }
+        template<typename U> bool operator!=(PacketBufferAllocator<U> const&) const { return false; }
+    };
+}
+
+#endif
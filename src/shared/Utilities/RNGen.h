@@ -26,6 +26,7 @@
 #ifndef MANGOS_RNG_H
 #define MANGOS_RNG_H
 
+#include <atomic>
 #include <random>
 
 #include "Platform/Define.h"
@@ -69,6 +70,11 @@ class RNGen
             return dist(gen_);
         }
 
+        void seed(uint32 value)
+        {
+            gen_.seed(value);
+        }
+
     private:
         std::mt19937 gen_;
 };
@@ -80,15 +86,57 @@ class RNGen
  * seeded independently from std::random_device). A genuine thread_local needs no
  * mutex on the access path — and these are called from the world and map-update
  * threads on every roll.
+ *
+ * Seed() makes the rolls repeatable, for capture and replay: the calling thread
+ * is reseeded with the seed itself, and every other thread, on its next roll,
+ * with the seed plus the order in which it got there, counted from one. The
+ * world thread's rolls then repeat exactly; a map thread's repeat as long as it
+ * updates the same maps in the same order.
  */
 class RNG
 {
     public:
         static RNGen* instance()
         {
-            thread_local RNGen generator;
-            return &generator;
+            Local& local = GetLocal();
+
+            uint32 current = s_epoch.load(std::memory_order_acquire);
+            if (local.epoch != current)
+            {
+                local.epoch = current;
+                local.generator.seed(s_seed.load(std::memory_order_relaxed) + s_nextThread.fetch_add(1, std::memory_order_relaxed));
+            }
+            return &local.generator;
+        }
+
+        static void Seed(uint32 seed)
+        {
+            s_seed.store(seed, std::memory_order_relaxed);
+            s_nextThread.store(1, std::memory_order_relaxed);
+
+            // The caller takes the new epoch directly rather than through instance(),
+            // which would hand it ordinal one as well before the reseed below.
+            Local& local = GetLocal();
+            local.epoch = s_epoch.fetch_add(1, std::memory_order_release) + 1;
+            local.generator.seed(seed);
+        }
+
+    private:
+        struct Local
+        {
+            RNGen generator;
+            uint32 epoch = 0;
+        };
+
+        static Local& GetLocal()
+        {
+            thread_local Local local;
+            return local;
         }
+
+        static inline std::atomic<uint32> s_epoch{0};
+        static inline std::atomic<uint32> s_seed{0};
+        static inline std::atomic<uint32> s_nextThread{0};
 };
 
 #endif
@@ -0,0 +1,239 @@
+/**
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2026 MaNGOS <https://www.getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+#include "SlabPool.h"
+
+#include <algorithm>
+#include <new>
+
+namespace MaNGOS
+{
+    namespace
+    {
+        /// Every pool by identifier; a destroyed pool leaves its slot empty.
+        std::atomic<SlabPool*> s_pools[SlabPool::MaxPools];
+        std::atomic<size_t> s_nextPoolId(0);
+
+        size_t AlignBlockSize(size_t size)
+        {
+            size_t const align = alignof(std::max_align_t);
+            size = std::max(size, sizeof(void*));
+            return (size + align - 1) / align * align;
+        }
+    }
+
+    /// The released blocks a thread holds, one slot per pool.
+    struct SlabPoolThreadCache
+    {
+        SlabPool::CacheSlot Slots[SlabPool::MaxPools];
+
+        SlabPoolThreadCache()
+        {
+            for (size_t i = 0; i < SlabPool::MaxPools; ++i)
+            {
+                Slots[i].Head = NULL;
+                Slots[i].Count = 0;
+            }
+        }
+
+        ~SlabPoolThreadCache()
+        {
+            // hand what this thread holds back, or its pool could never reuse it
+            for (size_t i = 0; i < SlabPool::MaxPools; ++i)
+            {
+                if (SlabPool* pool = s_pools[i].load(std::memory_order_acquire))
+                {
+                    if (Slots[i].Count)
+                    {
+                        pool->ReleaseCentral(Slots[i], Slots[i].Count);
+                    }
+                }
+            }
+        }
+    };
+
+    static thread_local SlabPoolThreadCache t_cache;
+
+    SlabPool::SlabPool(char const* name, size_t blockSize, size_t blocksPerSlab)
+        : m_name(name), m_blockSize(blockSize), m_blocksPerSlab(std::max<size_t>(blocksPerSlab, 1)),
+          m_id(s_nextPoolId.fetch_add(1)), m_free(NULL), m_bump(NULL), m_bumpEnd(NULL),
+          m_inUse(0), m_allocations(0), m_reused(0), m_oversized(0)
+    {
+        if (m_id < MaxPools)
+        {
+            s_pools[m_id].store(this, std::memory_order_release);
+        }
+        else
+        {
+            m_id = MaxPools;
+        }
+    }
+
+    SlabPool::~SlabPool()
+    {
+        if (m_id < MaxPools)
+        {
+            s_pools[m_id].store(NULL, std::memory_order_release);
+            // blocks the other threads still cache die with the slabs
+            t_cache.Slots[m_id].Head = NULL;
+            t_cache.Slots[m_id].Count = 0;
+        }
+
+        for (size_t i = 0; i < m_slabs.size(); ++i)
+        {
+            ::operator delete(m_slabs[i]);
+        }
+    }
+
+    void* SlabPool::Allocate(size_t size)
+    {
+        if (size != m_blockSize || m_id == MaxPools)
+        {
+            m_oversized.fetch_add(1, std::memory_order_relaxed);
+            return ::operator new(size);
+        }
+
+        m_allocations.fetch_add(1, std::memory_order_relaxed);
+        m_inUse.fetch_add(1, std::memory_order_relaxed);
+
+        CacheSlot& slot = t_cache.Slots[m_id];
+        if (slot.Head)
+        {
+            FreeBlock* block = slot.Head;
+            slot.Head = block->Next;
+            --slot.Count;
+            m_reused.fetch_add(1, std::memory_order_relaxed);
+            return block;
+        }
+
+        return AllocateCentral(slot);
+    }
+
+    void SlabPool::Release(void* block, size_t size)
+    {
+        if (!block)
+        {
+            return;
+        }
+
+        if (size != m_blockSize || m_id == MaxPools)
+        {
+            ::operator delete(block);
+            return;
+        }
+
+        m_inUse.fetch_sub(1, std::memory_order_relaxed);
+
+        CacheSlot& slot = t_cache.Slots[m_id];
+        FreeBlock* freed = static_cast<FreeBlock*>(block);
+        freed->Next = slot.Head;
+        slot.Head = freed;
+        if (++slot.Count > ThreadCacheLimit)
+        {
+            ReleaseCentral(slot, slot.Count / 2);
+        }
+    }
+
+    void* SlabPool::AllocateCentral(CacheSlot& slot)
+    {
+        std::lock_guard<std::mutex> guard(m_mutex);
+
+        // take a batch of released blocks, keep one and cache the rest
+        if (m_free)
+        {
+            FreeBlock* block = m_free;
+            m_free = block->Next;
+            for (size_t i = 0; i < ThreadCacheLimit / 2 && m_free; ++i)
+            {
+                FreeBlock* cached = m_free;
+                m_free = cached->Next;
+                cached->Next = slot.Head;
+                slot.Head = cached;
+                ++slot.Count;
+            }
+            m_reused.fetch_add(1, std::memory_order_relaxed);
+            return block;
+        }
+
+        if (m_bump == m_bumpEnd)
+        {
+            size_t blockSize = AlignBlockSize(m_blockSize);
+            char* slab = static_cast<char*>(::operator new(blockSize * m_blocksPerSlab));
+            m_slabs.push_back(slab);
+            m_bump = slab;
+            m_bumpEnd = slab + blockSize * m_blocksPerSlab;
+        }
+
+        void* block = m_bump;
+        m_bump += AlignBlockSize(m_blockSize);
+        return block;
+    }
+
+    void SlabPool::ReleaseCentral(CacheSlot& slot, size_t count)
+    {
+        std::lock_guard<std::mutex> guard(m_mutex);
+        for (size_t i = 0; i < count && slot.Head; ++i)
+        {
+            FreeBlock* block = slot.Head;
+            slot.Head = block->Next;
+            --slot.Count;
+            block->Next = m_free;
+            m_free = block;
+        }
+    }
+
+    SlabPoolStats SlabPool::GetStats() const
+    {
+        SlabPoolStats stats;
+        stats.Name = m_name;
+        stats.BlockSize = m_blockSize;
+        {
+            std::lock_guard<std::mutex> guard(m_mutex);
+            stats.Slabs = m_slabs.size();
+        }
+        stats.Capacity = stats.Slabs * m_blocksPerSlab;
+        stats.InUse = m_inUse.load(std::memory_order_relaxed);
+        stats.Allocations = m_allocations.load(std::memory_order_relaxed);
+        stats.Reused = m_reused.load(std::memory_order_relaxed);
+        stats.Oversized = m_oversized.load(std::memory_order_relaxed);
+        // the counters are read unsynchronised, keep the snapshot consistent
+        stats.InUse = std::min(stats.InUse, stats.Capacity);
+        stats.Reused = std::min(stats.Reused, stats.Allocations);
+        return stats;
+    }
+
+    std::vector<SlabPoolStats> SlabPool::GetAllStats()
+    {
+        std::vector<SlabPoolStats> all;
+        for (size_t i = 0; i < MaxPools; ++i)
+        {
+            if (SlabPool* pool = s_pools[i].load(std::memory_order_acquire))
+            {
+                all.push_back(pool->GetStats());
+            }
+        }
+        return all;
+    }
+}
@@ -0,0 +1,168 @@
+/**
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2026 MaNGOS <https://www.getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+/**
+ * @file SlabPool.h
+ * @brief Fixed-size block pools for the world objects grids create and destroy in bulk.
+ *
+ * A grid load allocates every creature and gameobject of its cells, a grid unload
+ * frees them again, and a busy continent does both all day on every map thread.
+ * SlabPool carves blocks of one size out of large slabs and keeps released blocks
+ * for the next allocation instead of returning them to the global heap.
+ *
+ * Released blocks go to a cache of the releasing thread first, so map threads
+ * allocate and free without a lock in the common case; only a cache running
+ * empty or full touches the pool's central free list. Slabs are never returned
+ * while the process runs.
+ *
+ * A class opts in through MANGOS_SLAB_POOL_ALLOCATOR. Objects of derived classes
+ * have another size and keep using the global heap. Pool identifiers are never
+ * reused, so a process gets at most MaxPools pools; later ones use the heap.
+ */
+
+#ifndef MANGOS_SLABPOOL_H
+#define MANGOS_SLABPOOL_H
+
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace MaNGOS
+{
+    /// A snapshot of the counters of one pool.
+    struct SlabPoolStats
+    {
+        std::string Name;
+        size_t BlockSize;
+        size_t Slabs;
+        size_t Capacity;      ///< Blocks carved or still to carve from the slabs
+        size_t InUse;         ///< Blocks holding a live object
+        size_t Allocations;   ///< Blocks handed out so far
+        size_t Reused;        ///< Of those, blocks a released object had used before
+        size_t Oversized;     ///< Allocations of derived classes sent to the heap
+
+        /// Share of allocations served by a released block.
+        float HitRate() const { return Allocations ? float(Reused) / float(Allocations) : 0.0f; }
+        /// Share of the pooled memory not holding a live object.
+        float Fragmentation() const { return Capacity ? float(Capacity - InUse) / float(Capacity) : 0.0f; }
+    };
+
+    class SlabPool
+    {
+        public:
+            /// Most pools a process may have; each one has a slot in every thread cache.
+            static const size_t MaxPools = 16;
+
+            /**
+             * @param name Shown in the statistics
+             * @param blockSize Size of the objects served, usually sizeof(T)
+             * @param blocksPerSlab Blocks carved from one slab allocation
+             */
+            SlabPool(char const* name, size_t blockSize, size_t blocksPerSlab);
+            ~SlabPool();
+
+            SlabPool(const SlabPool&) = delete;
+            SlabPool& operator=(const SlabPool&) = delete;
+
+            /// Allocate @p size bytes; anything but the block size goes to the heap.
+            void* Allocate(size_t size);
+
+            /// Release memory from Allocate() with the same @p size.
+            void Release(void* block, size_t size);
+
+            SlabPoolStats GetStats() const;
+
+            /// Statistics of every pool of the process.
+            static std::vector<SlabPoolStats> GetAllStats();
+
+        private:
+            struct FreeBlock
+            {
+                FreeBlock* Next;
+            };
+
+            /// Released blocks of one pool held by one thread.
+            struct CacheSlot
+            {
+                FreeBlock* Head;
+                size_t Count;
+            };
+
+            /// Blocks a thread may hold before half of them go back to the pool.
+            static const size_t ThreadCacheLimit = 64;
+
+            friend struct SlabPoolThreadCache;
+
+            void* AllocateCentral(CacheSlot& slot);
+            void ReleaseCentral(CacheSlot& slot, size_t count);
+
+            std::string m_name;
+            size_t m_blockSize;
+            size_t m_blocksPerSlab;
+            size_t m_id;                       ///< Thread cache slot, MaxPools if the pool is disabled
+
+            mutable std::mutex m_mutex;        ///< Guards everything below but the counters
+            FreeBlock* m_free;                 ///< Released blocks back from the thread caches
+            char* m_bump;                      ///< Next never used block of the newest slab
+            char* m_bumpEnd;
+            std::vector<char*> m_slabs;
+
+            std::atomic<size_t> m_inUse;
+            std::atomic<size_t> m_allocations;
+            std::atomic<size_t> m_reused;
+            std::atomic<size_t> m_oversized;
+    };
+}
+
+/**
+ * @brief Route the plain new/delete of a class through a SlabPool.
+ *
+ * Goes in the public part of the class body; MANGOS_SLAB_POOL_DEFINE(T, blocksPerSlab)
+ * goes in its translation unit.
+ */
+#define MANGOS_SLAB_POOL_ALLOCATOR                                          \
+        static void* operator new(size_t size);                             \
+        static void operator delete(void* block, size_t size);              \
+        static MaNGOS::SlabPool& GetSlabPool();
+
+#define MANGOS_SLAB_POOL_DEFINE(T, blocksPerSlab)                           \
+    MaNGOS::SlabPool& T::GetSlabPool()                                      \
+    {                                                                       \
+        /* never destroyed: objects may still be freed during exit */       \
+        static MaNGOS::SlabPool* pool =                                     \
+            new MaNGOS::SlabPool(#T, sizeof(T), blocksPerSlab);             \
+        return *pool;                                                       \
+    }                                                                       \
+    void* T::operator new(size_t size)                                      \
+    {                                                                       \
+        return GetSlabPool().Allocate(size);                                \
+    }                                                                       \
+    void T::operator delete(void* block, size_t size)                       \
+    {                                                                       \
+        GetSlabPool().Release(block, size);                                 \
+    }
+
+#endif
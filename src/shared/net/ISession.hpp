@@ -44,6 +44,20 @@ namespace net {
 // span need only stay valid for the duration of the call.
 using Sender = std::function<void(const uint8_t* data, size_t len)>;
 
+// The same channel, taking a frame in two spans that are queued back to back as one
+// unit. Lets a framed protocol send a per-connection header in front of a payload it
+// shares with other connections without first copying both into a frame of its own.
+using GatherSender = std::function<void(const uint8_t* head, size_t headLen,
+                                        const uint8_t* body, size_t bodyLen)>;
+
+// An immutable payload several connections send. The send queues hold references to it
+// rather than copies, so a broadcast is serialised once however many sockets it goes to.
+using SharedPayload = std::shared_ptr<const std::vector<uint8_t>>;
+
+// The same channel once more, queueing a per-connection header in front of a shared
+// payload that it keeps by reference until the socket has taken it.
+using SharedSender = std::function<void(const uint8_t* head, size_t headLen, SharedPayload body)>;
+
 // Lets a session ask the transport to tear the connection down. No-op once gone.
 using Closer = std::function<void()>;
 
@@ -80,6 +94,14 @@ public:
     // Default: ignored (request/response sessions only ever use onData's return).
     virtual void setSender(Sender) {}
 
+    // Hands the session the two-span form of the same channel (net thread, once,
+    // before onConnect). Default: ignored — only framed world sessions use it.
+    virtual void setGatherSender(GatherSender) {}
+
+    // Hands the session the shared-payload form of the same channel (net thread,
+    // once, before onConnect). Default: ignored — only world sessions broadcast.
+    virtual void setSharedSender(SharedSender) {}
+
     // Hands the session a way to request its own teardown (net thread, once).
     virtual void setCloser(Closer) {}
 
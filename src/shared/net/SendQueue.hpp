@@ -30,18 +30,27 @@
 // are swapped once drained.
 //
 // That swap buys both properties this needs. COALESCING: everything queued during one
-// write leaves in the next single write, and both vectors keep their capacity across
+// write leaves in the next single write, and both batches keep their capacity across
 // clear(), so after warm-up the send path allocates nothing -- a world tick emits a great
 // many small packets and a queue-of-buffers would cost an allocation and a syscall each.
 // STABLE STORAGE: a proactor hands the kernel a pointer and collects a completion later,
-// and producers never touch m_inflight, so that memory cannot move under it. m_off then
-// makes a partial write safe by resuming where the kernel stopped rather than dropping
-// the remainder.
+// and producers never touch m_inflight, so that memory cannot move under it. The cursor
+// then makes a partial write safe by resuming where the kernel stopped rather than
+// dropping the remainder.
+//
+// A batch is a run of segments. Most are ranges of the batch's own byte buffer, which is
+// where small packets and every per-connection header are copied. A payload shared by
+// many connections -- a broadcast, see SharedPayload -- is queued by reference instead,
+// as a segment of its own, so a packet sent to 2,000 sessions is held once and reaches
+// each socket through a scatter write (sendmsg, WSASend with several buffers, io_uring
+// sendmsg) rather than being copied 2,000 times. nextSpans() hands out up to MaxSpans
+// segments per write, so the coalescing survives.
 //
 // It lives in the per-connection SendChannel, a shared_ptr the session captures, so the
 // buffers outlive the socket and a parked producer cannot wake into freed memory.
 
 #include "net/FlowControl.hpp"
+#include "net/ISession.hpp"
 
 #include <cstddef>
 #include <cstdint>
@@ -50,8 +59,17 @@
 
 namespace net {
 
+/// One contiguous piece of a scatter write.
+struct SendSpan {
+    const uint8_t* data;
+    size_t         len;
+};
+
 class SendQueue {
 public:
+    /// Most spans nextSpans() hands out for one write. Well under IOV_MAX everywhere.
+    static constexpr size_t MaxSpans = 64;
+
     /// Producer (any thread): copy `len` bytes into the pending buffer.
     ///
     /// Returns true iff this call took ownership of the write — that is, no write
@@ -69,60 +87,114 @@ public:
         }
 
         std::lock_guard<std::mutex> lock(m_mu);
-        m_pending.insert(m_pending.end(), data, data + len);
+        m_pending.copy(data, len);
         m_gate.onQueued(len);
+        return takeWrite();
+    }
 
-        if (m_writing)
+    /// Producer (any thread): copy a header and a body into the pending buffer as
+    /// one contiguous frame, under one lock.
+    ///
+    /// Same ownership contract as the single-span append(). Taking both halves at
+    /// once is what lets a framed protocol skip assembling the frame itself: the
+    /// body is copied exactly once, straight from the caller's buffer, and no other
+    /// producer can slip bytes between the header and the body it belongs to.
+    bool append(const uint8_t* head, size_t headLen, const uint8_t* body, size_t bodyLen)
+    {
+        if (headLen == 0 && bodyLen == 0)
         {
             return false;
         }
-        m_writing = true;
-        return true;
+
+        std::lock_guard<std::mutex> lock(m_mu);
+        m_pending.copy(head, headLen);
+        m_pending.copy(body, bodyLen);
+        m_gate.onQueued(headLen + bodyLen);
+        return takeWrite();
+    }
+
+    /// Producer (any thread): copy a header into the pending buffer and queue a
+    /// shared body behind it by reference, under one lock.
+    ///
+    /// Same ownership contract as the single-span append(). The body is not copied:
+    /// the queue keeps a reference until the socket has taken all of it.
+    bool append(const uint8_t* head, size_t headLen, SharedPayload body)
+    {
+        size_t const bodyLen = body ? body->size() : 0;
+        if (headLen == 0 && bodyLen == 0)
+        {
+            return false;
+        }
+
+        std::lock_guard<std::mutex> lock(m_mu);
+        m_pending.copy(head, headLen);
+        m_pending.share(std::move(body));
+        m_gate.onQueued(headLen + bodyLen);
+        return takeWrite();
     }
 
-    /// Transport (the thread that owns the write): hand back the next contiguous
-    /// span to write to the socket.
+    /// Transport (the thread that owns the write): hand back the next spans to
+    /// write to the socket, at most `maxSpans` of them, in order.
     ///
-    /// If the in-flight span has been fully consumed, the pending buffer is swapped
-    /// in to take its place — this is where coalescing happens. Returns false when
+    /// If the in-flight batch has been fully consumed, the pending batch is swapped
+    /// in to take its place — this is where coalescing happens. Returns 0 when
     /// there is nothing left to write, and in that case also releases ownership of
     /// the write, so the next append() will hand it to whoever calls next.
     ///
-    /// The returned pointer stays valid until the matching consume() — producers
-    /// cannot invalidate it, because they only ever touch the pending buffer.
-    bool nextSpan(const uint8_t*& data, size_t& len)
+    /// The returned spans stay valid until the matching consume() — producers
+    /// cannot invalidate them, because they only ever touch the pending batch.
+    size_t nextSpans(SendSpan* spans, size_t maxSpans)
     {
         std::lock_guard<std::mutex> lock(m_mu);
 
-        if (m_off == m_inflight.size())
+        if (m_seg == m_inflight.segments.size())
         {
             // Fully drained: promote whatever accumulated while we were writing.
-            // swap() keeps both buffers' capacity, so this never allocates once
-            // the connection has reached its steady state.
+            // The swap keeps both batches' capacity, so this never allocates once
+            // the connection has reached its steady state. clear() also drops the
+            // references the drained batch held on shared payloads.
             m_inflight.swap(m_pending);
             m_pending.clear();
-            m_off = 0;
+            m_seg = 0;
+            m_segOff = 0;
         }
 
-        if (m_inflight.empty())
+        size_t count = 0;
+        for (size_t i = m_seg; i < m_inflight.segments.size() && count < maxSpans; ++i)
         {
-            m_writing = false;
-            return false;
+            Segment const& segment = m_inflight.segments[i];
+            size_t const skip = (i == m_seg) ? m_segOff : 0;
+            spans[count].data = m_inflight.data(segment) + skip;
+            spans[count].len  = segment.len - skip;
+            ++count;
         }
 
-        data = m_inflight.data() + m_off;
-        len  = m_inflight.size() - m_off;
-        return true;
+        if (count == 0)
+        {
+            m_writing = false;
+        }
+        return count;
     }
 
-    /// Transport: `n` bytes of the span handed out by nextSpan() reached the socket.
-    /// A short write is normal (and, on IOCP, was previously dropped on the floor);
-    /// the next nextSpan() simply resumes from the new offset.
+    /// Transport: `n` bytes of the spans handed out by nextSpans() reached the
+    /// socket. A short write is normal (and, on IOCP, was previously dropped on the
+    /// floor); the next nextSpans() simply resumes from the new position.
     void consume(size_t n)
     {
         std::lock_guard<std::mutex> lock(m_mu);
-        m_off += n;
         m_gate.onSent(n);
+        while (n != 0 && m_seg < m_inflight.segments.size())
+        {
+            size_t const left = m_inflight.segments[m_seg].len - m_segOff;
+            if (n < left)
+            {
+                m_segOff += n;
+                return;
+            }
+            n -= left;
+            ++m_seg;
+            m_segOff = 0;
+        }
     }
 
     /// Transport: the write could not be started (socket already gone). Releases
@@ -138,7 +210,7 @@ public:
     bool empty() const
     {
         std::lock_guard<std::mutex> lock(m_mu);
-        return m_off == m_inflight.size() && m_pending.empty();
+        return m_seg == m_inflight.segments.size() && m_pending.segments.empty();
     }
 
     /// Teardown: wake any producer parked on backpressure so it stops producing.
@@ -147,12 +219,79 @@ public:
     FlowGate& gate() { return m_gate; }
 
 private:
-    mutable std::mutex   m_mu;
-    std::vector<uint8_t> m_pending;        ///< producers append here
-    std::vector<uint8_t> m_inflight;       ///< the socket is draining this
-    size_t               m_off = 0;        ///< bytes of m_inflight already written
-    bool                 m_writing = false;///< a write is in flight (proactors)
-    FlowGate             m_gate;           ///< byte-counted backpressure
+    /// A range of the batch's own bytes, or a whole shared payload.
+    struct Segment {
+        SharedPayload shared;              ///< null: bytes [offset, offset + len) of Batch::bytes
+        size_t        offset;
+        size_t        len;
+    };
+
+    struct Batch {
+        std::vector<uint8_t> bytes;
+        std::vector<Segment> segments;
+
+        void copy(const uint8_t* data, size_t len)
+        {
+            if (len == 0)
+            {
+                return;
+            }
+            // Offsets rather than pointers, so the buffer may grow (geometrically --
+            // no reserve() here, which would pin it to this frame's size and make a
+            // backed-up socket reallocate on every packet) under segments already queued.
+            if (segments.empty() || segments.back().shared)
+            {
+                segments.push_back(Segment{SharedPayload(), bytes.size(), 0});
+            }
+            segments.back().len += len;
+            bytes.insert(bytes.end(), data, data + len);
+        }
+
+        void share(SharedPayload payload)
+        {
+            if (payload && !payload->empty())
+            {
+                size_t const len = payload->size();
+                segments.push_back(Segment{std::move(payload), 0, len});
+            }
+        }
+
+        const uint8_t* data(Segment const& segment) const
+        {
+            return segment.shared ? segment.shared->data() : bytes.data() + segment.offset;
+        }
+
+        void swap(Batch& other)
+        {
+            bytes.swap(other.bytes);
+            segments.swap(other.segments);
+        }
+
+        void clear()
+        {
+            bytes.clear();
+            segments.clear();
+        }
+    };
+
+    /// Called under m_mu once something was queued: claim the write if none runs.
+    bool takeWrite()
+    {
+        if (m_writing)
+        {
+            return false;
+        }
+        m_writing = true;
+        return true;
+    }
+
+    mutable std::mutex m_mu;
+    Batch              m_pending;          ///< producers append here
+    Batch              m_inflight;         ///< the socket is draining this
+    size_t             m_seg = 0;          ///< first segment of m_inflight not fully written
+    size_t             m_segOff = 0;       ///< bytes of that segment already written
+    bool               m_writing = false;  ///< a write is in flight (proactors)
+    FlowGate           m_gate;             ///< byte-counted backpressure
 };
 
 } // namespace net
@@ -49,6 +49,19 @@ void SendChannel::post(const uint8_t* data, size_t len) {
         ctx->enqueue(data, len);
 }
 
+void SendChannel::post(const uint8_t* head, size_t headLen,
+                       const uint8_t* body, size_t bodyLen) {
+    std::lock_guard<std::mutex> lock(mu);
+    if (ctx)
+        ctx->enqueue(head, headLen, body, bodyLen);
+}
+
+void SendChannel::post(const uint8_t* head, size_t headLen, SharedPayload body) {
+    std::lock_guard<std::mutex> lock(mu);
+    if (ctx)
+        ctx->enqueue(head, headLen, std::move(body));
+}
+
 // The session asked to close. Do NOT close the socket here.
 //
 // Closing it discards whatever is still queued, and what is queued at this exact
@@ -85,20 +98,23 @@ void SendChannel::disarm() {
 
 // ── ConnCtx ───────────────────────────────────────────────────────────────────
 
-bool ConnCtx::postSend(const uint8_t* data, size_t len) {
+bool ConnCtx::postSend(const SendSpan* spans, size_t count) {
     bool failed = false;
     {
         std::lock_guard<std::mutex> sk(sockMu);   // no concurrent Winsock call on `sock`
         if (sock == INVALID_SOCKET)
             return false;                          // closed under us; never addRef'd
         ZeroMemory(&sendOv.ov, sizeof(OVERLAPPED));
-        // Safe to hand the kernel a pointer into the SendQueue's in-flight buffer: only
-        // the pending buffer is ever appended to, so this storage cannot move or be
-        // reallocated before the completion arrives.
-        sendOv.wsabuf.buf = reinterpret_cast<char*>(const_cast<uint8_t*>(data));
-        sendOv.wsabuf.len = static_cast<ULONG>(len);
+        // Safe to hand the kernel pointers into the SendQueue's in-flight spans: only
+        // the pending batch is ever appended to, so this storage -- shared payloads
+        // included, which the batch holds references to -- cannot move or be freed
+        // before the completion arrives.
+        for (size_t i = 0; i < count; ++i) {
+            sendOv.wsabufs[i].buf = reinterpret_cast<char*>(const_cast<uint8_t*>(spans[i].data));
+            sendOv.wsabufs[i].len = static_cast<ULONG>(spans[i].len);
+        }
         addRef();  // the completion of this send will release()
-        int rc = WSASend(sock, &sendOv.wsabuf, 1, nullptr, 0, &sendOv.ov, nullptr);
+        int rc = WSASend(sock, sendOv.wsabufs, static_cast<DWORD>(count), nullptr, 0, &sendOv.ov, nullptr);
         if (rc == SOCKET_ERROR && WSAGetLastError() != WSA_IO_PENDING)
             failed = true;
     }
@@ -114,18 +130,32 @@ bool ConnCtx::postSend(const uint8_t* data, size_t len) {
 void ConnCtx::enqueue(const uint8_t* data, size_t len) {
     // append() returns true only for the caller that finds no write in flight, so
     // exactly one thread starts the write and the stream stays ordered. Everything
-    // else queued meanwhile is coalesced into the next span by nextSpan().
+    // else queued meanwhile is coalesced into the next write by nextSpans().
     if (channel && channel->out.append(data, len))
         startSend();
 }
 
+void ConnCtx::enqueue(const uint8_t* head, size_t headLen,
+                      const uint8_t* body, size_t bodyLen) {
+    // As above. Both spans land in the pending buffer under one lock, so the write
+    // this may start always sees the whole frame rather than a bare header.
+    if (channel && channel->out.append(head, headLen, body, bodyLen))
+        startSend();
+}
+
+void ConnCtx::enqueue(const uint8_t* head, size_t headLen, SharedPayload body) {
+    // As above; the body stays referenced by the queue until the socket has it.
+    if (channel && channel->out.append(head, headLen, std::move(body)))
+        startSend();
+}
+
 void ConnCtx::startSend() {
-    const uint8_t* data = nullptr;
-    size_t         len  = 0;
-    if (!channel->out.nextSpan(data, len))
-        return;  // nothing left; nextSpan() released ownership of the write
+    SendSpan spans[SendQueue::MaxSpans];
+    size_t const count = channel->out.nextSpans(spans, SendQueue::MaxSpans);
+    if (count == 0)
+        return;  // nothing left; nextSpans() released ownership of the write
 
-    if (!postSend(data, len)) {
+    if (!postSend(spans, count)) {
         // Socket already gone. Release ownership so the queue is not stuck believing
         // a write is running; teardown frees us once the recv side completes.
         channel->out.abortWrite();
@@ -535,6 +565,14 @@ void IocpServer::handleAccept(AcceptOv* aov, DWORD /*bytes*/) {
     ctx->channel->ctx = ctx;
     ctx->session->setSender(
         [ch = ctx->channel](const uint8_t* d, size_t n) { ch->post(d, n); });
+    ctx->session->setGatherSender(
+        [ch = ctx->channel](const uint8_t* h, size_t hn, const uint8_t* b, size_t bn) {
+            ch->post(h, hn, b, bn);
+        });
+    ctx->session->setSharedSender(
+        [ch = ctx->channel](const uint8_t* h, size_t hn, SharedPayload b) {
+            ch->post(h, hn, std::move(b));
+        });
     ctx->session->setCloser([ch = ctx->channel] { ch->requestClose(); });
     ctx->session->setFlowControl(
         std::shared_ptr<net::FlowControl>(ctx->channel, &ctx->channel->out.gate()));
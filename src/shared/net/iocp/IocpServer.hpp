@@ -79,11 +79,11 @@ struct RecvOv {
 };
 
 // No buffer of its own: a send is posted directly out of the SendQueue's in-flight
-// buffer, whose storage is guaranteed not to move while the write is outstanding.
+// spans, whose storage is guaranteed not to move while the write is outstanding.
 struct SendOv {
     OVERLAPPED ov{};
     IoType     type{IoType::Send};
-    WSABUF     wsabuf{};
+    WSABUF     wsabufs[SendQueue::MaxSpans]{};
 };
 
 // The worker recovers the op type from a bare OVERLAPPED* by reading the byte at
@@ -120,6 +120,10 @@ struct SendChannel {
     bool closeRequested = false;
 
     void post(const uint8_t* data, size_t len);  // append + kick a write while armed
+    void post(const uint8_t* head, size_t headLen,
+              const uint8_t* body, size_t bodyLen);  // same, one two-span frame
+    void post(const uint8_t* head, size_t headLen,
+              SharedPayload body);                   // same, body by reference
     void requestClose();                   // drain, then close
     void disarm();                         // detach from the ctx, forever
 };
@@ -194,15 +198,17 @@ struct ConnCtx {
     // Append bytes to the outbound buffer and start a write if none is in flight.
     // Thread-safe; callable from any thread.
     void enqueue(const uint8_t* data, size_t len);
-    // Post the next contiguous span from the SendQueue, if any. Exactly one write is
-    // ever in flight, which is what keeps the byte stream ordered.
+    void enqueue(const uint8_t* head, size_t headLen, const uint8_t* body, size_t bodyLen);
+    void enqueue(const uint8_t* head, size_t headLen, SharedPayload body);
+    // Post the next spans from the SendQueue, if any. Exactly one write is ever in
+    // flight, which is what keeps the byte stream ordered.
     void startSend();
     // A WSASend completed, having transferred `bytes`. Honouring `bytes` is what makes
     // a short write safe: the remainder is re-posted instead of being dropped.
     void onSendComplete(DWORD bytes);
-    // Post a WSASend of [data,len); refs++ on success, returns false if it could not
-    // be started (e.g. the socket is already closed).
-    bool postSend(const uint8_t* data, size_t len);
+    // Post one WSASend of `count` spans; refs++ on success, returns false if it could
+    // not be started (e.g. the socket is already closed).
+    bool postSend(const SendSpan* spans, size_t count);
     void close();
 };
 
@@ -71,6 +71,10 @@ struct SendChannel : public std::enable_shared_from_this<SendChannel> {
     Poller*                                     poller   = nullptr;
 
     void post(const uint8_t* data, size_t len);  // world thread
+    void post(const uint8_t* head, size_t headLen,
+              const uint8_t* body, size_t bodyLen);  // world thread, one frame
+    void post(const uint8_t* head, size_t headLen,
+              SharedPayload body);                   // world thread, body by reference
     void requestClose();                         // world thread
     void disarm();                               // worker thread
 
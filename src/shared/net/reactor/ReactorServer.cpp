@@ -35,6 +35,7 @@
 
 #include <sys/types.h>
 #include <sys/socket.h>
+#include <sys/uio.h>
 #include <netinet/in.h>
 #include <netinet/tcp.h>
 #include <arpa/inet.h>
@@ -210,6 +211,14 @@ void ReactorServer::acceptLoop() {
                 conn->channel->poller   = w.poller.get();
                 conn->session->setSender(
                     [ch = conn->channel](const uint8_t* d, size_t n) { ch->post(d, n); });
+                conn->session->setGatherSender(
+                    [ch = conn->channel](const uint8_t* h, size_t hn, const uint8_t* b, size_t bn) {
+                        ch->post(h, hn, b, bn);
+                    });
+                conn->session->setSharedSender(
+                    [ch = conn->channel](const uint8_t* h, size_t hn, SharedPayload b) {
+                        ch->post(h, hn, std::move(b));
+                    });
                 conn->session->setCloser([ch = conn->channel] { ch->requestClose(); });
                 conn->session->setFlowControl(
                     std::shared_ptr<net::FlowControl>(conn->channel, &conn->channel->out.gate()));
@@ -261,6 +270,25 @@ void SendChannel::post(const uint8_t* data, size_t len) {
     notifyWorker();
 }
 
+void SendChannel::post(const uint8_t* head, size_t headLen,
+                       const uint8_t* body, size_t bodyLen) {
+    {
+        std::lock_guard<std::mutex> lock(mu);
+        if (!alive) return;
+        out.append(head, headLen, body, bodyLen);
+    }
+    notifyWorker();
+}
+
+void SendChannel::post(const uint8_t* head, size_t headLen, SharedPayload body) {
+    {
+        std::lock_guard<std::mutex> lock(mu);
+        if (!alive) return;
+        out.append(head, headLen, std::move(body));
+    }
+    notifyWorker();
+}
+
 void SendChannel::requestClose() {
     {
         std::lock_guard<std::mutex> lock(mu);
@@ -306,14 +334,24 @@ bool ReactorServer::flush(Worker& w, Connection* conn) {
     SendQueue& out = conn->channel->out;
 
     for (;;) {
-        const uint8_t* p   = nullptr;
-        size_t         rem = 0;
-        if (!out.nextSpan(p, rem)) {
+        SendSpan spans[SendQueue::MaxSpans];
+        size_t const count = out.nextSpans(spans, SendQueue::MaxSpans);
+        if (count == 0) {
             setWriteInterest(w, conn, false); // fully drained
             return true;
         }
 
-        ssize_t n = ::send(conn->fd, p, rem, MSG_NOSIGNAL);
+        // One scatter write: queued bytes and shared payloads leave together.
+        iovec iov[SendQueue::MaxSpans];
+        for (size_t i = 0; i < count; ++i) {
+            iov[i].iov_base = const_cast<uint8_t*>(spans[i].data);
+            iov[i].iov_len  = spans[i].len;
+        }
+        msghdr msg{};
+        msg.msg_iov    = iov;
+        msg.msg_iovlen = count;
+
+        ssize_t n = ::sendmsg(conn->fd, &msg, MSG_NOSIGNAL);
         if (n > 0) {
             // Short writes are the norm on a non-blocking socket; consume() just
             // advances the cursor and the next span resumes from there.
@@ -189,6 +189,14 @@ void UringServer::acceptLoop() {
         conn->channel->evfd     = w.evfd;
         conn->session->setSender(
             [ch = conn->channel](const uint8_t* d, size_t n) { ch->post(d, n); });
+        conn->session->setGatherSender(
+            [ch = conn->channel](const uint8_t* h, size_t hn, const uint8_t* b, size_t bn) {
+                ch->post(h, hn, b, bn);
+            });
+        conn->session->setSharedSender(
+            [ch = conn->channel](const uint8_t* h, size_t hn, SharedPayload b) {
+                ch->post(h, hn, std::move(b));
+            });
         conn->session->setCloser([ch = conn->channel] { ch->requestClose(); });
         conn->session->setFlowControl(
             std::shared_ptr<net::FlowControl>(conn->channel, &conn->channel->out.gate()));
@@ -239,6 +247,25 @@ void UringSendChannel::post(const uint8_t* data, size_t len) {
     notifyWorker();
 }
 
+void UringSendChannel::post(const uint8_t* head, size_t headLen,
+                            const uint8_t* body, size_t bodyLen) {
+    {
+        std::lock_guard<std::mutex> lock(mu);
+        if (!alive) return;
+        out.append(head, headLen, body, bodyLen);
+    }
+    notifyWorker();
+}
+
+void UringSendChannel::post(const uint8_t* head, size_t headLen, SharedPayload body) {
+    {
+        std::lock_guard<std::mutex> lock(mu);
+        if (!alive) return;
+        out.append(head, headLen, std::move(body));
+    }
+    notifyWorker();
+}
+
 void UringSendChannel::requestClose() {
     {
         std::lock_guard<std::mutex> lock(mu);
@@ -318,17 +345,25 @@ void UringServer::submitRecv(Worker& w, UringConn* conn) {
 void UringServer::submitSend(Worker& w, UringConn* conn) {
     if (conn->dead || conn->sendInFlight) return;
 
-    // Safe to hand the kernel a raw pointer into the in-flight span: producers only
-    // ever append to the queue's *pending* buffer, so this storage cannot move
-    // before the completion arrives. nextSpan() also coalesces everything queued
-    // since the last write into this one SQE.
-    const uint8_t* data = nullptr;
-    size_t         len  = 0;
-    if (!conn->channel->out.nextSpan(data, len)) return;   // nothing to write
+    // Safe to hand the kernel raw pointers into the in-flight spans: producers only
+    // ever append to the queue's *pending* batch, so this storage -- shared payloads
+    // included, which the batch holds references to -- cannot move or be freed before
+    // the completion arrives. nextSpans() also coalesces everything queued since the
+    // last write into this one SQE.
+    SendSpan spans[SendQueue::MaxSpans];
+    size_t const count = conn->channel->out.nextSpans(spans, SendQueue::MaxSpans);
+    if (count == 0) return;                                 // nothing to write
 
     io_uring_sqe* sqe = getSqe(&w.ring);
     if (!sqe) { conn->channel->out.abortWrite(); return; }
-    io_uring_prep_send(sqe, conn->fd, data, len, MSG_NOSIGNAL);
+    for (size_t i = 0; i < count; ++i) {
+        conn->sendIov[i].iov_base = const_cast<uint8_t*>(spans[i].data);
+        conn->sendIov[i].iov_len  = spans[i].len;
+    }
+    conn->sendMsg = msghdr{};
+    conn->sendMsg.msg_iov    = conn->sendIov;
+    conn->sendMsg.msg_iovlen = count;
+    io_uring_prep_sendmsg(sqe, conn->fd, &conn->sendMsg, MSG_NOSIGNAL);
     io_uring_sqe_set_data64(sqe, reinterpret_cast<uint64_t>(conn) | OP_SEND);
     conn->sendInFlight = true;
     ++conn->inflight;
@@ -38,6 +38,8 @@
 #include "net/SendQueue.hpp"
 
 #include <liburing.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
 
 #include <atomic>
 #include <cstdint>
@@ -76,6 +78,10 @@ struct UringSendChannel : public std::enable_shared_from_this<UringSendChannel>
     int                                            evfd     = -1;
 
     void post(const uint8_t* data, size_t len);  // world thread
+    void post(const uint8_t* head, size_t headLen,
+              const uint8_t* body, size_t bodyLen);  // world thread, one frame
+    void post(const uint8_t* head, size_t headLen,
+              SharedPayload body);                   // world thread, body by reference
     void requestClose();                         // world thread
     void disarm();                               // worker thread
 
@@ -100,13 +106,18 @@ struct UringConn {
     // something. It does not.
     uint8_t  recvBuf[8192];
 
+    // The scatter list of the send in flight. The kernel reads both until the
+    // completion, so they live here rather than on submitSend()'s stack.
+    iovec    sendIov[SendQueue::MaxSpans];
+    msghdr   sendMsg{};
+
     bool     recvInFlight  = false;
     bool     sendInFlight  = false;
     int      inflight      = 0;     // submitted-but-not-completed ops
     bool     dead          = false; // teardown started; stop submitting new ops
     bool     closeAfterDrain = false;
 
-    // cppcheck-suppress uninitMemberVar ; recvBuf is a kernel-filled recv buffer, see above
+    // cppcheck-suppress uninitMemberVar ; recvBuf and sendIov are filled before use, see above
     explicit UringConn(const SessionFactory& factory) : session(factory()) {}
 };
 
@@ -7,6 +7,11 @@
 #include <limits>
 #include <type_traits>
 
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)
+#include <emmintrin.h>
+#define TERRAIN_WIDE_BVH_SSE 1
+#endif
+
 namespace world::terrain
 {
     namespace
@@ -36,6 +41,9 @@ namespace world::terrain
 
     static_assert(std::is_trivially_copyable<Bvh::Node>::value,
                   "Bvh::Node must stay trivially copyable (it is written raw to the tile)");
+    static_assert(std::is_trivially_copyable<WideBvh::Node>::value,
+                  "WideBvh::Node must stay trivially copyable (it is written raw to the tile)");
+    static_assert(WideBvh::WIDTH == 4, "the SSE box test below is four lanes wide");
 
     void Bvh::Build(TriSoup& soup, std::vector<uint16_t>* parallel, int leafSize)
     {
@@ -282,4 +290,344 @@ namespace world::terrain
             stack[sp++] = n.right;
         }
     }
+
+    namespace
+    {
+        // Deepest wide walk: each level pops one node and pushes at most WIDTH, and a
+        // collapsed tree is never deeper than the binary one it came from.
+        constexpr int WIDE_STACK = (Bvh::MAX_DEPTH + 2) * (WideBvh::WIDTH - 1) + 1;
+
+        // Must match Aabb::intersectsRay's padding exactly -- see the note there. The
+        // lanes below do the same float operations in the same order, so a slot is hit
+        // precisely when the scalar test on the same box would say so.
+        constexpr float SLAB_EPS = 1e-2f;
+
+        struct WideRay
+        {
+            float o[3];
+            float inv[3];
+        };
+
+        inline WideRay MakeRay(const Vec3& o, const Vec3& d)
+        {
+            auto inv = [](float v) { return std::fabs(v) > 1e-9f ? 1.f / v : 1e30f; };
+            return WideRay{{o.x, o.y, o.z}, {inv(d.x), inv(d.y), inv(d.z)}};
+        }
+
+        // Slab test of all four child boxes; bit i of the result is set when slot i is
+        // entered before tMax, and tEnter[i] receives where.
+        inline unsigned HitSlots(const WideBvh::Node& n, const WideRay& r, float tMax,
+                                 float tEnter[WideBvh::WIDTH])
+        {
+#ifdef TERRAIN_WIDE_BVH_SSE
+            const __m128 eps = _mm_set1_ps(SLAB_EPS);
+            __m128 t0 = _mm_setzero_ps();
+            __m128 t1 = _mm_set1_ps(tMax);
+            for (int a = 0; a < 3; ++a)
+            {
+                const __m128 oa = _mm_set1_ps(r.o[a]);
+                const __m128 ia = _mm_set1_ps(r.inv[a]);
+                const __m128 lo = _mm_sub_ps(_mm_loadu_ps(n.lo[a]), eps);
+                const __m128 hi = _mm_add_ps(_mm_loadu_ps(n.hi[a]), eps);
+                const __m128 ta = _mm_mul_ps(_mm_sub_ps(lo, oa), ia);
+                const __m128 tb = _mm_mul_ps(_mm_sub_ps(hi, oa), ia);
+                t0 = _mm_max_ps(t0, _mm_min_ps(ta, tb));
+                t1 = _mm_min_ps(t1, _mm_max_ps(ta, tb));
+            }
+            _mm_storeu_ps(tEnter, t0);
+            return unsigned(_mm_movemask_ps(_mm_cmple_ps(t0, t1)));
+#else
+            unsigned mask = 0;
+            for (int i = 0; i < WideBvh::WIDTH; ++i)
+            {
+                float t0 = 0.f, t1 = tMax;
+                for (int a = 0; a < 3; ++a)
+                {
+                    const float ta = (n.lo[a][i] - SLAB_EPS - r.o[a]) * r.inv[a];
+                    const float tb = (n.hi[a][i] + SLAB_EPS - r.o[a]) * r.inv[a];
+                    t0 = std::max(t0, std::min(ta, tb));
+                    t1 = std::min(t1, std::max(ta, tb));
+                }
+                tEnter[i] = t0;
+                mask |= unsigned(t0 <= t1) << i;
+            }
+            return mask;
+#endif
+        }
+
+        inline void SetSlot(WideBvh::Node& n, int slot, const Aabb& box)
+        {
+            n.lo[0][slot] = box.lo.x;
+            n.lo[1][slot] = box.lo.y;
+            n.lo[2][slot] = box.lo.z;
+            n.hi[0][slot] = box.hi.x;
+            n.hi[1][slot] = box.hi.y;
+            n.hi[2][slot] = box.hi.z;
+        }
+    }
+
+    void WideBvh::Collapse(const Bvh& bvh)
+    {
+        m_nodes.clear();
+        if (bvh.Empty())
+        {
+            return;
+        }
+        m_nodes.reserve(bvh.NodeCount() / 2 + 1);
+        CollapseNode(bvh.Nodes(), 0);
+    }
+
+    int WideBvh::CollapseNode(const std::vector<Bvh::Node>& src, int index)
+    {
+        const int self = int(m_nodes.size());
+        m_nodes.push_back(Node{});
+        for (int i = 0; i < WIDTH; ++i)
+        {
+            m_nodes[self].child[i] = EMPTY;
+        }
+
+        // Open the node up to WIDTH children, always splitting the inner child with the
+        // largest surface: the one a random ray is likeliest to enter, so the one whose
+        // level is most worth folding away.
+        int slots[WIDTH];
+        int used = 0;
+        if (src[index].left < 0)
+        {
+            slots[used++] = index;
+        }
+        else
+        {
+            slots[used++] = src[index].left;
+            slots[used++] = src[index].right;
+        }
+
+        while (used < WIDTH)
+        {
+            int widest = -1;
+            float widestArea = -1.f;
+            for (int i = 0; i < used; ++i)
+            {
+                const Bvh::Node& c = src[slots[i]];
+                if (c.left < 0)
+                {
+                    continue;
+                }
+                const float area = Surface(c.box);
+                if (area > widestArea)
+                {
+                    widestArea = area;
+                    widest = i;
+                }
+            }
+            if (widest < 0)
+            {
+                break;
+            }
+            const Bvh::Node& open = src[slots[widest]];
+            slots[widest] = open.left;
+            slots[used++] = open.right;
+        }
+
+        for (int i = 0; i < used; ++i)
+        {
+            const Bvh::Node& c = src[slots[i]];
+            SetSlot(m_nodes[self], i, c.box);
+            if (c.left < 0)
+            {
+                m_nodes[self].child[i] = LEAF;
+                m_nodes[self].first[i] = c.first;
+                m_nodes[self].count[i] = c.count;
+            }
+            else
+            {
+                // Recursion may reallocate m_nodes: index afresh, never hold a reference.
+                const int child = CollapseNode(src, slots[i]);
+                m_nodes[self].child[i] = child;
+            }
+        }
+        return self;
+    }
+
+    bool WideBvh::Valid(size_t triCount) const
+    {
+        // Children are allocated after their parent, so one forward pass sees every
+        // parent's depth before any of its children need it.
+        std::vector<int> depth(m_nodes.size(), 0);
+        for (size_t n = 0; n < m_nodes.size(); ++n)
+        {
+            const Node& node = m_nodes[n];
+            if (node.child[0] == EMPTY)
+            {
+                return false;
+            }
+            for (int i = 0; i < WIDTH; ++i)
+            {
+                const int32_t c = node.child[i];
+                if (c == EMPTY)
+                {
+                    if (i + 1 < WIDTH && node.child[i + 1] != EMPTY)
+                    {
+                        return false;
+                    }
+                    continue;
+                }
+                if (c == LEAF)
+                {
+                    if (uint64_t(node.first[i]) + node.count[i] > triCount)
+                    {
+                        return false;
+                    }
+                    continue;
+                }
+                if (c <= int32_t(n) || size_t(c) >= m_nodes.size() ||
+                    depth[n] + 1 > Bvh::MAX_DEPTH + 1)
+                {
+                    return false;
+                }
+                depth[c] = depth[n] + 1;
+            }
+        }
+        return true;
+    }
+
+    std::optional<float> WideBvh::Raycast(const TriSoup& soup, const Vec3& o, const Vec3& d,
+                                          float tMax, uint32_t* hitTri) const
+    {
+        if (m_nodes.empty())
+        {
+            return std::nullopt;
+        }
+
+        const WideRay ray = MakeRay(o, d);
+
+        float best = tMax;
+        uint32_t bestTri = 0;
+
+        struct Entry
+        {
+            int node;
+            float tEnter;
+        };
+        Entry stack[WIDE_STACK];
+        int sp = 0;
+        stack[sp++] = Entry{0, 0.f};
+
+        while (sp)
+        {
+            const Entry e = stack[--sp];
+            if (e.tEnter > best)
+            {
+                continue;   // something nearer turned up since this was pushed
+            }
+            const Node& n = m_nodes[e.node];
+
+            float tEnter[WIDTH];
+            unsigned mask = HitSlots(n, ray, best, tEnter);
+
+            // Nearest first: the slots hit, ordered by where the ray enters them. Leaves
+            // are tested on the spot and inner nodes pushed far-to-near, so the nearest
+            // subtree is the next one walked and its hit prunes the others.
+            int order[WIDTH];
+            int hits = 0;
+            for (int i = 0; i < WIDTH; ++i)
+            {
+                if (!(mask & (1u << i)) || n.child[i] == EMPTY)
+                {
+                    continue;
+                }
+                int j = hits++;
+                while (j > 0 && tEnter[order[j - 1]] > tEnter[i])
+                {
+                    order[j] = order[j - 1];
+                    --j;
+                }
+                order[j] = i;
+            }
+
+            for (int k = 0; k < hits; ++k)
+            {
+                const int i = order[k];
+                if (n.child[i] != LEAF || tEnter[i] > best)
+                {
+                    continue;
+                }
+                for (uint32_t t = n.first[i]; t < n.first[i] + n.count[i]; ++t)
+                {
+                    if (auto hit = rayTri(o, d, soup.At(t)))
+                    {
+                        if (*hit >= 0.f && *hit < best)
+                        {
+                            best = *hit;
+                            bestTri = t;
+                        }
+                    }
+                }
+            }
+
+            for (int k = hits - 1; k >= 0; --k)
+            {
+                const int i = order[k];
+                if (n.child[i] >= 0 && tEnter[i] <= best)
+                {
+                    stack[sp++] = Entry{n.child[i], tEnter[i]};
+                }
+            }
+        }
+
+        if (best >= tMax)
+        {
+            return std::nullopt;
+        }
+        if (hitTri)
+        {
+            *hitTri = bestTri;
+        }
+        return best;
+    }
+
+    void WideBvh::RaycastAll(const TriSoup& soup, const Vec3& o, const Vec3& d, float tMax,
+                             std::vector<Bvh::Crossing>& out) const
+    {
+        if (m_nodes.empty())
+        {
+            return;
+        }
+
+        const WideRay ray = MakeRay(o, d);
+
+        int stack[WIDE_STACK];
+        int sp = 0;
+        stack[sp++] = 0;
+
+        while (sp)
+        {
+            const Node& n = m_nodes[stack[--sp]];
+
+            float tEnter[WIDTH];
+            const unsigned mask = HitSlots(n, ray, tMax, tEnter);
+
+            for (int i = 0; i < WIDTH; ++i)
+            {
+                if (!(mask & (1u << i)) || n.child[i] == EMPTY)
+                {
+                    continue;
+                }
+                if (n.child[i] >= 0)
+                {
+                    stack[sp++] = n.child[i];
+                    continue;
+                }
+                for (uint32_t t = n.first[i]; t < n.first[i] + n.count[i]; ++t)
+                {
+                    if (auto hit = rayTri(o, d, soup.At(t)))
+                    {
+                        if (*hit >= 0.f && *hit < tMax)
+                        {
+                            out.push_back(Bvh::Crossing{*hit, t});
+                        }
+                    }
+                }
+            }
+        }
+    }
 }
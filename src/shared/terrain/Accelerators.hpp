@@ -1,8 +1,8 @@
 #pragma once
 
 // A triangle soup in model space and the binned-SAH BVH built over it. The BVH is
-// built offline by the baker and stored in the tile verbatim, so the server never
-// pays to construct one.
+// built offline by the baker, collapsed into a four-wide tree and stored in the tile
+// verbatim, so the server never pays to construct either.
 
 #include "terrain/Geometry.hpp"
 
@@ -98,4 +98,61 @@ namespace world::terrain
         std::vector<Node> m_nodes;
         int m_maxDepth = 0;
     };
+
+    // The same tree with three of every four levels folded away: each node holds up to
+    // WIDTH children, their boxes stored axis-major so one SSE compare tests all four
+    // against a ray at once. That is what the queries walk. The binary tree above is only
+    // what the builder produces; Collapse() turns it into this, without moving a triangle,
+    // so the soup's leaf order and any parallel array built alongside it stay valid.
+    //
+    // Traversal visits the children it hits nearest first and prunes on the best t so
+    // far, as the binary walk does. It tests a SUBSET of the binary walk's boxes (the
+    // folded levels' boxes are skipped, and every child box lies inside them), so it
+    // reaches every leaf the binary walk reaches and rayTri stays the arbiter: the
+    // nearest hit is the same one, to the bit.
+    class WideBvh
+    {
+    public:
+        static constexpr int WIDTH = 4;
+
+        // Slot markers in Node::child; a non-negative value is an inner node's index.
+        static constexpr int32_t LEAF = -1;
+        static constexpr int32_t EMPTY = -2;
+
+        // POD, written raw into the tile: do not reorder or resize the fields. EMPTY
+        // slots come last and their boxes are never read.
+        struct Node
+        {
+            float lo[3][WIDTH];
+            float hi[3][WIDTH];
+            int32_t child[WIDTH];
+            uint32_t first[WIDTH];
+            uint32_t count[WIDTH];
+        };
+
+        void Collapse(const Bvh& bvh);
+
+        std::optional<float> Raycast(const TriSoup& soup, const Vec3& o, const Vec3& d,
+                                     float tMax, uint32_t* hitTri = nullptr) const;
+
+        void RaycastAll(const TriSoup& soup, const Vec3& o, const Vec3& d, float tMax,
+                        std::vector<Bvh::Crossing>& out) const;
+
+        const std::vector<Node>& Nodes() const { return m_nodes; }
+        void Adopt(std::vector<Node> nodes) { m_nodes = std::move(nodes); }
+
+        size_t NodeCount() const { return m_nodes.size(); }
+        size_t MemoryBytes() const { return m_nodes.size() * sizeof(Node); }
+        bool Empty() const { return m_nodes.empty(); }
+
+        // Whether adopted nodes can be walked safely over `triCount` triangles: every
+        // child after its parent (so no cycle), every leaf inside the soup, and no path
+        // deeper than the traversal stack is sized for. The tile reader asks before use.
+        bool Valid(size_t triCount) const;
+
+    private:
+        int CollapseNode(const std::vector<Bvh::Node>& src, int index);
+
+        std::vector<Node> m_nodes;
+    };
 }
@@ -4,15 +4,31 @@
 namespace world::terrain
 {
     CollisionModel::CollisionModel(TriSoup soup, Bvh bvh)
+        : m_soup(std::move(soup))
+    {
+        AdoptBvh(std::move(bvh), nullptr);
+        DeriveBounds();
+    }
+
+    CollisionModel::CollisionModel(TriSoup soup, WideBvh bvh)
         : m_soup(std::move(soup)), m_bvh(std::move(bvh))
     {
         if (m_bvh.Empty() && !m_soup.tris.empty())
         {
-            m_bvh.Build(m_soup, nullptr, 4);
+            AdoptBvh(Bvh{}, nullptr);
         }
         DeriveBounds();
     }
 
+    void CollisionModel::AdoptBvh(Bvh bvh, std::vector<uint16_t>* parallel)
+    {
+        if (bvh.Empty() && !m_soup.tris.empty())
+        {
+            bvh.Build(m_soup, parallel, 4);
+        }
+        m_bvh.Collapse(bvh);
+    }
+
     void CollisionModel::DeriveBounds()
     {
         m_bounds = Aabb{};
@@ -20,9 +20,13 @@ namespace world::terrain
         CollisionModel() = default;
 
         // An empty `bvh` is built here; the baker hands one already built, in which case
-        // soup.tris must already be in that BVH's permuted order.
+        // soup.tris must already be in that BVH's permuted order. Either way it is
+        // collapsed into the wide tree the queries walk, and not kept.
         explicit CollisionModel(TriSoup soup, Bvh bvh = Bvh{});
 
+        // A wide tree read back from a tile, over a soup already in its leaf order.
+        CollisionModel(TriSoup soup, WideBvh bvh);
+
         ModelKind Kind() const override { return ModelKind::Mesh; }
 
         std::optional<float> RaycastNearest(const Vec3& origin, const Vec3& dir,
@@ -36,13 +40,17 @@ namespace world::terrain
 
         size_t TriangleCount() const { return m_soup.tris.size(); }
         const TriSoup& Soup() const { return m_soup; }
-        const Bvh& GetBvh() const { return m_bvh; }
+        const WideBvh& GetBvh() const { return m_bvh; }
 
     protected:
         void DeriveBounds();
 
+        // Builds the binary tree if none was given -- permuting the soup and `parallel`
+        // with it -- and collapses it into m_bvh.
+        void AdoptBvh(Bvh bvh, std::vector<uint16_t>* parallel);
+
         TriSoup m_soup;
-        Bvh m_bvh;
+        WideBvh m_bvh;
         Aabb m_bounds;
         bool m_empty = true;
     };
@@ -94,7 +94,7 @@ namespace world::terrain
         {
             return nullptr;
         }
-        return ReadTile(g_tileDir + "/" + TileFileName(m_mapId, tx, ty));
+        return MapTile(g_tileDir + "/" + TileFileName(m_mapId, tx, ty));
     }
 
     FusedTerrain::TilePtr FusedTerrain::TileAt(float x, float y) const
@@ -147,7 +147,7 @@ namespace world::terrain
         }
         else if (!g_tileDir.empty())
         {
-            tile = ReadTile(g_tileDir + "/" + GlobalWmoFileName(m_mapId));
+            tile = MapTile(g_tileDir + "/" + GlobalWmoFileName(m_mapId));
         }
 
         std::unique_lock<std::shared_mutex> lock(m_mutex);
@@ -163,7 +163,8 @@ namespace world::terrain
     {
         // m_loaded goes back to 0 so the next query re-probes. The absent-tile memo is
         // not kept here: its whole value is recording that the file is missing, and this
-        // tile plainly exists.
+        // tile plainly exists. The grids of a mapped tile need no freeing: the last
+        // reference going -- here, or in whichever query still holds it -- unmaps them.
         m_tiles[tx][ty].reset();
         m_loaded[tx][ty] = 0;
         m_tileLastUse[tx][ty].store(0, std::memory_order_relaxed);
@@ -357,6 +358,37 @@ namespace world::terrain
         return column;
     }
 
+    template <typename F>
+    void FusedTerrain::ForEachSegmentTile(const Vec3& a, const Vec3& b, F&& visit) const
+    {
+        const float dx = b.x - a.x, dy = b.y - a.y;
+        const float lengthXY = std::sqrt(dx * dx + dy * dy);
+        const int samples = std::max(2, int(lengthXY / (TILE_SIZE * 0.5f)) + 2);
+
+        int lastTx = 0, lastTy = 0;
+        bool seen = false;
+        for (int i = 0; i < samples; ++i)
+        {
+            const float f = float(i) / float(samples - 1);
+            const float px = a.x + dx * f, py = a.y + dy * f;
+            const int tx = TileIndex(px), ty = TileIndex(py);
+            if (seen && tx == lastTx && ty == lastTy)
+            {
+                continue;
+            }
+            seen = true;
+            lastTx = tx;
+            lastTy = ty;
+            if (tx >= 0 && tx < GRID_COUNT && ty >= 0 && ty < GRID_COUNT)
+            {
+                if (TilePtr tile = TileAt(px, py))
+                {
+                    visit(tile);
+                }
+            }
+        }
+    }
+
     void FusedTerrain::CollectSegmentInstances(const Vec3& a, const Vec3& b,
                                                std::vector<const StaticInstance*>& out,
                                                std::vector<TilePtr>& keepAlive) const
@@ -364,10 +396,6 @@ namespace world::terrain
         const float minx = std::min(a.x, b.x), maxx = std::max(a.x, b.x);
         const float miny = std::min(a.y, b.y), maxy = std::max(a.y, b.y);
 
-        const float dx = b.x - a.x, dy = b.y - a.y;
-        const float lengthXY = std::sqrt(dx * dx + dy * dy);
-        const int samples = std::max(2, int(lengthXY / (TILE_SIZE * 0.5f)) + 2);
-
         auto gather = [&](const TilePtr& tile)
         {
             if (!tile)
@@ -386,26 +414,7 @@ namespace world::terrain
             }
         };
 
-        int lastTx = 0, lastTy = 0;
-        bool seen = false;
-        for (int i = 0; i < samples; ++i)
-        {
-            const float f = float(i) / float(samples - 1);
-            const float px = a.x + dx * f, py = a.y + dy * f;
-            const int tx = TileIndex(px), ty = TileIndex(py);
-            if (seen && tx == lastTx && ty == lastTy)
-            {
-                continue;
-            }
-            seen = true;
-            lastTx = tx;
-            lastTy = ty;
-            if (tx >= 0 && tx < GRID_COUNT && ty >= 0 && ty < GRID_COUNT)
-            {
-                gather(TileAt(px, py));
-            }
-        }
-
+        ForEachSegmentTile(a, b, gather);
         gather(GlobalWmo());
     }
 
@@ -425,6 +434,105 @@ namespace world::terrain
         return NearestHitFraction(x1, y1, z1, x2, y2, z2) > 1.0f;
     }
 
+    void FusedTerrain::IsInLineOfSight(const Vec3& from, const std::vector<Vec3>& targets,
+                                       std::vector<uint8_t>& clear) const
+    {
+        // Per target, what SegmentHitFrac would derive from its segment: the slab
+        // inverse and the XY box CollectSegmentInstances filters with. A degenerate
+        // segment blocks nothing there, so it is never tested here either.
+        struct Segment
+        {
+            Vec3 invDir;
+            float minx, maxx, miny, maxy;
+            bool live;
+        };
+        auto inv = [](float d) { return std::fabs(d) > 1e-9f ? 1.0f / d : 1e30f; };
+
+        std::vector<Segment> segments(targets.size());
+        std::vector<TilePtr> tiles;
+        float minx = from.x, maxx = from.x, miny = from.y, maxy = from.y;
+        bool any = false;
+        for (size_t i = 0; i < targets.size(); ++i)
+        {
+            const Vec3& b = targets[i];
+            const Vec3 seg = b - from;
+            Segment& s = segments[i];
+            s.live = clear[i] && dot(seg, seg) >= 1e-6f;
+            if (!s.live)
+            {
+                continue;
+            }
+            any = true;
+            s.invDir = Vec3{inv(seg.x), inv(seg.y), inv(seg.z)};
+            s.minx = std::min(from.x, b.x);
+            s.maxx = std::max(from.x, b.x);
+            s.miny = std::min(from.y, b.y);
+            s.maxy = std::max(from.y, b.y);
+            minx = std::min(minx, s.minx);
+            maxx = std::max(maxx, s.maxx);
+            miny = std::min(miny, s.miny);
+            maxy = std::max(maxy, s.maxy);
+
+            // A fan of targets round one caster crosses the same tile or two over and
+            // over; each is looked up in the cache once per segment but kept once.
+            ForEachSegmentTile(from, b, [&tiles](const TilePtr& tile)
+            {
+                if (std::find(tiles.begin(), tiles.end(), tile) == tiles.end())
+                {
+                    tiles.push_back(tile);
+                }
+            });
+        }
+        if (!any)
+        {
+            return;
+        }
+        if (TilePtr global = GlobalWmo())
+        {
+            tiles.push_back(std::move(global));
+        }
+
+        for (const TilePtr& tile : tiles)
+        {
+            for (const StaticInstance& inst : tile->instances)
+            {
+                const Aabb& wb = inst.worldBounds;
+                if (!inst.model || inst.model->Empty() || wb.hi.x < minx ||
+                    wb.lo.x > maxx || wb.hi.y < miny || wb.lo.y > maxy)
+                {
+                    continue;
+                }
+
+                // The shared origin goes into this model's space once, not once per target.
+                bool haveOrigin = false;
+                Vec3 originLocal;
+                for (size_t i = 0; i < targets.size(); ++i)
+                {
+                    const Segment& s = segments[i];
+                    if (!s.live || !clear[i] || wb.hi.x < s.minx || wb.lo.x > s.maxx ||
+                        wb.hi.y < s.miny || wb.lo.y > s.maxy ||
+                        !wb.intersectsRay(from, s.invDir, 1.0f))
+                    {
+                        continue;
+                    }
+                    if (!haveOrigin)
+                    {
+                        originLocal = inst.xf.worldToLocal(from);
+                        haveOrigin = true;
+                    }
+                    const Vec3 dirLocal = inst.xf.worldToLocal(targets[i]) - originLocal;
+                    if (auto t = inst.model->RaycastNearest(originLocal, dirLocal, 1.0f))
+                    {
+                        if (*t >= 0.f)
+                        {
+                            clear[i] = 0;
+                        }
+                    }
+                }
+            }
+        }
+    }
+
     uint16_t FusedTerrain::GetAreaId(float x, float y) const
     {
         TilePtr tile = TileAt(x, y);
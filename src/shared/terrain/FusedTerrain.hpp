@@ -73,6 +73,17 @@ namespace world::terrain
         bool IsInLineOfSight(float x1, float y1, float z1, float x2, float y2,
                              float z2) const;
 
+        // The same question from one point to many -- an AoE, or a pack checking a
+        // raid. `clear` is sized to `targets`; an entry still set is cleared when its
+        // segment is blocked and an entry already zero is skipped, so the static and
+        // dynamic worlds can be asked in turn. The tiles are gathered once for the whole
+        // fan and each instance takes the shared origin into model space once: forty
+        // targets cost one gather, not forty. Each answer is the one the single query
+        // gives cast the same way, from `from` to the target; asked from the target
+        // back, a one-sided face can answer differently.
+        void IsInLineOfSight(const Vec3& from, const std::vector<Vec3>& targets,
+                             std::vector<uint8_t>& clear) const;
+
         // AreaTable.dbc id of the MCNK chunk under (x,y), or 0 when unknown.
         uint16_t GetAreaId(float x, float y) const;
 
@@ -101,6 +112,10 @@ namespace world::terrain
         TilePtr LoadCell(int tx, int ty) const;
         void EvictTile(int tx, int ty) const;
 
+        // Every resident tile the segment's XY projection crosses, each once in a row.
+        template <typename F>
+        void ForEachSegmentTile(const Vec3& a, const Vec3& b, F&& visit) const;
+
         void CollectSegmentInstances(const Vec3& a, const Vec3& b,
                                      std::vector<const StaticInstance*>& out,
                                      std::vector<TilePtr>& keepAlive) const;
@@ -0,0 +1,110 @@
+#include "terrain/MappedFile.hpp"
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace world::terrain
+{
+#ifdef _WIN32
+    std::shared_ptr<const MappedFile> MappedFile::Open(const std::string& path)
+    {
+        // FILE_SHARE_DELETE so a rebake can still rename a new tile over this one.
+        HANDLE file = CreateFileA(path.c_str(), GENERIC_READ,
+                                  FILE_SHARE_READ | FILE_SHARE_DELETE, nullptr,
+                                  OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE)
+        {
+            return nullptr;
+        }
+
+        LARGE_INTEGER size{};
+        if (!GetFileSizeEx(file, &size) || size.QuadPart <= 0)
+        {
+            CloseHandle(file);
+            return nullptr;
+        }
+
+        HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        const void* view = mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+        if (!view)
+        {
+            if (mapping)
+            {
+                CloseHandle(mapping);
+            }
+            CloseHandle(file);
+            return nullptr;
+        }
+
+        std::shared_ptr<MappedFile> mapped(new MappedFile());
+        mapped->m_data = static_cast<const uint8_t*>(view);
+        mapped->m_size = size_t(size.QuadPart);
+        mapped->m_file = file;
+        mapped->m_mapping = mapping;
+        return mapped;
+    }
+
+    MappedFile::~MappedFile()
+    {
+        if (m_data)
+        {
+            UnmapViewOfFile(m_data);
+        }
+        if (m_mapping)
+        {
+            CloseHandle(m_mapping);
+        }
+        if (m_file)
+        {
+            CloseHandle(m_file);
+        }
+    }
+#else
+    std::shared_ptr<const MappedFile> MappedFile::Open(const std::string& path)
+    {
+        const int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0)
+        {
+            return nullptr;
+        }
+
+        struct stat st{};
+        if (::fstat(fd, &st) != 0 || st.st_size <= 0)
+        {
+            ::close(fd);
+            return nullptr;
+        }
+
+        // The mapping holds its own reference to the file; the descriptor is not needed
+        // past this point.
+        void* view = ::mmap(nullptr, size_t(st.st_size), PROT_READ, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (view == MAP_FAILED)
+        {
+            return nullptr;
+        }
+
+        std::shared_ptr<MappedFile> mapped(new MappedFile());
+        mapped->m_data = static_cast<const uint8_t*>(view);
+        mapped->m_size = size_t(st.st_size);
+        return mapped;
+    }
+
+    MappedFile::~MappedFile()
+    {
+        if (m_data)
+        {
+            ::munmap(const_cast<uint8_t*>(m_data), m_size);
+        }
+    }
+#endif
+}
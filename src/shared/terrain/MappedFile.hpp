@@ -0,0 +1,43 @@
+#pragma once
+
+// A whole file mapped read-only. A tile served from one of these is queried in place:
+// every process serving the same map shares the one copy in the page cache, none of it
+// counts against a process's private memory, and dropping the last reference -- which
+// is all an eviction does -- unmaps it.
+//
+// A mapped file must never be rewritten in place: truncating it under a reader turns
+// that reader's next page fault into a SIGBUS. WriteTile replaces a tile by renaming a
+// new file over it, which leaves the old inode, and so every existing mapping, intact.
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace world::terrain
+{
+    class MappedFile
+    {
+    public:
+        // nullptr when the file is missing, empty, or cannot be mapped.
+        static std::shared_ptr<const MappedFile> Open(const std::string& path);
+
+        ~MappedFile();
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        const uint8_t* Data() const { return m_data; }
+        size_t Size() const { return m_size; }
+
+    private:
+        MappedFile() = default;
+
+        const uint8_t* m_data = nullptr;
+        size_t m_size = 0;
+#ifdef _WIN32
+        void* m_file = nullptr;
+        void* m_mapping = nullptr;
+#endif
+    };
+}
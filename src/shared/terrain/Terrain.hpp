@@ -49,6 +49,25 @@ namespace world::terrain
         int32_t adtId = 0;
     };
 
+    // A height grid read in place from a mapped tile: 16-bit steps above `base`, or raw
+    // floats where the baker found the grid's range too wide to quantise within its
+    // tolerance. Decoding a tile into vectors goes through the same operator[], so a
+    // mapped tile and a decoded one answer with the same floats.
+    struct PackedGrid
+    {
+        const uint16_t* steps = nullptr;
+        const float* raw = nullptr;
+        float base = 0.f;
+        float step = 0.f;
+
+        bool Empty() const { return !steps && !raw; }
+
+        float operator[](size_t i) const
+        {
+            return steps ? base + step * float(steps[i]) : raw[i];
+        }
+    };
+
     class TerrainTile
     {
     public:
@@ -70,10 +89,26 @@ namespace world::terrain
 
         std::vector<StaticInstance> instances;
 
+        // What MapTile fills instead of the grid vectors above, which it leaves empty: the
+        // grids are read in place from the mapped file, and `backing` keeps the mapping
+        // alive for as long as the tile is. Both masks are one bit per cell.
+        struct MappedGrids
+        {
+            PackedGrid v9;
+            PackedGrid v8;
+            PackedGrid liquidHeight;
+            const uint8_t* liquidShowBits = nullptr;
+            const uint8_t* liquidDeepBits = nullptr;
+            const uint8_t* liquidKind = nullptr;
+            const uint16_t* liquidEntry = nullptr;
+        };
+        MappedGrids mapped;
+        std::shared_ptr<const void> backing;
+
         // Mirrors the reference GridMap: four triangles meeting at the V8 centre.
         std::optional<float> TerrainHeight(float x, float y) const
         {
-            if (!hasTerrain || v8.empty() || v9.empty())
+            if (!HasHeights())
             {
                 return std::nullopt;
             }
@@ -89,8 +124,8 @@ namespace world::terrain
             const float fx = gx - std::floor(gx);
             const float fy = gy - std::floor(gy);
 
-            auto V9 = [&](int a, int b) { return v9[a * V9_SIDE + b]; };
-            auto V8 = [&](int a, int b) { return v8[a * GRID_PER_TILE + b]; };
+            auto V9 = [&](int a, int b) { return V9At(a * V9_SIDE + b); };
+            auto V8 = [&](int a, int b) { return V8At(a * GRID_PER_TILE + b); };
 
             float a, b, c;
             if (fx + fy < 1.f)
@@ -132,7 +167,7 @@ namespace world::terrain
 
         std::optional<LiquidInfo> LiquidAt(float x, float y) const
         {
-            if (!hasLiquid || liquidHeight.empty() || liquidShow.empty())
+            if (!HasLiquidGrid())
             {
                 return std::nullopt;
             }
@@ -141,23 +176,22 @@ namespace world::terrain
             const int ix = static_cast<int>(gx) & (GRID_PER_TILE - 1);
             const int iy = static_cast<int>(gy) & (GRID_PER_TILE - 1);
             const int cell = ix * GRID_PER_TILE + iy;
-            if (!liquidShow[cell])
+            if (!LiquidShown(cell))
             {
                 return std::nullopt;
             }
 
             const float fx = gx - std::floor(gx);
             const float fy = gy - std::floor(gy);
-            auto LH = [&](int a, int b) { return liquidHeight[a * V9_SIDE + b]; };
+            auto LH = [&](int a, int b) { return LiquidHeightAt(a * V9_SIDE + b); };
             const float top = LH(ix, iy) * (1 - fx) + LH(ix + 1, iy) * fx;
             const float bot = LH(ix, iy + 1) * (1 - fx) + LH(ix + 1, iy + 1) * fx;
 
             LiquidInfo info;
             info.level = top * (1 - fy) + bot * fy;
-            info.kind = liquidKind.empty() ? LiquidKind::Water
-                                           : static_cast<LiquidKind>(liquidKind[cell]);
-            info.entry = liquidEntry.empty() ? uint16_t(0) : liquidEntry[cell];
-            info.deep = !liquidDeep.empty() && liquidDeep[cell] != 0;
+            info.kind = LiquidKindAt(cell);
+            info.entry = LiquidEntryAt(cell);
+            info.deep = LiquidDeepAt(cell);
             return info;
         }
 
@@ -172,6 +206,77 @@ namespace world::terrain
         }
 
     private:
+        static bool Bit(const uint8_t* bits, int i) { return (bits[i >> 3] >> (i & 7)) & 1u; }
+
+        // A tile is either decoded or mapped, never partly both, so an empty vector means
+        // the mapped grid is the one to read.
+        bool HasHeights() const
+        {
+            if (!hasTerrain)
+            {
+                return false;
+            }
+            if (!v9.empty() || !v8.empty())
+            {
+                return !v9.empty() && !v8.empty();
+            }
+            return !mapped.v9.Empty() && !mapped.v8.Empty();
+        }
+
+        bool HasLiquidGrid() const
+        {
+            if (!hasLiquid)
+            {
+                return false;
+            }
+            if (!liquidHeight.empty() || !liquidShow.empty())
+            {
+                return !liquidHeight.empty() && !liquidShow.empty();
+            }
+            return !mapped.liquidHeight.Empty() && mapped.liquidShowBits;
+        }
+
+        float V9At(int i) const { return v9.empty() ? mapped.v9[i] : v9[i]; }
+        float V8At(int i) const { return v8.empty() ? mapped.v8[i] : v8[i]; }
+
+        float LiquidHeightAt(int i) const
+        {
+            return liquidHeight.empty() ? mapped.liquidHeight[i] : liquidHeight[i];
+        }
+
+        bool LiquidShown(int cell) const
+        {
+            return liquidShow.empty() ? Bit(mapped.liquidShowBits, cell) : liquidShow[cell] != 0;
+        }
+
+        LiquidKind LiquidKindAt(int cell) const
+        {
+            if (!liquidKind.empty())
+            {
+                return static_cast<LiquidKind>(liquidKind[cell]);
+            }
+            return mapped.liquidKind ? static_cast<LiquidKind>(mapped.liquidKind[cell])
+                                     : LiquidKind::Water;
+        }
+
+        uint16_t LiquidEntryAt(int cell) const
+        {
+            if (!liquidEntry.empty())
+            {
+                return liquidEntry[cell];
+            }
+            return mapped.liquidEntry ? mapped.liquidEntry[cell] : uint16_t(0);
+        }
+
+        bool LiquidDeepAt(int cell) const
+        {
+            if (!liquidDeep.empty())
+            {
+                return liquidDeep[cell] != 0;
+            }
+            return mapped.liquidDeepBits && Bit(mapped.liquidDeepBits, cell);
+        }
+
         // Each of the mask's 16 bits covers a 2x2 block of the chunk's 8x8 height cells.
         bool IsHole(int ix, int iy) const
         {
@@ -3,10 +3,15 @@
 #include <vector>
 #include "terrain/TileSerializer.hpp"
 #include "terrain/CollisionModel.hpp"
+#include "terrain/MappedFile.hpp"
 #include "terrain/WmoModel.hpp"
 
+#include <algorithm>
 #include <array>
+#include <cmath>
 #include <cstdio>
+#include <cstring>
+#include <filesystem>
 #include <unordered_map>
 
 namespace world::terrain
@@ -14,42 +19,173 @@ namespace world::terrain
     namespace
     {
         constexpr uint32_t MAGIC = 0x30474E4D;  // "MNG0" in file order
-        constexpr uint32_t VERSION = 1;
+
+        // 3: the height and liquid grids move out of the stream into aligned sections at
+        //    fixed offsets, heights quantised and masks bit-packed, so MapTile can read
+        //    them in place.
+        // 2: models carry the collapsed four-wide BVH instead of the binary one.
+        // Versions 1 and 2 are still read -- a binary tree is collapsed at load, a stream
+        // grid decoded -- and UpgradeTile rewrites them, so a bake is never forced just
+        // for this.
+        constexpr uint32_t VERSION = TILE_FORMAT_VERSION;
+        constexpr uint32_t VERSION_WIDE_BVH = 2;
+        constexpr uint32_t VERSION_BINARY_BVH = 1;
 
         constexpr uint32_t MAX_MODELS = 1u << 20;
         constexpr uint32_t MAX_INSTANCES = 1u << 22;
 
-        // A count is only believable if the file still holds that many elements. A fixed
-        // ceiling is not enough: it still lets a corrupt header reserve hundreds of
-        // megabytes before the short read is noticed, and on an overcommitting kernel
-        // that reservation succeeds, so the guard never fires and the test that was
-        // supposed to prove it stays green either way. Measuring against the actual file
-        // makes the allocation impossible rather than merely unlikely.
-        long RemainingBytes(std::FILE* f)
+        constexpr size_t V9_COUNT = size_t(V9_SIDE) * V9_SIDE;
+        constexpr size_t CELL_COUNT = size_t(GRID_PER_TILE) * GRID_PER_TILE;
+
+        // One grid of a version 3 tile. POD, written raw: do not reorder or resize.
+        struct Section
         {
-            const long here = std::ftell(f);
-            if (here < 0 || std::fseek(f, 0, SEEK_END) != 0)
+            uint32_t offset = 0;   ///< from the start of the file
+            uint32_t count = 0;    ///< elements, not bytes; 0 = the tile has none
+            uint8_t encoding = 0;
+            uint8_t pad[3] = {};
+            float base = 0.f;      ///< ENC_STEPS only
+            float step = 0.f;      ///< ENC_STEPS only
+        };
+        static_assert(sizeof(Section) == 20, "Section is written raw into the tile");
+
+        enum Encoding : uint8_t
+        {
+            ENC_NONE = 0,
+            ENC_F32 = 1,
+            ENC_STEPS = 2,   ///< uint16 steps above base
+            ENC_BITS = 3,
+            ENC_U8 = 4,
+            ENC_U16 = 5,
+        };
+
+        enum SectionId
+        {
+            S_V9,
+            S_V8,
+            S_LIQUID_HEIGHT,
+            S_LIQUID_SHOW,
+            S_LIQUID_DEEP,
+            S_LIQUID_KIND,
+            S_LIQUID_ENTRY,
+            S_COUNT
+        };
+
+        // Every section starts on this boundary, so a mapped tile can point straight at
+        // its floats. The mapping itself is page-aligned.
+        constexpr uint32_t SECTION_ALIGN = 8;
+
+        size_t SectionBytes(const Section& s)
+        {
+            switch (s.encoding)
+            {
+                case ENC_F32:   return size_t(s.count) * 4;
+                case ENC_STEPS: return size_t(s.count) * 2;
+                case ENC_BITS:  return (size_t(s.count) + 7) / 8;
+                case ENC_U8:    return size_t(s.count);
+                case ENC_U16:   return size_t(s.count) * 2;
+                default:        return 0;
+            }
+        }
+
+        // Quantises a height grid to 16-bit steps over its own range when every height
+        // comes back within TILE_HEIGHT_TOLERANCE, and stores raw floats otherwise -- a
+        // single sentinel deep below the rest must not flatten the whole grid.
+        Section EncodeHeights(const std::vector<float>& h, std::vector<uint8_t>& out)
+        {
+            Section s;
+            if (h.empty())
             {
-                return -1;
+                return s;
             }
-            const long end = std::ftell(f);
-            if (end < 0 || std::fseek(f, here, SEEK_SET) != 0)
+            s.count = uint32_t(h.size());
+
+            bool finite = true;
+            float lo = h[0], hi = h[0];
+            for (float v : h)
             {
-                return -1;
+                finite = finite && std::isfinite(v);
+                lo = std::min(lo, v);
+                hi = std::max(hi, v);
             }
-            return end - here;
+
+            if (finite)
+            {
+                PackedGrid grid;
+                grid.base = lo;
+                grid.step = (hi - lo) / 65535.f;
+                std::vector<uint16_t> steps(h.size(), 0);
+                if (grid.step > 0.f)
+                {
+                    for (size_t i = 0; i < h.size(); ++i)
+                    {
+                        const float q = std::round((h[i] - lo) / grid.step);
+                        steps[i] = uint16_t(std::min(std::max(q, 0.f), 65535.f));
+                    }
+                }
+                grid.steps = steps.data();
+
+                bool within = true;
+                for (size_t i = 0; within && i < h.size(); ++i)
+                {
+                    within = std::fabs(grid[i] - h[i]) <= TILE_HEIGHT_TOLERANCE;
+                }
+                if (within)
+                {
+                    s.encoding = ENC_STEPS;
+                    s.base = grid.base;
+                    s.step = grid.step;
+                    out.resize(steps.size() * 2);
+                    std::memcpy(out.data(), steps.data(), out.size());
+                    return s;
+                }
+            }
+
+            s.encoding = ENC_F32;
+            out.resize(h.size() * 4);
+            std::memcpy(out.data(), h.data(), out.size());
+            return s;
+        }
+
+        Section EncodeBits(const std::vector<uint8_t>& v, std::vector<uint8_t>& out)
+        {
+            Section s;
+            if (v.empty())
+            {
+                return s;
+            }
+            s.count = uint32_t(v.size());
+            s.encoding = ENC_BITS;
+            out.assign((v.size() + 7) / 8, 0);
+            for (size_t i = 0; i < v.size(); ++i)
+            {
+                if (v[i])
+                {
+                    out[i >> 3] |= uint8_t(1u << (i & 7));
+                }
+            }
+            return s;
         }
 
         template <class T>
-        bool WPod(std::FILE* f, const T& v)
+        Section EncodeRaw(const std::vector<T>& v, uint8_t encoding, std::vector<uint8_t>& out)
         {
-            return std::fwrite(&v, sizeof(T), 1, f) == 1;
+            Section s;
+            if (v.empty())
+            {
+                return s;
+            }
+            s.count = uint32_t(v.size());
+            s.encoding = encoding;
+            out.resize(v.size() * sizeof(T));
+            std::memcpy(out.data(), v.data(), out.size());
+            return s;
         }
 
         template <class T>
-        bool RPod(std::FILE* f, T& v)
+        bool WPod(std::FILE* f, const T& v)
         {
-            return std::fread(&v, sizeof(T), 1, f) == 1;
+            return std::fwrite(&v, sizeof(T), 1, f) == 1;
         }
 
         template <class T>
@@ -63,35 +199,75 @@ namespace world::terrain
             return n == 0 || std::fwrite(v.data(), sizeof(T), n, f) == n;
         }
 
-        template <class T>
-        bool RVec(std::FILE* f, std::vector<T>& v)
-        {
-            uint32_t n = 0;
-            if (std::fread(&n, 4, 1, f) != 1)
-            {
-                return false;
-            }
-            const long left = RemainingBytes(f);
-            if (left < 0 || uint64_t(n) * sizeof(T) > uint64_t(left))
-            {
-                return false;
-            }
-            v.resize(n);
-            return n == 0 || std::fread(v.data(), sizeof(T), n, f) == n;
-        }
-
         template <class T, size_t N>
         bool WArray(std::FILE* f, const std::array<T, N>& a)
         {
             return std::fwrite(a.data(), sizeof(T), N, f) == N;
         }
 
-        template <class T, size_t N>
-        bool RArray(std::FILE* f, std::array<T, N>& a)
+        bool WPad(std::FILE* f, long to)
         {
-            return std::fread(a.data(), sizeof(T), N, f) == N;
+            static const uint8_t zeros[SECTION_ALIGN] = {};
+            const long here = std::ftell(f);
+            return here >= 0 && here <= to &&
+                   std::fwrite(zeros, 1, size_t(to - here), f) == size_t(to - here);
         }
 
+        // Reads are bounded by the mapping, not by a ceiling on each count: a count is
+        // only believable if the file still holds that many elements. A fixed ceiling
+        // still lets a corrupt header reserve hundreds of megabytes before the short read
+        // is noticed, and on an overcommitting kernel that reservation succeeds, so the
+        // guard never fires. Measuring against the bytes actually there makes the
+        // allocation impossible rather than merely unlikely.
+        struct Cursor
+        {
+            const uint8_t* p = nullptr;
+            const uint8_t* end = nullptr;
+
+            size_t Left() const { return size_t(end - p); }
+
+            template <class T>
+            bool Pod(T& v)
+            {
+                if (Left() < sizeof(T))
+                {
+                    return false;
+                }
+                std::memcpy(&v, p, sizeof(T));
+                p += sizeof(T);
+                return true;
+            }
+
+            template <class T>
+            bool Vec(std::vector<T>& v)
+            {
+                uint32_t n = 0;
+                if (!Pod(n) || uint64_t(n) * sizeof(T) > Left())
+                {
+                    return false;
+                }
+                v.resize(n);
+                if (n != 0)
+                {
+                    std::memcpy(v.data(), p, size_t(n) * sizeof(T));
+                }
+                p += size_t(n) * sizeof(T);
+                return true;
+            }
+
+            template <class T, size_t N>
+            bool Array(std::array<T, N>& a)
+            {
+                if (Left() < sizeof(T) * N)
+                {
+                    return false;
+                }
+                std::memcpy(a.data(), p, sizeof(T) * N);
+                p += sizeof(T) * N;
+                return true;
+            }
+        };
+
         bool WriteGroup(std::FILE* f, const WmoModel::Group& g)
         {
             bool ok = WPod(f, g.mogpFlags) && WPod(f, g.groupWmoId);
@@ -107,21 +283,325 @@ namespace world::terrain
             return ok;
         }
 
-        bool ReadGroup(std::FILE* f, WmoModel::Group& g)
+        bool ReadGroup(Cursor& c, WmoModel::Group& g)
         {
-            bool ok = RPod(f, g.mogpFlags) && RPod(f, g.groupWmoId);
+            bool ok = c.Pod(g.mogpFlags) && c.Pod(g.groupWmoId);
             uint8_t hasLiquid = 0;
-            ok = ok && RPod(f, hasLiquid);
+            ok = ok && c.Pod(hasLiquid);
             g.hasLiquid = hasLiquid != 0;
             if (ok && g.hasLiquid)
             {
-                ok = RPod(f, g.liquid.tilesX) && RPod(f, g.liquid.tilesY) &&
-                     RPod(f, g.liquid.corner) && RPod(f, g.liquid.entry) &&
-                     RPod(f, g.liquid.kind) && RVec(f, g.liquid.heights) &&
-                     RVec(f, g.liquid.flags);
+                ok = c.Pod(g.liquid.tilesX) && c.Pod(g.liquid.tilesY) &&
+                     c.Pod(g.liquid.corner) && c.Pod(g.liquid.entry) &&
+                     c.Pod(g.liquid.kind) && c.Vec(g.liquid.heights) &&
+                     c.Vec(g.liquid.flags);
             }
             return ok;
         }
+
+        // Version 1 and 2 grids: length-prefixed vectors, inline in the stream.
+        bool ReadStreamGrids(Cursor& c, TerrainTile& tile)
+        {
+            uint8_t hasTerrain = 0, globalWmo = 0, hasLiquid = 0;
+            const bool ok = c.Pod(tile.tx) && c.Pod(tile.ty) && c.Pod(hasTerrain) &&
+                            c.Pod(globalWmo) && c.Vec(tile.v9) && c.Vec(tile.v8) &&
+                            c.Array(tile.holes) && c.Array(tile.areaIds) &&
+                            c.Pod(hasLiquid) && c.Vec(tile.liquidHeight) &&
+                            c.Vec(tile.liquidShow) && c.Vec(tile.liquidKind) &&
+                            c.Vec(tile.liquidEntry) && c.Vec(tile.liquidDeep);
+            tile.hasTerrain = hasTerrain != 0;
+            tile.isGlobalWmo = globalWmo != 0;
+            tile.hasLiquid = hasLiquid != 0;
+            return ok;
+        }
+
+        // The queries index a grid without bounds checks, so a section is only accepted
+        // with exactly the element count its grid has, in an encoding that grid can hold,
+        // aligned and wholly inside the file.
+        bool SectionValid(const Section& s, SectionId id, size_t fileSize)
+        {
+            if (s.encoding == ENC_NONE)
+            {
+                return s.count == 0;
+            }
+
+            size_t expected = CELL_COUNT;
+            bool encodingOk = false;
+            size_t align = 1;
+            switch (id)
+            {
+                case S_V9:
+                case S_LIQUID_HEIGHT:
+                    expected = V9_COUNT;
+                    [[fallthrough]];
+                case S_V8:
+                    encodingOk = s.encoding == ENC_F32 || s.encoding == ENC_STEPS;
+                    align = s.encoding == ENC_F32 ? 4 : 2;
+                    break;
+                case S_LIQUID_SHOW:
+                case S_LIQUID_DEEP:
+                    encodingOk = s.encoding == ENC_BITS;
+                    break;
+                case S_LIQUID_KIND:
+                    encodingOk = s.encoding == ENC_U8;
+                    break;
+                case S_LIQUID_ENTRY:
+                    encodingOk = s.encoding == ENC_U16;
+                    align = 2;
+                    break;
+                default:
+                    break;
+            }
+            return encodingOk && s.count == expected && s.offset % align == 0 &&
+                   size_t(s.offset) <= fileSize &&
+                   SectionBytes(s) <= fileSize - size_t(s.offset);
+        }
+
+        PackedGrid GridOf(const uint8_t* base, const Section& s)
+        {
+            PackedGrid g;
+            if (s.encoding == ENC_STEPS)
+            {
+                g.steps = reinterpret_cast<const uint16_t*>(base + s.offset);
+                g.base = s.base;
+                g.step = s.step;
+            }
+            else if (s.encoding == ENC_F32)
+            {
+                g.raw = reinterpret_cast<const float*>(base + s.offset);
+            }
+            return g;
+        }
+
+        // Version 3 grids. Pointed at in place when `inPlace`, otherwise decoded into the
+        // tile's vectors through the same PackedGrid a mapped tile reads with.
+        bool ReadSectionGrids(Cursor& c, const MappedFile& file, TerrainTile& tile,
+                              bool inPlace)
+        {
+            uint8_t flags[4] = {};
+            std::array<Section, S_COUNT> sections;
+            uint32_t bodyOffset = 0;
+            if (!c.Pod(tile.tx) || !c.Pod(tile.ty) || !c.Pod(flags) || !c.Array(sections) ||
+                !c.Pod(bodyOffset) || !c.Array(tile.holes) || !c.Array(tile.areaIds))
+            {
+                return false;
+            }
+            tile.hasTerrain = flags[0] != 0;
+            tile.isGlobalWmo = flags[1] != 0;
+            tile.hasLiquid = flags[2] != 0;
+
+            const uint8_t* base = file.Data();
+            for (int i = 0; i < S_COUNT; ++i)
+            {
+                if (!SectionValid(sections[i], SectionId(i), file.Size()))
+                {
+                    return false;
+                }
+            }
+            if (size_t(bodyOffset) > file.Size() || base + bodyOffset < c.p)
+            {
+                return false;
+            }
+            c.p = base + bodyOffset;
+
+            const Section& show = sections[S_LIQUID_SHOW];
+            const Section& deep = sections[S_LIQUID_DEEP];
+            const Section& kind = sections[S_LIQUID_KIND];
+            const Section& entry = sections[S_LIQUID_ENTRY];
+            const uint8_t* showBits = show.count ? base + show.offset : nullptr;
+            const uint8_t* deepBits = deep.count ? base + deep.offset : nullptr;
+            const uint8_t* kinds = kind.count ? base + kind.offset : nullptr;
+            const uint16_t* entries =
+                entry.count ? reinterpret_cast<const uint16_t*>(base + entry.offset) : nullptr;
+
+            if (inPlace)
+            {
+                tile.mapped.v9 = GridOf(base, sections[S_V9]);
+                tile.mapped.v8 = GridOf(base, sections[S_V8]);
+                tile.mapped.liquidHeight = GridOf(base, sections[S_LIQUID_HEIGHT]);
+                tile.mapped.liquidShowBits = showBits;
+                tile.mapped.liquidDeepBits = deepBits;
+                tile.mapped.liquidKind = kinds;
+                tile.mapped.liquidEntry = entries;
+                return true;
+            }
+
+            const auto decodeGrid = [&](SectionId id, std::vector<float>& out)
+            {
+                const PackedGrid g = GridOf(base, sections[id]);
+                out.resize(sections[id].count);
+                for (size_t i = 0; i < out.size(); ++i)
+                {
+                    out[i] = g[i];
+                }
+            };
+            const auto decodeBits = [](const uint8_t* bits, uint32_t count,
+                                       std::vector<uint8_t>& out)
+            {
+                out.resize(count);
+                for (size_t i = 0; i < out.size(); ++i)
+                {
+                    out[i] = (bits[i >> 3] >> (i & 7)) & 1u;
+                }
+            };
+            decodeGrid(S_V9, tile.v9);
+            decodeGrid(S_V8, tile.v8);
+            decodeGrid(S_LIQUID_HEIGHT, tile.liquidHeight);
+            decodeBits(showBits, show.count, tile.liquidShow);
+            decodeBits(deepBits, deep.count, tile.liquidDeep);
+            tile.liquidKind.assign(kinds, kinds + kind.count);
+            tile.liquidEntry.resize(entry.count);
+            if (entry.count)
+            {
+                std::memcpy(tile.liquidEntry.data(), entries, size_t(entry.count) * 2);
+            }
+            return true;
+        }
+
+        // The one parser behind ReadTile and MapTile. `backing` non-null maps the grids
+        // in place and keeps the mapping on the tile; null decodes everything.
+        std::shared_ptr<TerrainTile> ParseTile(const MappedFile& file,
+                                               std::shared_ptr<const MappedFile> backing)
+        {
+            Cursor c{file.Data(), file.Data() + file.Size()};
+
+            uint32_t magic = 0, version = 0;
+            if (!c.Pod(magic) || !c.Pod(version) || magic != MAGIC ||
+                (version != VERSION && version != VERSION_WIDE_BVH &&
+                 version != VERSION_BINARY_BVH))
+            {
+                return nullptr;
+            }
+            const bool binaryBvh = version == VERSION_BINARY_BVH;
+
+            auto tile = std::make_shared<TerrainTile>();
+            bool ok = version == VERSION
+                          ? ReadSectionGrids(c, file, *tile, backing != nullptr)
+                          : ReadStreamGrids(c, *tile);
+
+            // The tree as stored: binary trees are collapsed by the model constructor,
+            // wide ones are checked first, since a corrupt child index would be walked
+            // blindly.
+            auto readTree = [&](const TriSoup& soup, Bvh& binary, WideBvh& wide)
+            {
+                if (binaryBvh)
+                {
+                    std::vector<Bvh::Node> nodes;
+                    if (!c.Vec(nodes))
+                    {
+                        return false;
+                    }
+                    binary.Adopt(std::move(nodes));
+                    return true;
+                }
+                std::vector<WideBvh::Node> nodes;
+                if (!c.Vec(nodes))
+                {
+                    return false;
+                }
+                wide.Adopt(std::move(nodes));
+                return wide.Valid(soup.tris.size());
+            };
+
+            uint32_t nModels = 0;
+            ok = ok && c.Pod(nModels) && nModels <= MAX_MODELS;
+
+            std::vector<std::shared_ptr<const ICollisionModel>> models;
+            if (ok)
+            {
+                models.resize(nModels);
+            }
+
+            for (uint32_t i = 0; ok && i < nModels; ++i)
+            {
+                uint8_t kind = 0;
+                if (!c.Pod(kind))
+                {
+                    ok = false;
+                    break;
+                }
+
+                TriSoup soup;
+                Bvh binary;
+                WideBvh wide;
+
+                if (kind == uint8_t(ModelKind::Wmo))
+                {
+                    uint32_t rootId = 0, nGroups = 0;
+                    ok = c.Pod(rootId) && c.Pod(nGroups) && nGroups <= MAX_MODELS;
+                    std::vector<WmoModel::Group> groups(ok ? nGroups : 0);
+                    for (uint32_t g = 0; ok && g < nGroups; ++g)
+                    {
+                        ok = ReadGroup(c, groups[g]);
+                    }
+
+                    std::vector<uint16_t> triGroup;
+                    ok = ok && c.Vec(soup.verts) && c.Vec(soup.tris) && c.Vec(triGroup) &&
+                         readTree(soup, binary, wide) && triGroup.size() == soup.tris.size();
+                    if (ok && binaryBvh)
+                    {
+                        models[i] = std::make_shared<WmoModel>(std::move(soup),
+                                                               std::move(triGroup),
+                                                               std::move(groups), rootId,
+                                                               std::move(binary));
+                    }
+                    else if (ok)
+                    {
+                        models[i] = std::make_shared<WmoModel>(std::move(soup),
+                                                               std::move(triGroup),
+                                                               std::move(groups), rootId,
+                                                               std::move(wide));
+                    }
+                }
+                else if (kind == uint8_t(ModelKind::Mesh))
+                {
+                    ok = c.Vec(soup.verts) && c.Vec(soup.tris) && readTree(soup, binary, wide);
+                    if (ok && binaryBvh)
+                    {
+                        models[i] = std::make_shared<CollisionModel>(std::move(soup),
+                                                                     std::move(binary));
+                    }
+                    else if (ok)
+                    {
+                        models[i] = std::make_shared<CollisionModel>(std::move(soup),
+                                                                     std::move(wide));
+                    }
+                }
+                else
+                {
+                    ok = false;
+                }
+            }
+
+            uint32_t nInstances = 0;
+            ok = ok && c.Pod(nInstances) && nInstances <= MAX_INSTANCES;
+            for (uint32_t i = 0; ok && i < nInstances; ++i)
+            {
+                StaticInstance inst;
+                uint32_t idx = 0;
+                ok = c.Pod(inst.xf.pos) && c.Array(inst.xf.rot.m) && c.Pod(inst.xf.scale) &&
+                     c.Pod(inst.worldBounds.lo) && c.Pod(inst.worldBounds.hi) &&
+                     c.Pod(idx) && c.Pod(inst.adtId);
+                if (ok)
+                {
+                    if (idx < models.size())
+                    {
+                        inst.model = models[idx];
+                    }
+                    tile->instances.push_back(std::move(inst));
+                }
+            }
+
+            if (!ok)
+            {
+                return nullptr;
+            }
+            if (backing && version == VERSION)
+            {
+                tile->backing = std::move(backing);
+            }
+            return tile;
+        }
     }
 
     std::string TileFileName(uint32_t mapId, int tx, int ty)
@@ -147,23 +627,64 @@ namespace world::terrain
 
     bool WriteTile(const TerrainTile& tile, const std::string& path)
     {
-        std::FILE* f = std::fopen(path.c_str(), "wb");
+        // Written beside the target and renamed over it. A server may have the old tile
+        // mapped, and truncating a mapped file is a SIGBUS in that server; a rename
+        // leaves its mapping on the old inode. It also means a killed bake never leaves
+        // half a tile under the real name.
+        const std::string next = path + ".new";
+        std::FILE* f = std::fopen(next.c_str(), "wb");
         if (!f)
         {
             return false;
         }
 
-        const uint8_t hasTerrain = tile.hasTerrain ? 1 : 0;
-        const uint8_t globalWmo = tile.isGlobalWmo ? 1 : 0;
-        const uint8_t hasLiquid = tile.hasLiquid ? 1 : 0;
+        std::array<Section, S_COUNT> sections;
+        std::array<std::vector<uint8_t>, S_COUNT> payload;
+        sections[S_V9] = EncodeHeights(tile.v9, payload[S_V9]);
+        sections[S_V8] = EncodeHeights(tile.v8, payload[S_V8]);
+        sections[S_LIQUID_HEIGHT] = EncodeHeights(tile.liquidHeight, payload[S_LIQUID_HEIGHT]);
+        sections[S_LIQUID_SHOW] = EncodeBits(tile.liquidShow, payload[S_LIQUID_SHOW]);
+        sections[S_LIQUID_DEEP] = EncodeBits(tile.liquidDeep, payload[S_LIQUID_DEEP]);
+        sections[S_LIQUID_KIND] = EncodeRaw(tile.liquidKind, ENC_U8, payload[S_LIQUID_KIND]);
+        sections[S_LIQUID_ENTRY] =
+            EncodeRaw(tile.liquidEntry, ENC_U16, payload[S_LIQUID_ENTRY]);
+
+        const uint8_t flags[4] = {uint8_t(tile.hasTerrain ? 1 : 0),
+                                  uint8_t(tile.isGlobalWmo ? 1 : 0),
+                                  uint8_t(tile.hasLiquid ? 1 : 0), 0};
+
+        // The sections follow the fixed header, each aligned, and the stream of models
+        // and instances follows them.
+        const auto alignUp = [](uint32_t v)
+        {
+            return (v + SECTION_ALIGN - 1) & ~(SECTION_ALIGN - 1);
+        };
+        uint32_t offset = uint32_t(4 + 4 + 4 + 4 + sizeof(flags) + sizeof(sections) + 4 +
+                                   sizeof(tile.holes) + sizeof(tile.areaIds));
+        for (int i = 0; i < S_COUNT; ++i)
+        {
+            if (sections[i].encoding != ENC_NONE)
+            {
+                offset = alignUp(offset);
+                sections[i].offset = offset;
+                offset += uint32_t(payload[i].size());
+            }
+        }
+        const uint32_t bodyOffset = alignUp(offset);
 
         bool ok = WPod(f, MAGIC) && WPod(f, VERSION) && WPod(f, tile.tx) &&
-                  WPod(f, tile.ty) && WPod(f, hasTerrain) && WPod(f, globalWmo) &&
-                  WVec(f, tile.v9) && WVec(f, tile.v8) && WArray(f, tile.holes) &&
-                  WArray(f, tile.areaIds) && WPod(f, hasLiquid) &&
-                  WVec(f, tile.liquidHeight) && WVec(f, tile.liquidShow) &&
-                  WVec(f, tile.liquidKind) && WVec(f, tile.liquidEntry) &&
-                  WVec(f, tile.liquidDeep);
+                  WPod(f, tile.ty) && WPod(f, flags) && WArray(f, sections) &&
+                  WPod(f, bodyOffset) && WArray(f, tile.holes) && WArray(f, tile.areaIds);
+        for (int i = 0; ok && i < S_COUNT; ++i)
+        {
+            if (sections[i].encoding != ENC_NONE)
+            {
+                ok = WPad(f, long(sections[i].offset)) &&
+                     std::fwrite(payload[i].data(), 1, payload[i].size(), f) ==
+                         payload[i].size();
+            }
+        }
+        ok = ok && WPad(f, long(bodyOffset));
 
         // Deduped model table: a WMO instanced fifty times is written once and the
         // instances index it.
@@ -217,125 +738,63 @@ namespace world::terrain
                  WPod(f, inst.worldBounds.hi) && WPod(f, idx) && WPod(f, inst.adtId);
         }
 
-        std::fclose(f);
+        ok = std::fclose(f) == 0 && ok;
         if (!ok)
         {
-            std::remove(path.c_str());
+            std::remove(next.c_str());
+            return false;
         }
-        return ok;
-    }
 
-    std::shared_ptr<TerrainTile> ReadTile(const std::string& path)
-    {
-        std::FILE* f = std::fopen(path.c_str(), "rb");
-        if (!f)
+        std::error_code ec;
+        std::filesystem::rename(next, path, ec);
+        if (ec)
         {
-            return nullptr;
-        }
-
-        uint32_t magic = 0, version = 0;
-        if (!RPod(f, magic) || !RPod(f, version) || magic != MAGIC || version != VERSION)
-        {
-            std::fclose(f);
-            return nullptr;
+            std::filesystem::remove(next, ec);
+            return false;
         }
+        return true;
+    }
 
-        auto tile = std::make_shared<TerrainTile>();
-        uint8_t hasTerrain = 0, globalWmo = 0, hasLiquid = 0;
-
-        bool ok = RPod(f, tile->tx) && RPod(f, tile->ty) && RPod(f, hasTerrain) &&
-                  RPod(f, globalWmo) && RVec(f, tile->v9) && RVec(f, tile->v8) &&
-                  RArray(f, tile->holes) && RArray(f, tile->areaIds) &&
-                  RPod(f, hasLiquid) && RVec(f, tile->liquidHeight) &&
-                  RVec(f, tile->liquidShow) && RVec(f, tile->liquidKind) &&
-                  RVec(f, tile->liquidEntry) && RVec(f, tile->liquidDeep);
-
-        tile->hasTerrain = hasTerrain != 0;
-        tile->isGlobalWmo = globalWmo != 0;
-        tile->hasLiquid = hasLiquid != 0;
-
-        uint32_t nModels = 0;
-        ok = ok && RPod(f, nModels) && nModels <= MAX_MODELS;
+    std::shared_ptr<TerrainTile> ReadTile(const std::string& path)
+    {
+        // The mapping is dropped on return; nothing of the tile points into it.
+        const std::shared_ptr<const MappedFile> file = MappedFile::Open(path);
+        return file ? ParseTile(*file, nullptr) : nullptr;
+    }
 
-        std::vector<std::shared_ptr<const ICollisionModel>> models;
-        if (ok)
-        {
-            models.resize(nModels);
-        }
+    std::shared_ptr<TerrainTile> MapTile(const std::string& path)
+    {
+        const std::shared_ptr<const MappedFile> file = MappedFile::Open(path);
+        return file ? ParseTile(*file, file) : nullptr;
+    }
 
-        for (uint32_t i = 0; ok && i < nModels; ++i)
+    TileUpgrade UpgradeTile(const std::string& path)
+    {
+        uint32_t magic = 0, version = 0;
         {
-            uint8_t kind = 0;
-            if (!RPod(f, kind))
-            {
-                ok = false;
-                break;
-            }
-
-            TriSoup soup;
-            std::vector<Bvh::Node> nodes;
-
-            if (kind == uint8_t(ModelKind::Wmo))
-            {
-                uint32_t rootId = 0, nGroups = 0;
-                ok = RPod(f, rootId) && RPod(f, nGroups) && nGroups <= MAX_MODELS;
-                std::vector<WmoModel::Group> groups(ok ? nGroups : 0);
-                for (uint32_t g = 0; ok && g < nGroups; ++g)
-                {
-                    ok = ReadGroup(f, groups[g]);
-                }
-
-                std::vector<uint16_t> triGroup;
-                ok = ok && RVec(f, soup.verts) && RVec(f, soup.tris) &&
-                     RVec(f, triGroup) && RVec(f, nodes) &&
-                     triGroup.size() == soup.tris.size();
-                if (ok)
-                {
-                    Bvh bvh;
-                    bvh.Adopt(std::move(nodes));
-                    models[i] = std::make_shared<WmoModel>(std::move(soup),
-                                                           std::move(triGroup),
-                                                           std::move(groups), rootId,
-                                                           std::move(bvh));
-                }
-            }
-            else if (kind == uint8_t(ModelKind::Mesh))
+            const std::shared_ptr<const MappedFile> file = MappedFile::Open(path);
+            if (!file)
             {
-                ok = RVec(f, soup.verts) && RVec(f, soup.tris) && RVec(f, nodes);
-                if (ok)
-                {
-                    Bvh bvh;
-                    bvh.Adopt(std::move(nodes));
-                    models[i] = std::make_shared<CollisionModel>(std::move(soup),
-                                                                 std::move(bvh));
-                }
+                return TileUpgrade::Unreadable;
             }
-            else
+            Cursor c{file->Data(), file->Data() + file->Size()};
+            if (!c.Pod(magic) || !c.Pod(version) || magic != MAGIC)
             {
-                ok = false;
+                return TileUpgrade::Unreadable;
             }
         }
-
-        uint32_t nInstances = 0;
-        ok = ok && RPod(f, nInstances) && nInstances <= MAX_INSTANCES;
-        for (uint32_t i = 0; ok && i < nInstances; ++i)
+        if (version == VERSION)
         {
-            StaticInstance inst;
-            uint32_t idx = 0;
-            ok = RPod(f, inst.xf.pos) && RArray(f, inst.xf.rot.m) &&
-                 RPod(f, inst.xf.scale) && RPod(f, inst.worldBounds.lo) &&
-                 RPod(f, inst.worldBounds.hi) && RPod(f, idx) && RPod(f, inst.adtId);
-            if (ok)
-            {
-                if (idx < models.size())
-                {
-                    inst.model = models[idx];
-                }
-                tile->instances.push_back(std::move(inst));
-            }
+            return TileUpgrade::Current;
         }
 
-        std::fclose(f);
-        return ok ? tile : nullptr;
+        const std::shared_ptr<TerrainTile> tile = ReadTile(path);
+        if (!tile)
+        {
+            return TileUpgrade::Unreadable;
+        }
+        // WriteTile replaces the file by rename, so an interrupted run leaves the old
+        // tile -- still readable -- rather than half of a new one.
+        return WriteTile(*tile, path) ? TileUpgrade::Rewritten : TileUpgrade::Failed;
     }
 }
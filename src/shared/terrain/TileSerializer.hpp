@@ -9,6 +9,12 @@
 // Native-endian, same-machine cache, not a portable archive. Magic and version guard
 // the format: ReadTile returns nullptr on any mismatch or truncation, which the
 // caller treats as a miss and rebakes.
+//
+// The height and liquid grids sit in aligned sections of their own -- heights as 16-bit
+// steps over each grid's range, the liquid masks one bit per cell -- so MapTile can
+// leave them in the file and query them in place. Model geometry is decoded either way:
+// its BVH boxes are fitted to the exact vertices, so the soup cannot be quantised
+// without moving triangles out of the boxes that are meant to contain them.
 
 #include "terrain/Terrain.hpp"
 
@@ -17,10 +23,37 @@
 
 namespace world::terrain
 {
+    // The format WriteTile writes. Part of what an incremental bake keys a tile on:
+    // a new format rebakes everything, even from an unchanged client.
+    constexpr uint32_t TILE_FORMAT_VERSION = 3;
+
     bool WriteTile(const TerrainTile& tile, const std::string& path);
 
+    // Heights survive the round trip to within this, in yards. A grid whose range is too
+    // wide for 16-bit steps to meet it is stored as raw floats instead.
+    constexpr float TILE_HEIGHT_TOLERANCE = 1.f / 128.f;
+
+    // Decodes the whole tile into its vectors, which is what the baker and the tools
+    // that edit or re-bake a tile want. The file is not held open afterwards.
     std::shared_ptr<TerrainTile> ReadTile(const std::string& path);
 
+    // The runtime's reader: the grids stay in the file, mapped read-only and shared with
+    // every other process serving the map, and are unmapped with the last reference to
+    // the tile. An older-format tile is decoded as ReadTile would.
+    std::shared_ptr<TerrainTile> MapTile(const std::string& path);
+
+    enum class TileUpgrade
+    {
+        Current,     // already in the current format; not touched
+        Rewritten,   // an older format, rewritten in place
+        Unreadable,  // not a tile, or one no reader understands -- rebake it
+        Failed       // read, but the rewrite could not be written
+    };
+
+    // Brings a tile written by an older, still-readable format version up to the current
+    // one. ReadTile accepts those as they are, so this only saves the conversion at load.
+    TileUpgrade UpgradeTile(const std::string& path);
+
     // Names a tile file. `tx` is the tile index from world X, `ty` from world Y.
     std::string TileFileName(uint32_t mapId, int tx, int ty);
     std::string GlobalWmoFileName(uint32_t mapId);
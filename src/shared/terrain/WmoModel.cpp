@@ -13,12 +13,21 @@ namespace world::terrain
     WmoModel::WmoModel(TriSoup soup, std::vector<uint16_t> triGroup,
                        std::vector<Group> groups, uint32_t rootWmoId, Bvh bvh)
         : m_triGroup(std::move(triGroup)), m_groups(std::move(groups)), m_rootId(rootWmoId)
+    {
+        m_soup = std::move(soup);
+        AdoptBvh(std::move(bvh), &m_triGroup);
+        DeriveWmoBounds();
+    }
+
+    WmoModel::WmoModel(TriSoup soup, std::vector<uint16_t> triGroup,
+                       std::vector<Group> groups, uint32_t rootWmoId, WideBvh bvh)
+        : m_triGroup(std::move(triGroup)), m_groups(std::move(groups)), m_rootId(rootWmoId)
     {
         m_soup = std::move(soup);
         m_bvh = std::move(bvh);
         if (m_bvh.Empty() && !m_soup.tris.empty())
         {
-            m_bvh.Build(m_soup, &m_triGroup, 4);
+            AdoptBvh(Bvh{}, &m_triGroup);
         }
         DeriveWmoBounds();
     }
@@ -42,6 +42,9 @@ namespace world::terrain
         WmoModel(TriSoup soup, std::vector<uint16_t> triGroup, std::vector<Group> groups,
                  uint32_t rootWmoId, Bvh bvh = Bvh{});
 
+        WmoModel(TriSoup soup, std::vector<uint16_t> triGroup, std::vector<Group> groups,
+                 uint32_t rootWmoId, WideBvh bvh);
+
         ModelKind Kind() const override { return ModelKind::Wmo; }
 
         std::optional<LocalLiquid> LiquidLocal(const Vec3& pModel) const override;
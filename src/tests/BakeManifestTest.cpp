@@ -0,0 +1,129 @@
+/**
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2026 MaNGOS <https://www.getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+#include "TestHarness.h"
+
+#include "client/BakeManifest.hpp"
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+using world::terrain::BakeManifest;
+using world::terrain::ContentHash;
+
+namespace
+{
+    // Unique per run, so two test binaries side by side do not share a manifest.
+    struct TempManifest
+    {
+        std::string path;
+        TempManifest() : path((std::filesystem::temp_directory_path() /
+                               ("mangos_manifest_" + std::to_string(std::random_device()()))).string()) {}
+        ~TempManifest() { std::remove(path.c_str()); }
+    };
+
+    uint64_t HashOf(const std::string& a, const std::string& b)
+    {
+        ContentHash hash;
+        hash.Add(a);
+        hash.Add(b);
+        return hash.Value();
+    }
+}
+
+TEST(ContentHashTellsSplitInputsApart)
+{
+    CHECK(HashOf("ab", "c") != HashOf("a", "bc"));
+    CHECK_EQ(HashOf("ab", "c"), HashOf("ab", "c"));
+
+    ContentHash empty;
+    ContentHash zero;
+    zero.Add(uint64_t(0));
+    CHECK(empty.Value() != zero.Value());
+}
+
+TEST(BakeManifestRoundTripsThroughItsFile)
+{
+    TempManifest file;
+    {
+        BakeManifest manifest;
+        CHECK(!manifest.Load(file.path));                   // none yet
+        manifest.Set("t_0_32_48.tile", 0x0123456789ABCDEFull);
+        manifest.Set("w_33.tile", 7);
+        manifest.Set("t_0_1_1.tile", 1);
+        manifest.Erase("t_0_1_1.tile");
+        REQUIRE(manifest.Save(file.path));
+    }
+
+    BakeManifest manifest;
+    REQUIRE(manifest.Load(file.path));
+    CHECK_EQ(manifest.Size(), size_t(2));
+    CHECK(manifest.Matches("t_0_32_48.tile", 0x0123456789ABCDEFull));
+    CHECK(!manifest.Matches("t_0_32_48.tile", 0x0123456789ABCDEEull));
+    CHECK(manifest.Matches("w_33.tile", 7));
+    CHECK(!manifest.Matches("t_0_1_1.tile", 1));
+    CHECK(!std::filesystem::exists(file.path + ".tmp"));
+}
+
+TEST(BakeManifestIgnoresAFileThatIsNotOne)
+{
+    TempManifest file;
+    {
+        std::ofstream out(file.path);
+        out << "t_0_32_48.tile 0000000000000001\n";
+    }
+
+    BakeManifest manifest;
+    manifest.Set("w_33.tile", 7);
+    CHECK(!manifest.Load(file.path));
+    CHECK_EQ(manifest.Size(), size_t(0));                   // and forgets what it held
+}
+
+TEST(BakeManifestTakesUpdatesFromEveryWorker)
+{
+    BakeManifest manifest;
+    std::vector<std::thread> workers;
+    for (int w = 0; w < 4; ++w)
+    {
+        workers.emplace_back([&manifest, w]()
+        {
+            for (int i = 0; i < 500; ++i)
+            {
+                manifest.Set("t_" + std::to_string(w) + "_" + std::to_string(i) + ".tile",
+                             uint64_t(i));
+            }
+        });
+    }
+    for (std::thread& t : workers)
+    {
+        t.join();
+    }
+    CHECK_EQ(manifest.Size(), size_t(2000));
+    CHECK(manifest.Matches("t_3_499.tile", 499));
+}
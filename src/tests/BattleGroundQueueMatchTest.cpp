@@ -0,0 +1,278 @@
+/**
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2026 MaNGOS <https://www.getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+#include "TestHarness.h"
+
+#include "BattleGroundQueueMatch.h"
+#include "Threading/TaskPool.h"
+
+#include <random>
+#include <vector>
+
+/**
+ * @file
+ * @brief The per-bracket match search, and a queue simulator that runs it in parallel.
+ *
+ * The simulator fills every bracket of every queue with synthetic groups and plays
+ * invitation rounds the way BattleGroundMgr::Update does: search,
+ * then mark the selected groups invited. It does so twice, once one bracket after
+ * another and once on a TaskPool, and the two must pick exactly the same groups --
+ * a bracket's search may not depend on anything another bracket's search touches.
+ */
+
+namespace
+{
+    /// Owns the groups and lists of one bracket, the way BattleGroundQueue does.
+    struct Bracket
+    {
+        std::vector<GroupQueueInfo*> Owned;
+        BattleGroundGroupList Groups[BG_QUEUE_GROUP_TYPES_COUNT];
+        BattleGroundBracketMatcher Matcher;
+        uint32 NextPlayer;
+
+        Bracket() : NextPlayer(1)
+        {
+            Matcher.Attach(Groups);
+        }
+
+        Bracket(const Bracket&) = delete;
+        Bracket& operator=(const Bracket&) = delete;
+
+        ~Bracket()
+        {
+            for (size_t i = 0; i < Owned.size(); ++i)
+            {
+                delete Owned[i];
+            }
+        }
+
+        GroupQueueInfo* Add(BattleGroundQueueGroupTypes type, uint32 size, uint32 joinTime)
+        {
+            GroupQueueInfo* ginfo = new GroupQueueInfo();
+            ginfo->GroupTeam = (type == BG_QUEUE_PREMADE_ALLIANCE || type == BG_QUEUE_NORMAL_ALLIANCE) ? ALLIANCE : HORDE;
+            ginfo->BgTypeId = BATTLEGROUND_WS;
+            ginfo->JoinTime = joinTime;
+            ginfo->RemoveInviteTime = 0;
+            ginfo->IsInvitedToBGInstanceGUID = 0;
+            for (uint32 i = 0; i < size; ++i)
+            {
+                ginfo->Players[ObjectGuid(HIGHGUID_PLAYER, NextPlayer++)] = NULL;
+            }
+            Owned.push_back(ginfo);
+            Groups[type].push_back(ginfo);
+            return ginfo;
+        }
+    };
+
+    BattleGroundMatchRules Rules(uint32 minPlayers, uint32 maxPlayers)
+    {
+        BattleGroundMatchRules rules;
+        rules.MinPlayersPerTeam = minPlayers;
+        rules.MaxPlayersPerTeam = maxPlayers;
+        rules.PremadeJoinedBefore = 0;
+        rules.BalancedInvites = false;
+        rules.Testing = false;
+        return rules;
+    }
+
+    uint32 PoolSize(BattleGroundBracketMatcher const& matcher, uint32 teamIndex)
+    {
+        return matcher.GetPool(teamIndex).GetPlayerCount();
+    }
+
+    /// What ApplyMatch does to the queue: the selected groups become invited.
+    void Invite(BattleGroundBracketMatcher const& matcher, uint32 instance)
+    {
+        for (uint32 i = 0; i < PVP_TEAM_COUNT; ++i)
+        {
+            BattleGroundGroupList const& selected = matcher.GetPool(i).SelectedGroups;
+            for (BattleGroundGroupList::const_iterator itr = selected.begin(); itr != selected.end(); ++itr)
+            {
+                (*itr)->IsInvitedToBGInstanceGUID = instance;
+            }
+        }
+    }
+}
+
+TEST(BattleGroundMatchNeedsMinimumOnBothSides)
+{
+    Bracket bracket;
+    bracket.Add(BG_QUEUE_NORMAL_ALLIANCE, 5, 0);
+    bracket.Add(BG_QUEUE_NORMAL_ALLIANCE, 5, 0);
+    bracket.Add(BG_QUEUE_NORMAL_HORDE, 4, 0);
+
+    CHECK_EQ(int(bracket.Matcher.Match(Rules(5, 10))), int(BG_MATCH_NONE));
+
+    bracket.Add(BG_QUEUE_NORMAL_HORDE, 3, 0);
+    CHECK_EQ(int(bracket.Matcher.Match(Rules(5, 10))), int(BG_MATCH_NORMAL));
+    // Each side stops adding once it reaches the minimum.
+    CHECK_EQ(PoolSize(bracket.Matcher, TEAM_INDEX_ALLIANCE), 5u);
+    CHECK_EQ(PoolSize(bracket.Matcher, TEAM_INDEX_HORDE), 7u);
+
+    // Invited groups are no longer candidates.
+    Invite(bracket.Matcher, 1);
+    CHECK_EQ(int(bracket.Matcher.Match(Rules(5, 10))), int(BG_MATCH_NONE));
+}
+
+TEST(BattleGroundMatchTestingAllowsOneSide)
+{
+    Bracket bracket;
+    bracket.Add(BG_QUEUE_NORMAL_HORDE, 1, 0);
+
+    BattleGroundMatchRules rules = Rules(1, 10);
+    CHECK_EQ(int(bracket.Matcher.Match(rules)), int(BG_MATCH_NONE));
+    rules.Testing = true;
+    CHECK_EQ(int(bracket.Matcher.Match(rules)), int(BG_MATCH_NORMAL));
+}
+
+TEST(BattleGroundMatchPrefersPremadeAndExpiresWaitingPremades)
+{
+    Bracket bracket;
+    bracket.Add(BG_QUEUE_PREMADE_ALLIANCE, 8, 100);
+    bracket.Add(BG_QUEUE_PREMADE_HORDE, 6, 100);
+    bracket.Add(BG_QUEUE_NORMAL_HORDE, 2, 100);
+    bracket.Add(BG_QUEUE_NORMAL_HORDE, 2, 100);
+
+    CHECK_EQ(int(bracket.Matcher.Match(Rules(5, 10))), int(BG_MATCH_PREMADE));
+    // The horde premade is topped up from the normal queue to the size of the bigger one.
+    CHECK_EQ(PoolSize(bracket.Matcher, TEAM_INDEX_ALLIANCE), 8u);
+    CHECK_EQ(PoolSize(bracket.Matcher, TEAM_INDEX_HORDE), 8u);
+
+    // A premade without an opponent joins the normal queue once its wait is over.
+    Bracket lonely;
+    GroupQueueInfo* waiting = lonely.Add(BG_QUEUE_PREMADE_ALLIANCE, 5, 100);
+    BattleGroundMatchRules rules = Rules(5, 10);
+    CHECK_EQ(int(lonely.Matcher.Match(rules)), int(BG_MATCH_NONE));
+    CHECK(lonely.Groups[BG_QUEUE_NORMAL_ALLIANCE].empty());
+
+    rules.PremadeJoinedBefore = 101;
+    CHECK_EQ(int(lonely.Matcher.Match(rules)), int(BG_MATCH_NONE));
+    CHECK(lonely.Groups[BG_QUEUE_PREMADE_ALLIANCE].empty());
+    REQUIRE(lonely.Groups[BG_QUEUE_NORMAL_ALLIANCE].size() == 1u);
+    CHECK(lonely.Groups[BG_QUEUE_NORMAL_ALLIANCE].front() == waiting);
+}
+
+TEST(BattleGroundFillFreeSlotsBalancesTeams)
+{
+    Bracket bracket;
+    bracket.Add(BG_QUEUE_NORMAL_ALLIANCE, 5, 0);
+    bracket.Add(BG_QUEUE_NORMAL_ALLIANCE, 1, 0);
+    bracket.Add(BG_QUEUE_NORMAL_HORDE, 1, 0);
+
+    bracket.Matcher.Reset();
+    bracket.Matcher.FillFreeSlots(6, 6, false);
+    CHECK_EQ(PoolSize(bracket.Matcher, TEAM_INDEX_ALLIANCE), 6u);
+    CHECK_EQ(PoolSize(bracket.Matcher, TEAM_INDEX_HORDE), 1u);
+
+    // Balanced invites kick the big alliance group rather than open a 6 to 1 gap.
+    bracket.Matcher.Reset();
+    bracket.Matcher.FillFreeSlots(6, 6, true);
+    CHECK_EQ(PoolSize(bracket.Matcher, TEAM_INDEX_ALLIANCE), 1u);
+    CHECK_EQ(PoolSize(bracket.Matcher, TEAM_INDEX_HORDE), 1u);
+}
+
+TEST(BattleGroundQueueSimulatorPoolMatchesSerial)
+{
+    // Three battleground types times six brackets, the scheduler's worst case.
+    const size_t brackets = 3 * 6;
+    const uint32 groupsPerBracket = 300;
+    const uint32 rounds = 20;
+
+    std::vector<Bracket> serial(brackets);
+    std::vector<Bracket> pooled(brackets);
+    std::vector<BattleGroundMatchRules> rules(brackets);
+
+    std::mt19937 rng(0x5EED);
+    for (size_t b = 0; b < brackets; ++b)
+    {
+        // Warsong and Arathi sized teams side by side.
+        rules[b] = Rules(b % 2 ? 5 : 8, b % 2 ? 10 : 15);
+        rules[b].BalancedInvites = (b % 3) == 0;
+        rules[b].PremadeJoinedBefore = 500;
+        for (uint32 g = 0; g < groupsPerBracket; ++g)
+        {
+            BattleGroundQueueGroupTypes type = BattleGroundQueueGroupTypes(rng() % 20 ? BG_QUEUE_NORMAL_ALLIANCE + rng() % 2 : rng() % 2);
+            uint32 size = type <= BG_QUEUE_PREMADE_HORDE ? 5 + rng() % 6 : 1 + rng() % 5;
+            uint32 joinTime = rng() % 1000;
+            serial[b].Add(type, size, joinTime);
+            pooled[b].Add(type, size, joinTime);
+        }
+    }
+
+    MaNGOS::TaskPool pool;
+    REQUIRE(pool.Activate(4));
+
+    std::vector<BattleGroundMatchResult> serialResult(brackets);
+    std::vector<BattleGroundMatchResult> pooledResult(brackets);
+    uint32 started = 0;
+
+    for (uint32 round = 1; round <= rounds; ++round)
+    {
+        for (size_t b = 0; b < brackets; ++b)
+        {
+            serialResult[b] = serial[b].Matcher.Match(rules[b]);
+        }
+
+        for (size_t b = 0; b < brackets; ++b)
+        {
+            Bracket* bracket = &pooled[b];
+            BattleGroundMatchRules const* bracketRules = &rules[b];
+            BattleGroundMatchResult* result = &pooledResult[b];
+            pool.Schedule([bracket, bracketRules, result]()
+            {
+                *result = bracket->Matcher.Match(*bracketRules);
+            });
+        }
+        pool.Wait();
+
+        // Compare, then invite serially, exactly as BattleGroundMgr::Update applies matches.
+        for (size_t b = 0; b < brackets; ++b)
+        {
+            CHECK_EQ(int(pooledResult[b]), int(serialResult[b]));
+            for (uint32 i = 0; i < PVP_TEAM_COUNT; ++i)
+            {
+                BattleGroundGroupList const& s = serial[b].Matcher.GetPool(i).SelectedGroups;
+                BattleGroundGroupList const& p = pooled[b].Matcher.GetPool(i).SelectedGroups;
+                REQUIRE(s.size() == p.size());
+                BattleGroundGroupList::const_iterator sitr = s.begin();
+                BattleGroundGroupList::const_iterator pitr = p.begin();
+                for (; sitr != s.end(); ++sitr, ++pitr)
+                {
+                    CHECK(((*sitr)->Players.begin()->first == (*pitr)->Players.begin()->first));
+                }
+            }
+            if (serialResult[b] != BG_MATCH_NONE)
+            {
+                Invite(serial[b].Matcher, round);
+                Invite(pooled[b].Matcher, round);
+                ++started;
+            }
+        }
+    }
+
+    pool.Deactivate();
+
+    CHECK(started > 0u);
+}
@@ -0,0 +1,337 @@
+/**
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2026 MaNGOS <https://www.getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+#include "TestHarness.h"
+
+#include "CompiledLootTable.h"
+#include "LootTemplateRows.h"
+
+#include <cmath>
+#include <map>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @file
+ * @brief The flattened loot table against the walk it replaced.
+ *
+ * Templates are built with the code LootTemplate itself uses: rows routed by
+ * LootRows::AddEntry, flattened by LootRows::Compile, and rolled sequentially
+ * by LootRows::Process -- entries and references in a list, references looked
+ * up by id at every roll, group items selected by subtracting chance after
+ * chance. Both rolls are driven by the same kind of policy. With the same roll
+ * sequence they must produce the same items; with independent rolls they must
+ * produce the same distribution.
+ */
+
+namespace
+{
+    struct Row
+    {
+        uint32 itemid;
+        float chance;
+        int32 mincountOrRef;                                // negative: reference id
+        uint8 group;
+        uint8 maxcount;
+        bool blocked;                                       // reference condition fails
+    };
+
+    /// xorshift64*; cheap enough not to hide the cost of the walk itself.
+    struct Rolls
+    {
+        explicit Rolls(uint64 seed) : state(seed * 0x9E3779B97F4A7C15ULL + 1) {}
+
+        uint32 operator()()
+        {
+            state ^= state >> 12;
+            state ^= state << 25;
+            state ^= state >> 27;
+            return uint32((state * 0x2545F4914F6CDD1DULL) >> 32);
+        }
+
+        uint64 state;
+    };
+
+    /// Deterministic rolls; collects produced item ids.
+    struct Policy
+    {
+        explicit Policy(uint32 seed) : rng(seed) {}
+
+        bool IsAllowed(Row const& row) const { return row.itemid != 13; }
+        bool Roll(Row const& row) { return row.chance >= 100.0f || row.chance > RollChance(); }
+        bool IsReferenceAllowed(Row const& row) const { return !row.blocked; }
+        float RollChance() { return float(rng() % 400) * 0.25f; }
+        uint32 RollIndex(uint32 count) { return rng() % count; }
+        void Add(Row const& row) { items.push_back(row.itemid); }
+
+        Rolls rng;
+        std::vector<uint32> items;
+    };
+
+    /// A template's rows as LootTemplate holds them.
+    struct Template
+    {
+        std::vector<Row> entries;
+        std::vector<LootRows::Group<Row> > groups;
+
+        void Add(Row const& row) { LootRows::AddEntry(entries, groups, row); }
+    };
+
+    typedef std::unordered_map<uint32, Template> Store;
+
+    /// The reference store as the sequential roll sees it, looked up at every roll.
+    struct References
+    {
+        explicit References(Store const& store_) : store(store_) {}
+
+        bool Has(uint32 id) const { return store.find(id) != store.end(); }
+
+        void Process(uint32 id, Policy& policy, uint8 groupId) const
+        {
+            Template const& tab = store.find(id)->second;
+            LootRows::Process(tab.entries, tab.groups, policy, *this, groupId);
+        }
+
+        Store const& store;
+    };
+
+    void ProcessSequentially(Store const& store, Store const& references, uint32 id, Policy& policy)
+    {
+        Template const& tab = store.find(id)->second;
+        LootRows::Process(tab.entries, tab.groups, policy, References(references), 0);
+    }
+
+    /// Adds every template of a store to a table, as LootStore::Compile does.
+    void Compile(Store const& store, CompiledLootTable<Row>& table)
+    {
+        for (Store::const_iterator tab = store.begin(); tab != store.end(); ++tab)
+        {
+            LootRows::Compile(tab->second.entries, tab->second.groups, table, tab->first);
+        }
+    }
+
+    /**
+     * Random templates shaped like the world database: a few plain entries,
+     * a few groups with mostly small chances, some references to whole
+     * reference templates or to one of their groups. References often
+     * always take their chance and reference groups are long, as world drop
+     * references are. Chances are multiples of 0.25 when
+     * @p exact, so both selections see identical sums.
+     */
+    struct Fixture
+    {
+        Store creatures;
+        Store references;
+        CompiledLootTable<Row> creatureTable;
+        CompiledLootTable<Row> referenceTable;
+        std::vector<uint32> ids;
+
+        Fixture(bool exact, uint32 templates)
+        {
+            std::mt19937 rng(0x100AU);
+            uint32 item = 1;
+
+            for (uint32 id = 1; id <= templates / 4 + 1; ++id)
+            {
+                Fill(references[id], rng, item, exact, 0);
+            }
+            for (uint32 id = 1; id <= templates; ++id)
+            {
+                Fill(creatures[id * 10], rng, item, exact, uint32(references.size()) + 2);
+                ids.push_back(id * 10);
+            }
+
+            Compile(references, referenceTable);
+            Compile(creatures, creatureTable);
+            referenceTable.ResolveReferences(referenceTable);
+            creatureTable.ResolveReferences(referenceTable);
+        }
+
+        static float Chance(std::mt19937& rng, bool exact, float max)
+        {
+            float chance = exact ? float(1 + rng() % uint32(max * 4)) * 0.25f : 0.01f + float(rng() % 100000) / 100000.0f * max;
+            return chance;
+        }
+
+        static void Fill(Template& tab, std::mt19937& rng, uint32& item, bool exact, uint32 referenceIds)
+        {
+            uint32 entries = 1 + rng() % 6;
+            for (uint32 i = 0; i < entries; ++i)
+            {
+                Row row = { item++, Chance(rng, exact, 60.0f), 1, 0, 1, false };
+                if (rng() % 25 == 0)
+                {
+                    row.chance = 100.0f;
+                }
+                if (referenceIds && rng() % 4 == 0)
+                {
+                    // referenceIds - 1 does not exist; its entries never process
+                    row.mincountOrRef = -int32(1 + rng() % referenceIds);
+                    row.group = uint8(rng() % 3);
+                    row.maxcount = uint8(1 + rng() % 2);
+                    row.blocked = rng() % 8 == 0;
+                    if (rng() % 2)
+                    {
+                        row.chance = 100.0f;
+                    }
+                }
+                tab.Add(row);
+            }
+
+            uint32 groups = rng() % 4;
+            for (uint32 g = 0; g < groups; ++g)
+            {
+                uint32 chanced = referenceIds ? rng() % 12 : 20 + rng() % 300;
+                float maxChance = referenceIds ? 12.0f : 0.5f;
+                for (uint32 i = 0; i < chanced; ++i)
+                {
+                    Row row = { item++, Chance(rng, exact, maxChance), 1, uint8(g + 1), 1, false };
+                    if (rng() % 30 == 0)
+                    {
+                        row.chance = 100.0f;
+                    }
+                    tab.Add(row);
+                }
+                uint32 equal = rng() % 3 == 0 ? rng() % 5 : 0;
+                for (uint32 i = 0; i < equal; ++i)
+                {
+                    Row row = { item++, 0.0f, 1, uint8(g + 1), 1, false };
+                    tab.Add(row);
+                }
+            }
+        }
+    };
+}
+
+TEST(CompiledLootTable_same_rolls_give_same_items)
+{
+    Fixture fixture(true, 400);
+    CHECK(fixture.creatureTable.GetUnresolvedCount() > 0u);
+
+    Policy sequential(0x5EEDU);
+    Policy flat(0x5EEDU);
+    for (uint32 loot = 0; loot < 100000; ++loot)
+    {
+        uint32 id = fixture.ids[loot % fixture.ids.size()];
+        ProcessSequentially(fixture.creatures, fixture.references, id, sequential);
+        fixture.creatureTable.Process(fixture.creatureTable.Find(id), flat, fixture.referenceTable);
+        REQUIRE(sequential.items.size() == flat.items.size());
+    }
+
+    CHECK(sequential.items == flat.items);
+    CHECK(!flat.items.empty());
+}
+
+TEST(CompiledLootTable_group_selection_by_cumulative_chance)
+{
+    Row rows[] =
+    {
+        { 1, 10.0f, 1, 1, 1, false },
+        { 2, 20.0f, 1, 1, 1, false },
+        { 3, 100.0f, 1, 1, 1, false },
+        { 4, 30.0f, 1, 1, 1, false },
+        { 5, 0.0f, 1, 1, 1, false },
+    };
+
+    CompiledLootTable<Row> table;
+    uint32 index = table.AddTemplate(7);
+    table.AddGroup();
+    table.AddGroup();                                       // empty group
+    for (size_t i = 0; i < 5; ++i)
+    {
+        table.AddGroupItem(rows[i], rows[i].chance);
+    }
+    CHECK_EQ(table.GetGroupCount(), 2u);
+    CHECK_EQ(table.GetGroupItemCount(), 5u);
+    CHECK_EQ(table.Find(7), index);
+    CHECK_EQ(table.Find(8), CompiledLootTable<Row>::NoTemplate);
+
+    // Rolls of 0, 9.75, 10, 29.75 and 30 land on 1, 1, 2, 2 and 3; the entry of
+    // 100% takes every roll that reaches it, the one after it is never selected.
+    uint32 const expected[] = { 1, 1, 2, 2, 3, 3 };
+    float const rolls[] = { 0.0f, 9.75f, 10.0f, 29.75f, 30.0f, 99.75f };
+    for (size_t i = 0; i < 6; ++i)
+    {
+        struct FixedRoll : Policy
+        {
+            explicit FixedRoll(float roll) : Policy(0), roll(roll) {}
+            float RollChance() { return roll; }
+            float roll;
+        } policy(rolls[i]);
+
+        table.Process(index, policy, table, 2);
+        REQUIRE(policy.items.size() == 1u);
+        CHECK_EQ(policy.items[0], expected[i]);
+    }
+}
+
+TEST(CompiledLootTable_distribution_matches_sequential_walk)
+{
+    // Independent rolls with arbitrary chances: per item counts must agree
+    // within a few standard deviations of the binomial.
+    Fixture fixture(false, 60);
+
+    Policy sequential(1);
+    Policy flat(2);
+    uint32 const loots = 300000;
+    for (uint32 loot = 0; loot < loots; ++loot)
+    {
+        uint32 id = fixture.ids[loot % fixture.ids.size()];
+        ProcessSequentially(fixture.creatures, fixture.references, id, sequential);
+        fixture.creatureTable.Process(fixture.creatureTable.Find(id), flat, fixture.referenceTable);
+    }
+
+    std::map<uint32, uint32> sequentialCount, flatCount;
+    for (size_t i = 0; i < sequential.items.size(); ++i)
+    {
+        ++sequentialCount[sequential.items[i]];
+    }
+    for (size_t i = 0; i < flat.items.size(); ++i)
+    {
+        ++flatCount[flat.items[i]];
+    }
+
+    // Items of very small chance may show up on one side only; the
+    // tolerance covers them as for any other count.
+    std::map<uint32, uint32>::const_iterator itr;
+    for (itr = sequentialCount.begin(); itr != sequentialCount.end(); ++itr)
+    {
+        flatCount[itr->first];
+    }
+
+    uint32 outliers = 0;
+    for (itr = flatCount.begin(); itr != flatCount.end(); ++itr)
+    {
+        double a = sequentialCount[itr->first];
+        double b = itr->second;
+        if (std::fabs(a - b) > 5.0 * std::sqrt(a + b) + 5.0)
+        {
+            ++outliers;
+        }
+    }
+    CHECK_EQ(outliers, 0u);
+    CHECK(flatCount.size() > 1000u);
+}
@@ -134,6 +134,33 @@ TEST(DynamicCollisionBlocksASightlineThroughIt)
     CHECK(world.NearestHitFraction(-20.f, 50.f, 0.f, 20.f, 50.f, 0.f, 1) > 1.0f);
 }
 
+TEST(DynamicCollisionABatchOfSightLinesAnswersAsEachAlone)
+{
+    DynamicCollision world;
+    Body wall(3.f, Vector3{0.f, 0.f, 0.f});
+    Body phased(3.f, Vector3{0.f, 30.f, 0.f}, /*phase*/ 2);
+    REQUIRE(wall.model != nullptr);
+    REQUIRE(phased.model != nullptr);
+    world.Insert(*wall.model);
+    world.Insert(*phased.model);
+
+    const Vector3 from{-20.f, 0.f, 0.f};
+    const std::vector<Vector3> targets = {
+        {20.f, 0.f, 0.f}, {20.f, 50.f, 0.f}, {-10.f, 2.f, 0.f}, {20.f, 60.f, 0.f},
+        {-20.f, 0.f, 0.f}, {1.f, 1.f, 1.f}};
+    for (uint32 phase : {1u, 2u, 3u})
+    {
+        std::vector<uint8_t> clear(targets.size(), 1);
+        world.IsInLineOfSight(from, targets, clear, phase);
+        for (size_t i = 0; i < targets.size(); ++i)
+        {
+            const Vector3& t = targets[i];
+            CHECK_EQ(clear[i] != 0,
+                     world.IsInLineOfSight(from.x, from.y, from.z, t.x, t.y, t.z, phase));
+        }
+    }
+}
+
 TEST(DynamicCollisionRespectsTheCollidableFlag)
 {
     // A door "opening" flips this flag rather than moving, so it is the whole mechanism
@@ -0,0 +1,237 @@
+/**
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2026 MaNGOS <https://www.getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+/**
+ * @file GameEventWorkTest.cpp
+ * @brief The budgeted drain of game event map work, and the counting of a transition
+ *
+ * Map::ProcessGameEventWork drains its MaNGOS::LockedQueue of GameEventMapWork
+ * with ApplyGameEventWork, and GameEventMgr::CompleteMapWork counts every item a
+ * map copy applies or discards on its GameEventTransition. These tests call both:
+ * the drain against a clock they control, for the Event.MapUpdateBudget cut-off,
+ * and from real threads, one queue per map copy, with every item counted by
+ * GameEventTransition::Complete. ApplyMapWork itself needs the object manager and
+ * a loaded Map, so the items here are only counted.
+ */
+
+#include "TestHarness.h"
+
+#include "GameEventMgr.h"
+#include "LockedQueue/LockedQueue.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    typedef MaNGOS::LockedQueue<GameEventMapWork> GameEventWorkQueue;
+
+    const uint32 WorkPerMap = 20000;
+
+    GameEventMapWork MakeWork(uint32 dbGuid, GameEventTransition* transition)
+    {
+        GameEventMapWork work;
+        work.type = GAME_EVENT_WORK_SPAWN_CREATURE;
+        work.dbGuid = dbGuid;
+        work.activate = true;
+        work.eventData = NULL;
+        work.transition = transition;
+        return work;
+    }
+
+    /// A getMSTime() that moves on by `step` ms every time it is read.
+    struct SteppingClock
+    {
+        uint32* now;
+        uint32 step;
+
+        uint32 operator()() const
+        {
+            uint32 time = *now;
+            *now += step;
+            return time;
+        }
+    };
+
+    /// What one map copy's updates do to its queue, from its own thread, until the queuer is done.
+    struct MapThread
+    {
+        GameEventWorkQueue* queue;
+        std::atomic<bool> const* queuing;
+        uint32 applied;
+        uint32 completions;                                 // items whose Complete() finished the transition
+        bool inOrder;
+
+        void operator()()
+        {
+            auto apply = [this](GameEventMapWork const& work)
+            {
+                if (work.dbGuid != applied)
+                {
+                    inOrder = false;
+                }
+                ++applied;
+                if (work.transition->Complete())            // as GameEventMgr::CompleteMapWork
+                {
+                    ++completions;
+                }
+            };
+
+            for (;;)
+            {
+                bool finished = !queuing->load();           // read first, so an empty queue after it is final
+                if (!ApplyGameEventWork(*queue, 5, apply, getMSTime))
+                {
+                    if (finished)
+                    {
+                        return;
+                    }
+                    std::this_thread::yield();
+                }
+            }
+        }
+    };
+}
+
+TEST(GameEventWorkStopsAtTheMapUpdateBudget)
+{
+    GameEventTransition transition(1, true, 0);
+    GameEventWorkQueue queue;
+    for (uint32 i = 0; i < 12; ++i)
+    {
+        transition.Queue();
+        queue.add(MakeWork(i, &transition));
+    }
+
+    uint32 now = 1000;
+    SteppingClock clock = { &now, 1 };
+    std::vector<uint32> applied;
+    auto apply = [&applied](GameEventMapWork const& work)
+    {
+        applied.push_back(work.dbGuid);
+        work.transition->Complete();
+    };
+
+    // a millisecond per item: five items fit a 5 ms budget, in queue order
+    CHECK_EQ(ApplyGameEventWork(queue, 5, apply, clock), 5u);
+    CHECK_EQ(ApplyGameEventWork(queue, 5, apply, clock), 5u);
+    CHECK_EQ(queue.size(), size_t(2));
+
+    // one item that alone spends the budget still goes through, and stops the update
+    SteppingClock slow = { &now, 50 };
+    CHECK_EQ(ApplyGameEventWork(queue, 5, apply, slow), 1u);
+
+    // no budget at all still applies one item per update
+    CHECK_EQ(ApplyGameEventWork(queue, 0, apply, clock), 1u);
+    CHECK_EQ(ApplyGameEventWork(queue, 5, apply, clock), 0u);
+    CHECK(queue.empty());
+
+    REQUIRE(applied.size() == 12u);
+    for (uint32 i = 0; i < 12; ++i)
+    {
+        CHECK_EQ(applied[i], i);
+    }
+
+    CHECK(!transition.IsDone());                            // the extra count held while queuing
+    CHECK(transition.Complete());
+    CHECK(transition.IsDone());
+    CHECK_EQ(transition.applied.load(), transition.queued.load());
+}
+
+TEST(GameEventWorkQueuedWhileAMapDrainsItIsAppliedOnceInOrder)
+{
+    GameEventTransition transition(1, true, 0);
+    GameEventWorkQueue queue;
+    std::atomic<bool> queuing(true);
+    MapThread map = { &queue, &queuing, 0, 0, true };
+
+    std::thread thread(std::ref(map));
+    for (uint32 i = 0; i < WorkPerMap; ++i)
+    {
+        transition.Queue();
+        queue.add(MakeWork(i, &transition));
+    }
+    queuing.store(false);
+    thread.join();
+
+    CHECK_EQ(map.applied, WorkPerMap);
+    CHECK(map.inOrder);
+    CHECK_EQ(map.completions, 0u);                          // the queuer's count was still held
+    CHECK(queue.empty());
+
+    CHECK(!transition.IsDone());
+    CHECK(transition.Complete());                           // as GameEventMgr::EndTransition
+    CHECK(transition.IsDone());
+}
+
+TEST(GameEventWorkOfOneTransitionIsCompletedOnceAcrossMapThreads)
+{
+    const uint32 MapCount = 4;
+
+    GameEventTransition transition(2, false, 0);
+    std::vector<GameEventWorkQueue> queues(MapCount);
+    std::atomic<bool> queuing(true);
+    std::vector<MapThread> maps;
+    for (uint32 m = 0; m < MapCount; ++m)
+    {
+        MapThread map = { &queues[m], &queuing, 0, 0, true };
+        maps.push_back(map);
+    }
+
+    std::vector<std::thread> threads;
+    for (uint32 m = 0; m < MapCount; ++m)
+    {
+        threads.push_back(std::thread(std::ref(maps[m])));
+    }
+
+    // one object at a time to every copy of its map, as GameEventMgr::QueueMapWork does;
+    // the queuer lets go of its count while the maps are still applying
+    for (uint32 i = 0; i < WorkPerMap; ++i)
+    {
+        for (uint32 m = 0; m < MapCount; ++m)
+        {
+            transition.Queue();
+            queues[m].add(MakeWork(i, &transition));
+        }
+    }
+    uint32 completions = transition.Complete() ? 1 : 0;
+    queuing.store(false);
+    for (size_t m = 0; m < threads.size(); ++m)
+    {
+        threads[m].join();
+    }
+
+    for (uint32 m = 0; m < MapCount; ++m)
+    {
+        CHECK_EQ(maps[m].applied, WorkPerMap);
+        CHECK(maps[m].inOrder);
+        completions += maps[m].completions;
+    }
+    CHECK_EQ(completions, 1u);
+    CHECK_EQ(transition.applied.load(), MapCount * WorkPerMap + 1);
+    CHECK_EQ(transition.queued.load(), MapCount * WorkPerMap + 1);
+    CHECK(transition.IsDone());
+}
@@ -0,0 +1,126 @@
+/**
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2026 MaNGOS <https://www.getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+#include "TestHarness.h"
+
+#include "MapTickProfile.h"
+
+#include <chrono>
+#include <string>
+
+namespace
+{
+    // Ticks are driven from a fixed origin so the expected times are exact.
+    MapTickProfile::Clock::time_point At(uint64 micros)
+    {
+        return MapTickProfile::Clock::time_point() + std::chrono::microseconds(micros);
+    }
+}
+
+TEST(MapTickProfileChargesTimeToThePhaseThatRan)
+{
+    MapTickProfile profile;
+    profile.BeginTick(At(0));
+    profile.Mark(MAP_TICK_SESSIONS, At(100));
+    profile.Mark(MAP_TICK_CELLS, At(5100));
+    profile.Mark(MAP_TICK_SCRIPTS, At(5150));
+    uint64 total = profile.EndTick(At(5200));
+
+    CHECK_EQ(profile.GetLastTickMicros(MAP_TICK_SESSIONS), uint64(100));
+    CHECK_EQ(profile.GetLastTickMicros(MAP_TICK_CELLS), uint64(5000));
+    CHECK_EQ(profile.GetLastTickMicros(MAP_TICK_SCRIPTS), uint64(50));
+    CHECK_EQ(profile.GetLastTickMicros(MAP_TICK_WEATHER), uint64(0));
+    CHECK_EQ(total, uint64(5200));
+    CHECK_EQ(profile.GetLastTickTotal(), total);
+
+    std::string last = profile.FormatLastTick();
+    CHECK(last.find("cells ") != std::string::npos);
+    CHECK(last.find("weather") == std::string::npos);
+    CHECK(profile.FormatSlowTick().empty());
+
+    profile.CaptureSlowTick();
+    CHECK_EQ(profile.GetSlowTickTotal(), total);
+    CHECK(profile.FormatSlowTick() == last);
+}
+
+TEST(MapTickProfileAccumulatesMarksOfOnePhaseWithinATick)
+{
+    MapTickProfile profile;
+    profile.BeginTick(At(0));
+    uint64 now = 0;
+    for (int i = 0; i < 3; ++i)
+    {
+        now += 1000;
+        profile.Mark(MAP_TICK_HOSTILE_REFS, At(now));
+        now += 10;
+        profile.Mark(MAP_TICK_CELLS, At(now));
+    }
+    profile.EndTick(At(now));
+    CHECK_EQ(profile.GetLastTickMicros(MAP_TICK_HOSTILE_REFS), uint64(3000));
+    CHECK_EQ(profile.GetLastTickMicros(MAP_TICK_CELLS), uint64(30));
+
+    // the next tick starts from zero
+    profile.BeginTick(At(now));
+    profile.EndTick(At(now));
+    CHECK_EQ(profile.GetLastTickMicros(MAP_TICK_HOSTILE_REFS), uint64(0));
+    CHECK_EQ(profile.GetTicksEnded(), uint64(2));
+}
+
+TEST(MapTickProfileKeepsARollingWindowOfTicks)
+{
+    MapTickProfile profile;
+    profile.BeginTick(At(0));
+    profile.Mark(MAP_TICK_PLAYERS, At(2000));
+    profile.EndTick(At(2000));
+
+    MapTickProfile::PhaseStats stats = profile.GetPhaseStats(MAP_TICK_PLAYERS);
+    CHECK_EQ(stats.ticks, uint32(1));
+    CHECK_EQ(stats.maxMicros, uint64(2000));
+    CHECK_EQ(stats.avgMicros, uint64(2000));
+    CHECK_EQ(stats.p99Micros, stats.maxMicros);              // bucket bound capped by the max
+    CHECK(profile.FormatStats().find("players avg") != std::string::npos);
+
+    // two full windows of 100us ticks later the slow tick has rolled out
+    uint64 now = 2000;
+    for (uint32 i = 0; i < 2 * MapTickProfile::WindowTicks; ++i)
+    {
+        profile.BeginTick(At(now));
+        now += 100;
+        profile.Mark(MAP_TICK_PLAYERS, At(now));
+        profile.EndTick(At(now));
+    }
+    stats = profile.GetPhaseStats(MAP_TICK_PLAYERS);
+    CHECK(stats.ticks >= MapTickProfile::WindowTicks);
+    CHECK(stats.ticks <= 2 * MapTickProfile::WindowTicks);
+    CHECK_EQ(stats.maxMicros, uint64(100));
+}
+
+TEST(MapTickProfileSlowTickThresholdIsSharedByAllMaps)
+{
+    MapTickProfile::SetSlowTickThreshold(250);
+    CHECK_EQ(MapTickProfile::GetSlowTickThreshold(), uint32(250));
+    MapTickProfile::SetSlowTickThreshold(0);
+    CHECK_EQ(MapTickProfile::GetSlowTickThreshold(), uint32(0));
+    CHECK(std::string(GetMapTickPhaseName(MAP_TICK_TRANSPORTS)) == "transports");
+}
@@ -168,6 +168,31 @@ TEST(ModelMap_TheBulkheadBlocksSightAcrossIt)
     CHECK(hull.IsInLineOfSight(-5.f, 0.f, 8.5f, 5.f, 0.f, 8.5f));
 }
 
+TEST(ModelMap_ABatchOfSightLinesAnswersAsEachAlone)
+{
+    FusedTerrain hull(SHIP_TRANSPORTSHIP, HullSource());
+
+    const Vec3 from{-5.f, 0.f, 6.f};
+    const std::vector<Vec3> targets = {
+        {5.f, 0.f, 6.f},  {-2.f, 0.f, 6.f}, {5.f, 0.f, 8.5f}, {5.f, 2.f, 5.5f},
+        {-5.f, 0.f, 6.f}, {4.f, -3.f, 7.f}, {-8.f, 1.f, 6.f}};
+    std::vector<uint8_t> clear(targets.size(), 1);
+    hull.IsInLineOfSight(from, targets, clear);
+    for (size_t i = 0; i < targets.size(); ++i)
+    {
+        const Vec3& t = targets[i];
+        CHECK_EQ(clear[i] != 0, hull.IsInLineOfSight(from.x, from.y, from.z, t.x, t.y, t.z));
+    }
+    CHECK_EQ(clear[0], 0);
+    CHECK_EQ(clear[1], 1);
+
+    // An entry already cleared is not asked again, however open its line.
+    std::vector<uint8_t> masked(targets.size(), 1);
+    masked[1] = 0;
+    hull.IsInLineOfSight(from, targets, masked);
+    CHECK_EQ(masked[1], 0);
+}
+
 TEST(ModelMap_AModelWithNoGeometryMakesNoMap)
 {
     ModelTileSource empty(std::make_shared<CollisionModel>(TriSoup{}));
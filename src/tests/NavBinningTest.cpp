@@ -33,6 +33,8 @@
 using world::nav::SubTileSpan;
 using world::nav::CellRect;
 using world::nav::NeighbourCellRect;
+using world::nav::NavBakeSalt;
+using world::nav::NavConfig;
 
 namespace
 {
@@ -184,3 +186,29 @@ TEST(NavNeighbourCellRectRejectsNonOrthogonalNeighbours)
     CHECK(!NeighbourCellRect(1, 1, rect));
     CHECK(!NeighbourCellRect(-2, 0, rect));
 }
+
+TEST(NavBakeSaltFollowsWhatShapesTheMesh)
+{
+    const float orig[3] = {-533.33333f, 0.0f, 1066.66666f};
+    const NavConfig base;
+    const uint64_t salt = NavBakeSalt(base, orig);
+
+    // How a bake runs must not invalidate what an earlier one wrote.
+    NavConfig runner = base;
+    runner.threads = 7;
+    runner.incremental = true;
+    runner.offMeshFile = "elsewhere.txt";
+    CHECK_EQ(NavBakeSalt(runner, orig), salt);
+
+    NavConfig steeper = base;
+    steeper.maxWalkableAngle = 70.0f;
+    CHECK(NavBakeSalt(steeper, orig) != salt);
+
+    NavConfig wider = base;
+    wider.walkableRadius = 3;
+    CHECK(NavBakeSalt(wider, orig) != salt);
+
+    // Tiles store their index relative to the origin, so a new origin is a new bake.
+    const float moved[3] = {-1066.66666f, 0.0f, 1066.66666f};
+    CHECK(NavBakeSalt(base, moved) != salt);
+}
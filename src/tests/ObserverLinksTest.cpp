@@ -0,0 +1,282 @@
+/**
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2026 MaNGOS <https://www.getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+#include "TestHarness.h"
+
+#include "ObserverLinks.h"
+
+#include <cstdlib>
+#include <set>
+#include <vector>
+
+namespace
+{
+    // The shape of Player and WorldObject, reduced to what the links touch: a map, the
+    // guids a client holds, and a side each way.
+    struct Viewer;
+
+    struct Thing
+    {
+        int guid;
+        int map;
+        ObserverLinks::Side<Viewer> observers;
+
+        int GetObjectGuid() const { return guid; }
+    };
+
+    typedef ObserverLinks::Side<Thing, ObserverLinks::GuidSlots<Thing, int> > Observed;
+
+    struct Viewer : Thing
+    {
+        std::set<int> clientGuids;
+        Observed observed;
+        int received = 0;
+
+        // As Player::AddClientObject / LinkClientObject / RemoveClientGuid.
+        void Add(Thing* target)
+        {
+            if (clientGuids.insert(target->guid).second)
+            {
+                Link(target);
+            }
+        }
+
+        void Link(Thing* target)
+        {
+            if (target->map == map && observed.Find(target->guid) == Observed::npos)
+            {
+                ObserverLinks::Link(this, &Viewer::observed, target, &Thing::observers);
+            }
+        }
+
+        void Remove(int guid)
+        {
+            if (clientGuids.erase(guid))
+            {
+                size_t slot = observed.Find(guid);
+                if (slot != Observed::npos)
+                {
+                    ObserverLinks::Unlink(this, &Viewer::observed, slot, &Thing::observers);
+                }
+            }
+        }
+    };
+
+    Viewer MakeViewer(int guid, int map)
+    {
+        Viewer v;
+        v.guid = guid;
+        v.map = map;
+        return v;
+    }
+
+    // As Map::Remove: both sides of every link go, the guids stay.
+    void Leave(Viewer& v)
+    {
+        ObserverLinks::UnlinkAll(&v, &Viewer::observed, &Thing::observers);
+        ObserverLinks::UnlinkAll(static_cast<Thing*>(&v), &Thing::observers, &Viewer::observed);
+    }
+
+    // As Map::RelinkObservers, for a viewer arriving on `map`.
+    void Arrive(Viewer& v, int map, std::vector<Thing*> const& there, std::vector<Viewer*> const& players)
+    {
+        v.map = map;
+        for (Thing* t : there)
+        {
+            if (v.clientGuids.count(t->guid))
+            {
+                v.Link(t);
+            }
+        }
+        for (Viewer* p : players)
+        {
+            if (p != &v && p->clientGuids.count(v.guid))
+            {
+                p->Link(&v);
+            }
+        }
+    }
+
+    // Every entry's twin points back at it, and the guid slots agree with the list.
+    bool Consistent(Viewer const& v)
+    {
+        if (v.observed.slots.size() != v.observed.items.size())
+        {
+            return false;
+        }
+        for (size_t i = 0; i < v.observed.items.size(); ++i)
+        {
+            Thing const* t = v.observed.items[i];
+            size_t twin = v.observed.mirrors[i];
+            if (twin >= t->observers.items.size() || t->observers.items[twin] != &v ||
+                t->observers.mirrors[twin] != i || v.observed.Find(t->guid) != i)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // As MessageBroadcast over the observer list.
+    void Broadcast(Thing& from)
+    {
+        for (Viewer* v : from.observers.items)
+        {
+            ++v->received;
+        }
+    }
+}
+
+TEST(ObserverLinks_link_is_made_once)
+{
+    Viewer v = MakeViewer(1, 0);
+    Thing t{2, 0, {}};
+    v.Add(&t);
+    v.Link(&t);
+    CHECK_EQ(t.observers.items.size(), size_t(1));
+    CHECK_EQ(v.observed.items.size(), size_t(1));
+
+    v.Remove(2);
+    v.Remove(2);
+    CHECK(t.observers.items.empty());
+    CHECK(v.observed.items.empty());
+    CHECK(v.observed.slots.empty());
+}
+
+TEST(ObserverLinks_crossing_a_seam_keeps_one_delivery)
+{
+    // A player ashore who sees a guard there and, across the seam, a deck object and
+    // a watcher aboard who sees the player back. Then the player walks aboard.
+    Viewer walker = MakeViewer(1, 0);
+    Viewer watcher = MakeViewer(3, 1);
+    Thing guard{2, 0, {}};
+    Thing deck{4, 1, {}};
+
+    walker.Add(&guard);
+    walker.Add(&deck);                      // across the seam: held, not linked
+    watcher.Add(&walker);                   // likewise
+    CHECK(deck.observers.items.empty());
+    CHECK(walker.observers.items.empty());
+
+    // Embark: off the shore map, onto the deck. The guids survive, the links do not.
+    Leave(walker);
+    CHECK(guard.observers.items.empty());
+    Arrive(walker, 1, {&deck}, {&watcher});
+
+    // Seen again later by the ordinary visibility pass: already known, so no new link.
+    walker.Add(&deck);
+    watcher.Add(&walker);
+
+    Broadcast(deck);
+    Broadcast(walker);
+    CHECK_EQ(walker.received, 1);
+    CHECK_EQ(watcher.received, 1);
+
+    // Back ashore and back again: still exactly one link each way.
+    Leave(walker);
+    Arrive(walker, 0, {&guard}, {});
+    Leave(walker);
+    Arrive(walker, 1, {&deck}, {&watcher});
+    Arrive(walker, 1, {&deck}, {&watcher});
+    Broadcast(deck);
+    Broadcast(walker);
+    CHECK_EQ(walker.received, 2);
+    CHECK_EQ(watcher.received, 2);
+}
+
+TEST(ObserverLinks_forgetting_an_object_drops_its_link)
+{
+    // ResyncObserversAfterTeleport: the observer forgets the bot, then sees it anew.
+    Viewer observer = MakeViewer(1, 0);
+    Thing bot{2, 0, {}};
+    observer.Add(&bot);
+    observer.Remove(bot.guid);
+    CHECK(bot.observers.items.empty());
+
+    observer.Add(&bot);
+    Broadcast(bot);
+    CHECK_EQ(observer.received, 1);
+
+    // Out of sight for good: no packet reaches it any more.
+    observer.Remove(bot.guid);
+    Broadcast(bot);
+    CHECK_EQ(observer.received, 1);
+}
+
+TEST(ObserverLinks_unlinking_out_of_the_middle_keeps_every_twin)
+{
+    // Several viewers over many things, linked and unlinked in no particular order:
+    // every swap-and-pop must leave both ends pointing at each other.
+    const int Things = 200;
+    std::vector<Thing> things(Things);
+    for (int i = 0; i < Things; ++i)
+    {
+        things[i].guid = 100 + i;
+        things[i].map = 0;
+    }
+    std::vector<Viewer> viewers;
+    for (int i = 0; i < 4; ++i)
+    {
+        viewers.push_back(MakeViewer(i + 1, 0));
+    }
+
+    std::srand(42);
+    for (int round = 0; round < 20000; ++round)
+    {
+        Viewer& v = viewers[std::rand() % viewers.size()];
+        Thing& t = things[std::rand() % Things];
+        if (std::rand() % 2)
+        {
+            v.Add(&t);
+        }
+        else
+        {
+            v.Remove(t.guid);
+        }
+    }
+
+    size_t links = 0;
+    for (size_t i = 0; i < viewers.size(); ++i)
+    {
+        CHECK(Consistent(viewers[i]));
+        CHECK_EQ(viewers[i].observed.items.size(), viewers[i].clientGuids.size());
+        links += viewers[i].observed.items.size();
+    }
+    size_t observers = 0;
+    for (int i = 0; i < Things; ++i)
+    {
+        observers += things[i].observers.items.size();
+    }
+    CHECK_EQ(observers, links);
+
+    // A thing leaving the map drops its links from the viewers' side as well.
+    Thing& gone = things[7];
+    ObserverLinks::UnlinkAll(&gone, &Thing::observers, &Viewer::observed);
+    for (size_t i = 0; i < viewers.size(); ++i)
+    {
+        CHECK(Consistent(viewers[i]));
+        CHECK(viewers[i].observed.Find(gone.guid) == Observed::npos);
+    }
+}
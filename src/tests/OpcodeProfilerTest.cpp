@@ -0,0 +1,153 @@
+/**
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2026 MaNGOS <https://www.getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+#include "TestHarness.h"
+
+#include "OpcodeProfiler.h"
+
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+TEST(OpcodeProfilerSumsCallsAndReadsThePercentileFromTheHistogram)
+{
+    OpcodeProfiler profiler(16);
+    for (int i = 0; i < 99; ++i)
+    {
+        profiler.Record(3, 10, 20);                         // bucket [8, 16)
+    }
+    profiler.Record(3, 5000, 20);                           // bucket [4096, 8192)
+    profiler.Record(7, 1, 4);
+
+    std::vector<OpcodeProfile> totals = profiler.GetTotals();
+    REQUIRE(totals.size() == 2);
+    CHECK_EQ(totals[0].opcode, uint16(3));
+    CHECK_EQ(totals[0].calls, uint64(100));
+    CHECK_EQ(totals[0].totalMicros, uint64(99 * 10 + 5000));
+    CHECK_EQ(totals[0].maxMicros, uint64(5000));
+    CHECK_EQ(totals[0].p99Micros, uint64(15));
+    CHECK_EQ(totals[0].bytesIn, uint64(2000));
+    CHECK_EQ(totals[1].opcode, uint16(7));
+    CHECK_EQ(totals[1].p99Micros, uint64(1));
+
+    profiler.Record(99, 1, 1);                              // out of range, ignored
+    CHECK_EQ(profiler.GetTotals().size(), size_t(2));
+}
+
+TEST(OpcodeProfilerIntervalsOnlyHoldNewCalls)
+{
+    OpcodeProfiler profiler(8);
+    profiler.Record(1, 100, 10);
+    CHECK_EQ(profiler.TakeInterval().size(), size_t(1));
+    CHECK(profiler.TakeInterval().empty());
+
+    profiler.Record(1, 3, 10);
+    profiler.Record(1, 3, 10);
+    std::vector<OpcodeProfile> interval = profiler.TakeInterval();
+    REQUIRE(interval.size() == 1);
+    CHECK_EQ(interval[0].calls, uint64(2));
+    CHECK_EQ(interval[0].totalMicros, uint64(6));
+    CHECK_EQ(interval[0].p99Micros, uint64(3));
+    CHECK_EQ(profiler.GetTotals()[0].calls, uint64(3));
+}
+
+namespace
+{
+    // Sessions are only compared, never dereferenced.
+    WorldSession const* const s_sessionA = reinterpret_cast<WorldSession const*>(uintptr_t(0x10));
+    WorldSession const* const s_sessionB = reinterpret_cast<WorldSession const*>(uintptr_t(0x20));
+}
+
+TEST(OpcodeProfilerChargesSentBytesToTheInnermostHandler)
+{
+    OpcodeProfiler profiler(8);
+    OpcodeProfiler::NoteSent(s_sessionA, 1000);             // outside any handler
+    {
+        OpcodeProfiler::Scope outer(profiler, s_sessionA, 2, 12);
+        OpcodeProfiler::NoteSent(s_sessionA, 40);
+        {
+            OpcodeProfiler::Scope inner(profiler, s_sessionA, 5, 6);
+            OpcodeProfiler::NoteSent(s_sessionA, 7);
+        }
+        OpcodeProfiler::NoteSent(s_sessionA, 2);
+    }
+
+    std::vector<OpcodeProfile> totals = profiler.GetTotals();
+    REQUIRE(totals.size() == 2);
+    for (size_t i = 0; i < totals.size(); ++i)
+    {
+        CHECK_EQ(totals[i].calls, uint64(1));
+        CHECK_EQ(totals[i].bytesOut, totals[i].opcode == 2 ? uint64(42) : uint64(7));
+        CHECK_EQ(totals[i].bytesIn, totals[i].opcode == 2 ? uint64(12) : uint64(6));
+    }
+}
+
+TEST(OpcodeProfilerChargesSentBytesToTheHandlerOfTheReceivingSession)
+{
+    OpcodeProfiler profiler(8);
+    {
+        OpcodeProfiler::Scope outer(profiler, s_sessionA, 2, 0);
+        OpcodeProfiler::NoteSent(s_sessionB, 500);          // e.g. a whisper to another player
+        {
+            OpcodeProfiler::Scope inner(profiler, s_sessionB, 5, 0);
+            OpcodeProfiler::NoteSent(s_sessionA, 30);       // skips the other session's handler
+            OpcodeProfiler::NoteSent(s_sessionB, 4);
+        }
+    }
+
+    std::vector<OpcodeProfile> totals = profiler.GetTotals();
+    REQUIRE(totals.size() == 2);
+    for (size_t i = 0; i < totals.size(); ++i)
+    {
+        CHECK_EQ(totals[i].bytesOut, totals[i].opcode == 2 ? uint64(30) : uint64(4));
+    }
+}
+
+TEST(OpcodeProfilerMergesThreadsAndKeepsCountsOfEndedThreads)
+{
+    OpcodeProfiler profiler(4);
+    for (int round = 0; round < 3; ++round)
+    {
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 4; ++t)
+        {
+            threads.push_back(std::thread([&profiler]()
+            {
+                for (int i = 0; i < 1000; ++i)
+                {
+                    profiler.Record(1, 2, 1);
+                }
+            }));
+        }
+        for (size_t t = 0; t < threads.size(); ++t)
+        {
+            threads[t].join();
+        }
+    }
+
+    std::vector<OpcodeProfile> totals = profiler.GetTotals();
+    REQUIRE(totals.size() == 1);
+    CHECK_EQ(totals[0].calls, uint64(12000));
+    CHECK_EQ(totals[0].totalMicros, uint64(24000));
+}
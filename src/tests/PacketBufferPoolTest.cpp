@@ -0,0 +1,91 @@
+/**
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2026 MaNGOS <https://www.getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+#include "TestHarness.h"
+
+#include "Utilities/ByteBuffer.h"
+#include "Utilities/PacketBufferPool.h"
+
+#include <thread>
+
+/**
+ * @file
+ * @brief The size-classed storage behind ByteBuffer and WorldPacket.
+ */
+
+TEST(PacketBufferPoolReusesBlocksOfTheSameClass)
+{
+    MaNGOS::PacketBufferPoolStats before = MaNGOS::PacketBufferPool::GetStats();
+
+    // 200 and 130 bytes both land in the 256 byte class
+    void* first = MaNGOS::PacketBufferPool::Allocate(200);
+    MaNGOS::PacketBufferPool::Release(first, 200);
+    void* second = MaNGOS::PacketBufferPool::Allocate(130);
+    CHECK(second == first);
+    MaNGOS::PacketBufferPool::Release(second, 130);
+
+    MaNGOS::PacketBufferPoolStats after = MaNGOS::PacketBufferPool::GetStats();
+    CHECK_EQ(after.ClassSize[0], 256u);
+    CHECK_EQ(after.Allocations[0] - before.Allocations[0], 2u);
+    CHECK(after.Hits[0] - before.Hits[0] >= 1u);
+}
+
+TEST(PacketBufferPoolSendsBulkToTheHeap)
+{
+    MaNGOS::PacketBufferPoolStats before = MaNGOS::PacketBufferPool::GetStats();
+    void* bulk = MaNGOS::PacketBufferPool::Allocate(65536 + 1);
+    MaNGOS::PacketBufferPool::Release(bulk, 65536 + 1);
+    CHECK_EQ(MaNGOS::PacketBufferPool::GetStats().Oversized - before.Oversized, 1u);
+}
+
+TEST(PacketBufferPoolKeepsContentsAcrossClasses)
+{
+    // grows from the 256 byte class through every class to the heap
+    ByteBuffer buffer(16);
+    for (uint32 i = 0; i < 40000; ++i)
+    {
+        buffer << i;
+    }
+    REQUIRE(buffer.size() == 160000u);
+    for (uint32 i = 0; i < 40000; ++i)
+    {
+        CHECK_EQ(buffer.read<uint32>(), i);
+    }
+}
+
+TEST(PacketBufferPoolAcceptsBuffersFreedOnAnotherThread)
+{
+    // built on a map thread, freed by the network thread once encoded
+    ByteBuffer* buffer = new ByteBuffer(200);
+    *buffer << uint32(42);
+    std::thread sender([buffer]()
+    {
+        delete buffer;
+    });
+    sender.join();
+
+    ByteBuffer next(200);
+    next << uint32(7);
+    CHECK_EQ(next.read<uint32>(), 7u);
+}
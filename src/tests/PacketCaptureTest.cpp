@@ -0,0 +1,181 @@
+/**
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2026 MaNGOS <https://www.getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+#include "TestHarness.h"
+
+#include "PacketCapture.h"
+#include "Utilities/RNGen.h"
+
+#include <cstdio>
+#include <filesystem>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    // Unique per run, so two test binaries side by side do not read each other's capture.
+    struct TempCapture
+    {
+        std::string path;
+        TempCapture() : path((std::filesystem::temp_directory_path() /
+                              ("mangos_capture_" + std::to_string(std::random_device()()))).string()) {}
+        ~TempCapture() { std::remove(path.c_str()); }
+    };
+}
+
+TEST(PacketCaptureRoundTripsEveryRecordType)
+{
+    TempCapture file;
+    PacketCaptureWriter writer;
+    CHECK(!writer.IsOpen());
+    REQUIRE(writer.Open(file.path, 0xC0FFEE));
+    CHECK(writer.IsOpen());
+
+    WorldPacket move(0xEE, 8);
+    move << uint32(7) << uint32(0xDEADBEEF);
+    WorldPacket ping(0x1DC, 0);
+
+    writer.WriteAttach(3, 5875, "TESTER", "10.0.0.1");
+    writer.WriteTick(50);
+    writer.WritePacket(3, move);
+    writer.WritePacket(3, ping);
+    writer.WriteTick(51);
+    writer.WriteDetach(3);
+    CHECK_EQ(writer.GetTickCount(), uint64(2));
+    CHECK_EQ(writer.GetPacketCount(), uint64(2));
+    writer.Close();
+    writer.WriteTick(52);                                   // closed, dropped
+
+    PacketCaptureReader reader;
+    REQUIRE(reader.Open(file.path));
+    CHECK_EQ(reader.GetSeed(), uint32(0xC0FFEE));
+
+    CaptureRecord record;
+    REQUIRE(reader.Next(record));
+    CHECK_EQ(int(record.type), int(CAPTURE_ATTACH));
+    CHECK_EQ(record.session, uint32(3));
+    CHECK_EQ(record.build, uint32(5875));
+    CHECK(record.account == "TESTER");
+    CHECK(record.address == "10.0.0.1");
+
+    REQUIRE(reader.Next(record));
+    CHECK_EQ(int(record.type), int(CAPTURE_TICK));
+    CHECK_EQ(record.diff, uint32(50));
+
+    REQUIRE(reader.Next(record));
+    CHECK_EQ(int(record.type), int(CAPTURE_PACKET));
+    CHECK_EQ(record.packet.GetOpcode(), uint16(0xEE));
+    REQUIRE(record.packet.size() == 8);
+    CHECK_EQ(record.packet.read<uint32>(), uint32(7));
+    CHECK_EQ(record.packet.read<uint32>(), uint32(0xDEADBEEF));
+
+    REQUIRE(reader.Next(record));
+    CHECK_EQ(record.packet.GetOpcode(), uint16(0x1DC));
+    CHECK(record.packet.empty());
+
+    REQUIRE(reader.Next(record));
+    CHECK_EQ(record.diff, uint32(51));
+    REQUIRE(reader.Next(record));
+    CHECK_EQ(int(record.type), int(CAPTURE_DETACH));
+    CHECK_EQ(record.session, uint32(3));
+
+    CHECK(!reader.Next(record));
+    CHECK(!reader.IsTruncated());
+}
+
+TEST(PacketCaptureStopsAtARecordCutShort)
+{
+    TempCapture file;
+    {
+        PacketCaptureWriter writer;
+        REQUIRE(writer.Open(file.path, 1));
+        WorldPacket packet(0x95, 64);
+        packet.append(std::string(64, 'x').c_str(), 64);
+        writer.WriteTick(50);
+        writer.WritePacket(1, packet);
+    }
+
+    // The server died halfway through writing the packet.
+    std::filesystem::resize_file(file.path, std::filesystem::file_size(file.path) - 10);
+
+    PacketCaptureReader reader;
+    REQUIRE(reader.Open(file.path));
+    CaptureRecord record;
+    REQUIRE(reader.Next(record));
+    CHECK_EQ(record.diff, uint32(50));
+    CHECK(!reader.Next(record));
+    CHECK(reader.IsTruncated());
+}
+
+TEST(PacketCaptureRejectsAFileThatIsNotOne)
+{
+    TempCapture file;
+    FILE* out = fopen(file.path.c_str(), "wb");
+    REQUIRE(out != NULL);
+    fputs("not a capture at all", out);
+    fclose(out);
+
+    PacketCaptureReader reader;
+    CHECK(!reader.Open(file.path));
+
+    PacketCaptureReader missing;
+    CHECK(!missing.Open(file.path + ".missing"));
+}
+
+TEST(PacketCaptureSeedRepeatsTheWorldThreadSequence)
+{
+    std::vector<uint32> first;
+    RNG::Seed(0xC0FFEE);
+    for (int i = 0; i < 64; ++i)
+    {
+        first.push_back(RNG::instance()->rand());
+    }
+
+    RNG::Seed(0xC0FFEE);
+    for (int i = 0; i < 64; ++i)
+    {
+        CHECK_EQ(RNG::instance()->rand(), first[i]);
+    }
+
+    // The seeding thread draws from the seed itself, not from the first ordinal.
+    RNGen expected;
+    expected.seed(0xC0FFEE);
+    RNG::Seed(0xC0FFEE);
+    CHECK_EQ(RNG::instance()->rand(), expected.rand());
+}
+
+TEST(PacketCaptureSeedCountsOtherThreadsFromOne)
+{
+    RNG::Seed(1234);
+
+    uint32 drawn = 0;
+    std::thread other([&drawn]() { drawn = RNG::instance()->rand(); });
+    other.join();
+
+    RNGen expected;
+    expected.seed(1234 + 1);
+    CHECK_EQ(drawn, expected.rand());
+}
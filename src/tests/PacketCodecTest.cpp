@@ -26,7 +26,10 @@
 #include "TestHarness.h"
 
 #include "PacketCodec.h"
+#include "SharedPacket.h"
+#include "net/SendQueue.hpp"
 
+#include <memory>
 #include <vector>
 
 /**
@@ -58,6 +61,24 @@ namespace
         out.insert(out.end(), payload.begin(), payload.end());
         return out;
     }
+
+    /// Everything the next scatter write would send, gathered into one buffer.
+    std::vector<uint8> NextWrite(net::SendQueue& queue, size_t* spanCount = NULL)
+    {
+        net::SendSpan spans[net::SendQueue::MaxSpans];
+        const size_t count = queue.nextSpans(spans, net::SendQueue::MaxSpans);
+
+        std::vector<uint8> out;
+        for (size_t i = 0; i < count; ++i)
+        {
+            out.insert(out.end(), spans[i].data, spans[i].data + spans[i].len);
+        }
+        if (spanCount)
+        {
+            *spanCount = count;
+        }
+        return out;
+    }
 }
 
 TEST(PacketCodec_decodes_one_whole_packet)
@@ -238,3 +259,227 @@ TEST(PacketCodec_encode_sizes_the_header_the_way_this_expansion_does)
     CHECK_EQ(int(wire[2]), 0x02);
 #endif
 }
+
+// SendPacket hands the transport the header and the packet's own buffer as two spans
+// instead of an encoded frame, so the bytes that reach the socket must be exactly the
+// ones Encode() would have produced -- header cipher included, since the stream cipher
+// advances per header and a second pass over it would desynchronise the client.
+TEST(PacketCodec_header_and_payload_spans_match_the_encoded_frame)
+{
+    WorldPacket packet(0x01F6, 5);
+    for (uint8 i = 1; i <= 5; ++i)
+    {
+        packet << i;
+    }
+
+    // A stand-in stream cipher: stateful, so running it twice would show.
+    uint8 keyA = 0x5A;
+    uint8 keyB = 0x5A;
+    const std::vector<uint8> frame = proto::PacketCodec::Encode(packet,
+        [&keyA](uint8* header, size_t len)
+        {
+            for (size_t i = 0; i < len; ++i)
+            {
+                header[i] ^= keyA++;
+            }
+        });
+
+    uint8 header[proto::MAX_SERVER_HEADER_SIZE];
+    const size_t headerLen = proto::PacketCodec::EncodeHeader(packet,
+        [&keyB](uint8* h, size_t len)
+        {
+            for (size_t i = 0; i < len; ++i)
+            {
+                h[i] ^= keyB++;
+            }
+        }, header);
+
+    CHECK_EQ(int(headerLen), 4);
+    CHECK_EQ(int(keyA), int(keyB));
+
+    net::SendQueue queue;
+    CHECK(queue.append(header, headerLen, packet.contents(), packet.size()));
+    CHECK(!queue.append(header, 0, NULL, 0));
+
+    size_t spanCount = 0;
+    CHECK(NextWrite(queue, &spanCount) == frame);
+    CHECK_EQ(int(spanCount), 1);                          // both halves copied into one span
+}
+
+// A broadcast payload is queued by reference: the write points into the shared buffer
+// itself, and the queue lets go of it once the socket has taken every byte.
+TEST(SendQueue_shared_payload_is_sent_from_the_shared_buffer)
+{
+    const uint8 header[4] = { 1, 2, 3, 4 };
+    net::SharedPayload payload = std::make_shared<const std::vector<uint8_t> >(300, uint8(0xAB));
+
+    net::SendQueue queue;
+    CHECK(queue.append(header, sizeof(header), payload));
+    CHECK_EQ(long(payload.use_count()), 2L);
+
+    net::SendSpan spans[net::SendQueue::MaxSpans];
+    REQUIRE(queue.nextSpans(spans, net::SendQueue::MaxSpans) == 2);
+    CHECK_EQ(int(spans[0].len), 4);
+    CHECK(spans[1].data == payload->data());
+    CHECK_EQ(int(spans[1].len), 300);
+
+    queue.consume(304);
+    CHECK(queue.empty());
+    CHECK_EQ(int(queue.nextSpans(spans, net::SendQueue::MaxSpans)), 0);
+    CHECK_EQ(long(payload.use_count()), 1L);
+}
+
+// A short write can stop anywhere, including inside a shared payload; the next write
+// resumes at that byte, and copied bytes queued after it follow in order.
+TEST(SendQueue_partial_write_resumes_inside_a_shared_payload)
+{
+    const uint8 header[4] = { 1, 2, 3, 4 };
+    const uint8 tail[3] = { 7, 8, 9 };
+    std::vector<uint8_t> body(200);
+    for (size_t i = 0; i < body.size(); ++i)
+    {
+        body[i] = uint8(i);
+    }
+    net::SharedPayload payload = std::make_shared<const std::vector<uint8_t> >(body);
+
+    net::SendQueue queue;
+    CHECK(queue.append(header, sizeof(header), payload));
+    CHECK(!queue.append(tail, sizeof(tail)));             // the first append owns the write
+
+    std::vector<uint8> expected(header, header + sizeof(header));
+    expected.insert(expected.end(), body.begin(), body.end());
+    expected.insert(expected.end(), tail, tail + sizeof(tail));
+
+    size_t spanCount = 0;
+    CHECK(NextWrite(queue, &spanCount) == expected);
+    CHECK_EQ(int(spanCount), 3);
+
+    queue.consume(6);
+    net::SendSpan spans[net::SendQueue::MaxSpans];
+    REQUIRE(queue.nextSpans(spans, net::SendQueue::MaxSpans) == 2);
+    CHECK(spans[0].data == payload->data() + 2);
+    CHECK_EQ(int(spans[0].len), 198);
+
+    queue.consume(198 + sizeof(tail));
+    CHECK(queue.empty());
+    CHECK_EQ(int(queue.nextSpans(spans, net::SendQueue::MaxSpans)), 0);
+    CHECK(queue.append(tail, sizeof(tail)));              // released: the next append owns it
+}
+
+// Headers copied around shared payloads still coalesce with the copied bytes next to
+// them, so a run of broadcasts costs one span per payload plus one per gap.
+TEST(SendQueue_copied_bytes_coalesce_between_shared_payloads)
+{
+    const uint8 header[4] = { 1, 2, 3, 4 };
+    net::SharedPayload payload = std::make_shared<const std::vector<uint8_t> >(150, uint8(0x11));
+
+    net::SendQueue queue;
+    queue.append(header, sizeof(header));
+    queue.append(header, sizeof(header), payload);
+    queue.append(header, sizeof(header), payload);
+    CHECK_EQ(long(payload.use_count()), 3L);
+
+    size_t spanCount = 0;
+    CHECK_EQ(int(NextWrite(queue, &spanCount).size()), 4 + 2 * (4 + 150));
+    CHECK_EQ(int(spanCount), 4);                          // 8 bytes, payload, 4 bytes, payload
+}
+
+// SharedPacketScope snapshots a broadcast once, for that packet only, and only when
+// the payload is large enough to be worth a scatter entry of its own.
+TEST(SharedPacketScope_shares_only_its_own_large_packet)
+{
+    WorldPacket large(0x00A9, 512);
+    for (uint32 i = 0; i < 64; ++i)
+    {
+        large << uint32(i);
+    }
+    WorldPacket small(0x00A9, 4);
+    small << uint32(1);
+    WorldPacket other(0x00A9, 512);
+    other.append(large.contents(), large.size());
+
+    CHECK(!proto::SharedPacketScope::Find(large));
+    {
+        proto::SharedPacketScope outer(large);
+        proto::SharedPacketScope inner(small);
+
+        net::SharedPayload payload = proto::SharedPacketScope::Find(large);
+        REQUIRE(payload);
+        CHECK(*payload == std::vector<uint8_t>(large.contents(), large.contents() + large.size()));
+        CHECK(!proto::SharedPacketScope::Find(small));
+        CHECK(!proto::SharedPacketScope::Find(other));
+    }
+    CHECK(!proto::SharedPacketScope::Find(large));
+}
+
+// The load generator frames its requests with EncodeClient(), so what it writes has
+// to be exactly what Feed() accepts on the server side -- header cipher included.
+TEST(PacketCodec_client_encode_round_trips_through_decode)
+{
+    WorldPacket packet(0x01DC, 2);
+    packet << uint8(4);
+    packet << uint8(2);
+
+    uint8 sendKey = 0x33;
+    uint8 recvKey = 0x33;
+    const std::vector<uint8> wire = proto::PacketCodec::EncodeClient(packet,
+        [&sendKey](uint8* header, size_t len)
+        {
+            for (size_t i = 0; i < len; ++i)
+            {
+                header[i] ^= sendKey++;
+            }
+        });
+    CHECK_EQ(int(wire.size()), int(proto::CLIENT_HEADER_SIZE) + 2);
+
+    proto::PacketCodec codec([&recvKey](uint8* header, size_t len)
+        {
+            for (size_t i = 0; i < len; ++i)
+            {
+                header[i] ^= recvKey++;
+            }
+        });
+    std::vector<WorldPacket> out;
+
+    CHECK(codec.Feed(wire.data(), wire.size(), out) == proto::DecodeStatus::Ok);
+    REQUIRE(out.size() == 1);
+    CHECK_EQ(int(out[0].GetOpcode()), 0x01DC);
+    CHECK_EQ(int(out[0].size()), 2);
+    CHECK_EQ(int(sendKey), int(recvKey));
+}
+
+// Reading the server's side of the stream is the client's job: a four-byte header,
+// and no client-side ceiling on the size, since the world sends far larger packets
+// than it will ever accept.
+TEST(PacketCodec_server_stream_decodes_byte_at_a_time)
+{
+    const uint32 bigSize = proto::MAX_CLIENT_PACKET_SIZE + 1;
+    WorldPacket big(0x00A9, bigSize);
+    for (uint32 i = 0; i < bigSize; ++i)
+    {
+        big << uint8(i);
+    }
+    WorldPacket empty(0x01DD, 0);
+
+    std::vector<uint8> wire =
+        proto::PacketCodec::Encode(big, proto::PacketCodec::HeaderEncryptor());
+    const std::vector<uint8> second =
+        proto::PacketCodec::Encode(empty, proto::PacketCodec::HeaderEncryptor());
+    wire.insert(wire.end(), second.begin(), second.end());
+
+    proto::PacketCodec codec(proto::PacketCodec::HeaderDecryptor(),
+                             proto::PacketCodec::Peer::Server);
+    std::vector<WorldPacket> out;
+
+    for (size_t i = 0; i < wire.size(); ++i)
+    {
+        REQUIRE(codec.Feed(&wire[i], 1, out) == proto::DecodeStatus::Ok);
+    }
+
+    REQUIRE(out.size() == 2);
+    CHECK_EQ(int(out[0].GetOpcode()), 0x00A9);
+    CHECK_EQ(int(out[0].size()), int(bigSize));
+    CHECK_EQ(int(out[0].contents()[300]), 300 & 0xFF);
+    CHECK_EQ(int(out[1].GetOpcode()), 0x01DD);
+    CHECK_EQ(int(out[1].size()), 0);
+}
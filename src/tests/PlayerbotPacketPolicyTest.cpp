@@ -77,3 +77,17 @@ TEST(PlayerbotPacketPolicyRejectsUnsafeOpcodeHandlers)
     CHECK(ai::FindDispatchablePlayerbotOpcodeHandler(handlers, 2u, loggedIn) == NULL);
     CHECK(ai::FindDispatchablePlayerbotOpcodeHandler(handlers, 3u, loggedIn) == NULL);
 }
+
+TEST(PlayerbotPacketPolicyConsumesOnlyInlineAndHandledOpcodes)
+{
+    std::map<unsigned int, std::string> handlers;
+    handlers[7] = "known";
+    unsigned int const inlineOpcodes[] = {3u, 5u};
+
+    CHECK(ai::PlayerbotConsumesOutgoingOpcode(handlers, inlineOpcodes, 3u));
+    CHECK(ai::PlayerbotConsumesOutgoingOpcode(handlers, inlineOpcodes, 5u));
+    CHECK(ai::PlayerbotConsumesOutgoingOpcode(handlers, inlineOpcodes, 7u));
+    CHECK(!ai::PlayerbotConsumesOutgoingOpcode(handlers, inlineOpcodes, 4u));
+    CHECK(!ai::PlayerbotConsumesOutgoingOpcode(handlers, inlineOpcodes, 8u));
+    CHECK_EQ(handlers.size(), 1u);
+}
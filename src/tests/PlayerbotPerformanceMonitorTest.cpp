@@ -43,6 +43,9 @@ TEST(PlayerbotPerformanceMonitorAggregatesReportingWindows)
     monitor.RecordAiEvaluation(450);
     monitor.RecordAiDeferred();
     monitor.RecordAiDeferred();
+    monitor.RecordAiBudgetDeferred();
+    monitor.RecordAiBudgetOverrun(40);
+    monitor.RecordAiBudgetOverrun(90);
 
     CHECK(!monitor.TakeSnapshotIfDue(1499, 500, snapshot));
     CHECK(monitor.TakeSnapshotIfDue(1500, 500, snapshot));
@@ -55,6 +58,10 @@ TEST(PlayerbotPerformanceMonitorAggregatesReportingWindows)
     CHECK_EQ(snapshot.aiDeferredCount, 2u);
     CHECK_EQ(snapshot.aiEvaluationTotalMicros, 450u);
     CHECK_EQ(snapshot.aiEvaluationMaxMicros, 450u);
+    CHECK_EQ(snapshot.aiBudgetDeferredCount, 1u);
+    CHECK_EQ(snapshot.aiBudgetOverrunCount, 2u);
+    CHECK_EQ(snapshot.aiBudgetOverrunTotalMicros, 130u);
+    CHECK_EQ(snapshot.aiBudgetOverrunMaxMicros, 90u);
 
     monitor.RecordBuiltPacket(32);
     monitor.RecordEventQuery(25);
@@ -71,4 +78,6 @@ TEST(PlayerbotPerformanceMonitorAggregatesReportingWindows)
     CHECK_EQ(snapshot.aiDeferredCount, 0u);
     CHECK_EQ(snapshot.aiEvaluationTotalMicros, 50u);
     CHECK_EQ(snapshot.aiEvaluationMaxMicros, 50u);
+    CHECK_EQ(snapshot.aiBudgetDeferredCount, 0u);
+    CHECK_EQ(snapshot.aiBudgetOverrunCount, 0u);
 }
@@ -0,0 +1,84 @@
+/**
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2026 MaNGOS <https://www.getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+#include "TestHarness.h"
+
+#include "../modules/Bots/playerbot/PlayerbotUpdateScheduler.h"
+
+using ai::PlayerbotUpdateScheduler;
+
+TEST(PlayerbotUpdateSchedulerAdmitsEverythingOutsideATick)
+{
+    PlayerbotUpdateScheduler scheduler;
+    CHECK(!scheduler.IsActive());
+    scheduler.Charge(1000000);
+    CHECK(scheduler.Admit(ai::PLAYERBOT_UPDATE_IDLE, 0));
+
+    scheduler.BeginTick(0, 10);
+    scheduler.Charge(1000000);
+    CHECK(scheduler.Admit(ai::PLAYERBOT_UPDATE_IDLE, 0));
+    CHECK_EQ(scheduler.EndTick(), 0u);
+}
+
+TEST(PlayerbotUpdateSchedulerGivesEachPriorityItsShare)
+{
+    PlayerbotUpdateScheduler scheduler;
+    scheduler.BeginTick(1000, 0);
+
+    CHECK(scheduler.Admit(ai::PLAYERBOT_UPDATE_IDLE, 0));
+    scheduler.Charge(500);
+
+    // Idle bots stop at half the budget, bots near players at three quarters.
+    CHECK(!scheduler.Admit(ai::PLAYERBOT_UPDATE_IDLE, 0));
+    CHECK(scheduler.Admit(ai::PLAYERBOT_UPDATE_NEAR, 0));
+    scheduler.Charge(250);
+    CHECK(!scheduler.Admit(ai::PLAYERBOT_UPDATE_NEAR, 0));
+    CHECK(scheduler.Admit(ai::PLAYERBOT_UPDATE_COMBAT, 0));
+    scheduler.Charge(250);
+    CHECK(!scheduler.Admit(ai::PLAYERBOT_UPDATE_COMBAT, 0));
+
+    CHECK_EQ(scheduler.GetAdmitted(), 3u);
+    CHECK_EQ(scheduler.GetDeferred(), 3u);
+    CHECK_EQ(scheduler.EndTick(), 0u);
+}
+
+TEST(PlayerbotUpdateSchedulerAdmitsStarvedBotsAndReportsOverrun)
+{
+    PlayerbotUpdateScheduler scheduler;
+    scheduler.BeginTick(1000, 3);
+    scheduler.Charge(1200);
+
+    CHECK(!scheduler.Admit(ai::PLAYERBOT_UPDATE_IDLE, 2));
+    CHECK(scheduler.Admit(ai::PLAYERBOT_UPDATE_IDLE, 3));
+    scheduler.Charge(300);
+
+    CHECK_EQ(scheduler.EndTick(), 500u);
+    CHECK(!scheduler.IsActive());
+
+    // A new tick starts from nothing spent.
+    scheduler.BeginTick(1000, 3);
+    CHECK_EQ(scheduler.GetSpentMicros(), 0u);
+    CHECK(scheduler.Admit(ai::PLAYERBOT_UPDATE_IDLE, 0));
+}
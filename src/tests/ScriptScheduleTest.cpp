@@ -0,0 +1,175 @@
+/**
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2026 MaNGOS <https://www.getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+#include "TestHarness.h"
+
+#include "ScriptSchedule.h"
+
+#include <vector>
+
+/**
+ * @file
+ * @brief The order and termination rules Map::ScriptsProcess relies on.
+ */
+
+namespace
+{
+    /// The parts of ScriptAction the schedule looks at.
+    struct Step
+    {
+        int type;
+        uint32 id;
+        ObjectGuid source;
+        ObjectGuid target;
+        ObjectGuid owner;
+        int tag;
+
+        int GetType() const { return type; }
+        uint32 GetId() const { return id; }
+        ObjectGuid GetSourceGuid() const { return source; }
+        ObjectGuid GetTargetGuid() const { return target; }
+        ObjectGuid GetOwnerGuid() const { return owner; }
+
+        bool IsSameScript(int t, uint32 i, ObjectGuid s, ObjectGuid g, ObjectGuid o) const
+        {
+            return t == type && i == id && (s == source || !s) && (g == target || !g) && (o == owner || !o);
+        }
+    };
+
+    ObjectGuid Unit(uint32 counter)
+    {
+        return ObjectGuid(HIGHGUID_UNIT, uint32(100), counter);
+    }
+
+    Step MakeStep(int type, uint32 id, uint32 source, uint32 target, int tag)
+    {
+        Step step = { type, id, Unit(source), target ? Unit(target) : ObjectGuid(), ObjectGuid(), tag };
+        return step;
+    }
+
+    std::vector<int> RunDue(ScriptSchedule<Step>& schedule, time_t now)
+    {
+        std::vector<int> tags;
+        ScriptSchedule<Step>::StepId id;
+        while (Step* step = schedule.Next(now, id))
+        {
+            tags.push_back(step->tag);
+            schedule.Finish(id);
+        }
+        return tags;
+    }
+}
+
+TEST(ScriptScheduleRunsStepsByTimeThenSchedulingOrder)
+{
+    ScriptSchedule<Step> schedule;
+    schedule.Add(20, MakeStep(1, 1, 1, 0, 3));
+    schedule.Add(10, MakeStep(1, 1, 1, 0, 1));
+    schedule.Add(10, MakeStep(1, 2, 1, 0, 2));
+    schedule.Add(30, MakeStep(1, 1, 1, 0, 4));
+
+    schedule.BeginTick();
+    std::vector<int> tags = RunDue(schedule, 20);
+    REQUIRE(tags.size() == 3);
+    CHECK_EQ(tags[0], 1);
+    CHECK_EQ(tags[1], 2);
+    CHECK_EQ(tags[2], 3);
+    CHECK_EQ(schedule.size(), size_t(1));
+    CHECK_EQ(schedule.GetStepsLastTick(), uint32(3));
+
+    schedule.BeginTick();
+    CHECK(RunDue(schedule, 29).empty());
+    CHECK_EQ(RunDue(schedule, 30).size(), size_t(1));
+    CHECK(schedule.empty());
+    CHECK_EQ(schedule.GetStepsTotal(), uint64(4));
+}
+
+TEST(ScriptScheduleMatchesWithEmptyGuidsAsWildcards)
+{
+    ScriptSchedule<Step> schedule;
+    schedule.Add(10, MakeStep(1, 7, 1, 5, 1));
+    schedule.Add(10, MakeStep(1, 7, 2, 6, 2));
+
+    CHECK(schedule.IsScheduled(1, 7, Unit(1), ObjectGuid(), ObjectGuid()));
+    CHECK(schedule.IsScheduled(1, 7, ObjectGuid(), Unit(6), ObjectGuid()));
+    CHECK(schedule.IsScheduled(1, 7, ObjectGuid(), ObjectGuid(), ObjectGuid()));
+    CHECK(!schedule.IsScheduled(1, 7, Unit(1), Unit(6), ObjectGuid()));
+    CHECK(!schedule.IsScheduled(2, 7, Unit(1), ObjectGuid(), ObjectGuid()));
+    CHECK(!schedule.IsScheduled(1, 8, ObjectGuid(), ObjectGuid(), ObjectGuid()));
+}
+
+TEST(ScriptScheduleTerminationRemovesTheRunningStepAndItsSiblings)
+{
+    ScriptSchedule<Step> schedule;
+    schedule.Add(10, MakeStep(1, 7, 1, 0, 1));
+    schedule.Add(20, MakeStep(1, 7, 1, 0, 2));
+    schedule.Add(30, MakeStep(1, 7, 1, 0, 3));
+    schedule.Add(20, MakeStep(1, 7, 2, 0, 4));          // same script, other source
+    schedule.Add(20, MakeStep(1, 8, 1, 0, 5));          // other script, same source
+
+    ScriptSchedule<Step>::StepId id;
+    Step* step = schedule.Next(10, id);
+    REQUIRE(step != NULL);
+    CHECK_EQ(step->tag, 1);
+
+    // While it runs the step still counts as started, and it may schedule more.
+    CHECK(schedule.IsScheduled(1, 7, Unit(1), ObjectGuid(), ObjectGuid()));
+    schedule.Add(10, MakeStep(1, 9, 1, 0, 6));
+
+    CHECK_EQ(schedule.RemoveScript(step->GetType(), step->GetId(), step->GetSourceGuid(), step->GetTargetGuid(), step->GetOwnerGuid()), size_t(3));
+    CHECK_EQ(schedule.GetRemovedByTermination(), uint64(3));
+
+    std::vector<int> tags = RunDue(schedule, 100);
+    REQUIRE(tags.size() == 3);
+    CHECK_EQ(tags[0], 6);
+    CHECK_EQ(tags[1], 4);
+    CHECK_EQ(tags[2], 5);
+    CHECK(schedule.empty());
+}
+
+TEST(ScriptScheduleKeepsOrderThroughHeapRebuilds)
+{
+    ScriptSchedule<Step> schedule;
+    for (uint32 i = 0; i < 1000; ++i)
+    {
+        schedule.Add(time_t(1000 - i), MakeStep(1, i % 4, i, 0, int(1000 - i)));
+    }
+
+    // Removing three scripts in four leaves far more stale heap entries than live ones.
+    for (uint32 i = 0; i < 1000; ++i)
+    {
+        if (i % 4)
+        {
+            CHECK_EQ(schedule.RemoveScript(1, i % 4, Unit(i), ObjectGuid(), ObjectGuid()), size_t(1));
+        }
+    }
+    CHECK_EQ(schedule.size(), size_t(250));
+
+    std::vector<int> tags = RunDue(schedule, 1000);
+    REQUIRE(tags.size() == 250);
+    for (size_t i = 1; i < tags.size(); ++i)
+    {
+        CHECK(tags[i - 1] < tags[i]);
+    }
+}
@@ -135,3 +135,70 @@ TEST(SessionMailbox_closed_old_route_cannot_reach_replacement)
     CHECK_EQ(packet->GetOpcode(), 7);
     CHECK(!replacement->Next(raw));
 }
+
+namespace
+{
+struct StopAtOpcode
+{
+    uint16 stop;
+    bool Process(WorldPacket* packet) { return packet->GetOpcode() != stop; }
+};
+}
+
+TEST(SessionMailbox_filter_holds_the_rest_of_the_drained_batch)
+{
+    SessionMailbox mailbox;
+    CHECK(mailbox.Enqueue(MakePacket(1, 0x11)));
+    CHECK(mailbox.Enqueue(MakePacket(2, 0x22)));
+    CHECK(mailbox.Enqueue(MakePacket(3, 0x33)));
+
+    StopAtOpcode filter{2};
+    WorldPacket* raw = nullptr;
+    REQUIRE(mailbox.Next(raw, filter));
+    std::unique_ptr<WorldPacket> first(raw);
+    CHECK_EQ(first->GetOpcode(), 1);
+    CHECK(!mailbox.Next(raw, filter));
+
+    // Arrivals after the drain queue up behind the held packet.
+    CHECK(mailbox.Enqueue(MakePacket(4, 0x44)));
+    CHECK(!mailbox.Next(raw, filter));
+
+    for (uint16 opcode = 2; opcode <= 4; ++opcode)
+    {
+        REQUIRE(mailbox.Next(raw));
+        std::unique_ptr<WorldPacket> packet(raw);
+        CHECK_EQ(packet->GetOpcode(), opcode);
+    }
+    CHECK(!mailbox.Next(raw));
+}
+
+TEST(SessionMailbox_recycled_packets_are_reused)
+{
+    SessionMailbox mailbox;
+    WorldPacket source(5, 1);
+    source << uint8(0x55);
+
+    CHECK(mailbox.Enqueue(source));
+    WorldPacket* raw = nullptr;
+    REQUIRE(mailbox.Next(raw));
+    WorldPacket* first = raw;
+    mailbox.Recycle(raw);
+    CHECK_EQ(mailbox.GetAllocatedCount(), 1u);
+
+    // The freelist reaches the producer with the next drain.
+    CHECK(!mailbox.Next(raw));
+    source.SetOpcode(6);
+    CHECK(mailbox.Enqueue(source));
+    CHECK_EQ(mailbox.GetRecycledCount(), 1u);
+
+    REQUIRE(mailbox.Next(raw));
+    CHECK(raw == first);
+    CHECK_EQ(raw->GetOpcode(), 6);
+    CHECK_EQ(raw->size(), 1u);
+    CHECK_EQ((*raw)[0], 0x55);
+    mailbox.Recycle(raw);
+
+    // Recycled packets are freed with the mailbox.
+    mailbox.Close();
+    CHECK(!mailbox.Enqueue(source));
+}
@@ -0,0 +1,161 @@
+/**
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2026 MaNGOS <https://www.getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+#include "TestHarness.h"
+
+#include "Utilities/SlabPool.h"
+
+#include <set>
+#include <thread>
+#include <vector>
+
+/**
+ * @file
+ * @brief The slab pools behind Creature, GameObject, DynamicObject and Corpse.
+ */
+
+namespace
+{
+    /// Stands in for a pooled world object and the classes derived from it.
+    struct Pooled
+    {
+        MANGOS_SLAB_POOL_ALLOCATOR
+
+        Pooled() : Value(0) {}
+        virtual ~Pooled() {}
+
+        char Payload[200];
+        int Value;
+    };
+
+    MANGOS_SLAB_POOL_DEFINE(Pooled, 8)
+
+    struct Derived : public Pooled
+    {
+        char More[64];
+    };
+}
+
+TEST(SlabPoolReusesReleasedBlocks)
+{
+    MaNGOS::SlabPool pool("test", 96, 4);
+    std::vector<void*> blocks;
+    for (int i = 0; i < 6; ++i)
+    {
+        blocks.push_back(pool.Allocate(96));
+    }
+    CHECK_EQ(std::set<void*>(blocks.begin(), blocks.end()).size(), 6u);
+
+    MaNGOS::SlabPoolStats stats = pool.GetStats();
+    CHECK_EQ(stats.Slabs, 2u);
+    CHECK_EQ(stats.Capacity, 8u);
+    CHECK_EQ(stats.InUse, 6u);
+    CHECK_EQ(stats.Reused, 0u);
+
+    void* released = blocks.back();
+    blocks.pop_back();
+    pool.Release(released, 96);
+    CHECK(pool.Allocate(96) == released);
+
+    stats = pool.GetStats();
+    CHECK_EQ(stats.Allocations, 7u);
+    CHECK_EQ(stats.Reused, 1u);
+    CHECK_EQ(stats.InUse, 6u);
+    CHECK(stats.Fragmentation() > 0.24f && stats.Fragmentation() < 0.26f);
+
+    pool.Release(released, 96);
+    for (size_t i = 0; i < blocks.size(); ++i)
+    {
+        pool.Release(blocks[i], 96);
+    }
+    CHECK_EQ(pool.GetStats().InUse, 0u);
+}
+
+TEST(SlabPoolSendsOtherSizesToTheHeap)
+{
+    MaNGOS::SlabPoolStats before = Pooled::GetSlabPool().GetStats();
+
+    Pooled* base = new Pooled;
+    Pooled* derived = new Derived;
+    base->Value = 1;
+    derived->Value = 2;
+
+    MaNGOS::SlabPoolStats during = Pooled::GetSlabPool().GetStats();
+    CHECK_EQ(during.Allocations - before.Allocations, 1u);
+    CHECK_EQ(during.Oversized - before.Oversized, 1u);
+    CHECK_EQ(during.InUse - before.InUse, 1u);
+
+    // the virtual destructor hands operator delete the size of the object
+    delete derived;
+    delete base;
+    CHECK_EQ(Pooled::GetSlabPool().GetStats().InUse, before.InUse);
+}
+
+TEST(SlabPoolTakesBlocksReleasedOnOtherThreads)
+{
+    std::vector<Pooled*> objects;
+    for (int i = 0; i < 500; ++i)
+    {
+        objects.push_back(new Pooled);
+    }
+    size_t slabs = Pooled::GetSlabPool().GetStats().Slabs;
+
+    // a grid unloaded by another map thread than the one that loaded it
+    std::thread unloader([&objects]()
+    {
+        for (size_t i = 0; i < objects.size(); ++i)
+        {
+            delete objects[i];
+        }
+    });
+    unloader.join();
+    objects.clear();
+
+    // the exiting thread handed its cache back, the reload needs no new slab
+    for (int i = 0; i < 500; ++i)
+    {
+        objects.push_back(new Pooled);
+    }
+    MaNGOS::SlabPoolStats stats = Pooled::GetSlabPool().GetStats();
+    CHECK_EQ(stats.Slabs, slabs);
+    CHECK(stats.Reused >= 500u);
+
+    for (size_t i = 0; i < objects.size(); ++i)
+    {
+        delete objects[i];
+    }
+}
+
+TEST(SlabPoolStatisticsListEveryLivePool)
+{
+    Pooled::GetSlabPool();
+    bool found = false;
+    std::vector<MaNGOS::SlabPoolStats> all = MaNGOS::SlabPool::GetAllStats();
+    for (size_t i = 0; i < all.size(); ++i)
+    {
+        found = found || all[i].Name == "Pooled";
+        CHECK(all[i].Name != "test");                       // destroyed with its test
+    }
+    CHECK(found);
+}
@@ -0,0 +1,192 @@
+/**
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2026 MaNGOS <https://www.getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+#include "TestHarness.h"
+
+#include "SpellTargetInfoList.h"
+
+#include <list>
+#include <vector>
+
+/**
+ * @file
+ * @brief The unique target store of a spell cast.
+ *
+ * The last case replays what Spell::FillTargetMap does for a three-effect area
+ * spell: every candidate is added once per effect index, and the records are
+ * then walked the way Spell::handle_immediate does. It runs the same casts over
+ * the std::list store Spell used before and over SpellTargetInfoList, which must
+ * end up holding the same targets with the same effect masks.
+ */
+
+namespace
+{
+    /// The fields Spell::TargetInfo keeps, minus the hit results.
+    struct Target
+    {
+        ObjectGuid targetGUID;
+        uint64 timeDelay;
+        uint8 effectMask;
+    };
+
+    ObjectGuid Creature(uint32 counter)
+    {
+        return ObjectGuid(HIGHGUID_UNIT, uint32(1000 + counter % 17), counter);
+    }
+
+    /// Spell::AddUnitTarget as it read over a std::list.
+    void AddListTarget(std::list<Target>& targets, ObjectGuid guid, uint32 effIndex)
+    {
+        for (std::list<Target>::iterator itr = targets.begin(); itr != targets.end(); ++itr)
+        {
+            if (itr->targetGUID == guid)
+            {
+                itr->effectMask |= 1 << effIndex;
+                return;
+            }
+        }
+        Target target = { guid, 0, uint8(1 << effIndex) };
+        targets.push_back(target);
+    }
+
+    /// Spell::AddUnitTarget as it reads now.
+    void AddFlatTarget(SpellTargetInfoList<Target>& targets, ObjectGuid guid, uint32 effIndex)
+    {
+        if (Target* known = targets.Find(guid))
+        {
+            known->effectMask |= 1 << effIndex;
+            return;
+        }
+        Target target = { guid, 0, uint8(1 << effIndex) };
+        targets.push_back(target);
+    }
+
+    template<typename List>
+    uint32 EffectCount(List const& targets)
+    {
+        uint32 count = 0;
+        for (typename List::const_iterator itr = targets.begin(); itr != targets.end(); ++itr)
+        {
+            for (uint32 i = 0; i < 3; ++i)
+            {
+                count += (itr->effectMask >> i) & 1;
+            }
+        }
+        return count;
+    }
+}
+
+TEST(SpellTargetInfoListDeduplicatesAndKeepsOrder)
+{
+    SpellTargetInfoList<Target> targets;
+    for (uint32 effIndex = 0; effIndex < 3; ++effIndex)
+    {
+        // effect 1 skips the odd targets, as an immune or filtered target would
+        for (uint32 i = 0; i < 40; ++i)
+        {
+            if (effIndex != 1 || i % 2 == 0)
+            {
+                AddFlatTarget(targets, Creature(i), effIndex);
+            }
+        }
+    }
+
+    REQUIRE(targets.size() == 40u);
+    uint32 i = 0;
+    for (SpellTargetInfoList<Target>::const_iterator itr = targets.begin(); itr != targets.end(); ++itr, ++i)
+    {
+        CHECK(itr->targetGUID == Creature(i));
+        CHECK_EQ(unsigned(itr->effectMask), i % 2 ? 5u : 7u);
+    }
+    CHECK(targets.Find(Creature(40)) == NULL);
+}
+
+TEST(SpellTargetInfoListStaysSearchableAcrossClear)
+{
+    SpellTargetInfoList<Target> targets;
+    for (uint32 i = 0; i < 100; ++i)
+    {
+        AddFlatTarget(targets, Creature(i), 0);
+    }
+    REQUIRE(targets.Find(Creature(99)) != NULL);
+
+    // back to a single target: the index must not answer for the old ones
+    targets.clear();
+    CHECK(targets.empty());
+    CHECK(targets.Find(Creature(99)) == NULL);
+    AddFlatTarget(targets, Creature(7), 0);
+    AddFlatTarget(targets, Creature(7), 2);
+    REQUIRE(targets.size() == 1u);
+    CHECK_EQ(unsigned(targets.begin()->effectMask), 5u);
+}
+
+TEST(SpellTargetInfoListReusesStorageOfFinishedCasts)
+{
+    Target const* first = NULL;
+    {
+        SpellTargetInfoList<Target> cast;
+        AddFlatTarget(cast, Creature(1), 0);
+        first = &*cast.begin();
+    }
+
+    // the next cast on this thread picks up the storage the last one released
+    SpellTargetInfoList<Target> next;
+    AddFlatTarget(next, Creature(2), 0);
+    CHECK(&*next.begin() == first);
+}
+
+TEST(SpellTargetInfoListAreaSpellMatchesListStore)
+{
+    const uint32 casts = 20;
+    const uint32 sizes[] = { 1, 5, 40, 60, 200 };
+
+    for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); ++s)
+    {
+        uint32 n = sizes[s];
+        for (uint32 c = 0; c < casts; ++c)
+        {
+            std::list<Target> list;
+            SpellTargetInfoList<Target> flat;
+            for (uint32 effIndex = 0; effIndex < 3; ++effIndex)
+            {
+                for (uint32 i = 0; i < n; ++i)
+                {
+                    AddListTarget(list, Creature(c * 7 + i), effIndex);
+                    AddFlatTarget(flat, Creature(c * 7 + i), effIndex);
+                }
+            }
+
+            CHECK_EQ(EffectCount(flat), EffectCount(list));
+            CHECK_EQ(EffectCount(flat), n * 3);
+            REQUIRE(flat.size() == list.size());
+
+            std::list<Target>::const_iterator litr = list.begin();
+            for (SpellTargetInfoList<Target>::const_iterator fitr = flat.begin(); fitr != flat.end(); ++fitr, ++litr)
+            {
+                CHECK(fitr->targetGUID == litr->targetGUID);
+                CHECK_EQ(int(fitr->effectMask), int(litr->effectMask));
+            }
+        }
+    }
+}
@@ -29,6 +29,7 @@
 #include "terrain/Terrain.hpp"
 #include "terrain/WmoModel.hpp"
 
+#include <algorithm>
 #include <cmath>
 #include <cstdint>
 #include <random>
@@ -230,6 +231,151 @@ TEST(BvhEmptySoupIsQueryableAndMisses)
     CHECK(!bvh.Raycast(soup, Vec3{0, 0, 10}, Vec3{0, 0, -1}, 100.f).has_value());
 }
 
+TEST(WideBvhFindsTheSameNearestHitAsTheBinaryTree)
+{
+    std::mt19937 rng(0xB4B4);
+    TriSoup soup = RandomSoup(rng, 1200, 60.f);
+
+    Bvh bvh;
+    bvh.Build(soup, nullptr, 4);
+    WideBvh wide;
+    wide.Collapse(bvh);
+    REQUIRE(!wide.Empty());
+    CHECK(wide.Valid(soup.tris.size()));
+    CHECK(wide.NodeCount() < bvh.NodeCount());
+
+    // Not merely close: the wide walk reaches every leaf the binary one does, and
+    // rayTri decides, so the nearest t is the same float.
+    std::uniform_real_distribution<float> pos(-70.f, 70.f);
+    std::uniform_real_distribution<float> dir(-1.f, 1.f);
+    size_t mismatches = 0;
+    for (int i = 0; i < 6000; ++i)
+    {
+        const bool column = (i & 1) != 0;
+        const Vec3 o{pos(rng), pos(rng), column ? 200.f : pos(rng)};
+        Vec3 d{0.f, 0.f, -1.f};
+        if (!column)
+        {
+            d = Vec3{dir(rng), dir(rng), dir(rng)};
+            if (d.squaredMagnitude() < 1e-6f)
+            {
+                continue;
+            }
+            d = d.direction();
+        }
+
+        uint32_t binaryTri = 0, wideTri = 0;
+        const auto binary = bvh.Raycast(soup, o, d, 500.f, &binaryTri);
+        const auto fast = wide.Raycast(soup, o, d, 500.f, &wideTri);
+        const auto slow = BruteForce(soup, o, d, 500.f);
+
+        if (fast.has_value() != binary.has_value() || fast.has_value() != slow.has_value())
+        {
+            ++mismatches;
+        }
+        else if (fast && (*fast != *binary || std::fabs(*fast - *slow) > 1e-3f))
+        {
+            ++mismatches;
+        }
+        else if (fast && wideTri != binaryTri && *rayTri(o, d, soup.At(wideTri)) != *fast)
+        {
+            // Two triangles at exactly the same t may be reported either way round.
+            ++mismatches;
+        }
+    }
+    CHECK_EQ(mismatches, size_t(0));
+}
+
+TEST(WideBvhCrossesTheSameTrianglesAsTheBinaryTree)
+{
+    std::mt19937 rng(19);
+    TriSoup soup = RandomSoup(rng, 800, 30.f);
+
+    Bvh bvh;
+    bvh.Build(soup, nullptr, 4);
+    WideBvh wide;
+    wide.Collapse(bvh);
+
+    auto sorted = [](std::vector<Bvh::Crossing>& v)
+    {
+        std::sort(v.begin(), v.end(), [](const Bvh::Crossing& a, const Bvh::Crossing& b)
+                  { return a.tri < b.tri; });
+    };
+
+    std::uniform_real_distribution<float> pos(-35.f, 35.f);
+    std::vector<Bvh::Crossing> binary, fast;
+    size_t mismatches = 0, crossed = 0;
+    for (int i = 0; i < 2000; ++i)
+    {
+        const Vec3 o{pos(rng), pos(rng), 100.f};
+        const Vec3 d{0.f, 0.f, -1.f};
+        binary.clear();
+        fast.clear();
+        bvh.RaycastAll(soup, o, d, 300.f, binary);
+        wide.RaycastAll(soup, o, d, 300.f, fast);
+        sorted(binary);
+        sorted(fast);
+
+        crossed += binary.size();
+        if (binary.size() != fast.size())
+        {
+            ++mismatches;
+            continue;
+        }
+        for (size_t k = 0; k < binary.size(); ++k)
+        {
+            if (binary[k].tri != fast[k].tri || binary[k].t != fast[k].t)
+            {
+                ++mismatches;
+            }
+        }
+    }
+    CHECK_EQ(mismatches, size_t(0));
+    CHECK(crossed > 0);
+}
+
+TEST(WideBvhValidRejectsACorruptNodeTable)
+{
+    std::mt19937 rng(23);
+    TriSoup soup = RandomSoup(rng, 300, 20.f);
+
+    Bvh bvh;
+    bvh.Build(soup, nullptr, 2);
+    WideBvh wide;
+    wide.Collapse(bvh);
+    REQUIRE(wide.NodeCount() > 1);
+    REQUIRE(wide.Valid(soup.tris.size()));
+
+    // Each of these would send the walk out of bounds or round in a circle.
+    auto corrupt = [&](auto&& edit)
+    {
+        std::vector<WideBvh::Node> nodes = wide.Nodes();
+        edit(nodes);
+        WideBvh bad;
+        bad.Adopt(std::move(nodes));
+        return !bad.Valid(soup.tris.size());
+    };
+
+    CHECK(corrupt([](std::vector<WideBvh::Node>& n) { n[0].child[0] = 0; }));
+    CHECK(corrupt([](std::vector<WideBvh::Node>& n)
+                  { n[0].child[0] = int32_t(n.size()); }));
+    CHECK(corrupt([&](std::vector<WideBvh::Node>& n)
+                  {
+                      for (auto& node : n)
+                      {
+                          for (int k = 0; k < WideBvh::WIDTH; ++k)
+                          {
+                              if (node.child[k] == WideBvh::LEAF)
+                              {
+                                  node.first[k] = uint32_t(soup.tris.size());
+                                  return;
+                              }
+                          }
+                      }
+                  }));
+    CHECK(!wide.Valid(soup.tris.size() - 1));
+}
+
 TEST(CollisionModelBoundsCoverEveryTriangle)
 {
     TriSoup soup;
@@ -0,0 +1,141 @@
+/**
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2026 MaNGOS <https://www.getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+#include "TestHarness.h"
+
+#include "VisibilityScheduler.h"
+
+#include <vector>
+
+namespace
+{
+    ObjectGuid Unit(uint32 counter)
+    {
+        return ObjectGuid(HIGHGUID_UNIT, uint32(100), counter);
+    }
+}
+
+TEST(VisibilityScheduler_off_updates_at_relocation)
+{
+    VisibilityScheduler scheduler;
+    CHECK(!scheduler.Schedule(Unit(1)));
+    CHECK_EQ(scheduler.GetPendingCount(), size_t(0));
+    CHECK(!scheduler.Update(1000));
+}
+
+TEST(VisibilityScheduler_coalesces_relocations_into_one_pass)
+{
+    VisibilityScheduler scheduler;
+    scheduler.SetInterval(100);
+
+    // A unit moving after a quiet spell is updated on the next tick.
+    CHECK(scheduler.Schedule(Unit(1)));
+    CHECK(scheduler.Update(50));
+    std::vector<ObjectGuid> batch;
+    scheduler.TakeBatch(batch);
+    REQUIRE(batch.size() == 1u);
+
+    // While it keeps moving, its relocations wait for the next pass and count once.
+    for (uint32 i = 0; i < 5; ++i)
+    {
+        CHECK(scheduler.Schedule(Unit(1)));
+        CHECK(scheduler.Schedule(Unit(2)));
+        CHECK(!scheduler.Update(15));
+    }
+    CHECK_EQ(scheduler.GetPendingCount(), size_t(2));
+    CHECK(scheduler.Update(30));
+
+    batch.clear();
+    scheduler.TakeBatch(batch);
+    REQUIRE(batch.size() == 2u);
+    CHECK(batch[0] == Unit(1));
+    CHECK(batch[1] == Unit(2));
+    CHECK_EQ(scheduler.GetScheduledTotal(), uint64(11));
+    CHECK_EQ(scheduler.GetCoalescedTotal(), uint64(8));
+    CHECK_EQ(scheduler.GetPassesTotal(), uint64(2));
+    CHECK_EQ(scheduler.GetUpdatedTotal(), uint64(3));
+
+    // Queued again once taken.
+    CHECK(scheduler.Schedule(Unit(1)));
+    CHECK_EQ(scheduler.GetPendingCount(), size_t(1));
+}
+
+TEST(VisibilityScheduler_batch_limit_carries_the_rest_to_the_next_tick)
+{
+    VisibilityScheduler scheduler;
+    scheduler.SetInterval(200);
+    scheduler.SetBatchLimit(4);
+
+    for (uint32 i = 1; i <= 10; ++i)
+    {
+        scheduler.Schedule(Unit(i));
+    }
+
+    std::vector<ObjectGuid> taken;
+    uint32 passes = 0;
+    while (scheduler.Update(10))
+    {
+        std::vector<ObjectGuid> batch;
+        scheduler.TakeBatch(batch);
+        CHECK(batch.size() <= 4u);
+        taken.insert(taken.end(), batch.begin(), batch.end());
+        ++passes;
+    }
+
+    CHECK_EQ(passes, 3u);
+    CHECK_EQ(scheduler.GetLastPassSize(), 2u);
+    REQUIRE(taken.size() == 10u);
+    for (uint32 i = 0; i < 10; ++i)
+    {
+        CHECK(taken[i] == Unit(i + 1));
+    }
+
+    // Backlog done: the next unit waits for the interval again.
+    scheduler.Schedule(Unit(11));
+    CHECK(!scheduler.Update(10));
+    CHECK(scheduler.Update(190));
+}
+
+TEST(VisibilityScheduler_switching_off_flushes_pending)
+{
+    VisibilityScheduler scheduler;
+    scheduler.SetInterval(1000);
+    scheduler.Schedule(Unit(1));
+    scheduler.Update(2000);
+    std::vector<ObjectGuid> batch;
+    scheduler.TakeBatch(batch);
+
+    scheduler.Schedule(Unit(2));
+    CHECK(!scheduler.Update(10));
+
+    scheduler.SetInterval(0);
+    CHECK(!scheduler.Schedule(Unit(3)));
+    CHECK(scheduler.Update(0));
+    batch.clear();
+    scheduler.TakeBatch(batch);
+    REQUIRE(batch.size() == 1u);
+    CHECK(batch[0] == Unit(2));
+    CHECK(!scheduler.Update(0));
+}
@@ -0,0 +1,294 @@
+/**
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2026 MaNGOS <https://www.getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file AccelBench.cpp
+ * @brief IS THE WIDE BVH FASTER, AND DOES IT STILL ANSWER EXACTLY WHAT THE BINARY ONE DID?
+ *
+ * The baker builds a binary BVH and the server walks the four-wide tree collapsed from
+ * it. Both claims that buys -- fewer, fatter nodes walk faster; folding levels away
+ * changes no answer -- are about real geometry, so this measures them on real tiles and
+ * not on the random soups the unit tests use. For every distinct model in the tiles it
+ * rebuilds the binary tree from the model's own triangles, collapses it, and shoots the
+ * same rays through both:
+ *
+ *   - half aimed at random through the model's bounds, half straight down onto it: the
+ *     floor probe is the query the server makes most, and the one whose ray runs
+ *     parallel to two slabs, which is where a broadphase goes wrong;
+ *   - each tree timed over the whole set on its own, so neither warms the cache for
+ *     the other within a ray;
+ *   - every ray where the nearest t differs counted, and the brute-force answer printed
+ *     beside it, since only that says which tree was wrong.
+ *
+ * A mismatch is a bug, not noise: the wide walk tests a subset of the binary walk's
+ * boxes and the same triangles, so the nearest hit must be the same float.
+ */
+
+#include "terrain/CollisionModel.hpp"
+#include "terrain/Terrain.hpp"
+#include "terrain/TileSerializer.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <optional>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+using namespace world::terrain;
+
+namespace
+{
+    struct Ray
+    {
+        Vec3 o, d;
+        float tMax = 0.f;
+    };
+
+    struct Totals
+    {
+        size_t models = 0;
+        size_t tris = 0;
+        size_t rays = 0;
+        size_t mismatches = 0;
+        size_t binaryBytes = 0;
+        size_t wideBytes = 0;
+        size_t binaryNodes = 0;
+        size_t wideNodes = 0;
+        double binarySeconds = 0.0;
+        double wideSeconds = 0.0;
+    };
+
+    std::optional<float> BruteForce(const TriSoup& soup, const Ray& r)
+    {
+        std::optional<float> best;
+        for (uint32_t i = 0; i < soup.tris.size(); ++i)
+        {
+            if (auto t = rayTri(r.o, r.d, soup.At(i)))
+            {
+                if (*t >= 0.f && *t < r.tMax && (!best || *t < *best))
+                {
+                    best = *t;
+                }
+            }
+        }
+        return best;
+    }
+
+    std::vector<Ray> MakeRays(const Aabb& box, size_t count, std::mt19937& rng)
+    {
+        const Vec3 pad{2.f, 2.f, 2.f};
+        const Vec3 lo = box.lo - pad, hi = box.hi + pad;
+        std::uniform_real_distribution<float> ux(lo.x, hi.x), uy(lo.y, hi.y),
+            uz(lo.z, hi.z), dir(-1.f, 1.f);
+        const float span = (hi - lo).magnitude();
+
+        std::vector<Ray> rays;
+        rays.reserve(count);
+        while (rays.size() < count)
+        {
+            Ray r;
+            if ((rays.size() & 1) != 0)
+            {
+                r.o = Vec3{ux(rng), uy(rng), hi.z};
+                r.d = Vec3{0.f, 0.f, -1.f};
+                r.tMax = hi.z - lo.z;
+            }
+            else
+            {
+                r.o = Vec3{ux(rng), uy(rng), uz(rng)};
+                r.d = Vec3{dir(rng), dir(rng), dir(rng)};
+                if (r.d.squaredMagnitude() < 1e-6f)
+                {
+                    continue;
+                }
+                r.d = r.d.direction();
+                r.tMax = span;
+            }
+            rays.push_back(r);
+        }
+        return rays;
+    }
+
+    template <class Tree>
+    double Time(const Tree& tree, const TriSoup& soup, const std::vector<Ray>& rays,
+                std::vector<std::optional<float>>& out)
+    {
+        out.resize(rays.size());
+        const auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < rays.size(); ++i)
+        {
+            out[i] = tree.Raycast(soup, rays[i].o, rays[i].d, rays[i].tMax);
+        }
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start)
+            .count();
+    }
+
+    void Bench(const CollisionModel& model, size_t raysPerModel, std::mt19937& rng,
+               bool verbose, Totals& total)
+    {
+        // The model's soup is already in its tree's leaf order; building again over a
+        // copy gives the binary tree the baker would have, and collapsing that gives the
+        // wide tree the server would have.
+        TriSoup soup = model.Soup();
+        Bvh binary;
+        binary.Build(soup);
+        WideBvh wide;
+        wide.Collapse(binary);
+
+        const std::vector<Ray> rays = MakeRays(model.Bounds(), raysPerModel, rng);
+        std::vector<std::optional<float>> a, b;
+        total.binarySeconds += Time(binary, soup, rays, a);
+        total.wideSeconds += Time(wide, soup, rays, b);
+
+        for (size_t i = 0; i < rays.size(); ++i)
+        {
+            if (a[i] == b[i])
+            {
+                continue;
+            }
+            ++total.mismatches;
+            if (verbose)
+            {
+                const auto truth = BruteForce(soup, rays[i]);
+                std::printf("  MISMATCH o=(%.4f %.4f %.4f) d=(%.4f %.4f %.4f): "
+                            "binary %.6f wide %.6f brute %.6f\n",
+                            rays[i].o.x, rays[i].o.y, rays[i].o.z, rays[i].d.x,
+                            rays[i].d.y, rays[i].d.z, a[i] ? *a[i] : -1.f,
+                            b[i] ? *b[i] : -1.f, truth ? *truth : -1.f);
+            }
+        }
+
+        ++total.models;
+        total.tris += soup.tris.size();
+        total.rays += rays.size();
+        total.binaryNodes += binary.NodeCount();
+        total.wideNodes += wide.NodeCount();
+        total.binaryBytes += binary.NodeCount() * sizeof(Bvh::Node);
+        total.wideBytes += wide.MemoryBytes();
+    }
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 2)
+    {
+        std::printf("usage: mangos-accelbench <tileDir> [--map <id>] [--rays <n>] [--verbose]\n"
+                    "\n"
+                    "  tileDir   : baked tiles, or baked gomodels -- any directory of .tile\n"
+                    "  --map <id>: only that map's tiles\n"
+                    "  --rays <n>: rays per model                        (default: 20000)\n"
+                    "  --verbose : one line per mismatching ray, with the brute-force t\n");
+        return 2;
+    }
+
+    const std::string dir = argv[1];
+    int mapFilter = -1;
+    size_t raysPerModel = 20000;
+    bool verbose = false;
+    for (int i = 2; i < argc; ++i)
+    {
+        const std::string a = argv[i];
+        if (a == "--map" && i + 1 < argc)
+        {
+            mapFilter = std::atoi(argv[++i]);
+        }
+        else if (a == "--rays" && i + 1 < argc)
+        {
+            raysPerModel = size_t(std::strtoul(argv[++i], nullptr, 10));
+        }
+        else if (a == "--verbose")
+        {
+            verbose = true;
+        }
+    }
+
+    // A tile's file name leads with its map: t_<map>_<x>_<y> or w_<map>.
+    const std::string tilePrefix = "t_" + std::to_string(mapFilter) + "_";
+    const std::string wmoName = "w_" + std::to_string(mapFilter) + ".tile";
+
+    std::mt19937 rng(0xACCE1);
+    std::set<const ICollisionModel*> seen;
+    std::vector<std::shared_ptr<TerrainTile>> keep;
+    Totals total;
+
+    std::error_code ec;
+    for (const auto& entry : std::filesystem::directory_iterator(dir, ec))
+    {
+        const std::string name = entry.path().filename().string();
+        if (entry.path().extension() != ".tile")
+        {
+            continue;
+        }
+        if (mapFilter >= 0 && name.compare(0, tilePrefix.size(), tilePrefix) != 0 &&
+            name != wmoName)
+        {
+            continue;
+        }
+
+        std::shared_ptr<TerrainTile> tile = ReadTile(entry.path().string());
+        if (!tile)
+        {
+            std::printf("  skipped %s: not a readable tile\n", name.c_str());
+            continue;
+        }
+        for (const StaticInstance& inst : tile->instances)
+        {
+            // Models are shared between placements within a tile; time each once.
+            const auto* model = dynamic_cast<const CollisionModel*>(inst.model.get());
+            if (!model || model->Empty() || !seen.insert(inst.model.get()).second)
+            {
+                continue;
+            }
+            Bench(*model, raysPerModel, rng, verbose, total);
+        }
+        keep.push_back(std::move(tile));   // so a freed model's address is never reused
+    }
+    if (ec)
+    {
+        std::printf("cannot read %s: %s\n", dir.c_str(), ec.message().c_str());
+        return 2;
+    }
+    if (total.rays == 0)
+    {
+        std::printf("no models under %s\n", dir.c_str());
+        return 2;
+    }
+
+    const double binaryRate = double(total.rays) / total.binarySeconds;
+    const double wideRate = double(total.rays) / total.wideSeconds;
+    std::printf("%zu models, %zu triangles, %zu rays each way\n\n", total.models,
+                total.tris, total.rays);
+    std::printf("            nodes        bytes     rays/s\n");
+    std::printf("  binary %8zu %12zu %10.0f\n", total.binaryNodes, total.binaryBytes,
+                binaryRate);
+    std::printf("  wide   %8zu %12zu %10.0f\n", total.wideNodes, total.wideBytes,
+                wideRate);
+    std::printf("\n  speedup %.2fx, node memory %.2fx, %zu mismatching rays\n",
+                wideRate / binaryRate, double(total.wideBytes) / double(total.binaryBytes),
+                total.mismatches);
+
+    return total.mismatches == 0 ? 0 : 1;
+}
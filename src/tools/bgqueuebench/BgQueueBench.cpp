@@ -0,0 +1,261 @@
+/**
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2026 MaNGOS <https://www.getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+/**
+ * @file BgQueueBench.cpp
+ * @brief DOES SEARCHING THE BRACKETS ON A TASKPOOL PAY, AND DOES IT PICK WHAT THE SERIAL SEARCH DID?
+ *
+ * BattleGroundMgr::Update searches every bracket of every queue for a match, and the
+ * brackets are independent, so the searches run on a TaskPool and only the invites are
+ * applied one after another. The unit tests show on a few hundred groups that the pool
+ * picks exactly the groups a serial pass does; this is the full-size run the timing
+ * claim rests on:
+ *
+ *   - three battleground types times six brackets, each filled with thousands of
+ *     synthetic groups -- mostly solo and small parties, one in twenty a premade --
+ *     with Warsong and Arathi sized teams side by side;
+ *   - every round searched twice over identical queues, once bracket by bracket and
+ *     once on the pool, each timed on its own;
+ *   - the selected groups compared side by side and counted where they differ, then
+ *     invited on both, exactly as BattleGroundMgr::Update applies a match.
+ */
+
+#include "BattleGroundQueueMatch.h"
+#include "Threading/TaskPool.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+    /// Owns the groups and lists of one bracket, the way BattleGroundQueue does.
+    struct Bracket
+    {
+        std::vector<GroupQueueInfo*> Owned;
+        BattleGroundGroupList Groups[BG_QUEUE_GROUP_TYPES_COUNT];
+        BattleGroundBracketMatcher Matcher;
+        uint32 NextPlayer;
+
+        Bracket() : NextPlayer(1)
+        {
+            Matcher.Attach(Groups);
+        }
+
+        Bracket(const Bracket&) = delete;
+        Bracket& operator=(const Bracket&) = delete;
+
+        ~Bracket()
+        {
+            for (size_t i = 0; i < Owned.size(); ++i)
+            {
+                delete Owned[i];
+            }
+        }
+
+        void Add(BattleGroundQueueGroupTypes type, uint32 size, uint32 joinTime)
+        {
+            GroupQueueInfo* ginfo = new GroupQueueInfo();
+            ginfo->GroupTeam = (type == BG_QUEUE_PREMADE_ALLIANCE || type == BG_QUEUE_NORMAL_ALLIANCE) ? ALLIANCE : HORDE;
+            ginfo->BgTypeId = BATTLEGROUND_WS;
+            ginfo->JoinTime = joinTime;
+            ginfo->RemoveInviteTime = 0;
+            ginfo->IsInvitedToBGInstanceGUID = 0;
+            for (uint32 i = 0; i < size; ++i)
+            {
+                ginfo->Players[ObjectGuid(HIGHGUID_PLAYER, NextPlayer++)] = NULL;
+            }
+            Owned.push_back(ginfo);
+            Groups[type].push_back(ginfo);
+        }
+    };
+
+    /// What ApplyMatch does to the queue: the selected groups become invited.
+    void Invite(BattleGroundBracketMatcher const& matcher, uint32 instance)
+    {
+        for (uint32 i = 0; i < PVP_TEAM_COUNT; ++i)
+        {
+            BattleGroundGroupList const& selected = matcher.GetPool(i).SelectedGroups;
+            for (BattleGroundGroupList::const_iterator itr = selected.begin(); itr != selected.end(); ++itr)
+            {
+                (*itr)->IsInvitedToBGInstanceGUID = instance;
+            }
+        }
+    }
+
+    /// True if both searches selected the same groups, in the same order, on both sides.
+    bool SameSelection(BattleGroundBracketMatcher const& a, BattleGroundBracketMatcher const& b)
+    {
+        for (uint32 i = 0; i < PVP_TEAM_COUNT; ++i)
+        {
+            BattleGroundGroupList const& s = a.GetPool(i).SelectedGroups;
+            BattleGroundGroupList const& p = b.GetPool(i).SelectedGroups;
+            if (s.size() != p.size())
+            {
+                return false;
+            }
+            BattleGroundGroupList::const_iterator sitr = s.begin();
+            BattleGroundGroupList::const_iterator pitr = p.begin();
+            for (; sitr != s.end(); ++sitr, ++pitr)
+            {
+                if ((*sitr)->Players.begin()->first != (*pitr)->Players.begin()->first)
+                {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    double Seconds(std::chrono::steady_clock::duration d)
+    {
+        return std::chrono::duration<double>(d).count();
+    }
+}
+
+int main(int argc, char** argv)
+{
+    uint32 groupsPerBracket = 4000;
+    uint32 rounds = 200;
+    uint32 threads = 4;
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string a = argv[i];
+        if (a == "--groups" && i + 1 < argc)
+        {
+            groupsPerBracket = uint32(std::strtoul(argv[++i], nullptr, 10));
+        }
+        else if (a == "--rounds" && i + 1 < argc)
+        {
+            rounds = uint32(std::strtoul(argv[++i], nullptr, 10));
+        }
+        else if (a == "--threads" && i + 1 < argc)
+        {
+            threads = uint32(std::strtoul(argv[++i], nullptr, 10));
+        }
+        else
+        {
+            std::printf("usage: mangos-bgqueuebench [--groups <n>] [--rounds <n>] [--threads <n>]\n"
+                        "\n"
+                        "  --groups <n> : queued groups per bracket            (default: 4000)\n"
+                        "  --rounds <n> : invitation rounds                    (default: 200)\n"
+                        "  --threads <n>: TaskPool workers                     (default: 4)\n");
+            return 2;
+        }
+    }
+
+    // Three battleground types times six brackets, the scheduler's worst case.
+    const size_t brackets = 3 * 6;
+
+    std::vector<Bracket> serial(brackets);
+    std::vector<Bracket> pooled(brackets);
+    std::vector<BattleGroundMatchRules> rules(brackets);
+
+    std::mt19937 rng(0x5EED);
+    for (size_t b = 0; b < brackets; ++b)
+    {
+        // Warsong and Arathi sized teams side by side.
+        rules[b].MinPlayersPerTeam = b % 2 ? 5 : 8;
+        rules[b].MaxPlayersPerTeam = b % 2 ? 10 : 15;
+        rules[b].PremadeJoinedBefore = 500;
+        rules[b].BalancedInvites = (b % 3) == 0;
+        rules[b].Testing = false;
+        for (uint32 g = 0; g < groupsPerBracket; ++g)
+        {
+            BattleGroundQueueGroupTypes type = BattleGroundQueueGroupTypes(rng() % 20 ? BG_QUEUE_NORMAL_ALLIANCE + rng() % 2 : rng() % 2);
+            uint32 size = type <= BG_QUEUE_PREMADE_HORDE ? 5 + rng() % 6 : 1 + rng() % 5;
+            uint32 joinTime = rng() % 1000;
+            serial[b].Add(type, size, joinTime);
+            pooled[b].Add(type, size, joinTime);
+        }
+    }
+
+    MaNGOS::TaskPool pool;
+    if (!pool.Activate(threads))
+    {
+        std::printf("cannot start %u pool workers\n", unsigned(threads));
+        return 2;
+    }
+
+    std::vector<BattleGroundMatchResult> serialResult(brackets);
+    std::vector<BattleGroundMatchResult> pooledResult(brackets);
+    std::chrono::steady_clock::duration serialTime(0), pooledTime(0);
+    uint32 started = 0;
+    uint32 mismatches = 0;
+
+    for (uint32 round = 1; round <= rounds; ++round)
+    {
+        std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+        for (size_t b = 0; b < brackets; ++b)
+        {
+            serialResult[b] = serial[b].Matcher.Match(rules[b]);
+        }
+        serialTime += std::chrono::steady_clock::now() - begin;
+
+        begin = std::chrono::steady_clock::now();
+        for (size_t b = 0; b < brackets; ++b)
+        {
+            Bracket* bracket = &pooled[b];
+            BattleGroundMatchRules const* bracketRules = &rules[b];
+            BattleGroundMatchResult* result = &pooledResult[b];
+            pool.Schedule([bracket, bracketRules, result]()
+            {
+                *result = bracket->Matcher.Match(*bracketRules);
+            });
+        }
+        pool.Wait();
+        pooledTime += std::chrono::steady_clock::now() - begin;
+
+        // Compare, then invite serially, exactly as BattleGroundMgr::Update applies matches.
+        for (size_t b = 0; b < brackets; ++b)
+        {
+            if (pooledResult[b] != serialResult[b] || !SameSelection(serial[b].Matcher, pooled[b].Matcher))
+            {
+                ++mismatches;
+            }
+            if (serialResult[b] != BG_MATCH_NONE)
+            {
+                Invite(serial[b].Matcher, round);
+                Invite(pooled[b].Matcher, round);
+                ++started;
+            }
+        }
+    }
+
+    pool.Deactivate();
+
+    std::printf("%u brackets x %u groups, %u rounds, %u matches started\n\n",
+                unsigned(brackets), unsigned(groupsPerBracket), unsigned(rounds), unsigned(started));
+    std::printf("                  rounds/s\n");
+    std::printf("  serial        %10.0f\n", rounds / Seconds(serialTime));
+    std::printf("  pool (%2u)     %10.0f\n", unsigned(threads), rounds / Seconds(pooledTime));
+    std::printf("\n  speedup %.2fx, %u mismatching bracket searches\n",
+                Seconds(serialTime) / Seconds(pooledTime), unsigned(mismatches));
+
+    return mismatches ? 1 : 0;
+}
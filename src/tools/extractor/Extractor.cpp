@@ -32,6 +32,7 @@
 #include <memory>
 #include "ExtractorConsole.hpp"
 #include "nav/NavMeshBuilder.hpp"
+#include "client/BakeManifest.hpp"
 #include "client/ModelLoaders.hpp"
 #include "client/MpqTileSource.hpp"
 #include "client/StormLibArchive.hpp"
@@ -41,6 +42,7 @@
 #include "terrain/TileSerializer.hpp"
 
 #include <algorithm>
+#include <atomic>
 #include <chrono>
 #include <cstdio>
 #include <cctype>
@@ -49,6 +51,7 @@
 #include <fstream>
 #include <sstream>
 #include <string>
+#include <thread>
 #include <vector>
 
 #ifndef MANGOS_CLIENT_NAME
@@ -71,6 +74,7 @@ namespace
         bool goModels = false;
         bool vessels = false;
         bool nav = false;
+        bool upgrade = false;
         std::string vesselList;
 
         // Whether the command line named components itself. Naming them is an
@@ -82,8 +86,17 @@ namespace
         bool help = false;
         std::string offMesh;
         int threads = 0;
+        bool incremental = false;
     };
 
+    // Bump whenever a change to the parsers or the model loaders changes what a tile
+    // holds, so an incremental bake does not keep tiles the old code wrote.
+    constexpr uint32_t TILE_BAKE_VERSION = 1;
+
+    // Beside the tiles it describes. The nav bake and the server only look at t_ and w_
+    // names, so it is invisible to both.
+    const char* const TILE_MANIFEST = "tiles.manifest";
+
     ExtractorConsole g_console;
     std::chrono::steady_clock::time_point g_started;
 
@@ -161,6 +174,10 @@ namespace
 "  nav        the navmesh, built FROM THE TILES, never from the client, so\n"
 "             the pathfinder walks exactly the surface collision answers with.\n"
 "  all        every one of the above, in that order.\n"
+"  upgrade    rewrite baked tiles and gomodels left by an older cache format\n"
+"             in the current one, in place. No client needed; never part of\n"
+"             all. The server reads the older format too -- this just spares\n"
+"             it the conversion on every load.\n"
 "\n"
 "WHERE\n"
 "\n"
@@ -186,6 +203,12 @@ namespace
 "  --map <id>      bake only this map id. For chasing one map, not for a\n"
 "                  real bake.\n"
 "  --threads <n>   worker threads                    (default: all cores)\n"
+"  --incremental   tile: skip every tile whose ADT, models and this tool's\n"
+"                  version hash as they did in the last bake (recorded in\n"
+"                  tiles/tiles.manifest). For re-baking after a data refresh.\n"
+"                  nav: likewise skip every mmtile whose tile, neighbours,\n"
+"                  offmesh links and settings are unchanged (recorded in\n"
+"                  mmaps/<map>.manifest). For tuning a few problem areas.\n"
 "  --no-menu       never ask, even on a terminal.\n"
 "\n"
 "On a terminal, naming no component opens the menu -- that is the front door\n"
@@ -205,6 +228,7 @@ namespace
             else if (a == "gomodels") { out.goModels = out.named = true; }
             else if (a == "trans" || a == "vessels") { out.vessels = out.named = true; }
             else if (a == "nav") { out.nav = out.named = true; }
+            else if (a == "upgrade") { out.upgrade = out.named = true; }
             else if (a == "all")
             {
                 out.dbc = out.tiles = out.goModels = out.vessels = out.nav =
@@ -222,6 +246,7 @@ namespace
             else if (a == "--map" && hasValue) { out.mapFilter = std::atoi(argv[++i]); }
             else if (a == "--offmesh" && hasValue) { out.offMesh = argv[++i]; }
             else if (a == "--threads" && hasValue) { out.threads = std::atoi(argv[++i]); }
+            else if (a == "--incremental") { out.incremental = true; }
             else if (a == "--no-menu") { out.noMenu = true; }
             else if (a == "-h" || a == "--help") { out.help = true; return false; }
             else
@@ -374,6 +399,55 @@ namespace
         g_console.Success(msg);
     }
 
+    // Rewrites every tile under `dir` still in an older format. ReadTile keeps reading
+    // those, so this is never required -- it only moves the conversion from every server
+    // start to one run here.
+    bool UpgradeTiles(const std::string& dir)
+    {
+        std::error_code ec;
+        std::filesystem::directory_iterator it(dir, ec);
+        if (ec)
+        {
+            return true;
+        }
+
+        int current = 0, rewritten = 0, unreadable = 0, failed = 0;
+        for (const auto& entry : it)
+        {
+            if (!entry.is_regular_file(ec) || entry.path().extension() != ".tile")
+            {
+                continue;
+            }
+            const std::string path = entry.path().generic_string();
+            switch (UpgradeTile(path))
+            {
+                case TileUpgrade::Current:    ++current; break;
+                case TileUpgrade::Rewritten:  ++rewritten; break;
+                case TileUpgrade::Unreadable:
+                    ++unreadable;
+                    g_console.Error("upgrade: " + path +
+                                    " is not a readable tile -- rebake it");
+                    break;
+                case TileUpgrade::Failed:
+                    ++failed;
+                    g_console.Error("upgrade: could not rewrite " + path);
+                    break;
+            }
+            if (((current + rewritten) % 64) == 0)
+            {
+                g_console.Activity("upgrade " + entry.path().filename().string());
+                Tick();
+            }
+        }
+
+        char msg[512];
+        std::snprintf(msg, sizeof(msg),
+                      "upgrade %s: %d rewritten, %d already current, %d unreadable",
+                      dir.c_str(), rewritten, current, unreadable);
+        g_console.Success(msg);
+        return failed == 0;
+    }
+
     void NavProgress(void* ctx, uint32_t, const char* label, size_t done, size_t total)
     {
         (void)ctx;
@@ -387,12 +461,21 @@ namespace
 
     // One durable line per map, so a piped log -- where the moving header prints nothing
     // -- still shows the bake advancing map by map.
-    void NavMapDone(void* ctx, uint32_t, const char* label, int written, size_t total)
+    void NavMapDone(void* ctx, uint32_t, const char* label, int written, int unchanged,
+                    size_t total)
     {
         (void)ctx;
         char msg[128];
-        std::snprintf(msg, sizeof(msg), "nav %s -> %d/%zu mmtiles",
-                      label ? label : "", written, total);
+        if (unchanged != 0)
+        {
+            std::snprintf(msg, sizeof(msg), "nav %s -> %d/%zu mmtiles, %d unchanged",
+                          label ? label : "", written, total, unchanged);
+        }
+        else
+        {
+            std::snprintf(msg, sizeof(msg), "nav %s -> %d/%zu mmtiles",
+                          label ? label : "", written, total);
+        }
         g_console.Detail(msg);
         Tick();
     }
@@ -538,6 +621,7 @@ namespace
         world::nav::NavConfig cfg;
         cfg.threads = opt.threads;
         cfg.offMeshFile = opt.offMesh;
+        cfg.incremental = opt.incremental;
 
         world::nav::NavMeshBuilder builder(tileDir, opt.dest + "/mmaps", cfg);
         builder.SetProgress(&NavProgress, nullptr);
@@ -558,10 +642,86 @@ namespace
         return true;
     }
 
+    unsigned WorkerCount(int requested)
+    {
+        const unsigned workers = requested > 0 ? unsigned(requested)
+                                               : std::thread::hardware_concurrency();
+        return workers ? workers : 1;
+    }
+
+    struct TileBake
+    {
+        unsigned workers = 1;
+        bool incremental = false;
+        uint64_t salt = 0;                  ///< TileBakeSalt()
+        BakeManifest* manifest = nullptr;
+    };
+
+    // What every tile depends on besides its own files: this tool's version, the tile
+    // format, and LiquidType.dbc, which classifies each liquid cell.
+    uint64_t TileBakeSalt(IMpqArchive& archive)
+    {
+        ContentHash hash;
+        hash.Add(uint64_t(TILE_BAKE_VERSION));
+        hash.Add(uint64_t(TILE_FORMAT_VERSION));
+        std::vector<uint8_t> bytes;
+        archive.Read("DBFilesClient\\LiquidType.dbc", bytes);
+        hash.Add(bytes);
+        return hash.Value();
+    }
+
+    enum class TileOutcome { Written, Unchanged, Failed, Absent };
+
+    // One tile file, skipped when the bake is incremental and its inputs hash as the
+    // manifest remembers them. Called from every worker at once.
+    TileOutcome BakeTile(MpqTileSource& source, const TileBake& bake, uint32_t mapId,
+                         int tx, int ty, bool globalWmo, const std::string& dest)
+    {
+        const std::string leaf = globalWmo ? GlobalWmoFileName(mapId)
+                                           : TileFileName(mapId, tx, ty);
+        const std::string path = dest + "/" + leaf;
+
+        ContentHash hash;
+        hash.Add(bake.salt);
+        const bool hashed = source.AddInputs(mapId, tx, ty, hash);
+
+        std::error_code ec;
+        if (hashed && bake.incremental && bake.manifest->Matches(leaf, hash.Value()) &&
+            std::filesystem::exists(path, ec))
+        {
+            return TileOutcome::Unchanged;
+        }
+
+        auto tile = source.Load(mapId, tx, ty);
+        if (!tile || (globalWmo ? !tile->isGlobalWmo : !tile->hasTerrain))
+        {
+            return globalWmo ? TileOutcome::Absent : TileOutcome::Failed;
+        }
+        if (!WriteTile(*tile, path))
+        {
+            bake.manifest->Erase(leaf);
+            return TileOutcome::Failed;
+        }
+
+        if (hashed)
+        {
+            bake.manifest->Set(leaf, hash.Value());
+        }
+        else
+        {
+            bake.manifest->Erase(leaf);
+        }
+        return TileOutcome::Written;
+    }
+
     // One map's tiles. A map is either an ADT grid or a single global WMO; both end up
     // as the same payload, so the runtime has nothing to reconcile.
+    //
+    // The grid is baked by a pool pulling the next ADT off a shared counter, the scheme
+    // the nav bake uses. The calling thread works too and is the only one that touches
+    // the console.
     void BakeMap(MpqTileSource& source, uint32_t mapId, const std::string& name,
-                 const std::string& dest)
+                 const std::string& dest, const TileBake& bake)
     {
         const WdtData* wdt = source.Wdt(mapId);
         if (!wdt)
@@ -571,58 +731,88 @@ namespace
 
         if (!wdt->HasAnyAdt())
         {
-            auto tile = source.Load(mapId, 0, 0);
-            if (tile && tile->isGlobalWmo)
+            const TileOutcome outcome = BakeTile(source, bake, mapId, 0, 0, true, dest);
+            if (outcome != TileOutcome::Absent)
             {
-                const bool ok =
-                    WriteTile(*tile, dest + "/" + GlobalWmoFileName(mapId));
+                const bool ok = outcome != TileOutcome::Failed;
                 char msg[256];
                 std::snprintf(msg, sizeof(msg), "  map %4u %-24s global WMO %s", mapId,
-                              name.c_str(), ok ? "ok" : "FAILED");
+                              name.c_str(), outcome == TileOutcome::Unchanged
+                                  ? "unchanged" : ok ? "ok" : "FAILED");
                 if (ok) { g_console.Detail(msg); } else { g_console.Error(msg); }
             }
             return;
         }
 
-        size_t expected = 0;
+        std::vector<std::pair<int, int>> grids;
         for (int ty = 0; ty < 64; ++ty)
         {
             for (int tx = 0; tx < 64; ++tx)
             {
-                expected += wdt->HasAdt(tx, ty) ? 1 : 0;
+                if (wdt->HasAdt(tx, ty))
+                {
+                    grids.emplace_back(tx, ty);
+                }
             }
         }
 
-        int written = 0, failed = 0;
-        for (int ty = 0; ty < 64; ++ty)
+        std::atomic<size_t> next{0};
+        std::atomic<size_t> done{0};
+        std::atomic<int> written{0};
+        std::atomic<int> unchanged{0};
+        std::atomic<int> failed{0};
+
+        auto worker = [&](bool isMain)
         {
-            for (int tx = 0; tx < 64; ++tx)
+            for (;;)
             {
-                if (!wdt->HasAdt(tx, ty))
+                const size_t i = next.fetch_add(1);
+                if (i >= grids.size())
                 {
-                    continue;
+                    return;
                 }
-                g_console.SetCounts(size_t(written), expected);
-                Tick();
-                auto tile = source.Load(mapId, tx, ty);
-                if (!tile || !tile->hasTerrain)
+                switch (BakeTile(source, bake, mapId, grids[i].first, grids[i].second,
+                                 false, dest))
                 {
-                    ++failed;
-                    continue;
+                    case TileOutcome::Written:   ++written; break;
+                    case TileOutcome::Unchanged: ++unchanged; break;
+                    default:                     ++failed; break;
                 }
-                if (WriteTile(*tile, dest + "/" + TileFileName(mapId, tx, ty)))
+                ++done;
+                if (isMain)
                 {
-                    ++written;
-                }
-                else
-                {
-                    ++failed;
+                    g_console.SetCounts(done.load(), grids.size());
+                    Tick();
                 }
             }
+        };
+
+        const unsigned workers = std::min<unsigned>(bake.workers, unsigned(grids.size()));
+        std::vector<std::thread> pool;
+        pool.reserve(workers);
+        for (unsigned i = 1; i < workers; ++i)
+        {
+            pool.emplace_back(worker, false);
         }
+        worker(true);
+        for (std::thread& t : pool)
+        {
+            t.join();
+        }
+        g_console.SetCounts(grids.size(), grids.size());
+
         char msg[256];
-        std::snprintf(msg, sizeof(msg), "  map %4u %-24s %5d tiles%s", mapId,
-                      name.c_str(), written, failed ? " (SOME FAILED)" : "");
+        if (bake.incremental)
+        {
+            std::snprintf(msg, sizeof(msg), "  map %4u %-24s %5d tiles, %5d unchanged%s",
+                          mapId, name.c_str(), written.load(), unchanged.load(),
+                          failed ? " (SOME FAILED)" : "");
+        }
+        else
+        {
+            std::snprintf(msg, sizeof(msg), "  map %4u %-24s %5d tiles%s", mapId,
+                          name.c_str(), written.load(), failed ? " (SOME FAILED)" : "");
+        }
         if (failed) { g_console.Warn(msg); } else { g_console.Detail(msg); }
     }
 }
@@ -777,6 +967,18 @@ int main(int argc, char** argv)
         BakeVesselMaps(opt.dest + "/gomodels", tileDir, ReadVesselMaps(opt.vesselList));
     };
 
+    // Before anything reads the caches, so a nav bake named alongside it reads them once
+    // in the current format rather than converting each tile as it goes.
+    if (opt.upgrade)
+    {
+        g_console.SetStage("upgrade");
+        if (!UpgradeTiles(opt.dest + "/gomodels") || !UpgradeTiles(tileDir))
+        {
+            g_console.Stop();
+            return 1;
+        }
+    }
+
     if (!opt.dbc && !opt.tiles && !opt.goModels)
     {
         BakeVessels();
@@ -888,8 +1090,43 @@ int main(int argc, char** argv)
     }
 
     g_console.SetStage("tiles");
-    MpqTileSource source(mpq, &maps, &liquids);
-    g_console.Log("tiles -> " + tileDir);
+
+    // A chain of archives per worker: StormLib serialises nothing itself, and one shared
+    // chain would have every worker queue on the reads.
+    TileBake bake;
+    bake.workers = WorkerCount(opt.threads);
+    StormLibArchivePool archives;
+    if (!archives.OpenClientData(opt.src, ClientArchives112(), ClientLocaleArchives112(),
+                                 opt.locale, bake.workers))
+    {
+        g_console.Error("no client archives opened under " + opt.src);
+        g_console.Stop();
+        return 1;
+    }
+
+    // Written on every bake, so the first incremental one already has something to
+    // compare against.
+    BakeManifest manifest;
+    const std::string manifestPath = tileDir + "/" + TILE_MANIFEST;
+    const bool hadManifest = manifest.Load(manifestPath);
+    bake.incremental = opt.incremental;
+    bake.salt = TileBakeSalt(archives);
+    bake.manifest = &manifest;
+    if (opt.incremental)
+    {
+        char msg[256];
+        std::snprintf(msg, sizeof(msg), "incremental: %zu tiles on record%s",
+                      manifest.Size(), hadManifest ? "" : " -- no manifest, baking all");
+        g_console.Log(msg);
+    }
+
+    MpqTileSource source(archives, &maps, &liquids);
+    {
+        char msg[256];
+        std::snprintf(msg, sizeof(msg), "tiles -> %s (%u workers)", tileDir.c_str(),
+                      bake.workers);
+        g_console.Log(msg);
+    }
 
     for (const auto& entry : maps.All())
     {
@@ -897,7 +1134,13 @@ int main(int argc, char** argv)
         {
             continue;
         }
-        BakeMap(source, entry.first, entry.second, tileDir);
+        BakeMap(source, entry.first, entry.second, tileDir, bake);
+
+        // After every map, so a bake stopped halfway keeps what it already did.
+        if (!manifest.Save(manifestPath))
+        {
+            g_console.Warn("could not write " + manifestPath);
+        }
     }
 
     if (!BakeNav(opt, tileDir))
@@ -0,0 +1,129 @@
+#include "BakeManifest.hpp"
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+namespace world::terrain
+{
+    namespace
+    {
+        const char* const MANIFEST_HEADER = "# mangos bake manifest 1";
+    }
+
+    void ContentHash::Add(const void* data, size_t len)
+    {
+        const uint8_t* p = static_cast<const uint8_t*>(data);
+        uint64_t h = m_state;
+        for (size_t i = 0; i < len; ++i)
+        {
+            h = (h ^ p[i]) * 1099511628211ull;
+        }
+        m_state = h;
+    }
+
+    void ContentHash::Add(uint64_t value)
+    {
+        uint8_t bytes[8];
+        for (int i = 0; i < 8; ++i)
+        {
+            bytes[i] = uint8_t(value >> (8 * i));
+        }
+        Add(bytes, sizeof(bytes));
+    }
+
+    bool BakeManifest::Load(const std::string& path)
+    {
+        std::lock_guard<std::mutex> lock(m_lock);
+        m_hashes.clear();
+
+        std::ifstream in(path);
+        std::string line;
+        if (!in || !std::getline(in, line) || line != MANIFEST_HEADER)
+        {
+            return false;
+        }
+
+        while (std::getline(in, line))
+        {
+            std::istringstream ls(line);
+            std::string file, hex;
+            if (!(ls >> file >> hex) || file[0] == '#')
+            {
+                continue;
+            }
+            char* end = nullptr;
+            const uint64_t hash = std::strtoull(hex.c_str(), &end, 16);
+            if (end && *end == '\0')
+            {
+                m_hashes[file] = hash;
+            }
+        }
+        return true;
+    }
+
+    bool BakeManifest::Save(const std::string& path) const
+    {
+        std::vector<std::pair<std::string, uint64_t>> sorted;
+        {
+            std::lock_guard<std::mutex> lock(m_lock);
+            sorted.assign(m_hashes.begin(), m_hashes.end());
+        }
+        std::sort(sorted.begin(), sorted.end());
+
+        const std::string temp = path + ".tmp";
+        std::FILE* f = std::fopen(temp.c_str(), "w");
+        if (!f)
+        {
+            return false;
+        }
+        bool ok = std::fprintf(f, "%s\n", MANIFEST_HEADER) > 0;
+        for (const auto& entry : sorted)
+        {
+            ok = ok && std::fprintf(f, "%s %016" PRIx64 "\n", entry.first.c_str(),
+                                    entry.second) > 0;
+        }
+        ok = (std::fclose(f) == 0) && ok;
+
+        std::error_code ec;
+        if (ok)
+        {
+            std::filesystem::rename(temp, path, ec);
+        }
+        if (!ok || ec)
+        {
+            std::filesystem::remove(temp, ec);
+            return false;
+        }
+        return true;
+    }
+
+    bool BakeManifest::Matches(const std::string& file, uint64_t hash) const
+    {
+        std::lock_guard<std::mutex> lock(m_lock);
+        auto it = m_hashes.find(file);
+        return it != m_hashes.end() && it->second == hash;
+    }
+
+    void BakeManifest::Set(const std::string& file, uint64_t hash)
+    {
+        std::lock_guard<std::mutex> lock(m_lock);
+        m_hashes[file] = hash;
+    }
+
+    void BakeManifest::Erase(const std::string& file)
+    {
+        std::lock_guard<std::mutex> lock(m_lock);
+        m_hashes.erase(file);
+    }
+
+    size_t BakeManifest::Size() const
+    {
+        std::lock_guard<std::mutex> lock(m_lock);
+        return m_hashes.size();
+    }
+}
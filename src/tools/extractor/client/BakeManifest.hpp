@@ -0,0 +1,70 @@
+#pragma once
+
+// What an incremental bake remembers between runs: for every file it wrote, a hash of
+// everything that file was built from. A file whose inputs hash the same as last time
+// is left alone, so re-baking after a patch that touched one zone redoes that zone.
+//
+// The hash is FNV-1a over the raw input bytes, salted by whoever uses it with the
+// tool's own version -- a fix to a parser changes what a tile holds without changing a
+// byte of the client, and must invalidate the tiles it affects all the same. It needs
+// to tell inputs apart, not resist anyone, so 64 bits of FNV is plenty.
+//
+// The manifest is text, one "<file> <hash>" per line, so a person can diff two of
+// them and see which tiles a data refresh touched.
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace world::terrain
+{
+    class ContentHash
+    {
+    public:
+        void Add(const void* data, size_t len);
+        void Add(uint64_t value);
+
+        // Length first, so "ab" + "c" and "a" + "bc" hash apart.
+        void Add(const std::string& s)
+        {
+            Add(uint64_t(s.size()));
+            Add(s.data(), s.size());
+        }
+
+        void Add(const std::vector<uint8_t>& bytes)
+        {
+            Add(uint64_t(bytes.size()));
+            Add(bytes.data(), bytes.size());
+        }
+
+        uint64_t Value() const { return m_state; }
+
+    private:
+        uint64_t m_state = 14695981039346656037ull;
+    };
+
+    // Safe to update from every bake worker at once.
+    class BakeManifest
+    {
+    public:
+        // False when there is no manifest yet, or it is not one; either way the manifest
+        // is then empty and every file is rebuilt.
+        bool Load(const std::string& path);
+
+        // Written beside `path` and renamed over it, so a bake killed mid-save leaves
+        // the previous manifest rather than half of this one.
+        bool Save(const std::string& path) const;
+
+        bool Matches(const std::string& file, uint64_t hash) const;
+        void Set(const std::string& file, uint64_t hash);
+        void Erase(const std::string& file);
+        size_t Size() const;
+
+    private:
+        mutable std::mutex m_lock;
+        std::unordered_map<std::string, uint64_t> m_hashes;
+    };
+}
@@ -4,52 +4,113 @@
 #include <vector>
 #include "ModelLoaders.hpp"
 
+#include "BakeManifest.hpp"
 #include "M2Parser.hpp"
 #include "terrain/CollisionModel.hpp"
 #include "terrain/WmoModel.hpp"
 
 namespace world::terrain
 {
-    const WmoRootData* WmoLoader::Root(const std::string& rootPath)
+    namespace
     {
-        auto it = m_roots.find(rootPath);
-        if (it != m_roots.end())
+        // Builds each key's value once, however many workers ask for it at the same
+        // time: the first builds, outside the lock, and the rest wait on its future.
+        template<class Value, class Make>
+        Value OncePerKey(std::mutex& lock,
+                         std::unordered_map<std::string, std::shared_future<Value>>& cache,
+                         const std::string& key, Make make)
         {
-            return it->second.doodads.empty() ? nullptr : &it->second;
-        }
+            std::promise<Value> promise;
+            std::shared_future<Value> pending;
+            {
+                std::lock_guard<std::mutex> guard(lock);
+                auto found = cache.find(key);
+                if (found != cache.end())
+                {
+                    pending = found->second;
+                }
+                else
+                {
+                    cache.emplace(key, promise.get_future().share());
+                }
+            }
+            if (pending.valid())
+            {
+                return pending.get();
+            }
 
-        std::vector<uint8_t> bytes;
-        WmoRootData root;
-        if (m_archive.Read(rootPath, bytes))
-        {
-            ParseWmoRoot(bytes, root);
+            try
+            {
+                Value value = make();
+                promise.set_value(value);
+                return value;
+            }
+            catch (...)
+            {
+                promise.set_exception(std::current_exception());
+                throw;
+            }
         }
-        auto& slot = m_roots.emplace(rootPath, std::move(root)).first->second;
-        return slot.doodads.empty() ? nullptr : &slot;
     }
 
-    std::shared_ptr<const ICollisionModel> WmoLoader::Load(const std::string& rootPath)
+    std::shared_ptr<const WmoRootData> WmoLoader::LoadRoot(const std::string& rootPath)
     {
-        auto cached = m_cache.find(rootPath);
-        if (cached != m_cache.end())
+        return OncePerKey(m_lock, m_roots, rootPath, [&]()
         {
-            return cached->second;
-        }
+            std::vector<uint8_t> bytes;
+            if (!m_archive.Read(rootPath, bytes))
+            {
+                return std::shared_ptr<const WmoRootData>();
+            }
+            auto root = std::make_shared<WmoRootData>();
+            ParseWmoRoot(bytes, *root);
+            return std::shared_ptr<const WmoRootData>(std::move(root));
+        });
+    }
+
+    const WmoRootData* WmoLoader::Root(const std::string& rootPath)
+    {
+        // The cache keeps the root alive for as long as the loader, so the pointer
+        // stays good after the shared_ptr here is gone.
+        std::shared_ptr<const WmoRootData> root = LoadRoot(rootPath);
+        return root && !root->doodads.empty() ? root.get() : nullptr;
+    }
 
-        std::vector<uint8_t> rootBytes;
-        if (!m_archive.Read(rootPath, rootBytes))
+    uint64_t WmoLoader::HashOf(const std::string& rootPath)
+    {
+        return OncePerKey(m_lock, m_hashes, rootPath, [&]()
         {
-            m_cache.emplace(rootPath, nullptr);
-            m_roots.emplace(rootPath, WmoRootData{});
-            return nullptr;
-        }
+            ContentHash hash;
+            hash.Add(rootPath);
+            std::vector<uint8_t> bytes;
+            const std::shared_ptr<const WmoRootData> root = LoadRoot(rootPath);
+            if (root && m_archive.Read(rootPath, bytes))
+            {
+                hash.Add(bytes);
+                for (uint32_t g = 0; g < root->nGroups; ++g)
+                {
+                    bytes.clear();
+                    m_archive.Read(WmoGroupPath(rootPath, g), bytes);
+                    hash.Add(bytes);
+                }
+            }
+            return hash.Value();
+        });
+    }
+
+    std::shared_ptr<const ICollisionModel> WmoLoader::Load(const std::string& rootPath)
+    {
+        return OncePerKey(m_lock, m_cache, rootPath, [&]() { return Build(rootPath); });
+    }
 
-        WmoRootData root;
-        ParseWmoRoot(rootBytes, root);
-        if (m_roots.find(rootPath) == m_roots.end())
+    std::shared_ptr<const ICollisionModel> WmoLoader::Build(const std::string& rootPath)
+    {
+        const std::shared_ptr<const WmoRootData> rootData = LoadRoot(rootPath);
+        if (!rootData)
         {
-            m_roots.emplace(rootPath, root);
+            return nullptr;
         }
+        const WmoRootData& root = *rootData;
 
         // One soup for the whole WMO. Each group's vertices are re-indexed as they are
         // appended, so the ~60% that only ever fed render-only faces are never carried.
@@ -115,26 +176,37 @@ namespace world::terrain
         Bvh bvh;
         bvh.Build(soup, &triGroup, 4);
 
-        auto model = std::make_shared<WmoModel>(std::move(soup), std::move(triGroup),
-                                                std::move(groups), root.wmoId,
-                                                std::move(bvh));
-        m_cache.emplace(rootPath, model);
-        return model;
+        return std::make_shared<WmoModel>(std::move(soup), std::move(triGroup),
+                                          std::move(groups), root.wmoId, std::move(bvh));
     }
 
     std::shared_ptr<const ICollisionModel> M2Loader::Load(const std::string& path)
     {
         const std::string key = M2PathOf(path);
-        auto cached = m_cache.find(key);
-        if (cached != m_cache.end())
+        return OncePerKey(m_lock, m_cache, key, [&]() { return Build(key); });
+    }
+
+    uint64_t M2Loader::HashOf(const std::string& path)
+    {
+        const std::string key = M2PathOf(path);
+        return OncePerKey(m_lock, m_hashes, key, [&]()
         {
-            return cached->second;
-        }
+            ContentHash hash;
+            hash.Add(key);
+            std::vector<uint8_t> bytes;
+            if (m_archive.Read(key, bytes))
+            {
+                hash.Add(bytes);
+            }
+            return hash.Value();
+        });
+    }
 
+    std::shared_ptr<const ICollisionModel> M2Loader::Build(const std::string& key)
+    {
         std::vector<uint8_t> bytes;
         if (!m_archive.Read(key, bytes))
         {
-            m_cache.emplace(key, nullptr);
             return nullptr;
         }
 
@@ -145,8 +217,6 @@ namespace world::terrain
         soup.verts = std::move(parsed.verts);
         soup.tris = std::move(parsed.tris);
 
-        auto model = std::make_shared<CollisionModel>(std::move(soup));
-        m_cache.emplace(key, model);
-        return model;
+        return std::make_shared<CollisionModel>(std::move(soup));
     }
 }
@@ -3,13 +3,21 @@
 // Turns parsed client bytes into the collision models the tile stores: a WMO's
 // collidable faces folded into one soup with a BVH built over them, and an M2's
 // collision hull. Both cache by path -- a WMO instanced fifty times is read once.
+//
+// Both are shared by every tile-bake worker. The first worker to ask for a model builds
+// it and any other that asks meanwhile waits for that one, so a city WMO that straddles
+// nine tiles baked at once is still built a single time. The archive must be safe to
+// read from several threads (StormLibArchivePool, MemoryArchive).
 
 #include "IMpqArchive.hpp"
 #include "WmoParser.hpp"
 #include "stores/LiquidTypeStore.hpp"
 #include "terrain/ICollisionModel.hpp"
 
+#include <cstdint>
+#include <future>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 
@@ -27,11 +35,24 @@ namespace world::terrain
         // WMO ships none.
         const WmoRootData* Root(const std::string& rootPath);
 
+        // A hash of the root and every group file, for the incremental bake. The
+        // doodads' own M2s are not in it; see M2Loader::HashOf.
+        uint64_t HashOf(const std::string& rootPath);
+
     private:
+        // nullptr when the root is not in the archive.
+        std::shared_ptr<const WmoRootData> LoadRoot(const std::string& rootPath);
+        std::shared_ptr<const ICollisionModel> Build(const std::string& rootPath);
+
         IMpqArchive& m_archive;
         const world::LiquidTypeStore* m_liquidTypes;
-        std::unordered_map<std::string, std::shared_ptr<const ICollisionModel>> m_cache;
-        std::unordered_map<std::string, WmoRootData> m_roots;
+
+        std::mutex m_lock;
+        std::unordered_map<std::string,
+                           std::shared_future<std::shared_ptr<const ICollisionModel>>> m_cache;
+        std::unordered_map<std::string,
+                           std::shared_future<std::shared_ptr<const WmoRootData>>> m_roots;
+        std::unordered_map<std::string, std::shared_future<uint64_t>> m_hashes;
     };
 
     class M2Loader
@@ -41,8 +62,17 @@ namespace world::terrain
 
         std::shared_ptr<const ICollisionModel> Load(const std::string& path);
 
+        // A hash of the file Load() reads for `path`, for the incremental bake.
+        uint64_t HashOf(const std::string& path);
+
     private:
+        std::shared_ptr<const ICollisionModel> Build(const std::string& key);
+
         IMpqArchive& m_archive;
-        std::unordered_map<std::string, std::shared_ptr<const ICollisionModel>> m_cache;
+
+        std::mutex m_lock;
+        std::unordered_map<std::string,
+                           std::shared_future<std::shared_ptr<const ICollisionModel>>> m_cache;
+        std::unordered_map<std::string, std::shared_future<uint64_t>> m_hashes;
     };
 }
@@ -109,10 +109,13 @@ namespace world::terrain
 
     const WdtData* MpqTileSource::Wdt(uint32_t mapId)
     {
-        auto it = m_wdtCache.find(mapId);
-        if (it != m_wdtCache.end())
         {
-            return &it->second;
+            std::lock_guard<std::mutex> lock(m_lock);
+            auto it = m_wdtCache.find(mapId);
+            if (it != m_wdtCache.end())
+            {
+                return &it->second;
+            }
         }
 
         const std::string path = WdtPath(mapId);
@@ -122,6 +125,9 @@ namespace world::terrain
         {
             return nullptr;
         }
+
+        // Two threads may both have parsed it; the first one in is kept.
+        std::lock_guard<std::mutex> lock(m_lock);
         return &m_wdtCache.emplace(mapId, std::move(wdt)).first->second;
     }
 
@@ -263,10 +269,13 @@ namespace world::terrain
 
     std::shared_ptr<TerrainTile> MpqTileSource::LoadGlobalWmo(uint32_t mapId)
     {
-        auto cached = m_globalWmoCache.find(mapId);
-        if (cached != m_globalWmoCache.end())
         {
-            return cached->second;
+            std::lock_guard<std::mutex> lock(m_lock);
+            auto cached = m_globalWmoCache.find(mapId);
+            if (cached != m_globalWmoCache.end())
+            {
+                return cached->second;
+            }
         }
 
         const WdtData* wdt = Wdt(mapId);
@@ -296,8 +305,67 @@ namespace world::terrain
         // A dungeon IS one big WMO, so all of its furniture is doodads.
         AttachWmoDoodads(*wdt->globalWmoPlacement, wdt->globalWmoName, xf, *tile);
 
-        m_globalWmoCache[mapId] = tile;
-        return tile;
+        std::lock_guard<std::mutex> lock(m_lock);
+        return m_globalWmoCache.emplace(mapId, tile).first->second;
+    }
+
+    void MpqTileSource::AddWmoInputs(const std::string& wmoPath, ContentHash& hash)
+    {
+        hash.Add(m_wmo.HashOf(wmoPath));
+
+        // Every set's doodads, not only the placed one: the set is the ADT's choice, and
+        // the ADT is hashed as well.
+        if (const WmoRootData* root = m_wmo.Root(wmoPath))
+        {
+            for (const WmoDoodad& d : root->doodads)
+            {
+                if (!d.name.empty())
+                {
+                    hash.Add(m_m2.HashOf(d.name));
+                }
+            }
+        }
+    }
+
+    bool MpqTileSource::AddInputs(uint32_t mapId, int tx, int ty, ContentHash& hash)
+    {
+        hash.Add(uint64_t(m_loadStatics));
+
+        // The same order of preference as Load(): the ADT, else the map's global WMO.
+        const std::string adtPath = AdtPath(mapId, tx, ty);
+        std::vector<uint8_t> bytes;
+        AdtData adt;
+        if (!adtPath.empty() && m_archive.Read(adtPath, bytes) && ParseAdt(bytes, adt) &&
+            adt.hasTerrain)
+        {
+            hash.Add(adtPath);
+            hash.Add(bytes);
+            if (m_loadStatics)
+            {
+                for (const std::string& wmoPath : adt.wmoNames)
+                {
+                    AddWmoInputs(wmoPath, hash);
+                }
+                for (const std::string& m2Path : adt.m2Names)
+                {
+                    hash.Add(m_m2.HashOf(m2Path));
+                }
+            }
+            return true;
+        }
+
+        const WdtData* wdt = Wdt(mapId);
+        const std::string wdtPath = WdtPath(mapId);
+        bytes.clear();
+        if (!wdt || !wdt->hasGlobalWmo || wdt->globalWmoName.empty() ||
+            !wdt->globalWmoPlacement || !m_archive.Read(wdtPath, bytes))
+        {
+            return false;
+        }
+        hash.Add(wdtPath);
+        hash.Add(bytes);
+        AddWmoInputs(wdt->globalWmoName, hash);
+        return true;
     }
 
     std::shared_ptr<TerrainTile> MpqTileSource::Load(uint32_t mapId, int tx, int ty)
@@ -5,7 +5,11 @@
 //
 // Tile indexing throughout: tx is the tile index derived from world X, ty from world Y.
 // The ADT file is named the other way round -- "<Map>_<ty>_<tx>.adt".
+//
+// Load() may be called from several threads at once, as the tile bake does; the model
+// loaders it holds are shared by all of them.
 
+#include "BakeManifest.hpp"
 #include "IMpqArchive.hpp"
 #include "ModelLoaders.hpp"
 #include "WdtParser.hpp"
@@ -14,6 +18,7 @@
 
 #include <cstdint>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 
@@ -38,9 +43,16 @@ namespace world::terrain
         // Parsed once per map; the tile bake walks it to know which tiles exist.
         const WdtData* Wdt(uint32_t mapId);
 
+        // Feeds `hash` every input Load() would build this tile from: the ADT, and the
+        // files of each WMO and M2 it places, doodads included -- or, for a map that is
+        // one global WMO, the WDT and that WMO. False when Load() would find no tile.
+        // Reads the files but builds nothing, so it is cheap next to Load().
+        bool AddInputs(uint32_t mapId, int tx, int ty, ContentHash& hash);
+
     private:
         std::shared_ptr<TerrainTile> LoadAdt(uint32_t mapId, int tx, int ty);
         std::shared_ptr<TerrainTile> LoadGlobalWmo(uint32_t mapId);
+        void AddWmoInputs(const std::string& wmoPath, ContentHash& hash);
         void AttachWmoDoodads(const Placement& p, const std::string& wmoPath,
                               const Transform& wmoXf, TerrainTile& tile);
 
@@ -51,6 +63,7 @@ namespace world::terrain
         M2Loader m_m2;
         bool m_loadStatics = true;
 
+        std::mutex m_lock;          ///< the two caches below
         std::unordered_map<uint32_t, WdtData> m_wdtCache;
         std::unordered_map<uint32_t, std::shared_ptr<TerrainTile>> m_globalWmoCache;
     };
@@ -4,6 +4,7 @@
 
 #include <StormLib.h>
 
+#include <algorithm>
 #include <cstdio>
 #include <unordered_set>
 
@@ -184,4 +185,66 @@ namespace world::terrain
         }
         return result;
     }
+
+    int StormLibArchivePool::OpenClientData(const std::string& dataDir,
+                                            const std::vector<std::string>& archives,
+                                            const std::vector<std::string>& localeArchives,
+                                            const std::string& locale, size_t chains)
+    {
+        int opened = 0;
+        for (size_t i = 0; i < std::max<size_t>(chains, 1); ++i)
+        {
+            auto chain = std::make_unique<StormLibArchive>();
+            opened = chain->OpenClientData(dataDir, archives, localeArchives, locale);
+            if (!opened)
+            {
+                break;
+            }
+            m_free.push_back(chain.get());
+            m_chains.push_back(std::move(chain));
+        }
+        return m_chains.empty() ? 0 : opened;
+    }
+
+    StormLibArchive* StormLibArchivePool::Borrow() const
+    {
+        std::unique_lock<std::mutex> lock(m_lock);
+        m_returned.wait(lock, [this]() { return !m_free.empty(); });
+        StormLibArchive* chain = m_free.back();
+        m_free.pop_back();
+        return chain;
+    }
+
+    void StormLibArchivePool::Return(StormLibArchive* chain) const
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_lock);
+            m_free.push_back(chain);
+        }
+        m_returned.notify_one();
+    }
+
+    bool StormLibArchivePool::Read(const std::string& path, std::vector<uint8_t>& out)
+    {
+        if (m_chains.empty())
+        {
+            return false;
+        }
+        StormLibArchive* chain = Borrow();
+        const bool found = chain->Read(path, out);
+        Return(chain);
+        return found;
+    }
+
+    bool StormLibArchivePool::Contains(const std::string& path) const
+    {
+        if (m_chains.empty())
+        {
+            return false;
+        }
+        StormLibArchive* chain = Borrow();
+        const bool found = chain->Contains(path);
+        Return(chain);
+        return found;
+    }
 }
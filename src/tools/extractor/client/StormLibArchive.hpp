@@ -6,6 +6,9 @@
 
 #include "IMpqArchive.hpp"
 
+#include <condition_variable>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -43,6 +46,32 @@ namespace world::terrain
         std::vector<void*> m_handles;
     };
 
+    // The same archive chain opened once per worker. A StormLib handle must not be used
+    // from two threads at once, so one StormLibArchive shared by the tile bake would
+    // queue every read -- and a read, which decompresses, is a fair part of a tile's
+    // cost. Read() borrows whichever chain is free and hands it back.
+    class StormLibArchivePool : public IMpqArchive
+    {
+    public:
+        // Opens `chains` copies of the chain; returns the archives in each, 0 if none.
+        int OpenClientData(const std::string& dataDir,
+                           const std::vector<std::string>& archives,
+                           const std::vector<std::string>& localeArchives,
+                           const std::string& locale, size_t chains);
+
+        bool Read(const std::string& path, std::vector<uint8_t>& out) override;
+        bool Contains(const std::string& path) const override;
+
+    private:
+        StormLibArchive* Borrow() const;
+        void Return(StormLibArchive* chain) const;
+
+        std::vector<std::unique_ptr<StormLibArchive>> m_chains;
+        mutable std::mutex m_lock;
+        mutable std::condition_variable m_returned;
+        mutable std::vector<StormLibArchive*> m_free;
+    };
+
     // The 3.3.5a archive chain, lowest priority first.
     const std::vector<std::string>& ClientArchives112();
     const std::vector<std::string>& ClientLocaleArchives112();
@@ -2,6 +2,7 @@
 #include <vector>
 #include "nav/NavMeshBuilder.hpp"
 
+#include "client/BakeManifest.hpp"
 #include "terrain/TileSerializer.hpp"
 #include "terrain/WmoModel.hpp"
 
@@ -31,9 +32,15 @@ namespace world::nav
 {
     namespace
     {
+        using world::terrain::BakeManifest;
+        using world::terrain::ContentHash;
         using world::terrain::TerrainTile;
         using Vec3 = Geometry::Vector3;
 
+        // Bump when a change to THIS file alters what a tile holds, so an incremental
+        // bake rebuilds every tile rather than keeping the ones the old code wrote.
+        constexpr uint64_t NAV_BAKE_VERSION = 1;
+
         constexpr float GRID_SIZE = 533.33333f;
         constexpr int V9_SIDE = 129;
         constexpr int V8_SIDE = 128;
@@ -426,24 +433,64 @@ namespace world::nav
             return links;
         }
 
+        // Written beside `path` and renamed over it. An incremental bake trusts any
+        // .mmtile its manifest vouches for, so a bake killed mid-write must leave the
+        // previous file, never a truncated one under the right name.
         bool WriteFile(const std::string& path, const void* head, size_t headSize,
                        const void* body, size_t bodySize)
         {
-            std::FILE* f = std::fopen(path.c_str(), "wb");
+            const std::string tmp = path + ".tmp";
+            std::FILE* f = std::fopen(tmp.c_str(), "wb");
             if (!f)
             {
                 return false;
             }
             bool ok = headSize == 0 || std::fwrite(head, headSize, 1, f) == 1;
             ok = ok && (bodySize == 0 || std::fwrite(body, bodySize, 1, f) == 1);
-            std::fclose(f);
+            ok = std::fclose(f) == 0 && ok;
+
+            std::error_code ec;
+            if (ok)
+            {
+                std::filesystem::rename(tmp, path, ec);
+                ok = !ec;
+            }
             if (!ok)
             {
-                std::remove(path.c_str());
+                std::filesystem::remove(tmp, ec);
+            }
+            return ok;
+        }
+
+        // Absent and unreadable are both false; the caller only hashes files it knows
+        // are there.
+        bool ReadBytes(const std::string& path, std::vector<uint8_t>& out)
+        {
+            out.clear();
+            std::FILE* f = std::fopen(path.c_str(), "rb");
+            if (!f)
+            {
+                return false;
             }
+            uint8_t buffer[64 * 1024];
+            size_t n;
+            while ((n = std::fread(buffer, 1, sizeof(buffer), f)) != 0)
+            {
+                out.insert(out.end(), buffer, buffer + n);
+            }
+            const bool ok = !std::ferror(f);
+            std::fclose(f);
             return ok;
         }
 
+        std::string MmtileFileName(uint32_t mapId, int navTileX, int navTileY)
+        {
+            char name[64];
+            std::snprintf(name, sizeof(name), "%04u%02i%02i.mmtile", mapId, navTileX,
+                          navTileY);
+            return name;
+        }
+
         struct MapBake
         {
             uint32_t mapId = 0;
@@ -454,6 +501,7 @@ namespace world::nav
             int subTileSize = 0;
             int subTilesPerTile = 0;
             int borderSize = 0;
+            uint64_t salt = 0;              ///< NavBakeSalt(), plus a global WMO's tile
 
             // Set only for a WMO-only map (a WDT with no ADT grid, e.g. Deeprun Tram):
             // there is no per-grid t_ tile to read, so every grid this WMO spans bakes
@@ -556,6 +604,60 @@ namespace world::nav
             return true;
         }
 
+        // Everything BakeTile reads for grid (gx, gy), hashed: the tile itself, whichever
+        // of the four neighbours exist (each lends a border row), and the offmesh links
+        // filed under this tile. A global WMO's one tile is already in the salt. False
+        // when an input cannot be read; the tile is then baked and left off the manifest.
+        bool HashTileInputs(const MapBake& mb, int gx, int gy, ContentHash& hash)
+        {
+            hash.Add(mb.salt);
+
+            if (!mb.globalWmo)
+            {
+                constexpr int inputs[][2] = {
+                    {0, 0},
+                    {-1, 0},
+                    {1, 0},
+                    {0, -1},
+                    {0, 1},
+                };
+
+                std::vector<uint8_t> bytes;
+                for (const auto& offset : inputs)
+                {
+                    const std::string path =
+                        mb.tileDir + "/" +
+                        world::terrain::TileFileName(mb.mapId, gx + offset[0],
+                                                     gy + offset[1]);
+                    std::error_code ec;
+                    const bool exists = std::filesystem::exists(path, ec);
+                    if (ec || (!exists && offset[0] == 0 && offset[1] == 0))
+                    {
+                        return false;
+                    }
+                    hash.Add(uint64_t(exists));
+                    if (exists)
+                    {
+                        if (!ReadBytes(path, bytes))
+                        {
+                            return false;
+                        }
+                        hash.Add(bytes);
+                    }
+                }
+            }
+
+            const std::vector<OffMeshLink> links =
+                LoadOffMesh(mb.cfg.offMeshFile, mb.mapId, gy, gx);
+            hash.Add(uint64_t(links.size()));
+            for (const OffMeshLink& l : links)
+            {
+                hash.Add(l.verts, sizeof(l.verts));
+                hash.Add(&l.radius, sizeof(l.radius));
+            }
+            return true;
+        }
+
         // Which triangles each sub-tile has to look at.
         //
         // A grid tile is 25x25 sub-tiles, and the obvious loop hands the WHOLE tile soup
@@ -959,9 +1061,7 @@ namespace world::nav
             header.size = uint32(navDataSize);
             header.usesLiquids = !liquid.Empty();
 
-            char name[64];
-            std::snprintf(name, sizeof(name), "%04u%02i%02i.mmtile", mb.mapId, navTileX,
-                          navTileY);
+            const std::string name = MmtileFileName(mb.mapId, navTileX, navTileY);
             const bool ok = WriteFile(mb.outDir + "/" + name, &header, sizeof(header),
                                       navData, size_t(navDataSize));
             dtFree(navData);
@@ -1004,6 +1104,22 @@ namespace world::nav
         return true;
     }
 
+    uint64_t NavBakeSalt(const NavConfig& cfg, const float* orig)
+    {
+        ContentHash hash;
+        hash.Add(NAV_BAKE_VERSION);
+        hash.Add(uint64_t(MMAP_VERSION));
+        hash.Add(uint64_t(DT_NAVMESH_VERSION));
+        hash.Add(&cfg.cellSize, sizeof(cfg.cellSize));
+        hash.Add(&cfg.maxWalkableAngle, sizeof(cfg.maxWalkableAngle));
+        hash.Add(uint64_t(cfg.walkableHeight));
+        hash.Add(uint64_t(cfg.walkableClimb));
+        hash.Add(uint64_t(cfg.walkableRadius));
+        hash.Add(uint64_t(cfg.subTileSize));
+        hash.Add(orig, 3 * sizeof(float));
+        return hash.Value();
+    }
+
     NavMeshBuilder::NavMeshBuilder(std::string tileDir, std::string outDir, NavConfig cfg)
         : m_tileDir(std::move(tileDir)), m_outDir(std::move(outDir)), m_cfg(cfg)
     {
@@ -1021,9 +1137,10 @@ namespace world::nav
     }
 
     int NavMeshBuilder::BakeMap(uint32_t mapId, const std::string& mapName,
-                                const std::vector<std::pair<int, int>>& grids,
+                                const std::vector<std::pair<int, int>>& grids, int& unchanged,
                                 std::shared_ptr<const world::terrain::TerrainTile> globalWmo)
     {
+        unchanged = 0;
         if (grids.empty())
         {
             return 0;
@@ -1070,6 +1187,30 @@ namespace world::nav
         mb.borderSize = m_cfg.walkableRadius + 3;
         mb.globalWmo = std::move(globalWmo);
 
+        // A global WMO map's grids all bake from the one w_ tile, so it goes into the salt
+        // once rather than into every grid's hash.
+        ContentHash salt;
+        salt.Add(NavBakeSalt(m_cfg, orig));
+        if (mb.globalWmo)
+        {
+            std::vector<uint8_t> bytes;
+            ReadBytes(m_tileDir + "/" + world::terrain::GlobalWmoFileName(mapId), bytes);
+            salt.Add(bytes);
+        }
+        mb.salt = salt.Value();
+
+        // Written on every bake, so the first incremental one already has something to
+        // compare against. A full bake starts it empty, so it names exactly the tiles
+        // this map has now and the digest the server logs describes this bake alone.
+        char manifestName[32];
+        std::snprintf(manifestName, sizeof(manifestName), "%04u.manifest", mapId);
+        const std::string manifestPath = m_outDir + "/" + manifestName;
+        BakeManifest manifest;
+        if (m_cfg.incremental)
+        {
+            manifest.Load(manifestPath);
+        }
+
         unsigned workers = m_cfg.threads > 0 ? unsigned(m_cfg.threads)
                                              : std::thread::hardware_concurrency();
         if (workers == 0)
@@ -1080,6 +1221,7 @@ namespace world::nav
 
         std::atomic<size_t> next{0};
         std::atomic<int> written{0};
+        std::atomic<int> skipped{0};
         std::atomic<int> tileErrors{0};
 
         // Only the main-thread worker touches the console, so the report reads the shared
@@ -1103,14 +1245,41 @@ namespace world::nav
                 {
                     return;
                 }
-                bool tileError = false;
-                if (BakeTile(mb, grids[i].first, grids[i].second, tileError))
+                const int gx = grids[i].first;
+                const int gy = grids[i].second;
+                const std::string leaf = MmtileFileName(mapId, gy, gx);
+
+                ContentHash inputs;
+                const bool hashed = HashTileInputs(mb, gx, gy, inputs);
+                std::error_code ec;
+                if (hashed && m_cfg.incremental && manifest.Matches(leaf, inputs.Value()) &&
+                    std::filesystem::exists(m_outDir + "/" + leaf, ec))
                 {
-                    ++written;
+                    ++skipped;
                 }
-                else if (tileError)
+                else
                 {
-                    ++tileErrors;
+                    bool tileError = false;
+                    if (BakeTile(mb, gx, gy, tileError))
+                    {
+                        ++written;
+                        if (hashed)
+                        {
+                            manifest.Set(leaf, inputs.Value());
+                        }
+                        else
+                        {
+                            manifest.Erase(leaf);
+                        }
+                    }
+                    else
+                    {
+                        manifest.Erase(leaf);
+                        if (tileError)
+                        {
+                            ++tileErrors;
+                        }
+                    }
                 }
                 if (isMain)
                 {
@@ -1132,6 +1301,14 @@ namespace world::nav
             t.join();
         }
         report(grids.size());
+        unchanged = skipped.load();
+
+        if (!manifest.Save(manifestPath))
+        {
+            std::lock_guard<std::mutex> lock(g_bakeLogMutex);
+            std::fprintf(stderr, "nav: map %u: cannot write %s; the next incremental "
+                         "bake will rebuild it\n", mapId, manifestPath.c_str());
+        }
 
         if (tileErrors.load() != 0)
         {
@@ -1187,14 +1364,15 @@ namespace world::nav
             char label[48];
             std::snprintf(label, sizeof(label), "map %u  [%zu/%zu]", entry.first,
                           done + 1, mapCount);
-            const int written = BakeMap(entry.first, label, entry.second);
+            int unchanged = 0;
+            const int written = BakeMap(entry.first, label, entry.second, unchanged);
             if (written < 0)
             {
                 return -1;
             }
             if (m_mapDone)
             {
-                m_mapDone(m_progressContext, entry.first, label, written,
+                m_mapDone(m_progressContext, entry.first, label, written, unchanged,
                           entry.second.size());
             }
             total += written;
@@ -1212,14 +1390,16 @@ namespace world::nav
             if (tile)
             {
                 const std::vector<std::pair<int, int>> grids = GlobalWmoGrids(*tile);
-                const int written = BakeMap(mapId, label, grids, tile);
+                int unchanged = 0;
+                const int written = BakeMap(mapId, label, grids, unchanged, tile);
                 if (written < 0)
                 {
                     return -1;
                 }
                 if (m_mapDone)
                 {
-                    m_mapDone(m_progressContext, mapId, label, written, grids.size());
+                    m_mapDone(m_progressContext, mapId, label, written, unchanged,
+                              grids.size());
                 }
                 total += written;
             }
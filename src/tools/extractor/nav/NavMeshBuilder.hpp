@@ -13,6 +13,11 @@
 // Tile indices. Recast X is world Y, so navmesh tile coordinates are SWAPPED relative to
 // the grid: navTileX = gy, navTileY = gx. That is why the runtime opens
 // mmaps/%04u%02i%02i.mmtile with (mapId, y, x); see MMapManager::loadMap.
+//
+// Incremental bake. Each map's mmaps/<map>.manifest records, per .mmtile, a hash of
+// everything that tile was built from: its terrain tile, the four neighbours it borrows a
+// border from, its offmesh links and the config. With NavConfig::incremental a tile whose
+// inputs hash as recorded is left alone, so tuning one problem area re-bakes that area.
 
 #include <cstdint>
 #include <memory>
@@ -35,8 +40,15 @@ namespace world::nav
         int subTileSize = 80;            ///< recast sub-tile edge, in cells
         int threads = 0;                 ///< 0 asks the hardware
         std::string offMeshFile;         ///< optional offmesh.txt
+        bool incremental = false;        ///< skip tiles whose inputs are unchanged
     };
 
+    // What every tile of a map depends on besides its own inputs: this tool's version,
+    // the mmtile format, every setting that shapes the mesh, and the navmesh origin the
+    // tile coordinates are stored relative to. `threads` and `incremental` change how a
+    // bake runs, not what it writes, so they are deliberately left out.
+    uint64_t NavBakeSalt(const NavConfig& cfg, const float* orig);
+
     // Range of sub-tiles a world-space interval [lo, hi] touches on one axis.
     //
     // The bake bins triangles into sub-tiles so each sub-tile rasterises only its own
@@ -77,10 +89,11 @@ namespace world::nav
         void SetProgress(ProgressFn fn, void* context);
 
         // One durable line per finished map (`written` of `total` tiles produced a
-        // navmesh). Unlike ProgressFn this is meant to survive in a piped log, where the
-        // moving header renders nothing.
+        // navmesh, `unchanged` more were skipped by an incremental bake). Unlike
+        // ProgressFn this is meant to survive in a piped log, where the moving header
+        // renders nothing.
         using MapDoneFn = void (*)(void* context, uint32_t mapId, const char* mapName,
-                                   int written, size_t total);
+                                   int written, int unchanged, size_t total);
         void SetMapDone(MapDoneFn fn);
 
         /// Bakes every map that has tiles, or only `mapFilter` when >= 0.
@@ -89,9 +102,10 @@ namespace world::nav
 
     private:
         // `globalWmo`, when set, is a WMO-only map's single shared tile: every grid in
-        // `grids` bakes from it instead of reading a per-grid tile off disk.
+        // `grids` bakes from it instead of reading a per-grid tile off disk. Tiles an
+        // incremental bake skipped are counted into `unchanged`, not the return value.
         int BakeMap(uint32_t mapId, const std::string& mapName,
-                    const std::vector<std::pair<int, int>>& grids,
+                    const std::vector<std::pair<int, int>>& grids, int& unchanged,
                     std::shared_ptr<const world::terrain::TerrainTile> globalWmo = nullptr);
 
         std::string m_tileDir;
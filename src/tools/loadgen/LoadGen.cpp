@@ -0,0 +1,1263 @@
+/**
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2026 MaNGOS <https://www.getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file LoadGen.cpp
+ * @brief HOW DOES A REAL MANGOSD HOLD UP UNDER N PLAYERS DOING WHAT PLAYERS DO?
+ *
+ * NetworkStressTest drives the network engine and `mangosd -t` drives game scenarios
+ * in process; neither puts a running server under the traffic it meets in production.
+ * This does: it opens N client connections, frames them with proto::PacketCodec from
+ * the client's side, and for each one
+ *
+ *   - authenticates, creates a character when the account has none and enters the
+ *     world, timing CMSG_PLAYER_LOGIN to SMSG_LOGIN_VERIFY_WORLD;
+ *   - walks back and forth, with the start/heartbeat/stop packets a client sends;
+ *   - says a numbered line and times it until the server echoes it back;
+ *   - casts a spell on itself and times it until SMSG_SPELL_GO or SMSG_CAST_FAILED;
+ *   - browses an auction house and times it until SMSG_AUCTION_LIST_RESULT;
+ *   - pings as the client does, every thirty seconds, since a faster ping is a kick.
+ *
+ * What a player waits for is the round trip, so that is what gets the percentiles. How
+ * long the server spent is asked of the server: the first account is an administrator,
+ * samples ".server info" for the world tick through the run, and at the end asks for
+ * ".debug maptick" and ".debug opcodes", whose answers are printed as they arrive.
+ *
+ * THE AUTH STAND-IN. The world server trusts the session key realmd left in the
+ * `account` table and nothing else, so there is no SRP6 exchange to fake: --provision
+ * prints the accounts with keys derived from --seed and no usable password, to be run
+ * once against realmd's database, and a run with the same --seed proves it knows them. The tool itself never
+ * opens a database. Run the server with Warden.EnforcementMode = 0, since no real
+ * client is there to answer its checks, and pass --tele to put everyone beside the
+ * auctioneer named by --auctioneer: an auction house only answers those in reach.
+ */
+
+#include "PacketCodec.h"
+#include "Opcodes.h"
+#include "Auth/BigNumber.h"
+#include "Auth/Sha1.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef _WIN32
+#  include <winsock2.h>
+#  include <ws2tcpip.h>
+   typedef SOCKET socket_t;
+   typedef WSAPOLLFD pollfd_t;
+#  define CLOSESOCKET closesocket
+#  define POLL WSAPoll
+#else
+#  include <arpa/inet.h>
+#  include <errno.h>
+#  include <fcntl.h>
+#  include <netdb.h>
+#  include <netinet/in.h>
+#  include <netinet/tcp.h>
+#  include <poll.h>
+#  include <sys/socket.h>
+#  include <unistd.h>
+   typedef int socket_t;
+   typedef struct pollfd pollfd_t;
+#  define INVALID_SOCKET (-1)
+#  define CLOSESOCKET ::close
+#  define POLL ::poll
+#endif
+
+namespace
+{
+    typedef std::chrono::steady_clock Clock;
+
+    // The handful of game constants the scripts need. The tool links no game code, so
+    // they are restated here; the comment names where each one lives.
+    const uint8  AUTH_OK              = 0x0C; // ResponseCodes, SharedDefines.h
+    const uint8  AUTH_WAIT_QUEUE      = 0x1B;
+    const uint8  CHAR_CREATE_SUCCESS  = 0x2E;
+    const uint32 CHAT_MSG_SAY         = 0x00; // ChatMsg, SharedDefines.h
+    const uint32 CHAT_MSG_SYSTEM      = 0x0A;
+    const uint32 LANG_COMMON          = 7;    // Language, SharedDefines.h
+    const uint32 MOVEFLAG_FORWARD     = 0x00000001; // MovementFlags, Unit.h
+    const uint8  RACE_HUMAN           = 1;
+    const uint8  CLASS_MAGE           = 8;
+    const float  RUN_SPEED            = 7.0f;
+    const float  PI                   = 3.14159265f;
+
+    const uint32 SESSION_KEY_SIZE     = 40;   // AuthCrypt::SetKey under CLASSIC
+
+    enum Kind
+    {
+        KIND_LOGIN,
+        KIND_PING,
+        KIND_CHAT,
+        KIND_CAST,
+        KIND_AUCTION,
+        KIND_COUNT
+    };
+
+    const char* const s_kindNames[KIND_COUNT] = { "login", "ping", "chat", "cast", "auction" };
+
+    struct Options
+    {
+        std::string host = "127.0.0.1";
+        uint16 port = 8085;
+        uint32 clients = 10;
+        uint32 threads = 0;              ///< 0: one per eight clients, at most eight
+        uint32 seconds = 60;
+        uint32 rampMs = 50;              ///< between two connects
+        uint32 build = 5875;
+        uint32 seed = 1;
+        std::string prefix = "LOADGEN";
+        uint32 moveMs = 1000;            ///< pause between two walks; 0 stands still
+        uint32 chatMs = 5000;
+        uint32 castMs = 3000;
+        uint32 spell = 168;              ///< Frost Armor: a level 1 mage's self buff
+        uint32 auctionMs = 10000;
+        uint64 auctioneer = 0;           ///< 0: no auction browsing
+        std::string tele;                ///< game_tele name to gather everyone at
+        uint32 sampleSeconds = 5;
+        uint32 timeoutMs = 5000;
+        bool gm = true;                  ///< the first account asks for tick times
+    };
+
+    /**
+     * @brief The session cipher from the client's seat.
+     *
+     * The same stream as AuthCrypt, keyed the same way, but the lengths swap: a client
+     * encrypts the six bytes AuthCrypt::DecryptRecv undoes and decrypts the four that
+     * AuthCrypt::EncryptSend wrote. AuthCrypt fixes those lengths for the server side,
+     * hence this mirror.
+     */
+    class ClientCrypt
+    {
+        public:
+
+            void Init(const uint8* key, size_t len)
+            {
+                m_key.assign(key, key + len);
+                m_sendI = m_sendJ = m_recvI = m_recvJ = 0;
+            }
+
+            void EncryptSend(uint8* data, size_t len)
+            {
+                if (m_key.empty())
+                {
+                    return;
+                }
+                for (size_t t = 0; t < len; ++t)
+                {
+                    m_sendI %= m_key.size();
+                    uint8 x = (data[t] ^ m_key[m_sendI]) + m_sendJ;
+                    ++m_sendI;
+                    data[t] = m_sendJ = x;
+                }
+            }
+
+            void DecryptRecv(uint8* data, size_t len)
+            {
+                if (m_key.empty())
+                {
+                    return;
+                }
+                for (size_t t = 0; t < len; ++t)
+                {
+                    m_recvI %= m_key.size();
+                    uint8 x = (data[t] - m_recvJ) ^ m_key[m_recvI];
+                    ++m_recvI;
+                    m_recvJ = data[t];
+                    data[t] = x;
+                }
+            }
+
+        private:
+
+            std::vector<uint8> m_key;
+            size_t m_sendI = 0, m_recvI = 0;
+            uint8 m_sendJ = 0, m_recvJ = 0;
+    };
+
+    std::string AccountName(const Options& opt, uint32 index)
+    {
+        char buf[16];
+        std::snprintf(buf, sizeof(buf), "%04u", index + 1);
+        return opt.prefix + buf;
+    }
+
+    /// Character names may only hold letters, so the index is spelled in base 26.
+    std::string CharacterName(uint32 index)
+    {
+        std::string name = "Lg";
+        std::string digits;
+        for (int i = 0; i < 6; ++i)
+        {
+            digits.insert(digits.begin(), char('a' + index % 26));
+            index /= 26;
+        }
+        return name + digits;
+    }
+
+    /// The session key of one account: little-endian, as AuthCrypt is handed it, and
+    /// a pure function of the seed and the name so both halves of a run agree on it.
+    void SessionKey(const Options& opt, const std::string& account, uint8 (&key)[SESSION_KEY_SIZE])
+    {
+        for (uint32 block = 0; block * 20 < SESSION_KEY_SIZE; ++block)
+        {
+            Sha1Hash sha;
+            sha.UpdateData("mangos-loadgen");
+            sha.UpdateData(reinterpret_cast<const uint8*>(&opt.seed), sizeof(opt.seed));
+            sha.UpdateData(account);
+            sha.UpdateData(reinterpret_cast<const uint8*>(&block), sizeof(block));
+            sha.Finalize();
+            const uint32 take = std::min<uint32>(20, SESSION_KEY_SIZE - block * 20);
+            std::memcpy(key + block * 20, sha.GetDigest(), take);
+        }
+        // A zero top byte would make the number shorter than the key it stands for.
+        key[SESSION_KEY_SIZE - 1] |= 0x80;
+    }
+
+    /// The same key as the hex realmd stores: big-endian, for BigNumber::SetHexStr.
+    std::string SessionKeyHex(const uint8 (&key)[SESSION_KEY_SIZE])
+    {
+        static const char digits[] = "0123456789ABCDEF";
+        std::string hex;
+        for (int i = SESSION_KEY_SIZE - 1; i >= 0; --i)
+        {
+            hex += digits[key[i] >> 4];
+            hex += digits[key[i] & 0xF];
+        }
+        return hex;
+    }
+
+    /// A `sha_pass_hash` nobody can log in with: UPPER(SHA1(...)) is forty hex digits
+    /// and this is not, and the rest of it is drawn afresh on every run.
+    std::string UnusablePassHash(std::random_device& device)
+    {
+        static const char digits[] = "0123456789ABCDEF";
+        std::string hash = "!";
+        while (hash.size() < 40)
+        {
+            hash += digits[device() & 0xF];
+        }
+        return hash;
+    }
+
+    /// A new account gets the session key, an unusable password and, for the first one
+    /// under --gm, administrator rights. An account that already exists only gets the
+    /// session key: its password and gmlevel are left as they are.
+    int Provision(const Options& opt)
+    {
+        std::random_device device;
+        std::printf("-- mangos-loadgen accounts, seed %u. Run against the realmd database.\n", opt.seed);
+        for (uint32 i = 0; i < opt.clients; ++i)
+        {
+            const std::string name = AccountName(opt, i);
+            uint8 key[SESSION_KEY_SIZE];
+            SessionKey(opt, name, key);
+            std::printf("INSERT INTO `account` (`username`, `sha_pass_hash`, `gmlevel`, `sessionkey`) "
+                        "VALUES ('%s', '%s', %u, '%s') "
+                        "ON DUPLICATE KEY UPDATE `sessionkey` = VALUES(`sessionkey`);\n",
+                        name.c_str(), UnusablePassHash(device).c_str(), (opt.gm && i == 0) ? 3u : 0u,
+                        SessionKeyHex(key).c_str());
+        }
+        return 0;
+    }
+
+    /// Round trips of one kind, in microseconds, and the requests never answered.
+    struct Samples
+    {
+        std::vector<uint32> micros;
+        uint64 sent = 0;
+        uint64 lost = 0;
+
+        void Merge(const Samples& other)
+        {
+            micros.insert(micros.end(), other.micros.begin(), other.micros.end());
+            sent += other.sent;
+            lost += other.lost;
+        }
+    };
+
+    /// What every worker reports into. Written under the lock, once per event, which
+    /// at these rates is nothing next to the socket calls around it.
+    struct Shared
+    {
+        std::atomic<uint32> inWorld{0};
+        std::atomic<uint32> failed{0};
+
+        std::mutex lock;
+        std::string firstFailure;
+        std::vector<uint32> worldDelayMs;   ///< ".server info" samples
+        std::vector<std::string> report;    ///< what the server said at the end
+    };
+
+    class Client
+    {
+        public:
+
+            Client(const Options& opt, uint32 index, Clock::time_point connectAt)
+                : m_opt(opt),
+                  m_index(index),
+                  m_account(AccountName(opt, index)),
+                  m_gm(opt.gm && index == 0),
+                  m_connectAt(connectAt),
+                  m_codec(proto::PacketCodec::HeaderDecryptor(), proto::PacketCodec::Peer::Server),
+                  m_rng(opt.seed * 7919u + index)
+            {
+                m_codec.SetHeaderDecryptor([this](uint8* header, size_t len)
+                {
+                    m_crypt.DecryptRecv(header, len);
+                });
+            }
+
+            ~Client()
+            {
+                Close();
+            }
+
+            socket_t Socket() const { return m_sock; }
+            bool Idle() const { return m_state == State::Idle; }
+            bool Done() const { return m_state == State::Failed; }
+            bool WantsWrite() const { return !m_out.empty(); }
+            Clock::time_point ConnectAt() const { return m_connectAt; }
+            const Samples& Stats(Kind kind) const { return m_samples[kind]; }
+            uint64 MovePackets() const { return m_movePackets; }
+
+            void Connect(Shared& shared)
+            {
+                addrinfo hints;
+                std::memset(&hints, 0, sizeof(hints));
+                hints.ai_family = AF_INET;
+                hints.ai_socktype = SOCK_STREAM;
+                addrinfo* res = NULL;
+                const std::string port = std::to_string(m_opt.port);
+                if (getaddrinfo(m_opt.host.c_str(), port.c_str(), &hints, &res) != 0 || !res)
+                {
+                    Fail(shared, "cannot resolve " + m_opt.host);
+                    return;
+                }
+
+                m_sock = socket(res->ai_family, res->ai_socktype, res->ai_protocol);
+                const bool ok = m_sock != INVALID_SOCKET &&
+                                connect(m_sock, res->ai_addr, int(res->ai_addrlen)) == 0;
+                freeaddrinfo(res);
+                if (!ok)
+                {
+                    Fail(shared, "cannot connect to " + m_opt.host + ":" + port);
+                    return;
+                }
+
+                int one = 1;
+                setsockopt(m_sock, IPPROTO_TCP, TCP_NODELAY, reinterpret_cast<const char*>(&one), sizeof(one));
+#ifdef _WIN32
+                u_long nonBlocking = 1;
+                ioctlsocket(m_sock, FIONBIO, &nonBlocking);
+#else
+                fcntl(m_sock, F_SETFL, fcntl(m_sock, F_GETFL, 0) | O_NONBLOCK);
+#endif
+                m_state = State::Challenge;
+            }
+
+            /// Drain the socket into the codec, and the codec into the scripts.
+            void Read(Clock::time_point now, Shared& shared)
+            {
+                uint8 buf[16384];
+                for (;;)
+                {
+                    const int got = int(recv(m_sock, reinterpret_cast<char*>(buf), sizeof(buf), 0));
+                    if (got == 0)
+                    {
+                        Fail(shared, "server closed the connection");
+                        return;
+                    }
+                    if (got < 0)
+                    {
+                        if (!WouldBlock())
+                        {
+                            Fail(shared, "connection reset");
+                        }
+                        return;
+                    }
+
+                    m_in.clear();
+                    if (m_codec.Feed(buf, size_t(got), m_in) == proto::DecodeStatus::Malformed)
+                    {
+                        // The server answers a refused login before the cipher starts,
+                        // so a bad key shows up here as a header that makes no sense.
+                        Fail(shared, m_state == State::Authing
+                             ? "unreadable auth response: was --provision run with this --seed?"
+                             : "malformed server packet");
+                        return;
+                    }
+                    for (WorldPacket& packet : m_in)
+                    {
+                        try
+                        {
+                            Handle(packet, now, shared);
+                        }
+                        catch (ByteBufferException const&)
+                        {
+                            Fail(shared, "short server packet, opcode " + std::to_string(packet.GetOpcode()));
+                        }
+                        if (m_state == State::Failed)
+                        {
+                            return;
+                        }
+                    }
+                }
+            }
+
+            void Flush(Shared& shared)
+            {
+                while (!m_out.empty())
+                {
+                    const int sent = int(send(m_sock, reinterpret_cast<const char*>(m_out.data()), int(m_out.size()), 0));
+                    if (sent < 0)
+                    {
+                        if (!WouldBlock())
+                        {
+                            Fail(shared, "send failed");
+                        }
+                        return;
+                    }
+                    m_out.erase(m_out.begin(), m_out.begin() + sent);
+                }
+            }
+
+            /// Run the scripts due by @p now. @p reportAt is when the run ends and the
+            /// administrator asks the server for its numbers.
+            void Tick(Clock::time_point now, Clock::time_point reportAt, Shared& shared)
+            {
+                if (m_state != State::InWorld)
+                {
+                    return;
+                }
+
+                ExpirePending(now);
+
+                if (now >= m_nextPing)
+                {
+                    WorldPacket ping(CMSG_PING, 8);
+                    ping << uint32(++m_pingSeq) << m_lastLatencyMs;
+                    Request(ping, KIND_PING, m_pingSeq, now);
+                    m_nextPing = now + std::chrono::seconds(30);
+                }
+
+                if (m_opt.moveMs)
+                {
+                    Walk(now);
+                }
+
+                if (m_opt.chatMs && now >= m_nextChat)
+                {
+                    const std::string text = "loadgen " + std::to_string(++m_chatSeq);
+                    WorldPacket chat(CMSG_MESSAGECHAT, 8 + text.size() + 1);
+                    chat << CHAT_MSG_SAY << LANG_COMMON << text;
+                    Request(chat, KIND_CHAT, m_chatSeq, now);
+                    m_nextChat = now + Jitter(m_opt.chatMs);
+                }
+
+                if (m_opt.castMs && now >= m_nextCast && !Awaiting(KIND_CAST))
+                {
+                    WorldPacket cast(CMSG_CAST_SPELL, 6);
+                    cast << m_opt.spell << uint16(0);             // TARGET_FLAG_SELF
+                    Request(cast, KIND_CAST, m_opt.spell, now);
+                    m_nextCast = now + Jitter(m_opt.castMs);
+                }
+
+                if (m_opt.auctioneer && m_opt.auctionMs && now >= m_nextAuction && !Awaiting(KIND_AUCTION))
+                {
+                    WorldPacket browse(CMSG_AUCTION_LIST_ITEMS, 40);
+                    browse << m_opt.auctioneer << uint32(0) << std::string();
+                    browse << uint8(0) << uint8(0);                  // any level
+                    browse << uint32(0xFFFFFFFF) << uint32(0xFFFFFFFF) << uint32(0xFFFFFFFF) << uint32(0xFFFFFFFF);
+                    browse << uint8(0);                              // usable or not
+                    Request(browse, KIND_AUCTION, 0, now);
+                    m_nextAuction = now + Jitter(m_opt.auctionMs);
+                }
+
+                if (m_gm)
+                {
+                    Administer(now, reportAt, shared);
+                }
+            }
+
+        private:
+
+            enum class State
+            {
+                Idle,
+                Challenge,
+                Authing,
+                Listing,
+                Creating,
+                Entering,
+                InWorld,
+                Failed
+            };
+
+            struct Pending
+            {
+                Kind kind;
+                uint32 key;
+                Clock::time_point sentAt;
+            };
+
+            static bool WouldBlock()
+            {
+#ifdef _WIN32
+                return WSAGetLastError() == WSAEWOULDBLOCK;
+#else
+                return errno == EWOULDBLOCK || errno == EAGAIN || errno == EINTR;
+#endif
+            }
+
+            void Close()
+            {
+                if (m_sock != INVALID_SOCKET)
+                {
+                    CLOSESOCKET(m_sock);
+                    m_sock = INVALID_SOCKET;
+                }
+            }
+
+            void Fail(Shared& shared, const std::string& why)
+            {
+                if (m_state == State::InWorld)
+                {
+                    shared.inWorld.fetch_sub(1);
+                }
+                m_state = State::Failed;
+                Close();
+                shared.failed.fetch_add(1);
+
+                std::lock_guard<std::mutex> guard(shared.lock);
+                if (shared.firstFailure.empty())
+                {
+                    shared.firstFailure = m_account + ": " + why;
+                }
+            }
+
+            /// A period spread by a quarter either way, so N clients do not fire in step.
+            Clock::duration Jitter(uint32 ms)
+            {
+                std::uniform_int_distribution<uint32> spread(ms * 3 / 4, ms * 5 / 4);
+                return std::chrono::milliseconds(spread(m_rng));
+            }
+
+            void Send(const WorldPacket& packet)
+            {
+                const std::vector<uint8> wire = proto::PacketCodec::EncodeClient(packet,
+                    [this](uint8* header, size_t len)
+                    {
+                        m_crypt.EncryptSend(header, len);
+                    });
+                m_out.insert(m_out.end(), wire.begin(), wire.end());
+            }
+
+            void Request(const WorldPacket& packet, Kind kind, uint32 key, Clock::time_point now)
+            {
+                Send(packet);
+                m_pending.push_back(Pending{ kind, key, now });
+                ++m_samples[kind].sent;
+            }
+
+            bool Awaiting(Kind kind) const
+            {
+                for (const Pending& p : m_pending)
+                {
+                    if (p.kind == kind)
+                    {
+                        return true;
+                    }
+                }
+                return false;
+            }
+
+            void Answer(Kind kind, uint32 key, Clock::time_point now)
+            {
+                for (size_t i = 0; i < m_pending.size(); ++i)
+                {
+                    if (m_pending[i].kind == kind && m_pending[i].key == key)
+                    {
+                        const auto took = std::chrono::duration_cast<std::chrono::microseconds>(now - m_pending[i].sentAt);
+                        m_samples[kind].micros.push_back(uint32(took.count()));
+                        if (kind == KIND_PING)
+                        {
+                            m_lastLatencyMs = uint32(took.count() / 1000);
+                        }
+                        m_pending.erase(m_pending.begin() + i);
+                        return;
+                    }
+                }
+            }
+
+            void ExpirePending(Clock::time_point now)
+            {
+                const Clock::duration limit = std::chrono::milliseconds(m_opt.timeoutMs);
+                for (size_t i = 0; i < m_pending.size();)
+                {
+                    if (now - m_pending[i].sentAt > limit)
+                    {
+                        ++m_samples[m_pending[i].kind].lost;
+                        m_pending.erase(m_pending.begin() + i);
+                    }
+                    else
+                    {
+                        ++i;
+                    }
+                }
+            }
+
+            void SendMovement(uint16 opcode, uint32 flags)
+            {
+                const uint32 time = uint32(std::chrono::duration_cast<std::chrono::milliseconds>(
+                    Clock::now().time_since_epoch()).count());
+                WorldPacket move(opcode, 28);
+                move << flags << time << m_x << m_y << m_z << m_o << uint32(0); // fall time
+                Send(move);
+                ++m_movePackets;
+            }
+
+            /// Two seconds forward at run speed, heartbeats every half second, then
+            /// turn about and rest: a patrol that never strays from where it began.
+            void Walk(Clock::time_point now)
+            {
+                if (!m_moving)
+                {
+                    if (now >= m_nextMove)
+                    {
+                        m_moving = true;
+                        m_lastStep = now;
+                        m_stopAt = now + std::chrono::seconds(2);
+                        m_nextHeartbeat = now + std::chrono::milliseconds(500);
+                        SendMovement(MSG_MOVE_START_FORWARD, MOVEFLAG_FORWARD);
+                    }
+                    return;
+                }
+
+                if (now < m_nextHeartbeat && now < m_stopAt)
+                {
+                    return;
+                }
+
+                const float dt = std::chrono::duration<float>(std::min(now, m_stopAt) - m_lastStep).count();
+                m_x += std::cos(m_o) * RUN_SPEED * dt;
+                m_y += std::sin(m_o) * RUN_SPEED * dt;
+                m_lastStep = now;
+
+                if (now >= m_stopAt)
+                {
+                    SendMovement(MSG_MOVE_STOP, 0);
+                    m_o = std::fmod(m_o + PI, 2 * PI);
+                    SendMovement(MSG_MOVE_SET_FACING, 0);
+                    m_moving = false;
+                    m_nextMove = now + Jitter(m_opt.moveMs);
+                }
+                else
+                {
+                    SendMovement(MSG_MOVE_HEARTBEAT, MOVEFLAG_FORWARD);
+                    m_nextHeartbeat = now + std::chrono::milliseconds(500);
+                }
+            }
+
+            void Say(const std::string& text)
+            {
+                WorldPacket chat(CMSG_MESSAGECHAT, 8 + text.size() + 1);
+                chat << CHAT_MSG_SAY << LANG_COMMON << text;
+                Send(chat);
+            }
+
+            /// The administrator's extra duties: gather everyone, sample the world
+            /// tick, and at the end ask the server where its time went.
+            void Administer(Clock::time_point now, Clock::time_point reportAt, Shared& shared)
+            {
+                if (!m_opt.tele.empty() && !m_gathered &&
+                    (shared.inWorld.load() + shared.failed.load() >= m_opt.clients || now >= m_gatherBy))
+                {
+                    for (uint32 i = 0; i < m_opt.clients; ++i)
+                    {
+                        Say(".tele name " + CharacterName(i) + " " + m_opt.tele);
+                    }
+                    m_gathered = true;
+                }
+
+                if (now >= m_nextSample && now < reportAt)
+                {
+                    Say(".server info");
+                    m_nextSample = now + std::chrono::seconds(std::max<uint32>(1, m_opt.sampleSeconds));
+                }
+
+                if (now >= reportAt && !m_reporting)
+                {
+                    m_reporting = true;
+                    Say(".debug maptick");
+                    Say(".debug opcodes 10");
+                }
+            }
+
+            void Handle(WorldPacket& packet, Clock::time_point now, Shared& shared)
+            {
+                switch (packet.GetOpcode())
+                {
+                    case SMSG_AUTH_CHALLENGE:
+                    {
+                        uint32 serverSeed;
+                        packet >> serverSeed;
+                        const uint32 clientSeed = m_rng();
+
+                        uint8 key[SESSION_KEY_SIZE];
+                        SessionKey(m_opt, m_account, key);
+                        BigNumber K;
+                        K.SetBinary(key, SESSION_KEY_SIZE);
+
+                        // Exactly what ClientConnection::HandleAuthSession recomputes.
+                        const uint8 zero[4] = { 0, 0, 0, 0 };
+                        Sha1Hash sha;
+                        sha.UpdateData(m_account);
+                        sha.UpdateData(zero, sizeof(zero));
+                        sha.UpdateData(reinterpret_cast<const uint8*>(&clientSeed), sizeof(clientSeed));
+                        sha.UpdateData(reinterpret_cast<const uint8*>(&serverSeed), sizeof(serverSeed));
+                        sha.UpdateBigNumbers(&K, NULL);
+                        sha.Finalize();
+
+                        WorldPacket auth(CMSG_AUTH_SESSION, 64);
+                        auth << m_opt.build << uint32(0) << m_account << clientSeed;
+                        auth.append(sha.GetDigest(), 20);
+                        Send(auth);
+
+                        // The server keys its cipher as it accepts the digest, so
+                        // everything after this packet is enciphered both ways.
+                        m_crypt.Init(key, SESSION_KEY_SIZE);
+                        m_state = State::Authing;
+                        break;
+                    }
+                    case SMSG_AUTH_RESPONSE:
+                    {
+                        uint8 code;
+                        packet >> code;
+                        if (code == AUTH_OK)
+                        {
+                            Send(WorldPacket(CMSG_CHAR_ENUM, 0));
+                            m_state = State::Listing;
+                        }
+                        else if (code != AUTH_WAIT_QUEUE)
+                        {
+                            Fail(shared, "auth refused, code " + std::to_string(code));
+                        }
+                        break;
+                    }
+                    case SMSG_CHAR_ENUM:
+                    {
+                        uint8 count;
+                        packet >> count;
+                        if (count == 0)
+                        {
+                            if (m_state == State::Creating)
+                            {
+                                Fail(shared, "created a character but the list is empty");
+                                break;
+                            }
+                            WorldPacket create(CMSG_CHAR_CREATE, 24);
+                            create << CharacterName(m_index) << RACE_HUMAN << CLASS_MAGE;
+                            create << uint8(0) << uint8(0) << uint8(0);    // gender, skin, face
+                            create << uint8(0) << uint8(0) << uint8(0);    // hair style, colour, facial
+                            create << uint8(0);                            // outfit
+                            Send(create);
+                            m_state = State::Creating;
+                            break;
+                        }
+                        packet >> m_guid;
+                        WorldPacket login(CMSG_PLAYER_LOGIN, 8);
+                        login << m_guid;
+                        Request(login, KIND_LOGIN, 0, now);
+                        m_state = State::Entering;
+                        break;
+                    }
+                    case SMSG_CHAR_CREATE:
+                    {
+                        uint8 code;
+                        packet >> code;
+                        if (code != CHAR_CREATE_SUCCESS)
+                        {
+                            Fail(shared, "character create refused, code " + std::to_string(code));
+                            break;
+                        }
+                        Send(WorldPacket(CMSG_CHAR_ENUM, 0));
+                        break;
+                    }
+                    case SMSG_CHARACTER_LOGIN_FAILED:
+                        Fail(shared, "character login refused");
+                        break;
+                    case SMSG_LOGIN_VERIFY_WORLD:
+                    {
+                        uint32 map;
+                        packet >> map >> m_x >> m_y >> m_z >> m_o;
+                        if (m_state == State::Entering)
+                        {
+                            Answer(KIND_LOGIN, 0, now);
+                            m_state = State::InWorld;
+                            shared.inWorld.fetch_add(1);
+
+                            // Start every script somewhere inside its period.
+                            m_nextPing = now + std::chrono::seconds(30);
+                            m_nextMove = now + Jitter(std::max<uint32>(m_opt.moveMs, 1));
+                            m_nextChat = now + Jitter(std::max<uint32>(m_opt.chatMs, 1));
+                            m_nextCast = now + Jitter(std::max<uint32>(m_opt.castMs, 1));
+                            m_nextAuction = now + Jitter(std::max<uint32>(m_opt.auctionMs, 1));
+                            m_nextSample = now;
+                            m_gatherBy = now + std::chrono::milliseconds(uint64(m_opt.rampMs) * m_opt.clients)
+                                             + std::chrono::seconds(10);
+                        }
+                        break;
+                    }
+                    case SMSG_PONG:
+                    {
+                        uint32 seq;
+                        packet >> seq;
+                        Answer(KIND_PING, seq, now);
+                        break;
+                    }
+                    case SMSG_MESSAGECHAT:
+                        HandleChat(packet, now, shared);
+                        break;
+                    case SMSG_SPELL_GO:
+                    {
+                        packet.readPackGUID();                   // the item, or the caster again
+                        const uint64 caster = packet.readPackGUID();
+                        uint32 spell;
+                        packet >> spell;
+                        if (caster == m_guid)
+                        {
+                            Answer(KIND_CAST, spell, now);
+                        }
+                        break;
+                    }
+                    case SMSG_CAST_FAILED:
+                    {
+                        uint32 spell;
+                        packet >> spell;
+                        Answer(KIND_CAST, spell, now);
+                        break;
+                    }
+                    case SMSG_AUCTION_LIST_RESULT:
+                        Answer(KIND_AUCTION, 0, now);
+                        break;
+                    case MSG_MOVE_TELEPORT_ACK:
+                    {
+                        packet.readPackGUID();
+                        uint32 counter, flags, time;
+                        packet >> counter >> flags >> time >> m_x >> m_y >> m_z >> m_o;
+                        WorldPacket ack(MSG_MOVE_TELEPORT_ACK, 16);
+                        ack << m_guid << counter << time;
+                        Send(ack);
+                        m_moving = false;
+                        break;
+                    }
+                    case SMSG_NEW_WORLD:
+                    {
+                        uint32 map;
+                        packet >> map >> m_x >> m_y >> m_z >> m_o;
+                        Send(WorldPacket(MSG_MOVE_WORLDPORT_ACK, 0));
+                        m_moving = false;
+                        break;
+                    }
+                    default:
+                        break;
+                }
+            }
+
+            void HandleChat(WorldPacket& packet, Clock::time_point now, Shared& shared)
+            {
+                uint8 type;
+                uint32 language, length;
+                uint64 sender;
+                std::string text;
+                packet >> type >> language;
+
+                if (type == CHAT_MSG_SAY)
+                {
+                    packet >> sender >> sender >> length >> text;
+                    if (sender == m_guid && text.compare(0, 8, "loadgen ") == 0)
+                    {
+                        Answer(KIND_CHAT, uint32(std::strtoul(text.c_str() + 8, NULL, 10)), now);
+                    }
+                    return;
+                }
+                if (type != CHAT_MSG_SYSTEM || !m_gm)
+                {
+                    return;
+                }
+
+                packet >> sender >> length >> text;
+                std::lock_guard<std::mutex> guard(shared.lock);
+                if (m_reporting)
+                {
+                    shared.report.push_back(text);
+                }
+                else if (text.compare(0, 13, "World Delay: ") == 0)
+                {
+                    shared.worldDelayMs.push_back(uint32(std::strtoul(text.c_str() + 13, NULL, 10)));
+                }
+            }
+
+            const Options& m_opt;
+            const uint32 m_index;
+            const std::string m_account;
+            const bool m_gm;
+            const Clock::time_point m_connectAt;
+
+            socket_t m_sock = INVALID_SOCKET;
+            State m_state = State::Idle;
+            proto::PacketCodec m_codec;
+            ClientCrypt m_crypt;
+            std::vector<WorldPacket> m_in;
+            std::vector<uint8> m_out;
+            std::mt19937 m_rng;
+
+            uint64 m_guid = 0;
+            float m_x = 0.f, m_y = 0.f, m_z = 0.f, m_o = 0.f;
+
+            std::vector<Pending> m_pending;
+            Samples m_samples[KIND_COUNT];
+            uint64 m_movePackets = 0;
+            uint32 m_pingSeq = 0;
+            uint32 m_chatSeq = 0;
+            uint32 m_lastLatencyMs = 0;
+
+            bool m_moving = false;
+            Clock::time_point m_lastStep, m_stopAt, m_nextHeartbeat, m_nextMove;
+            Clock::time_point m_nextPing, m_nextChat, m_nextCast, m_nextAuction;
+
+            bool m_gathered = false;
+            bool m_reporting = false;
+            Clock::time_point m_nextSample, m_gatherBy;
+    };
+
+    /// One thread's share of the clients, all polled together.
+    void RunWorker(std::vector<std::unique_ptr<Client>>& clients, Clock::time_point reportAt,
+                   Clock::time_point endAt, Shared& shared)
+    {
+        std::vector<pollfd_t> fds;
+        std::vector<Client*> polled;
+
+        for (Clock::time_point now = Clock::now(); now < endAt; now = Clock::now())
+        {
+            fds.clear();
+            polled.clear();
+            for (const std::unique_ptr<Client>& c : clients)
+            {
+                if (c->Idle() && now >= c->ConnectAt() && now < reportAt)
+                {
+                    c->Connect(shared);
+                }
+                if (c->Idle() || c->Done())
+                {
+                    continue;
+                }
+                pollfd_t fd;
+                fd.fd = c->Socket();
+                fd.events = POLLIN | (c->WantsWrite() ? POLLOUT : 0);
+                fd.revents = 0;
+                fds.push_back(fd);
+                polled.push_back(c.get());
+            }
+
+            if (fds.empty())
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+                continue;
+            }
+            if (POLL(fds.data(), (unsigned long)fds.size(), 10) < 0)
+            {
+                continue;
+            }
+
+            now = Clock::now();
+            for (size_t i = 0; i < fds.size(); ++i)
+            {
+                Client* c = polled[i];
+                if (fds[i].revents & (POLLIN | POLLHUP | POLLERR))
+                {
+                    c->Read(now, shared);
+                }
+                if (!c->Done())
+                {
+                    c->Tick(now, reportAt, shared);
+                }
+                if (!c->Done())
+                {
+                    c->Flush(shared);
+                }
+            }
+        }
+    }
+
+    void PrintLatency(const char* name, Samples& s)
+    {
+        if (s.sent == 0)
+        {
+            return;
+        }
+        std::sort(s.micros.begin(), s.micros.end());
+        const auto at = [&s](double q) -> double
+        {
+            if (s.micros.empty())
+            {
+                return 0.0;
+            }
+            const size_t i = std::min(s.micros.size() - 1, size_t(q * double(s.micros.size())));
+            return s.micros[i] / 1000.0;
+        };
+        std::printf("  %-8s %9llu %9zu %6llu %9.2f %9.2f %9.2f %9.2f\n", name,
+                    (unsigned long long)s.sent, s.micros.size(), (unsigned long long)s.lost,
+                    at(0.50), at(0.90), at(0.99), s.micros.empty() ? 0.0 : s.micros.back() / 1000.0);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 2)
+    {
+        std::printf("usage: mangos-loadgen <host> [options]      drive a running mangosd\n"
+                    "       mangos-loadgen --provision [options]  print the accounts as SQL for realmd\n"
+                    "\n"
+                    "  --port <n>        : world port                                 (default: 8085)\n"
+                    "  --clients <n>     : connections, one character each            (default: 10)\n"
+                    "  --threads <n>     : client threads             (default: one per eight clients)\n"
+                    "  --seconds <n>     : length of the run after the last connect   (default: 60)\n"
+                    "  --ramp <ms>       : pause between two connects                 (default: 50)\n"
+                    "  --seed <n>        : session key seed; must match --provision   (default: 1)\n"
+                    "  --prefix <name>   : account names are <name>0001 and on        (default: LOADGEN)\n"
+                    "  --build <n>       : client build to claim                      (default: 5875)\n"
+                    "  --move <ms>       : rest between two walks, 0 stands still     (default: 1000)\n"
+                    "  --chat <ms>       : period of a numbered /say, 0 off           (default: 5000)\n"
+                    "  --cast <ms>       : period of a self cast, 0 off               (default: 3000)\n"
+                    "  --spell <id>      : the spell cast                             (default: 168)\n"
+                    "  --auction <ms>    : period of an auction browse, 0 off         (default: 10000)\n"
+                    "  --auctioneer <g>  : full guid of the auctioneer to browse at   (default: none)\n"
+                    "  --tele <name>     : game_tele location to gather everyone at   (default: none)\n"
+                    "  --sample <s>      : period of the world tick sample            (default: 5)\n"
+                    "  --timeout <ms>    : when an unanswered request counts as lost  (default: 5000)\n"
+                    "  --no-gm           : no administrator; no tick times, no --tele\n");
+        return 2;
+    }
+
+    Options opt;
+    bool provision = false;
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string a = argv[i];
+        const bool more = i + 1 < argc;
+        if (a == "--provision")
+        {
+            provision = true;
+        }
+        else if (a == "--no-gm")
+        {
+            opt.gm = false;
+        }
+        else if (a == "--port" && more)
+        {
+            opt.port = uint16(std::atoi(argv[++i]));
+        }
+        else if (a == "--clients" && more)
+        {
+            opt.clients = uint32(std::strtoul(argv[++i], NULL, 10));
+        }
+        else if (a == "--threads" && more)
+        {
+            opt.threads = uint32(std::strtoul(argv[++i], NULL, 10));
+        }
+        else if (a == "--seconds" && more)
+        {
+            opt.seconds = uint32(std::strtoul(argv[++i], NULL, 10));
+        }
+        else if (a == "--ramp" && more)
+        {
+            opt.rampMs = uint32(std::strtoul(argv[++i], NULL, 10));
+        }
+        else if (a == "--seed" && more)
+        {
+            opt.seed = uint32(std::strtoul(argv[++i], NULL, 10));
+        }
+        else if (a == "--prefix" && more)
+        {
+            opt.prefix = argv[++i];
+        }
+        else if (a == "--build" && more)
+        {
+            opt.build = uint32(std::strtoul(argv[++i], NULL, 10));
+        }
+        else if (a == "--move" && more)
+        {
+            opt.moveMs = uint32(std::strtoul(argv[++i], NULL, 10));
+        }
+        else if (a == "--chat" && more)
+        {
+            opt.chatMs = uint32(std::strtoul(argv[++i], NULL, 10));
+        }
+        else if (a == "--cast" && more)
+        {
+            opt.castMs = uint32(std::strtoul(argv[++i], NULL, 10));
+        }
+        else if (a == "--spell" && more)
+        {
+            opt.spell = uint32(std::strtoul(argv[++i], NULL, 10));
+        }
+        else if (a == "--auction" && more)
+        {
+            opt.auctionMs = uint32(std::strtoul(argv[++i], NULL, 10));
+        }
+        else if (a == "--auctioneer" && more)
+        {
+            opt.auctioneer = std::strtoull(argv[++i], NULL, 0);
+        }
+        else if (a == "--tele" && more)
+        {
+            opt.tele = argv[++i];
+        }
+        else if (a == "--sample" && more)
+        {
+            opt.sampleSeconds = uint32(std::strtoul(argv[++i], NULL, 10));
+        }
+        else if (a == "--timeout" && more)
+        {
+            opt.timeoutMs = uint32(std::strtoul(argv[++i], NULL, 10));
+        }
+        else if (a[0] != '-')
+        {
+            opt.host = a;
+        }
+        else
+        {
+            std::printf("unknown option %s\n", a.c_str());
+            return 2;
+        }
+    }
+
+    // Account names are the prefix and four digits; realmd keeps them upper case.
+    std::transform(opt.prefix.begin(), opt.prefix.end(), opt.prefix.begin(), ::toupper);
+    if (opt.clients == 0)
+    {
+        std::printf("nothing to do: --clients 0\n");
+        return 2;
+    }
+    if (provision)
+    {
+        return Provision(opt);
+    }
+
+#ifdef _WIN32
+    WSADATA wsa;
+    WSAStartup(MAKEWORD(2, 2), &wsa);
+#endif
+
+    const uint32 threads = std::max<uint32>(1, std::min(opt.clients,
+        opt.threads ? opt.threads : std::min<uint32>(8, (opt.clients + 7) / 8)));
+
+    // The run is measured from the last connect, so every client does its share; the
+    // last few seconds are the administrator's, for the server's answers to arrive.
+    const Clock::time_point start = Clock::now();
+    const Clock::time_point reportAt = start + std::chrono::milliseconds(uint64(opt.rampMs) * opt.clients)
+                                             + std::chrono::seconds(opt.seconds);
+    const Clock::time_point endAt = reportAt + std::chrono::seconds(opt.gm ? 3 : 0);
+
+    std::vector<std::vector<std::unique_ptr<Client>>> shares(threads);
+    for (uint32 i = 0; i < opt.clients; ++i)
+    {
+        shares[i % threads].push_back(std::unique_ptr<Client>(
+            new Client(opt, i, start + std::chrono::milliseconds(uint64(opt.rampMs) * i))));
+    }
+
+    std::printf("%u clients on %u threads against %s:%u, %u s after a %u ms ramp\n", opt.clients,
+                threads, opt.host.c_str(), opt.port, opt.seconds, opt.rampMs * opt.clients);
+    std::fflush(stdout);
+
+    Shared shared;
+    std::vector<std::thread> workers;
+    for (uint32 t = 0; t < threads; ++t)
+    {
+        workers.emplace_back(RunWorker, std::ref(shares[t]), reportAt, endAt, std::ref(shared));
+    }
+    for (std::thread& w : workers)
+    {
+        w.join();
+    }
+
+    Samples total[KIND_COUNT];
+    uint64 movePackets = 0;
+    for (std::vector<std::unique_ptr<Client>>& share : shares)
+    {
+        for (const std::unique_ptr<Client>& c : share)
+        {
+            for (int k = 0; k < KIND_COUNT; ++k)
+            {
+                total[k].Merge(c->Stats(Kind(k)));
+            }
+            movePackets += c->MovePackets();
+        }
+    }
+
+    std::printf("\n%u in world at the end, %u failed\n", shared.inWorld.load(), shared.failed.load());
+    if (!shared.firstFailure.empty())
+    {
+        std::printf("  first failure: %s\n", shared.firstFailure.c_str());
+    }
+    std::printf("%llu movement packets\n\n", (unsigned long long)movePackets);
+
+    std::printf("  round trip     sent  answered   lost   p50 ms    p90 ms    p99 ms    max ms\n");
+    for (int k = 0; k < KIND_COUNT; ++k)
+    {
+        PrintLatency(s_kindNames[k], total[k]);
+    }
+
+    if (!shared.worldDelayMs.empty())
+    {
+        std::vector<uint32>& d = shared.worldDelayMs;
+        std::sort(d.begin(), d.end());
+        std::printf("\n  world tick, %zu samples: p50 %u ms, p90 %u ms, max %u ms\n", d.size(),
+                    d[d.size() / 2], d[std::min(d.size() - 1, d.size() * 9 / 10)], d.back());
+    }
+    if (!shared.report.empty())
+    {
+        std::printf("\nserver:\n");
+        for (const std::string& line : shared.report)
+        {
+            std::printf("  %s\n", line.c_str());
+        }
+    }
+
+#ifdef _WIN32
+    WSACleanup();
+#endif
+    return shared.inWorld.load() ? 0 : 1;
+}
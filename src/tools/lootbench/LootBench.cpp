@@ -0,0 +1,299 @@
+/**
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2026 MaNGOS <https://www.getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+/**
+ * @file LootBench.cpp
+ * @brief HOW MUCH FASTER IS THE FLATTENED LOOT TABLE, AND DOES IT STILL DROP WHAT THE ROWS DID?
+ *
+ * Generation rolls loot from a CompiledLootTable: references resolved to indices at
+ * load, a group's item found by binary search over running sums. The rows it was
+ * compiled from can still be rolled the old way, by LootRows::Process -- references
+ * looked up by id at every roll, chance subtracted after chance -- and that walk is
+ * what the table has to agree with. The unit tests prove it on a few hundred
+ * templates; this times it on as many as the world database holds:
+ *
+ *   - templates shaped like creature loot: a few plain entries, up to three short
+ *     groups, a quarter of the entries references; reference templates with long
+ *     groups of small chances, as world drops are;
+ *   - every loot rolled twice from the same seed, once each way, and every loot
+ *     whose items differ counted -- a mismatch is a compile bug, not noise;
+ *   - then each way timed over the whole run on its own, so neither warms the cache
+ *     for the other within a loot.
+ */
+
+#include "CompiledLootTable.h"
+#include "LootTemplateRows.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+    struct Row
+    {
+        uint32 itemid;
+        float chance;
+        int32 mincountOrRef;                                // negative: reference id
+        uint8 group;
+        uint8 maxcount;
+    };
+
+    /// xorshift64*; cheap enough not to hide the cost of the walk itself. Rolls fall
+    /// halfway between hundredths and chances on them, as the database writes them, so
+    /// no roll ever sits on a sum that summing and subtracting might round apart.
+    struct Policy
+    {
+        explicit Policy(uint64 seed) : state(seed * 0x9E3779B97F4A7C15ULL + 1) {}
+
+        bool IsAllowed(Row const& /*row*/) const { return true; }
+        bool Roll(Row const& row) { return row.chance >= 100.0f || row.chance > RollChance(); }
+        bool IsReferenceAllowed(Row const& /*row*/) const { return true; }
+        float RollChance() { return (float(Next() % 10000) + 0.5f) * 0.01f; }
+        uint32 RollIndex(uint32 count) { return Next() % count; }
+        void Add(Row const& row) { items.push_back(row.itemid); }
+
+        uint32 Next()
+        {
+            state ^= state >> 12;
+            state ^= state << 25;
+            state ^= state >> 27;
+            return uint32((state * 0x2545F4914F6CDD1DULL) >> 32);
+        }
+
+        uint64 state;
+        std::vector<uint32> items;
+    };
+
+    struct Template
+    {
+        std::vector<Row> entries;
+        std::vector<LootRows::Group<Row> > groups;
+
+        void Add(Row const& row) { LootRows::AddEntry(entries, groups, row); }
+    };
+
+    typedef std::unordered_map<uint32, Template> Store;
+
+    struct References
+    {
+        explicit References(Store const& store_) : store(store_) {}
+
+        bool Has(uint32 id) const { return store.find(id) != store.end(); }
+
+        void Process(uint32 id, Policy& policy, uint8 groupId) const
+        {
+            Template const& tab = store.find(id)->second;
+            LootRows::Process(tab.entries, tab.groups, policy, *this, groupId);
+        }
+
+        Store const& store;
+    };
+
+    float Chance(std::mt19937& rng, float max)
+    {
+        return float(1 + rng() % uint32(max * 100)) * 0.01f;
+    }
+
+    void Fill(Template& tab, std::mt19937& rng, uint32& item, uint32 referenceIds)
+    {
+        uint32 entries = 1 + rng() % 6;
+        for (uint32 i = 0; i < entries; ++i)
+        {
+            Row row = { item++, Chance(rng, 60.0f), 1, 0, 1 };
+            if (rng() % 25 == 0)
+            {
+                row.chance = 100.0f;
+            }
+            if (referenceIds && rng() % 4 == 0)
+            {
+                row.mincountOrRef = -int32(1 + rng() % referenceIds);
+                row.group = uint8(rng() % 3);
+                row.maxcount = uint8(1 + rng() % 2);
+                if (rng() % 2)
+                {
+                    row.chance = 100.0f;
+                }
+            }
+            tab.Add(row);
+        }
+
+        uint32 groups = rng() % 4;
+        for (uint32 g = 0; g < groups; ++g)
+        {
+            uint32 chanced = referenceIds ? rng() % 12 : 20 + rng() % 300;
+            float maxChance = referenceIds ? 12.0f : 0.5f;
+            for (uint32 i = 0; i < chanced; ++i)
+            {
+                Row row = { item++, Chance(rng, maxChance), 1, uint8(g + 1), 1 };
+                if (rng() % 30 == 0)
+                {
+                    row.chance = 100.0f;
+                }
+                tab.Add(row);
+            }
+            uint32 equal = rng() % 3 == 0 ? rng() % 5 : 0;
+            for (uint32 i = 0; i < equal; ++i)
+            {
+                Row row = { item++, 0.0f, 1, uint8(g + 1), 1 };
+                tab.Add(row);
+            }
+        }
+    }
+
+    void Compile(Store const& store, CompiledLootTable<Row>& table)
+    {
+        for (Store::const_iterator tab = store.begin(); tab != store.end(); ++tab)
+        {
+            LootRows::Compile(tab->second.entries, tab->second.groups, table, tab->first);
+        }
+    }
+
+    double Seconds(std::chrono::steady_clock::time_point begin)
+    {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+    }
+}
+
+int main(int argc, char** argv)
+{
+    uint32 templates = 20000;
+    uint32 loots = 2000000;
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string a = argv[i];
+        if (a == "--templates" && i + 1 < argc)
+        {
+            templates = uint32(std::strtoul(argv[++i], nullptr, 10));
+        }
+        else if (a == "--loots" && i + 1 < argc)
+        {
+            loots = uint32(std::strtoul(argv[++i], nullptr, 10));
+        }
+        else
+        {
+            std::printf("usage: mangos-lootbench [--templates <n>] [--loots <n>]\n"
+                        "\n"
+                        "  --templates <n>: creature loot templates           (default: 20000)\n"
+                        "  --loots <n>    : loots rolled each way              (default: 2000000)\n");
+            return 2;
+        }
+    }
+    if (!templates || !loots)
+    {
+        std::printf("nothing to roll\n");
+        return 2;
+    }
+
+    std::mt19937 rng(0x100AU);
+    uint32 item = 1;
+    Store creatures;
+    Store references;
+    for (uint32 id = 1; id <= templates / 4 + 1; ++id)
+    {
+        Fill(references[id], rng, item, 0);
+    }
+    std::vector<uint32> ids;
+    for (uint32 id = 1; id <= templates; ++id)
+    {
+        // one id past the reference store is never found; its entries never process
+        Fill(creatures[id * 10], rng, item, uint32(references.size()) + 1);
+        ids.push_back(id * 10);
+    }
+
+    CompiledLootTable<Row> creatureTable;
+    CompiledLootTable<Row> referenceTable;
+    Compile(references, referenceTable);
+    Compile(creatures, creatureTable);
+    referenceTable.ResolveReferences(referenceTable);
+    creatureTable.ResolveReferences(referenceTable);
+
+    std::vector<uint32> indices(ids.size());
+    for (size_t i = 0; i < ids.size(); ++i)
+    {
+        indices[i] = creatureTable.Find(ids[i]);
+    }
+
+    References const lookup(references);
+
+    // Same seed each way, loot by loot: the items must be the same list.
+    uint64 mismatches = 0;
+    for (uint32 loot = 0; loot < loots; ++loot)
+    {
+        size_t const t = loot % ids.size();
+        Policy sequential(loot);
+        Policy flat(loot);
+        Template const& tab = creatures.find(ids[t])->second;
+        LootRows::Process(tab.entries, tab.groups, sequential, lookup, 0);
+        creatureTable.Process(indices[t], flat, referenceTable);
+        if (sequential.items != flat.items)
+        {
+            ++mismatches;
+        }
+    }
+
+    Policy sequential(3);
+    Policy flat(3);
+    sequential.items.reserve(4096);
+    flat.items.reserve(4096);
+    uint64 sequentialItems = 0;
+    uint64 flatItems = 0;
+
+    std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+    for (uint32 loot = 0; loot < loots; ++loot)
+    {
+        Template const& tab = creatures.find(ids[loot % ids.size()])->second;
+        LootRows::Process(tab.entries, tab.groups, sequential, lookup, 0);
+        sequentialItems += sequential.items.size();
+        sequential.items.clear();
+    }
+    double const sequentialSeconds = Seconds(begin);
+
+    begin = std::chrono::steady_clock::now();
+    for (uint32 loot = 0; loot < loots; ++loot)
+    {
+        creatureTable.Process(indices[loot % indices.size()], flat, referenceTable);
+        flatItems += flat.items.size();
+        flat.items.clear();
+    }
+    double const flatSeconds = Seconds(begin);
+
+    std::printf("%u templates, %u references (%u unresolved), %u entries, %u groups of %u items\n"
+                "%u loots each way\n\n",
+                unsigned(creatureTable.GetTemplateCount()), unsigned(referenceTable.GetTemplateCount()),
+                unsigned(creatureTable.GetUnresolvedCount()), unsigned(creatureTable.GetEntryCount() + referenceTable.GetEntryCount()),
+                unsigned(creatureTable.GetGroupCount() + referenceTable.GetGroupCount()),
+                unsigned(creatureTable.GetGroupItemCount() + referenceTable.GetGroupItemCount()), unsigned(loots));
+    std::printf("                   items    loots/s\n");
+    std::printf("  sequential %12llu %10.0f\n", (unsigned long long)sequentialItems, loots / sequentialSeconds);
+    std::printf("  flattened  %12llu %10.0f\n", (unsigned long long)flatItems, loots / flatSeconds);
+    std::printf("\n  speedup %.2fx, %llu mismatching loots\n", sequentialSeconds / flatSeconds, (unsigned long long)mismatches);
+
+    return mismatches ? 1 : 0;
+}
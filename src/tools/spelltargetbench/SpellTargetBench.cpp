@@ -0,0 +1,184 @@
+/**
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2026 MaNGOS <https://www.getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+/**
+ * @file SpellTargetBench.cpp
+ * @brief HOW MUCH DOES THE FLAT TARGET STORE SAVE AN AREA SPELL OVER THE LIST IT REPLACED?
+ *
+ * Spell::FillTargetMap adds every candidate of an area spell once per effect index,
+ * and Spell::AddUnitTarget looks each one up by guid before it either merges the
+ * effect into the known record or appends a new one. Over the std::list Spell kept
+ * before, that search is linear and every target is a heap node; SpellTargetInfoList
+ * keeps the records in a vector reused per thread, indexed by guid past a few
+ * entries. The unit tests check that both stores end up with the same targets and
+ * effect masks; this times them:
+ *
+ *   - casts of a three-effect spell over 1, 5, 40, 60 and 200 targets -- a single
+ *     target, a party, a raid, a raid with pets, a packed city;
+ *   - each cast gathered over both stores, then walked once the way
+ *     Spell::handle_immediate walks its targets, and the effects hit counted;
+ *   - each store timed over all casts of a size on its own, and the effect counts
+ *     compared -- a difference is a bug in the store, not noise.
+ */
+
+#include "SpellTargetInfoList.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <list>
+#include <string>
+
+namespace
+{
+    /// The fields Spell::TargetInfo keeps, minus the hit results.
+    struct Target
+    {
+        ObjectGuid targetGUID;
+        uint64 timeDelay;
+        uint8 effectMask;
+    };
+
+    ObjectGuid Creature(uint32 counter)
+    {
+        return ObjectGuid(HIGHGUID_UNIT, uint32(1000 + counter % 17), counter);
+    }
+
+    /// Spell::AddUnitTarget as it read over a std::list.
+    void AddListTarget(std::list<Target>& targets, ObjectGuid guid, uint32 effIndex)
+    {
+        for (std::list<Target>::iterator itr = targets.begin(); itr != targets.end(); ++itr)
+        {
+            if (itr->targetGUID == guid)
+            {
+                itr->effectMask |= 1 << effIndex;
+                return;
+            }
+        }
+        Target target = { guid, 0, uint8(1 << effIndex) };
+        targets.push_back(target);
+    }
+
+    /// Spell::AddUnitTarget as it reads now.
+    void AddFlatTarget(SpellTargetInfoList<Target>& targets, ObjectGuid guid, uint32 effIndex)
+    {
+        if (Target* known = targets.Find(guid))
+        {
+            known->effectMask |= 1 << effIndex;
+            return;
+        }
+        Target target = { guid, 0, uint8(1 << effIndex) };
+        targets.push_back(target);
+    }
+
+    template<typename List>
+    uint32 EffectCount(List const& targets)
+    {
+        uint32 count = 0;
+        for (typename List::const_iterator itr = targets.begin(); itr != targets.end(); ++itr)
+        {
+            for (uint32 i = 0; i < 3; ++i)
+            {
+                count += (itr->effectMask >> i) & 1;
+            }
+        }
+        return count;
+    }
+
+    /// Gathers and walks `casts` casts over `targets` candidates each, on a store of type List.
+    template<typename List, typename Add>
+    uint64 Cast(uint32 casts, uint32 targets, Add add, std::chrono::steady_clock::duration& elapsed)
+    {
+        uint64 effects = 0;
+        std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+        for (uint32 c = 0; c < casts; ++c)
+        {
+            List list;
+            for (uint32 effIndex = 0; effIndex < 3; ++effIndex)
+            {
+                for (uint32 i = 0; i < targets; ++i)
+                {
+                    add(list, Creature(c * 7 + i), effIndex);
+                }
+            }
+            effects += EffectCount(list);
+        }
+        elapsed = std::chrono::steady_clock::now() - begin;
+        return effects;
+    }
+
+    double Microseconds(std::chrono::steady_clock::duration d)
+    {
+        return std::chrono::duration<double, std::micro>(d).count();
+    }
+}
+
+int main(int argc, char** argv)
+{
+    uint32 casts = 20000;
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string a = argv[i];
+        if (a == "--casts" && i + 1 < argc)
+        {
+            casts = uint32(std::strtoul(argv[++i], nullptr, 10));
+        }
+        else
+        {
+            std::printf("usage: mangos-spelltargetbench [--casts <n>]\n"
+                        "\n"
+                        "  --casts <n>: casts per target count                (default: 20000)\n");
+            return 2;
+        }
+    }
+    if (casts == 0)
+    {
+        std::printf("nothing to cast\n");
+        return 2;
+    }
+
+    const uint32 sizes[] = { 1, 5, 40, 60, 200 };
+    uint32 mismatches = 0;
+
+    std::printf("%u casts of a three-effect spell per target count\n\n", unsigned(casts));
+    std::printf("  targets    list us/cast    flat us/cast    speedup\n");
+    for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); ++s)
+    {
+        std::chrono::steady_clock::duration listTime, flatTime;
+        uint64 listEffects = Cast<std::list<Target> >(casts, sizes[s], AddListTarget, listTime);
+        uint64 flatEffects = Cast<SpellTargetInfoList<Target> >(casts, sizes[s], AddFlatTarget, flatTime);
+        if (listEffects != flatEffects || flatEffects != uint64(casts) * sizes[s] * 3)
+        {
+            ++mismatches;
+        }
+
+        std::printf("  %7u %15.3f %15.3f %9.2fx\n", unsigned(sizes[s]),
+                    Microseconds(listTime) / casts, Microseconds(flatTime) / casts,
+                    Microseconds(listTime) / Microseconds(flatTime));
+    }
+    std::printf("\n  %u target counts with mismatching effects\n", unsigned(mismatches));
+
+    return mismatches ? 1 : 0;
+}